@@ -0,0 +1,200 @@
+#pragma once
+
+// external includes
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+// internal includes
+#include "Memory.h"
+#include "Platform.h"
+
+namespace Ratchet
+{
+	namespace Memory
+	{
+		/**
+		 * @brief Growable array with a guaranteed alignment whose storage comes from a user-supplied allocator.
+		 *
+		 * Capacity is kept when the buffer shrinks or is cleared, so a buffer reused every frame stops
+		 * allocating once it has reached its working size.
+		 *
+		 * @tparam T The element type.
+		 * @tparam Alignment The alignment of the first element in bytes, a power of two.
+		 */
+		template <typename T, size_t Alignment = alignof(T)>
+		class FAlignedBuffer
+		{
+			static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+			static_assert(Alignment >= alignof(T), "Alignment must be at least the natural alignment of T");
+
+		public:
+			/**
+			 * @brief Constructor that creates an empty buffer.
+			 *
+			 * @param InAllocator The allocator the storage is taken from.
+			 */
+			explicit FAlignedBuffer(FAllocator &InAllocator = GetDefaultAllocator())
+				: Allocator(&InAllocator) {}
+
+			/**
+			 * @brief Constructor that creates a buffer of value-initialized elements.
+			 *
+			 * @param InNum The number of elements.
+			 * @param InAllocator The allocator the storage is taken from.
+			 */
+			explicit FAlignedBuffer(const size_t InNum, FAllocator &InAllocator = GetDefaultAllocator())
+				: Allocator(&InAllocator)
+			{
+				Resize(InNum);
+			}
+
+			FAlignedBuffer(const FAlignedBuffer &) = delete;
+			FAlignedBuffer &operator=(const FAlignedBuffer &) = delete;
+
+			FAlignedBuffer(FAlignedBuffer &&Other) noexcept
+				: Allocator(Other.Allocator), Data(std::exchange(Other.Data, nullptr)),
+				  Count(std::exchange(Other.Count, 0)), Capacity(std::exchange(Other.Capacity, 0)) {}
+
+			FAlignedBuffer &operator=(FAlignedBuffer &&Other) noexcept
+			{
+				if (this != &Other)
+				{
+					Release();
+					Allocator = Other.Allocator;
+					Data = std::exchange(Other.Data, nullptr);
+					Count = std::exchange(Other.Count, 0);
+					Capacity = std::exchange(Other.Capacity, 0);
+				}
+				return *this;
+			}
+
+			~FAlignedBuffer()
+			{
+				Release();
+			}
+
+			/**
+			 * @brief Make sure the buffer can hold a number of elements without reallocating.
+			 *
+			 * @param InCapacity The number of elements to make room for.
+			 */
+			void Reserve(const size_t InCapacity)
+			{
+				if (InCapacity <= Capacity)
+					return;
+
+				T *NewData = static_cast<T *>(Allocator->Allocate(InCapacity * sizeof(T), Alignment));
+				if (NewData == nullptr)
+					throw std::bad_alloc();
+
+				std::uninitialized_move(Data, Data + Count, NewData);
+				std::destroy(Data, Data + Count);
+				Allocator->Free(Data, Capacity * sizeof(T), Alignment);
+
+				Data = NewData;
+				Capacity = InCapacity;
+			}
+
+			/**
+			 * @brief Change the number of elements. New elements are value-initialized.
+			 *
+			 * @param InNum The new number of elements.
+			 */
+			void Resize(const size_t InNum)
+			{
+				Reserve(InNum);
+				if (InNum > Count)
+					std::uninitialized_value_construct(Data + Count, Data + InNum);
+				else
+					std::destroy(Data + InNum, Data + Count);
+				Count = InNum;
+			}
+
+			/**
+			 * @brief Change the number of elements. New elements are copies of a value.
+			 *
+			 * @param InNum The new number of elements.
+			 * @param Value The value to copy into new elements.
+			 */
+			void Resize(const size_t InNum, const T &Value)
+			{
+				Reserve(InNum);
+				if (InNum > Count)
+					std::uninitialized_fill(Data + Count, Data + InNum, Value);
+				else
+					std::destroy(Data + InNum, Data + Count);
+				Count = InNum;
+			}
+
+			/**
+			 * @brief Append an element, growing the storage geometrically if needed.
+			 *
+			 * @param Value The element to append.
+			 * @return Reference to the new element.
+			 */
+			T &Add(const T &Value)
+			{
+				if (Count == Capacity)
+				{
+					// Value may live in the storage Reserve is about to free, e.g. Add(Buffer[0])
+					T Copy(Value);
+					Reserve(std::max<size_t>(Capacity * 2, CacheLineSize / sizeof(T) + 1));
+					T *Element = new (Data + Count) T(std::move(Copy));
+					++Count;
+					return *Element;
+				}
+				T *Element = new (Data + Count) T(Value);
+				++Count;
+				return *Element;
+			}
+
+			/**
+			 * @brief Destroy all elements but keep the storage.
+			 */
+			void Clear()
+			{
+				std::destroy(Data, Data + Count);
+				Count = 0;
+			}
+
+			/**
+			 * @brief Destroy all elements and return the storage to the allocator.
+			 */
+			void Release()
+			{
+				Clear();
+				Allocator->Free(Data, Capacity * sizeof(T), Alignment);
+				Data = nullptr;
+				Capacity = 0;
+			}
+
+			size_t Num() const { return Count; }
+			size_t GetCapacity() const { return Capacity; }
+			bool IsEmpty() const { return Count == 0; }
+			FAllocator &GetAllocator() const { return *Allocator; }
+
+			T *GetData() { return Data; }
+			const T *GetData() const { return Data; }
+
+			T &operator[](const size_t i) { return Data[i]; }
+			const T &operator[](const size_t i) const { return Data[i]; }
+
+			T *begin() { return Data; }
+			T *end() { return Data + Count; }
+			const T *begin() const { return Data; }
+			const T *end() const { return Data + Count; }
+
+			operator std::span<T>() { return {Data, Count}; }
+			operator std::span<const T>() const { return {Data, Count}; }
+
+		private:
+			FAllocator *Allocator;
+			T *Data = nullptr;
+			size_t Count = 0;
+			size_t Capacity = 0;
+		};
+	}
+}
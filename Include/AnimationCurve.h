@@ -0,0 +1,179 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "Vector3D.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief How a curve interpolates between its keys.
+	 */
+	enum class ECurveInterpolation : uint8
+	{
+		Linear,
+		Hermite,	// Cubic through the keys with one explicit tangent per key
+		CatmullRom, // Hermite with tangents from the neighbouring keys
+		Bezier		// Cubic Bezier with two explicit control points per segment
+	};
+
+	template <FloatingPoint T>
+	class FVector3DCurve;
+
+	/**
+	 * @brief Reduce the number of keys of a curve within an error bound.
+	 *
+	 * The result keeps a subset of the source keys and joins them with cubic segments that match the source's
+	 * values and one-sided derivatives at the kept keys, so kinks of the source are preserved. Keys are added
+	 * where the error is largest until the distance to the source is within Tolerance at every source key and
+	 * at SamplesPerSegment evenly spaced points inside every source segment.
+	 *
+	 * @param Source The curve to compress.
+	 * @param Tolerance The largest allowed distance to the source at the checked points.
+	 * @param SamplesPerSegment The number of points checked inside every source segment.
+	 * @param InAllocator The allocator the result's keys are taken from.
+	 * @return The compressed curve.
+	 */
+	template <FloatingPoint T>
+	FVector3DCurve<T> CompressCurve(const FVector3DCurve<T> &Source, const T Tolerance, const int32 SamplesPerSegment = 4,
+									Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+	/**
+	 * @brief Key-framed animation curve of FVector3D values.
+	 *
+	 * Every segment is stored as a cubic polynomial in power form, so all interpolation types evaluate with
+	 * the same few multiply-adds. Times before the first or after the last key clamp to the end values.
+	 *
+	 * Finding the segment of a time is the main cost of sampling; the evaluation functions take a segment
+	 * hint that is checked first and then advanced, which makes monotonically increasing times cheap.
+	 *
+	 * @tparam T The floating-point type of the times and values.
+	 */
+	template <FloatingPoint T>
+	class FVector3DCurve
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty curve, which evaluates to zero.
+		 *
+		 * @param InAllocator The allocator the keys are taken from.
+		 */
+		explicit FVector3DCurve(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Replace the keys of the curve.
+		 *
+		 * @param Interpolation How to interpolate between the keys.
+		 * @param Times The key times, strictly increasing.
+		 * @param Values The key values, one per time.
+		 * @param Controls Hermite: one tangent per key, in value units per time unit. Bezier: two control points
+		 *        per segment, in order. Ignored for Linear and CatmullRom.
+		 * @return false if the times are empty or not strictly increasing, or a length doesn't match, in which
+		 *         case the curve is left unchanged.
+		 */
+		bool SetKeys(const ECurveInterpolation Interpolation, std::span<const T> Times, std::span<const FVector3D<T>> Values,
+					 std::span<const FVector3D<T>> Controls = {});
+
+		/**
+		 * @brief Evaluate the curve at a time.
+		 *
+		 * @param Time The time.
+		 * @return The value at the time.
+		 */
+		FVector3D<T> Evaluate(const T Time) const;
+
+		/**
+		 * @brief Evaluate the curve at a time, starting the segment search from a hint.
+		 *
+		 * @param Time The time.
+		 * @param InOutSegment The segment to try first, e.g. the one of the previous call; receives the segment
+		 *        of Time. Any value is accepted, so it can start at zero.
+		 * @return The value at the time.
+		 */
+		FVector3D<T> Evaluate(const T Time, int32 &InOutSegment) const;
+
+		/**
+		 * @brief Evaluate the derivative with respect to time.
+		 *
+		 * @param Time The time. At a key, the derivative of the segment that starts there.
+		 * @return The derivative; zero outside the key range.
+		 */
+		FVector3D<T> EvaluateDerivative(const T Time) const;
+
+		/**
+		 * @brief Evaluate the curve at many times, several per SIMD register, across the worker pool.
+		 *
+		 * @param Times The times; fastest when sorted.
+		 * @param Out Receives one value per time.
+		 * @return false if the lengths don't match.
+		 */
+		bool EvaluateMany(std::span<const T> Times, const FVector3DStreams<T> &Out) const;
+
+		int32 GetKeyCount() const;
+		int32 GetSegmentCount() const;
+		T GetStartTime() const;
+		T GetEndTime() const;
+		std::span<const T> GetTimes() const;
+
+		/**
+		 * @brief Get the value of a key.
+		 *
+		 * @param Key The key index.
+		 * @return The value at the key's time.
+		 */
+		FVector3D<T> GetKeyValue(const int32 Key) const;
+
+		/**
+		 * @brief Find the segment of a time.
+		 *
+		 * @param Time The time.
+		 * @param Hint The segment to try first.
+		 * @return The index of the segment whose time range holds Time, clamped to the valid segments.
+		 */
+		int32 FindSegment(const T Time, const int32 Hint) const;
+
+		/**
+		 * @brief Get the power-form coefficients of a segment.
+		 *
+		 * @param Segment The segment index.
+		 * @return 12 values: constant, linear, quadratic and cubic coefficient vectors, each X, Y, Z, in the
+		 *         segment parameter u = (Time - SegmentStart) / SegmentDuration.
+		 */
+		const T *GetCoefficients(const int32 Segment) const;
+
+		/**
+		 * @brief Get the reciprocal duration of a segment; zero for the single segment of a one-key curve.
+		 */
+		T GetInverseDuration(const int32 Segment) const;
+
+	private:
+		template <FloatingPoint U>
+		friend FVector3DCurve<U> CompressCurve(const FVector3DCurve<U> &Source, const U Tolerance, const int32 SamplesPerSegment,
+												Memory::FAllocator &InAllocator);
+
+		Memory::FAlignedBuffer<T> Times;
+		Memory::FAlignedBuffer<T> InverseDurations;
+		Memory::FAlignedBuffer<T, CacheLineSize> Coefficients; // 12 per segment
+	};
+
+	/**
+	 * @brief Evaluate many curves at the same time, several per SIMD register, across the worker pool.
+	 *
+	 * @param Curves The curves.
+	 * @param Time The time.
+	 * @param InOutSegments Per curve, the segment to try first; receives the segment of Time. Keeping this
+	 *        between frames makes the lookup constant time when time advances.
+	 * @param Out Receives one value per curve.
+	 * @return false if the lengths don't match.
+	 */
+	template <FloatingPoint T>
+	bool EvaluateCurves(std::type_identity_t<std::span<const FVector3DCurve<T>>> Curves, const std::type_identity_t<T> Time, std::span<int32> InOutSegments,
+						const FVector3DStreams<T> &Out);
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+// external includes
+#include <concepts>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "Parallel.h"
+#include "Platform.h"
+#include "Quat.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Shape pairs per worker batch of the batched queries.
+	 */
+	constexpr int64 CollisionPairBatchSize = 64;
+
+	/**
+	 * @brief Concept for convex shapes the GJK and EPA queries work on.
+	 *
+	 * A shape is the set of points within GetRadius() of a convex core. Support(Direction) returns a point of
+	 * the core that is furthest along Direction; Direction is not normalized and may be zero. Spheres and
+	 * capsules are cores of a point and a segment with a radius, which keeps their supports exact and cheap.
+	 */
+	template <typename ShapeType>
+	concept ConvexShape = FloatingPoint<typename ShapeType::ValueType> &&
+						  requires(const ShapeType &Shape, const FVector3D<typename ShapeType::ValueType> &Direction) {
+							  { Shape.Support(Direction) } -> std::convertible_to<FVector3D<typename ShapeType::ValueType>>;
+							  { Shape.GetRadius() } -> std::convertible_to<typename ShapeType::ValueType>;
+						  };
+
+	template <FloatingPoint T>
+	struct FSphereShape
+	{
+		using ValueType = T;
+
+		FVector3D<T> Center;
+		T Radius;
+
+		FVector3D<T> Support(const FVector3D<T> &Direction) const;
+		T GetRadius() const;
+	};
+
+	template <FloatingPoint T>
+	struct FCapsuleShape
+	{
+		using ValueType = T;
+
+		FVector3D<T> Start; // Center of one cap
+		FVector3D<T> End;	// Center of the other cap
+		T Radius;
+
+		FVector3D<T> Support(const FVector3D<T> &Direction) const;
+		T GetRadius() const;
+	};
+
+	/**
+	 * @brief Oriented box.
+	 */
+	template <FloatingPoint T>
+	struct FBoxShape
+	{
+		using ValueType = T;
+
+		FVector3D<T> Center;
+		FQuat<T> Rotation;
+		FVector3D<T> HalfExtents; // Along the rotated axes
+
+		FVector3D<T> Support(const FVector3D<T> &Direction) const;
+		T GetRadius() const;
+	};
+
+	/**
+	 * @brief Convex polytope given by its vertices in a local frame, e.g. FConvexHull::GetVertices().
+	 *
+	 * The support is a linear scan, so keep vertex counts in the tens for the narrowphase.
+	 */
+	template <FloatingPoint T>
+	struct FConvexPolytopeShape
+	{
+		using ValueType = T;
+
+		std::span<const FVector3D<T>> Vertices; // Not owned
+		FVector3D<T> Position;
+		FQuat<T> Rotation;
+
+		FVector3D<T> Support(const FVector3D<T> &Direction) const;
+		T GetRadius() const;
+	};
+
+	/**
+	 * @brief Non-owning reference to the support mapping of a shape core, a callable taking a
+	 *        const FVector3D<T> & direction and returning FVector3D<T>.
+	 *
+	 * Like Parallel::FRangeFunction it never allocates, and the referenced callable must outlive the call it
+	 * is passed to.
+	 */
+	template <FloatingPoint T>
+	class FSupportFunction
+	{
+	public:
+		template <typename FunctionType>
+			requires(!std::is_same_v<std::remove_cvref_t<FunctionType>, FSupportFunction>)
+		FSupportFunction(FunctionType &&Function)
+			: Object(const_cast<void *>(static_cast<const void *>(std::addressof(Function)))),
+			  Invoker([](void *InObject, const FVector3D<T> &Direction) -> FVector3D<T>
+					  { return (*static_cast<std::remove_reference_t<FunctionType> *>(InObject))(Direction); })
+		{
+		}
+
+		FVector3D<T> operator()(const FVector3D<T> &Direction) const
+		{
+			return Invoker(Object, Direction);
+		}
+
+	private:
+		void *Object;
+		FVector3D<T> (*Invoker)(void *, const FVector3D<T> &);
+	};
+
+	/**
+	 * @brief Simplex of the last GJK query on a pair, to warm-start the next one.
+	 *
+	 * The search directions that produced the simplex vertices are kept rather than the vertices, so the
+	 * simplex is rebuilt on the shapes' new poses. Coherent motion then ends most queries after an iteration
+	 * or two. A zero-initialized cache starts cold.
+	 */
+	template <FloatingPoint T>
+	struct FGJKCache
+	{
+		FVector3D<T> Directions[4];
+		int32 Count = 0;
+	};
+
+	template <FloatingPoint T>
+	struct FGJKResult
+	{
+		T Distance;			// Between the shapes' surfaces, 0 if they intersect
+		FVector3D<T> PointA; // Closest point on A, if they don't intersect
+		FVector3D<T> PointB; // Closest point on B, if they don't intersect
+		bool bIntersecting;
+		int32 Iterations; // Support evaluations of each shape
+	};
+
+	template <FloatingPoint T>
+	struct FPenetrationResult
+	{
+		FVector3D<T> Normal; // Unit direction from A to B; moving B by Depth * Normal separates the shapes
+		T Depth;			 // Penetration depth, or minus the distance if the shapes don't intersect
+		FVector3D<T> PointA; // Deepest point of A inside B, or the closest point on A
+		FVector3D<T> PointB; // Deepest point of B inside A, or the closest point on B
+		bool bPenetrating;
+	};
+
+	/**
+	 * @brief Distance between two convex shapes with GJK, given by their support functions.
+	 *
+	 * @param SupportA The support mapping of the core of A.
+	 * @param RadiusA The radius around the core of A.
+	 * @param SupportB The support mapping of the core of B.
+	 * @param RadiusB The radius around the core of B.
+	 * @param Cache The simplex to start from and to update, or nullptr to start cold.
+	 * @return The distance and closest points.
+	 */
+	template <FloatingPoint T>
+	FGJKResult<T> ComputeDistance(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+								  const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache = nullptr);
+
+	/**
+	 * @brief Whether two convex shapes intersect, with GJK stopping at the first separating axis.
+	 *
+	 * @param SupportA The support mapping of the core of A.
+	 * @param RadiusA The radius around the core of A.
+	 * @param SupportB The support mapping of the core of B.
+	 * @param RadiusB The radius around the core of B.
+	 * @param Cache The simplex to start from and to update, or nullptr to start cold.
+	 * @return true if the shapes intersect.
+	 */
+	template <FloatingPoint T>
+	bool ComputeIntersection(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+							 const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache = nullptr);
+
+	/**
+	 * @brief Penetration depth and contact of two convex shapes.
+	 *
+	 * When the radii alone overlap, the contact follows from the GJK closest points of the cores; when the
+	 * cores intersect, EPA expands the GJK simplex over their Minkowski difference.
+	 *
+	 * @param SupportA The support mapping of the core of A.
+	 * @param RadiusA The radius around the core of A.
+	 * @param SupportB The support mapping of the core of B.
+	 * @param RadiusB The radius around the core of B.
+	 * @param Cache The simplex to start GJK from and to update, or nullptr to start cold.
+	 * @return The contact normal, depth and points.
+	 */
+	template <FloatingPoint T>
+	FPenetrationResult<T> ComputePenetration(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+											 const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache = nullptr);
+
+	/**
+	 * @brief Distance between two convex shapes with GJK.
+	 *
+	 * @param A The first shape.
+	 * @param B The second shape.
+	 * @param Cache The simplex to start from and to update, or nullptr to start cold.
+	 * @return The distance and closest points.
+	 */
+	template <ConvexShape ShapeA, ConvexShape ShapeB>
+		requires std::same_as<typename ShapeA::ValueType, typename ShapeB::ValueType>
+	FGJKResult<typename ShapeA::ValueType> GJKDistance(const ShapeA &A, const ShapeB &B, FGJKCache<typename ShapeA::ValueType> *Cache = nullptr)
+	{
+		using T = typename ShapeA::ValueType;
+		const auto SupportA = [&A](const FVector3D<T> &Direction) -> FVector3D<T> { return A.Support(Direction); };
+		const auto SupportB = [&B](const FVector3D<T> &Direction) -> FVector3D<T> { return B.Support(Direction); };
+		return ComputeDistance<T>(SupportA, A.GetRadius(), SupportB, B.GetRadius(), Cache);
+	}
+
+	/**
+	 * @brief Whether two convex shapes intersect.
+	 *
+	 * @param A The first shape.
+	 * @param B The second shape.
+	 * @param Cache The simplex to start from and to update, or nullptr to start cold.
+	 * @return true if the shapes intersect.
+	 */
+	template <ConvexShape ShapeA, ConvexShape ShapeB>
+		requires std::same_as<typename ShapeA::ValueType, typename ShapeB::ValueType>
+	bool GJKIntersect(const ShapeA &A, const ShapeB &B, FGJKCache<typename ShapeA::ValueType> *Cache = nullptr)
+	{
+		using T = typename ShapeA::ValueType;
+		const auto SupportA = [&A](const FVector3D<T> &Direction) -> FVector3D<T> { return A.Support(Direction); };
+		const auto SupportB = [&B](const FVector3D<T> &Direction) -> FVector3D<T> { return B.Support(Direction); };
+		return ComputeIntersection<T>(SupportA, A.GetRadius(), SupportB, B.GetRadius(), Cache);
+	}
+
+	/**
+	 * @brief Penetration depth and contact of two convex shapes with GJK and EPA.
+	 *
+	 * @param A The first shape.
+	 * @param B The second shape.
+	 * @param Cache The simplex to start GJK from and to update, or nullptr to start cold.
+	 * @return The contact normal, depth and points.
+	 */
+	template <ConvexShape ShapeA, ConvexShape ShapeB>
+		requires std::same_as<typename ShapeA::ValueType, typename ShapeB::ValueType>
+	FPenetrationResult<typename ShapeA::ValueType> EPAPenetration(const ShapeA &A, const ShapeB &B, FGJKCache<typename ShapeA::ValueType> *Cache = nullptr)
+	{
+		using T = typename ShapeA::ValueType;
+		const auto SupportA = [&A](const FVector3D<T> &Direction) -> FVector3D<T> { return A.Support(Direction); };
+		const auto SupportB = [&B](const FVector3D<T> &Direction) -> FVector3D<T> { return B.Support(Direction); };
+		return ComputePenetration<T>(SupportA, A.GetRadius(), SupportB, B.GetRadius(), Cache);
+	}
+
+	/**
+	 * @brief Distances of many shape pairs (A[i], B[i]), distributed over the worker pool.
+	 *
+	 * @param A The first shape of every pair.
+	 * @param B The second shape of every pair.
+	 * @param Caches One warm-start cache per pair, or empty to start every query cold.
+	 * @param Results Receives one result per pair.
+	 * @return false if the lengths don't match, in which case nothing is written.
+	 */
+	template <ConvexShape ShapeA, ConvexShape ShapeB>
+		requires std::same_as<typename ShapeA::ValueType, typename ShapeB::ValueType>
+	bool GJKDistanceMany(std::span<const ShapeA> A, std::span<const ShapeB> B, std::span<FGJKCache<typename ShapeA::ValueType>> Caches,
+						 std::span<FGJKResult<typename ShapeA::ValueType>> Results)
+	{
+		const size_t Count = A.size();
+		if (B.size() != Count || Results.size() != Count || (!Caches.empty() && Caches.size() != Count))
+			return false;
+
+		Parallel::ParallelFor(static_cast<int64>(Count), CollisionPairBatchSize, [A, B, Caches, Results](const int64 Begin, const int64 End)
+							  {
+								  for (int64 i = Begin; i < End; ++i)
+									  Results[i] = GJKDistance(A[i], B[i], Caches.empty() ? nullptr : &Caches[i]);
+							  });
+		return true;
+	}
+
+	/**
+	 * @brief Penetrations of many shape pairs (A[i], B[i]), distributed over the worker pool.
+	 *
+	 * @param A The first shape of every pair.
+	 * @param B The second shape of every pair.
+	 * @param Caches One warm-start cache per pair, or empty to start every query cold.
+	 * @param Results Receives one result per pair.
+	 * @return false if the lengths don't match, in which case nothing is written.
+	 */
+	template <ConvexShape ShapeA, ConvexShape ShapeB>
+		requires std::same_as<typename ShapeA::ValueType, typename ShapeB::ValueType>
+	bool EPAPenetrationMany(std::span<const ShapeA> A, std::span<const ShapeB> B, std::span<FGJKCache<typename ShapeA::ValueType>> Caches,
+							std::span<FPenetrationResult<typename ShapeA::ValueType>> Results)
+	{
+		const size_t Count = A.size();
+		if (B.size() != Count || Results.size() != Count || (!Caches.empty() && Caches.size() != Count))
+			return false;
+
+		Parallel::ParallelFor(static_cast<int64>(Count), CollisionPairBatchSize, [A, B, Caches, Results](const int64 Begin, const int64 End)
+							  {
+								  for (int64 i = Begin; i < End; ++i)
+									  Results[i] = EPAPenetration(A[i], B[i], Caches.empty() ? nullptr : &Caches[i]);
+							  });
+		return true;
+	}
+}
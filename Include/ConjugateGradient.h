@@ -0,0 +1,106 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "SparseMatrix.h"
+#include "Types.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Preconditioner applied by the conjugate gradient solver.
+	 */
+	enum class EPreconditioner : uint8
+	{
+		None,
+		Jacobi,			   // Inverse of the diagonal blocks; cheap and parallel
+		IncompleteCholesky // Zero fill-in Cholesky factor; fewer iterations, but its triangular solves run on one thread
+	};
+
+	/**
+	 * @brief Outcome of a conjugate gradient solve.
+	 */
+	template <FloatingPoint T>
+	struct FConjugateGradientResult
+	{
+		int64 Iterations = 0;	// Iterations performed
+		T RelativeResidual = 0; // |R| / |B| of the final residual R = B - A * X, as updated by the iteration
+		bool bConverged = false;
+	};
+
+	/**
+	 * @brief Preconditioned conjugate gradient solver for sparse symmetric positive-definite systems.
+	 *
+	 * Compute builds the preconditioner from the current values of the matrix and has to be called again
+	 * after they change. Once a solver has seen a matrix of a given pattern, Compute and Solve run without
+	 * allocating. Vector work and the matrix product run across the worker pool; dot products are summed
+	 * in a fixed order, so results do not depend on the number of workers.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 * @tparam BlockSize The block size of the matrix, 1 or 3.
+	 */
+	template <FloatingPoint T, int32 BlockSize = 1>
+	class FConjugateGradientSolver
+	{
+	public:
+		using MatrixType = FSparseMatrix<T, BlockSize>;
+		using VectorType = typename MatrixType::VectorType;
+
+		/**
+		 * @brief Constructor that creates a solver without a matrix.
+		 *
+		 * @param InAllocator The allocator the preconditioner and work vectors are taken from.
+		 */
+		explicit FConjugateGradientSolver(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Set the matrix and build the preconditioner.
+		 *
+		 * @param InMatrix The square matrix. It is referenced, not copied, and must outlive the solves.
+		 * @param InPreconditioner The preconditioner to use.
+		 * @return false if the matrix is not square or the preconditioner cannot be built, e.g. because of a
+		 *         missing or non-positive diagonal. Solve fails until the next successful Compute.
+		 */
+		bool Compute(const MatrixType &InMatrix, const EPreconditioner InPreconditioner = EPreconditioner::Jacobi);
+
+		/**
+		 * @brief Solve A * X = B.
+		 *
+		 * @param B The right-hand side.
+		 * @param X The initial guess on input, e.g. last frame's solution, and the solution on output. Must not overlap B.
+		 * @param Tolerance Stop when |B - A * X| <= Tolerance * |B|.
+		 * @param MaxIterations The maximum number of iterations.
+		 * @return The iteration count and residual; nothing is done if there is no valid matrix or the lengths don't match.
+		 */
+		FConjugateGradientResult<T> Solve(std::span<const VectorType> B, std::span<VectorType> X, const T Tolerance = T(1e-5), const int64 MaxIterations = 1000);
+
+	private:
+		// Computes Preconditioned = M^-1 * Residual and returns Residual . Preconditioned
+		T ApplyPreconditioner();
+
+		bool FactorIncompleteCholesky();
+
+		const MatrixType *Matrix = nullptr;
+		EPreconditioner Preconditioner = EPreconditioner::None;
+		bool bValid = false;
+
+		// Jacobi: inverse of every diagonal block, BlockSize * BlockSize entries per block row
+		Memory::FAlignedBuffer<T, CacheLineSize> InverseDiagonal;
+
+		// Incomplete Cholesky: scalar CSR lower-triangular factor, diagonal stored last in every row
+		Memory::FAlignedBuffer<int64> FactorOffsets;
+		Memory::FAlignedBuffer<int32> FactorColumns;
+		Memory::FAlignedBuffer<T, CacheLineSize> FactorValues;
+
+		// Work vectors in scalar components and the per-partition partial sums of the dot products
+		Memory::FAlignedBuffer<T, CacheLineSize> Residual;
+		Memory::FAlignedBuffer<T, CacheLineSize> Direction;
+		Memory::FAlignedBuffer<T, CacheLineSize> Product;
+		Memory::FAlignedBuffer<T, CacheLineSize> Preconditioned;
+		Memory::FAlignedBuffer<T> PartialSums;
+	};
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Half-edge of a convex hull. The edges of a face form a counterclockwise loop seen from outside.
+	 */
+	struct FHullHalfEdge
+	{
+		int32 Vertex; // Hull vertex the edge starts at
+		int32 Twin;	  // The opposite half-edge, in the neighbouring face
+		int32 Next;	  // The next half-edge of the same face
+		int32 Face;
+	};
+
+	/**
+	 * @brief Face of a convex hull with its outward plane: Dot(Normal, X) = Offset for points X on the face.
+	 */
+	template <FloatingPoint T>
+	struct FHullFace
+	{
+		int32 Edge; // One of the face's half-edges
+		FVector3D<T> Normal;
+		T Offset;
+	};
+
+	/**
+	 * @brief 3D convex hull of a point set, built with Quickhull and stored as a half-edge mesh of triangles.
+	 *
+	 * Points are added furthest first. Whether a face is visible from a new point is decided with the exact
+	 * Predicates::Orient3D, so the mesh stays closed and convex however degenerate the input is. Points within
+	 * a small tolerance of the current hull are treated as coplanar and dropped rather than turned into sliver
+	 * faces; the hull can miss such points by at most that tolerance. Coplanar regions are triangulated, not
+	 * merged into polygons.
+	 *
+	 * All working storage lives in the hull and is reused by the next Build, so a hull object that has
+	 * reached its working size builds without allocating.
+	 *
+	 * @tparam T The floating-point type of the points.
+	 */
+	template <FloatingPoint T>
+	class FConvexHull
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty hull.
+		 *
+		 * @param InAllocator The allocator the hull and its working storage are taken from.
+		 */
+		explicit FConvexHull(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Build the hull of a point set, replacing the previous one.
+		 *
+		 * The points are first assigned to the faces of an initial tetrahedron in parallel.
+		 *
+		 * @param Points The points.
+		 * @param MaxVertices The largest number of hull vertices, at least 4, or 0 for no limit. With a limit
+		 *        the hull simplifies by leaving out the points closest to it, and so may not contain all points.
+		 * @return false if the points don't span a volume (fewer than four, or all within the tolerance of
+		 *         a plane), in which case the hull is empty.
+		 */
+		bool Build(std::span<const FVector3D<T>> Points, const int32 MaxVertices = 0);
+
+		/**
+		 * @brief Get the hull vertices.
+		 */
+		std::span<const FVector3D<T>> GetVertices() const;
+
+		/**
+		 * @brief Get the index into the input points of every hull vertex.
+		 */
+		std::span<const int32> GetVertexIndices() const;
+
+		std::span<const FHullHalfEdge> GetEdges() const;
+		std::span<const FHullFace<T>> GetFaces() const;
+
+		/**
+		 * @brief Get the distance below which a point was treated as lying on the hull by the last Build.
+		 */
+		T GetTolerance() const;
+
+	private:
+		// Working state of a triangle; the half-edges of face f are 3f, 3f + 1 and 3f + 2
+		struct FWorkFace
+		{
+			T Normal[3];
+			T Offset;
+			int32 Conflicts;	  // First point of the outside set, linked through NextConflicts
+			int32 Furthest;		  // Point of the outside set furthest from the face
+			T FurthestDistance;
+			uint32 Generation;	  // Incremented when the slot is reused, to invalidate queue entries
+			uint32 VisitedMark;	  // Point addition that last visited the face
+			bool bAlive;
+		};
+
+		struct FQueueEntry
+		{
+			T Distance;
+			int32 Face;
+			uint32 Generation;
+
+			bool operator<(const FQueueEntry &Other) const { return Distance < Other.Distance; }
+		};
+
+		struct FHorizonEdge
+		{
+			int32 Start;
+			int32 End;
+			int32 Twin; // Half-edge of the face that stays
+		};
+
+		bool BuildInitialSimplex(std::span<const FVector3D<T>> Points);
+		void PartitionInitialPoints(std::span<const FVector3D<T>> Points);
+		int32 AddFace(const int32 A, const int32 B, const int32 C);
+		void AddConflict(const int32 Face, const int32 Point, const T Distance);
+		T GetDistance(const int32 Face, const int32 Point) const;
+		bool AddPoint(std::span<const FVector3D<T>> Points, const int32 Eye, const int32 EyeFace);
+		void Finish(std::span<const FVector3D<T>> Points);
+
+		// Working state
+		Memory::FAlignedBuffer<T> Coordinates[3]; // The input points as streams, for the distance tests
+		Memory::FAlignedBuffer<FWorkFace> WorkFaces;
+		Memory::FAlignedBuffer<int32> WorkVertices; // Input point at the start of every half-edge
+		Memory::FAlignedBuffer<int32> WorkTwins;
+		Memory::FAlignedBuffer<int32> FreeFaces;
+		Memory::FAlignedBuffer<int32> NextConflicts; // Per input point
+		Memory::FAlignedBuffer<int32> PointFaces;	 // Per input point, the face of the initial partition
+		Memory::FAlignedBuffer<T> PointDistances;
+		Memory::FAlignedBuffer<FQueueEntry> Queue;
+		Memory::FAlignedBuffer<int32> VisibleFaces;
+		Memory::FAlignedBuffer<int32> Stack;
+		Memory::FAlignedBuffer<FHorizonEdge> Horizon;
+		Memory::FAlignedBuffer<int32> NewFaces;
+		uint32 Mark = 0;
+
+		// Result
+		Memory::FAlignedBuffer<FVector3D<T>> Vertices;
+		Memory::FAlignedBuffer<int32> VertexIndices;
+		Memory::FAlignedBuffer<FHullHalfEdge> Edges;
+		Memory::FAlignedBuffer<FHullFace<T>> Faces;
+		T Tolerance = 0;
+	};
+}
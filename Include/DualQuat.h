@@ -0,0 +1,142 @@
+#pragma once
+
+// internal includes
+#include "Platform.h"
+#include "Quat.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Dual quaternion class template, Real + epsilon * Dual, representing a rigid transform.
+	 *
+	 * A unit dual quaternion holds a rotation R in the real part and 0.5 * t * R in the dual part, where t is
+	 * the translation applied after the rotation. Weighted sums of unit dual quaternions renormalized with
+	 * Normalize blend rigid transforms without the volume loss of blended matrices.
+	 *
+	 * @tparam T The floating-point type to use for the components.
+	 */
+	template <FloatingPoint T>
+	class FDualQuat
+	{
+	public:
+		/**
+		 * @brief Default constructor. Initializes the identity transform.
+		 */
+		FDualQuat();
+
+		/**
+		 * @brief Constructor that initializes both parts with given values.
+		 *
+		 * @param InReal The real part.
+		 * @param InDual The dual part.
+		 */
+		FDualQuat(const FQuat<T> &InReal, const FQuat<T> &InDual);
+
+		/**
+		 * @brief Constructor that creates a rigid transform, rotation first, then translation.
+		 *
+		 * @param Rotation The rotation; must be a unit quaternion.
+		 * @param Translation The translation.
+		 */
+		FDualQuat(const FQuat<T> &Rotation, const FVector3D<T> &Translation);
+
+		const FQuat<T> &GetReal() const { return Real; }
+		const FQuat<T> &GetDual() const { return Dual; }
+
+		/**
+		 * @brief Get the rotation of a unit dual quaternion.
+		 *
+		 * @return The rotation.
+		 */
+		FQuat<T> GetRotation() const;
+
+		/**
+		 * @brief Get the translation of a unit dual quaternion.
+		 *
+		 * @return The translation.
+		 */
+		FVector3D<T> GetTranslation() const;
+
+		/**
+		 * @brief Scale both parts so that the real part has a magnitude of 1.
+		 *
+		 * @return Reference to the normalized dual quaternion.
+		 */
+		FDualQuat &Normalize();
+
+		/**
+		 * @brief Get the quaternion conjugate of both parts, which is the inverse transform for unit dual quaternions.
+		 *
+		 * @return The conjugate dual quaternion.
+		 */
+		FDualQuat GetConjugate() const;
+
+		/**
+		 * @brief Transform a point by this unit dual quaternion.
+		 *
+		 * @param Point The point to transform.
+		 * @return The rotated and translated point.
+		 */
+		FVector3D<T> TransformPoint(const FVector3D<T> &Point) const;
+
+		/**
+		 * @brief Transform a direction, such as a normal, by this unit dual quaternion; only the rotation applies.
+		 *
+		 * @param Vector The direction to transform.
+		 * @return The rotated direction.
+		 */
+		FVector3D<T> TransformVector(const FVector3D<T> &Vector) const;
+
+		/**
+		 * @brief Compound assignment operator for dual quaternion addition.
+		 *
+		 * @param Other The dual quaternion to add.
+		 * @return Reference to the modified dual quaternion.
+		 */
+		FDualQuat &operator+=(const FDualQuat &Other);
+
+		/**
+		 * @brief Compound assignment operator for scalar multiplication.
+		 *
+		 * @param Scalar The scalar value to multiply by.
+		 * @return Reference to the modified dual quaternion.
+		 */
+		FDualQuat &operator*=(const T Scalar);
+
+	private:
+		FQuat<T> Real; // Rotation
+		FQuat<T> Dual; // Half the translation times the rotation
+	};
+
+	/**
+	 * @brief Binary operator for the dual quaternion product; (A * B) applies B first.
+	 *
+	 * @param A The left dual quaternion.
+	 * @param B The right dual quaternion.
+	 * @return The product A * B.
+	 */
+	template <FloatingPoint T>
+	FDualQuat<T> operator*(const FDualQuat<T> &A, const FDualQuat<T> &B);
+
+	/**
+	 * @brief Binary operator for dual quaternion-scalar multiplication.
+	 *
+	 * @param LHS The dual quaternion to multiply.
+	 * @param Scalar The scalar value to multiply by.
+	 * @return The result of the multiplication.
+	 */
+	template <FloatingPoint T>
+	FDualQuat<T> operator*(const FDualQuat<T> &LHS, const T Scalar);
+
+	/**
+	 * @brief Binary operator for dual quaternion addition.
+	 *
+	 * @param A The first dual quaternion.
+	 * @param B The second dual quaternion.
+	 * @return The result of the addition.
+	 */
+	template <FloatingPoint T>
+	FDualQuat<T> operator+(const FDualQuat<T> &A, const FDualQuat<T> &B);
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+// external includes
+#include <atomic>
+#include <bit>
+#include <cstdio>
+
+// internal includes
+#include "Platform.h"
+
+#ifdef RATCHET_INSTRUMENT
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace Ratchet
+{
+	namespace Instrument
+	{
+		/**
+		 * @brief Library functions with their own counters.
+		 */
+		enum class ECounter : uint8
+		{
+			MathSqrt,
+			MathSqrtIterations, // Records Newton iterations per Math::Sqrt call instead of cycles
+			VectorMagnitude,
+			VectorNormalize,
+			VectorGetNormalized,
+			VectorDistanceTo,
+			VectorDistance,
+			KDTreeBuild,
+			KDTreeFindKNearest,
+			KDTreeFindKNearestBatch,
+			VectorFileAppend,
+			VectorPipelineRun,
+			VectorSum,
+			VectorBounds,
+			VectorCovariance,
+			MatrixGemm,
+			MatrixGemv,
+			MatrixEigen3x3Batch,
+			MatrixSolve3x3Batch,
+			SparseMultiply,
+			SparseConjugateGradient,
+			SparseConjugateGradientIterations, // Records iterations per solve instead of cycles
+			SkinDualQuat,
+			TransformHierarchyUpdate,
+			CurveEvaluateMany,
+			CurveEvaluateCurves,
+			IntegrateSymplecticEuler,
+			IntegrateVerlet,
+			IntegrateRungeKutta4,
+			PredicateOrient2D, // Every predicate has an ...Exact counter for the calls that needed exact arithmetic
+			PredicateOrient2DExact,
+			PredicateOrient3D,
+			PredicateOrient3DExact,
+			PredicateInCircle,
+			PredicateInCircleExact,
+			PredicateInSphere,
+			PredicateInSphereExact,
+			ConvexHullBuild,
+			GJKDistance,
+			GJKIntersect,
+			EPAPenetration,
+			OBBFit,
+			OBBOverlapMany,
+			OBBOverlapSphereMany,
+			OBBIntersectRayMany,
+			MeshComputeNormals,
+			MeshComputeTangents,
+			Polygon2DBoolean,
+			Polygon2DBooleanMany,
+			Polygon2DTriangulate,
+			Polygon2DTriangulateMany,
+			Polygon2DOffset,
+			Polygon2DOffsetMany,
+			RandomUniform,
+			RandomUnitVectors,
+			RandomPointsInSphere,
+			RandomPointsInDisk,
+			RandomCosineHemisphere,
+			RandomBarycentrics,
+			RandomPointsInTriangle,
+			RandomPoissonDisk2D,
+			RandomPoissonDisk3D,
+			Noise2D,
+			Noise3D,
+			Noise4D,
+			SpatialMortonCodes,
+			SpatialHilbertCodes,
+			SpatialSortPermutation,
+			Count
+		};
+
+		/**
+		 * @brief Number of log2 buckets in every histogram. Bucket i holds values in [2^i, 2^(i+1)), bucket 0 also holds 0.
+		 */
+		constexpr int32 HistogramBuckets = 40;
+
+		/**
+		 * @brief Totals of one counter, merged over all threads.
+		 */
+		struct FCounterTotals
+		{
+			uint64 Calls = 0;						// Number of recorded calls
+			uint64 Elements = 0;					// Elements processed by batch calls, or the recorded values
+			uint64 Cycles = 0;						// Cycles spent inside timed calls
+			uint64 Histogram[HistogramBuckets] = {}; // Distribution of cycles per call, or of the recorded values
+		};
+
+		/**
+		 * @brief Output format of Dump.
+		 */
+		enum class EDumpFormat : uint8
+		{
+			Text,
+			Json
+		};
+
+		/**
+		 * @brief Check whether the library was built with RATCHET_INSTRUMENT.
+		 *
+		 * @return true if counters are being recorded.
+		 */
+		constexpr bool IsEnabled()
+		{
+#ifdef RATCHET_INSTRUMENT
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		 * @brief Get the printable name of a counter.
+		 *
+		 * @param Counter The counter.
+		 * @return The name, e.g. "Math::Sqrt".
+		 */
+		const char *GetCounterName(const ECounter Counter);
+
+		/**
+		 * @brief Sum the thread-local counters of every thread that has recorded anything.
+		 *
+		 * Threads keep recording while the merge runs, so totals of a busy counter may lag by a few calls.
+		 *
+		 * @param OutTotals Receives one entry per counter, indexed by ECounter.
+		 */
+		void Merge(FCounterTotals (&OutTotals)[static_cast<int32>(ECounter::Count)]);
+
+		/**
+		 * @brief Zero the counters of every thread.
+		 */
+		void Reset();
+
+		/**
+		 * @brief Write the merged counters of all called functions.
+		 *
+		 * @param File The stream to write to.
+		 * @param Format Human-readable text or JSON.
+		 */
+		void Dump(std::FILE *File, const EDumpFormat Format);
+
+#ifdef RATCHET_INSTRUMENT
+		/**
+		 * @brief Per-thread counter storage. Only the owning thread writes; other threads read while merging.
+		 */
+		struct FThreadCounters
+		{
+			struct FCounter
+			{
+				std::atomic<uint64> Calls{0};
+				std::atomic<uint64> Elements{0};
+				std::atomic<uint64> Cycles{0};
+				std::atomic<uint64> Histogram[HistogramBuckets] = {};
+			};
+
+			FCounter Counters[static_cast<int32>(ECounter::Count)];
+			FThreadCounters *Next = nullptr;
+			std::atomic<bool> bInUse{true};
+		};
+
+		/**
+		 * @brief Get the counters of the calling thread, registering them on first use.
+		 */
+		FThreadCounters &GetThreadCounters();
+
+		inline uint64 ReadCycleCounter()
+		{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		inline int32 GetHistogramBucket(const uint64 Value)
+		{
+			const int32 Bucket = static_cast<int32>(std::bit_width(Value | 1)) - 1;
+			return Bucket < HistogramBuckets ? Bucket : HistogramBuckets - 1;
+		}
+
+		// Single-writer increment: a plain load and store, no locked read-modify-write
+		inline void Increment(std::atomic<uint64> &Value, const uint64 Amount)
+		{
+			Value.store(Value.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+		}
+
+		inline void Record(const ECounter Counter, const uint64 Elements, const uint64 Cycles)
+		{
+			FThreadCounters::FCounter &Data = GetThreadCounters().Counters[static_cast<int32>(Counter)];
+			Increment(Data.Calls, 1);
+			Increment(Data.Elements, Elements);
+			Increment(Data.Cycles, Cycles);
+			Increment(Data.Histogram[GetHistogramBucket(Cycles)], 1);
+		}
+
+		inline void RecordValue(const ECounter Counter, const uint64 Value)
+		{
+			FThreadCounters::FCounter &Data = GetThreadCounters().Counters[static_cast<int32>(Counter)];
+			Increment(Data.Calls, 1);
+			Increment(Data.Elements, Value);
+			Increment(Data.Histogram[GetHistogramBucket(Value)], 1);
+		}
+
+		/**
+		 * @brief Times the enclosing scope and records it as one call of a counter.
+		 */
+		class FScopedCounter
+		{
+		public:
+			explicit FScopedCounter(const ECounter InCounter, const uint64 InElements = 0)
+				: Counter(InCounter), Elements(InElements), Start(ReadCycleCounter()) {}
+
+			~FScopedCounter()
+			{
+				Record(Counter, Elements, ReadCycleCounter() - Start);
+			}
+
+			FScopedCounter(const FScopedCounter &) = delete;
+			FScopedCounter &operator=(const FScopedCounter &) = delete;
+
+		private:
+			ECounter Counter;
+			uint64 Elements;
+			uint64 Start;
+		};
+#endif
+	}
+}
+
+#define RATCHET_INSTRUMENT_CONCAT_INNER(A, B) A##B
+#define RATCHET_INSTRUMENT_CONCAT(A, B) RATCHET_INSTRUMENT_CONCAT_INNER(A, B)
+
+#ifdef RATCHET_INSTRUMENT
+
+// Time the rest of the enclosing scope as one call of a counter
+#define RATCHET_INSTRUMENT_SCOPE(Counter) \
+	::Ratchet::Instrument::FScopedCounter RATCHET_INSTRUMENT_CONCAT(InstrumentScope, __LINE__)(::Ratchet::Instrument::ECounter::Counter)
+
+// Time the rest of the enclosing scope as one batch call over a number of elements
+#define RATCHET_INSTRUMENT_BATCH(Counter, ElementCount) \
+	::Ratchet::Instrument::FScopedCounter RATCHET_INSTRUMENT_CONCAT(InstrumentScope, __LINE__)(::Ratchet::Instrument::ECounter::Counter, static_cast<::Ratchet::uint64>(ElementCount))
+
+// Record a value, such as an iteration count, into a counter's histogram
+#define RATCHET_INSTRUMENT_VALUE(Counter, Value) \
+	::Ratchet::Instrument::RecordValue(::Ratchet::Instrument::ECounter::Counter, static_cast<::Ratchet::uint64>(Value))
+
+#else
+
+#define RATCHET_INSTRUMENT_SCOPE(Counter) \
+	do                                    \
+	{                                     \
+	} while (0)
+#define RATCHET_INSTRUMENT_BATCH(Counter, ElementCount) \
+	do                                                  \
+	{                                                   \
+		(void)sizeof(ElementCount);                     \
+	} while (0)
+#define RATCHET_INSTRUMENT_VALUE(Counter, Value) \
+	do                                           \
+	{                                            \
+		(void)sizeof(Value);                     \
+	} while (0)
+
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+
+// external includes
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Number of particles the integrators advance side by side, and so the most an acceleration function
+	 *        is asked for at once.
+	 */
+	constexpr int32 IntegratorLaneCount = 8;
+
+	/**
+	 * @brief Optional velocity damping and clamping applied by every integrator step.
+	 */
+	template <FloatingPoint T>
+	struct FIntegratorSettings
+	{
+		T Damping = 0;									 // Velocity decays by exp(-Damping * DeltaTime) per step
+		T MaxSpeed = std::numeric_limits<T>::infinity(); // Faster velocities are scaled down to this speed
+	};
+
+	/**
+	 * @brief State of up to IntegratorLaneCount consecutive particles, as passed to an acceleration function.
+	 *
+	 * Lanes at and past Count repeat the last valid particle.
+	 */
+	template <FloatingPoint T>
+	struct FParticleLanes
+	{
+		int64 First; // Index of the particle in lane 0
+		int32 Count; // Number of valid lanes
+		T Time;
+		T Positions[3][IntegratorLaneCount];
+		T Velocities[3][IntegratorLaneCount];
+	};
+
+	/**
+	 * @brief Non-owning reference to a callable that computes the accelerations of a block of particles.
+	 *
+	 * The callable takes a const FParticleLanes<T> & and a T (&)[3][IntegratorLaneCount] that receives the
+	 * acceleration X, Y and Z of every lane. It is called from several worker threads at once. Like
+	 * Parallel::FRangeFunction it never allocates, and the referenced callable must outlive the call it is
+	 * passed to.
+	 */
+	template <FloatingPoint T>
+	class FAccelerationFunction
+	{
+	public:
+		template <typename FunctionType>
+			requires(!std::is_same_v<std::remove_cvref_t<FunctionType>, FAccelerationFunction>)
+		FAccelerationFunction(FunctionType &&Function)
+			: Object(const_cast<void *>(static_cast<const void *>(std::addressof(Function)))),
+			  Invoker([](void *InObject, const FParticleLanes<T> &State, T(&Accelerations)[3][IntegratorLaneCount])
+					  { (*static_cast<std::remove_reference_t<FunctionType> *>(InObject))(State, Accelerations); })
+		{
+		}
+
+		void operator()(const FParticleLanes<T> &State, T (&Accelerations)[3][IntegratorLaneCount]) const
+		{
+			Invoker(Object, State, Accelerations);
+		}
+
+	private:
+		void *Object;
+		void (*Invoker)(void *, const FParticleLanes<T> &, T (&)[3][IntegratorLaneCount]);
+	};
+
+	/**
+	 * @brief Advance particles by one symplectic (semi-implicit) Euler step, in place.
+	 *
+	 * Velocities are updated from the forces first, then damped and clamped, and the positions move with the
+	 * new velocities. Particles are processed several per SIMD register and distributed over the worker pool.
+	 *
+	 * @param Positions The positions, updated in place.
+	 * @param Velocities The velocities, updated in place.
+	 * @param Forces The forces acting on the particles.
+	 * @param InverseMasses The reciprocal masses, or empty for unit masses, in which case Forces are accelerations.
+	 * @param DeltaTime The time step.
+	 * @param Settings The damping and clamping.
+	 * @return false if the stream lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool IntegrateSymplecticEuler(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Velocities,
+								  const std::type_identity_t<FVector3DStreams<const T>> &Forces, std::type_identity_t<std::span<const T>> InverseMasses,
+								  const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings = {});
+
+	/**
+	 * @brief Advance particles by one position Verlet step, in place.
+	 *
+	 * The velocity is implicit in the displacement since the previous step, which is damped and clamped to
+	 * MaxSpeed * DeltaTime before the forces are added. The time step must stay constant between calls.
+	 *
+	 * @param Positions The positions, updated in place.
+	 * @param PreviousPositions The positions of the previous step; receive the positions before this step.
+	 * @param Forces The forces acting on the particles.
+	 * @param InverseMasses The reciprocal masses, or empty for unit masses, in which case Forces are accelerations.
+	 * @param DeltaTime The time step.
+	 * @param Settings The damping and clamping.
+	 * @return false if the stream lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool IntegrateVerlet(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &PreviousPositions,
+						 const std::type_identity_t<FVector3DStreams<const T>> &Forces, std::type_identity_t<std::span<const T>> InverseMasses,
+						 const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings = {});
+
+	/**
+	 * @brief Advance particles by one classic fourth-order Runge-Kutta step, in place.
+	 *
+	 * The accelerations are evaluated four times per step at the intermediate states, one block of
+	 * IntegratorLaneCount particles at a time, so they may depend on position, velocity and time. The
+	 * intermediate states live on the stack; damping and clamping apply to the final velocity.
+	 *
+	 * @param Positions The positions, updated in place.
+	 * @param Velocities The velocities, updated in place.
+	 * @param Acceleration The function computing accelerations from a block of states.
+	 * @param Time The time at the start of the step.
+	 * @param DeltaTime The time step.
+	 * @param Settings The damping and clamping.
+	 * @return false if the stream lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool IntegrateRungeKutta4(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Velocities, const FAccelerationFunction<T> &Acceleration,
+							  const std::type_identity_t<T> Time, const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings = {});
+}
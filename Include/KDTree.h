@@ -0,0 +1,127 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorTraits.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Result entry of a nearest-neighbor query.
+	 *
+	 * @tparam T The floating-point type of the distances.
+	 */
+	template <FloatingPoint T>
+	struct FKDTreeNeighbor
+	{
+		int32 Index = -1;		 // Index of the point in the array the tree was built from, -1 if unused
+		T DistanceSquared = 0; // Squared distance from the query to the point
+	};
+
+	/**
+	 * @brief Static k-d tree over a point set for exact and approximate nearest-neighbor queries.
+	 *
+	 * The tree is stored implicitly: points are reordered so that the node of the range [Begin, End)
+	 * lives at its midpoint, with the left subtree in [Begin, Mid) and the right subtree in [Mid + 1, End).
+	 * No child pointers are stored, only the split axis per node.
+	 *
+	 * @tparam VectorType FVector2D, FVector3D or FVector4D.
+	 */
+	template <typename VectorType>
+	class FKDTree
+	{
+	public:
+		using ScalarType = typename TVectorTraits<VectorType>::ScalarType;
+		using FNeighbor = FKDTreeNeighbor<ScalarType>;
+
+		static constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+
+		/**
+		 * @brief Constructor that creates an empty tree.
+		 *
+		 * @param InAllocator The allocator the tree's storage is taken from.
+		 */
+		explicit FKDTree(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Constructor that builds the tree from a point set.
+		 *
+		 * @param InPoints The points to index.
+		 * @param InAllocator The allocator the tree's storage is taken from.
+		 */
+		explicit FKDTree(std::span<const VectorType> InPoints, Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Rebuild the tree from a point set, using the worker pool for large inputs.
+		 *
+		 * Storage is reused between builds, so rebuilding with at most as many points does not allocate.
+		 *
+		 * @param InPoints The points to index. The tree keeps its own reordered copy.
+		 */
+		void Build(std::span<const VectorType> InPoints);
+
+		/**
+		 * @brief Get the number of points stored in the tree.
+		 *
+		 * @return The number of points.
+		 */
+		int32 Num() const;
+
+		/**
+		 * @brief Check whether the tree has no points.
+		 *
+		 * @return true if the tree is empty, false otherwise.
+		 */
+		bool IsEmpty() const;
+
+		/**
+		 * @brief Find the nearest point to a query position.
+		 *
+		 * @param Query The query position.
+		 * @param Epsilon Relative error allowed: the result is within (1 + Epsilon) of the true nearest distance.
+		 * @return The nearest neighbor, or an entry with Index -1 if the tree is empty.
+		 */
+		FNeighbor FindNearest(const VectorType &Query, const ScalarType Epsilon = 0) const;
+
+		/**
+		 * @brief Find the K nearest points to a query position, where K is the size of the output span.
+		 *
+		 * @param Query The query position.
+		 * @param OutNeighbors Receives the neighbors sorted by increasing distance. Unused entries get Index -1.
+		 * @param Epsilon Relative error allowed for every returned neighbor.
+		 * @return The number of neighbors found.
+		 */
+		int32 FindKNearest(const VectorType &Query, std::span<FNeighbor> OutNeighbors, const ScalarType Epsilon = 0) const;
+
+		/**
+		 * @brief Run FindKNearest for many queries on the worker pool.
+		 *
+		 * @param Queries The query positions.
+		 * @param K The number of neighbors to find per query.
+		 * @param OutNeighbors Receives K neighbors per query, query i at [i * K, i * K + K). Must hold Queries.size() * K entries.
+		 * @param Epsilon Relative error allowed for every returned neighbor.
+		 */
+		void FindKNearestBatch(std::span<const VectorType> Queries, const int32 K, std::span<FNeighbor> OutNeighbors, const ScalarType Epsilon = 0) const;
+
+		/**
+		 * @brief Get the points in tree order.
+		 *
+		 * @return The reordered points.
+		 */
+		std::span<const VectorType> GetPoints() const;
+
+	private:
+		void BuildRange(std::span<const VectorType> Source, int32 Begin, int32 End);
+
+		void SearchRange(const VectorType &Query, int32 Begin, int32 End, std::span<FNeighbor> Heap, int32 &HeapSize, const ScalarType PruneScale) const;
+
+		Memory::FAlignedBuffer<VectorType, CacheLineSize> Points; // Points in implicit tree order
+		Memory::FAlignedBuffer<int32> Indices;					  // Original index of every point in tree order
+		Memory::FAlignedBuffer<uint8> SplitAxes;				  // Split axis of the node stored at every position
+	};
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "MatrixX.h"
+#include "Platform.h"
+#include "SymmetricMatrix3x3.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief LU decomposition with partial pivoting, P * A = L * U, of a square matrix.
+	 *
+	 * Meant for small systems (tens of rows); Compute reuses the storage of previous calls of the same size.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 */
+	template <FloatingPoint T>
+	class FLUDecomposition
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty decomposition.
+		 *
+		 * @param InAllocator The allocator the factors are taken from.
+		 */
+		explicit FLUDecomposition(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Factor a matrix.
+		 *
+		 * @param A The square matrix to factor.
+		 * @return false if A is not square or is singular.
+		 */
+		bool Compute(const FMatrixX<T> &A);
+
+		/**
+		 * @brief Solve A * X = B with the last successful factorization.
+		 *
+		 * @param B The right-hand side, of length N.
+		 * @param X Receives the solution, of length N. May alias B.
+		 * @return false if there is no valid factorization or the lengths don't match.
+		 */
+		bool Solve(std::span<const T> B, std::span<T> X) const;
+
+		/**
+		 * @brief Get the determinant of the factored matrix.
+		 *
+		 * @return The determinant; 0 if the last factorization failed.
+		 */
+		T GetDeterminant() const;
+
+	private:
+		FMatrixX<T> LU;
+		Memory::FAlignedBuffer<int64> Pivots;
+		T PivotSign = 1;
+		bool bValid = false;
+	};
+
+	/**
+	 * @brief Cholesky decomposition A = L * L^T of a symmetric positive-definite matrix.
+	 *
+	 * Only the lower triangle of A is read.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 */
+	template <FloatingPoint T>
+	class FCholeskyDecomposition
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty decomposition.
+		 *
+		 * @param InAllocator The allocator the factor is taken from.
+		 */
+		explicit FCholeskyDecomposition(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Factor a matrix.
+		 *
+		 * @param A The square symmetric matrix to factor.
+		 * @return false if A is not square or not positive definite.
+		 */
+		bool Compute(const FMatrixX<T> &A);
+
+		/**
+		 * @brief Solve A * X = B with the last successful factorization.
+		 *
+		 * @param B The right-hand side, of length N.
+		 * @param X Receives the solution, of length N. May alias B.
+		 * @return false if there is no valid factorization or the lengths don't match.
+		 */
+		bool Solve(std::span<const T> B, std::span<T> X) const;
+
+		/**
+		 * @brief Get the lower-triangular factor; the strict upper triangle is zero.
+		 */
+		const FMatrixX<T> &GetL() const;
+
+	private:
+		FMatrixX<T> L;
+		bool bValid = false;
+	};
+
+	/**
+	 * @brief Householder QR decomposition A = Q * R of an M x N matrix with M >= N.
+	 *
+	 * Solve uses internal scratch storage, so one object must not be used from several threads at once.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 */
+	template <FloatingPoint T>
+	class FQRDecomposition
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty decomposition.
+		 *
+		 * @param InAllocator The allocator the factors are taken from.
+		 */
+		explicit FQRDecomposition(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Factor a matrix.
+		 *
+		 * @param A The matrix to factor, with at least as many rows as columns.
+		 * @return false if A has fewer rows than columns or does not have full column rank.
+		 */
+		bool Compute(const FMatrixX<T> &A);
+
+		/**
+		 * @brief Solve the least-squares problem min |A * X - B| with the last successful factorization.
+		 *
+		 * @param B The right-hand side, of length M.
+		 * @param X Receives the solution, of length N. Must not overlap B.
+		 * @return false if there is no valid factorization or the lengths don't match.
+		 */
+		bool Solve(std::span<const T> B, std::span<T> X) const;
+
+		/**
+		 * @brief Get the N x N upper-triangular factor R.
+		 */
+		FMatrixX<T> GetR() const;
+
+	private:
+		FMatrixX<T> QR; // R in the upper triangle, Householder vectors below the diagonal
+		Memory::FAlignedBuffer<T> Scales;
+		mutable Memory::FAlignedBuffer<T> Workspace;
+		bool bValid = false;
+	};
+
+	/**
+	 * @brief Eigen decomposition of a symmetric 3x3 matrix.
+	 */
+	template <FloatingPoint T>
+	struct FSymmetricEigen3x3
+	{
+		FVector3D<T> Eigenvalues;	  // Sorted in descending order
+		FVector3D<T> Eigenvectors[3]; // Unit vectors, Eigenvectors[i] belongs to Eigenvalues[i]
+	};
+
+	/**
+	 * @brief Decompose a symmetric 3x3 matrix, e.g. a covariance or inertia tensor, with cyclic Jacobi rotations.
+	 *
+	 * @param A The matrix.
+	 * @return The eigenvalues and an orthonormal basis of eigenvectors.
+	 */
+	template <FloatingPoint T>
+	FSymmetricEigen3x3<T> EigenDecompose(const FSymmetricMatrix3x3<T> &A);
+
+	/**
+	 * @brief Decompose many symmetric 3x3 matrices, several per SIMD register, across the worker pool.
+	 *
+	 * @param Matrices The matrices.
+	 * @param OutResults Receives one decomposition per matrix. Must be at least as long as Matrices.
+	 */
+	template <FloatingPoint T>
+	void EigenDecomposeBatch(std::span<const FSymmetricMatrix3x3<T>> Matrices, std::span<FSymmetricEigen3x3<T>> OutResults);
+
+	/**
+	 * @brief Solve a symmetric 3x3 system A * X = B.
+	 *
+	 * @param A The matrix.
+	 * @param B The right-hand side.
+	 * @param OutX Receives the solution, or the zero vector if A is singular.
+	 * @return false if A is singular to working precision.
+	 */
+	template <FloatingPoint T>
+	bool Solve3x3(const FSymmetricMatrix3x3<T> &A, const FVector3D<T> &B, FVector3D<T> &OutX);
+
+	/**
+	 * @brief Solve many independent symmetric 3x3 systems, several per SIMD register, across the worker pool.
+	 *
+	 * @param A The matrices.
+	 * @param B The right-hand sides. Must be at least as long as A.
+	 * @param OutX Receives the solutions; zero for singular systems. Must be at least as long as A.
+	 * @return The number of singular systems.
+	 */
+	template <FloatingPoint T>
+	int64 Solve3x3Batch(std::span<const FSymmetricMatrix3x3<T>> A, std::span<const FVector3D<T>> B, std::span<FVector3D<T>> OutX);
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Whether a matrix operand is used as stored or transposed.
+	 */
+	enum class EMatrixTranspose : uint8
+	{
+		None,
+		Transpose
+	};
+
+	/**
+	 * @brief Dense matrix with sizes chosen at run time, stored row-major in cache-line aligned memory.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 */
+	template <FloatingPoint T>
+	class FMatrixX
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty 0x0 matrix.
+		 *
+		 * @param InAllocator The allocator the entries are taken from.
+		 */
+		explicit FMatrixX(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Constructor that creates a zero matrix.
+		 *
+		 * @param InRows The number of rows.
+		 * @param InColumns The number of columns.
+		 * @param InAllocator The allocator the entries are taken from.
+		 */
+		FMatrixX(const int64 InRows, const int64 InColumns, Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Copy constructor. The copy uses the same allocator.
+		 *
+		 * @param Other The matrix to copy.
+		 */
+		FMatrixX(const FMatrixX &Other);
+
+		/**
+		 * @brief Move constructor. Leaves the source as an empty 0x0 matrix.
+		 *
+		 * @param Other The matrix to move from.
+		 */
+		FMatrixX(FMatrixX &&Other) noexcept;
+
+		/**
+		 * @brief Copy assignment operator. Keeps this matrix's allocator.
+		 *
+		 * @param Other The matrix to copy.
+		 * @return Reference to this matrix.
+		 */
+		FMatrixX &operator=(const FMatrixX &Other);
+
+		/**
+		 * @brief Move assignment operator. Leaves the source as an empty 0x0 matrix.
+		 *
+		 * @param Other The matrix to move from.
+		 * @return Reference to this matrix.
+		 */
+		FMatrixX &operator=(FMatrixX &&Other) noexcept;
+
+		/**
+		 * @brief Access an entry.
+		 *
+		 * @param Row The row index.
+		 * @param Column The column index.
+		 * @return Reference to the entry.
+		 */
+		T &operator()(const int64 Row, const int64 Column);
+
+		/**
+		 * @brief Access an entry (const version).
+		 *
+		 * @param Row The row index.
+		 * @param Column The column index.
+		 * @return Const reference to the entry.
+		 */
+		const T &operator()(const int64 Row, const int64 Column) const;
+
+		/**
+		 * @brief Change the size. All entries are reset to zero.
+		 *
+		 * @param InRows The number of rows.
+		 * @param InColumns The number of columns.
+		 */
+		void Resize(const int64 InRows, const int64 InColumns);
+
+		/**
+		 * @brief Set every entry to zero.
+		 */
+		void SetZero();
+
+		/**
+		 * @brief Set the matrix to the identity; non-square matrices get ones on the main diagonal.
+		 */
+		void SetIdentity();
+
+		/**
+		 * @brief Get a transposed copy.
+		 *
+		 * @return The Columns x Rows transpose.
+		 */
+		FMatrixX GetTransposed() const;
+
+		int64 GetRows() const;
+		int64 GetColumns() const;
+		bool IsEmpty() const;
+
+		/**
+		 * @brief Get a row as a contiguous span.
+		 *
+		 * @param Row The row index.
+		 * @return The entries of the row.
+		 */
+		std::span<T> GetRow(const int64 Row);
+		std::span<const T> GetRow(const int64 Row) const;
+
+		T *GetData();
+		const T *GetData() const;
+
+	private:
+		Memory::FAlignedBuffer<T, CacheLineSize> Data;
+		int64 Rows = 0;
+		int64 Columns = 0;
+	};
+
+	/**
+	 * @brief General matrix-matrix product C = Alpha * op(A) * op(B) + Beta * C.
+	 *
+	 * Operands are packed into cache-sized panels and multiplied by a register-tiled micro-kernel; row blocks
+	 * of C are distributed over the worker pool. C must not alias A or B.
+	 *
+	 * @param A The left operand.
+	 * @param B The right operand.
+	 * @param C The result, which must already have the shape of op(A) * op(B).
+	 * @param Alpha The scale of the product.
+	 * @param Beta The scale of the previous contents of C; with 0 they are ignored, even if NaN.
+	 * @param TransposeA Whether A is used transposed.
+	 * @param TransposeB Whether B is used transposed.
+	 * @param Allocator The allocator the packed panels of A and B are taken from, for the duration of the call.
+	 * @return false if the shapes don't match, in which case C is left unchanged.
+	 */
+	template <FloatingPoint T>
+	bool Gemm(const FMatrixX<T> &A, const FMatrixX<T> &B, FMatrixX<T> &C, const T Alpha = 1, const T Beta = 0,
+			  const EMatrixTranspose TransposeA = EMatrixTranspose::None, const EMatrixTranspose TransposeB = EMatrixTranspose::None,
+			  Memory::FAllocator &Allocator = Memory::GetDefaultAllocator());
+
+	/**
+	 * @brief General matrix-vector product Y = Alpha * op(A) * X + Beta * Y.
+	 *
+	 * @param A The matrix.
+	 * @param X The input vector, of length op(A).GetColumns().
+	 * @param Y The output vector, of length op(A).GetRows(). Must not overlap X.
+	 * @param Alpha The scale of the product.
+	 * @param Beta The scale of the previous contents of Y; with 0 they are ignored, even if NaN.
+	 * @param TransposeA Whether A is used transposed.
+	 * @return false if the lengths don't match, in which case Y is left unchanged.
+	 */
+	template <FloatingPoint T>
+	bool Gemv(const FMatrixX<T> &A, std::span<const T> X, std::span<T> Y, const T Alpha = 1, const T Beta = 0,
+			  const EMatrixTranspose TransposeA = EMatrixTranspose::None);
+
+	/**
+	 * @brief Binary operator for matrix multiplication.
+	 *
+	 * @param A The left operand.
+	 * @param B The right operand.
+	 * @return The product A * B, or an empty matrix if A.GetColumns() != B.GetRows().
+	 */
+	template <FloatingPoint T>
+	FMatrixX<T> operator*(const FMatrixX<T> &A, const FMatrixX<T> &B);
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+// external includes
+#include <atomic>
+#include <cstddef>
+
+// internal includes
+#include "Platform.h"
+
+namespace Ratchet
+{
+	namespace Memory
+	{
+		/**
+		 * @brief Snapshot of the allocation counters of an allocator.
+		 */
+		struct FAllocatorStats
+		{
+			uint64 AllocationCount = 0; // Successful allocations
+			uint64 FreeCount = 0;		// Released allocations
+			uint64 FailedCount = 0;		// Allocations that could not be served
+			uint64 BytesInUse = 0;		// Bytes handed out and not yet released
+			uint64 PeakBytesInUse = 0;	// Highest value BytesInUse reached
+		};
+
+		/**
+		 * @brief Interface every allocator passed to the library's batch APIs implements.
+		 *
+		 * Allocators are not thread-safe unless stated otherwise, the counters are.
+		 */
+		class FAllocator
+		{
+		public:
+			virtual ~FAllocator() = default;
+
+			/**
+			 * @brief Allocate a block of memory.
+			 *
+			 * @param Size The number of bytes to allocate.
+			 * @param Alignment The required alignment, a power of two.
+			 * @return Pointer to the block, or nullptr if the request cannot be served.
+			 */
+			void *Allocate(const size_t Size, const size_t Alignment);
+
+			/**
+			 * @brief Release a block returned by Allocate.
+			 *
+			 * @param Pointer The block to release. nullptr is ignored.
+			 * @param Size The size the block was allocated with.
+			 * @param Alignment The alignment the block was allocated with.
+			 */
+			void Free(void *Pointer, const size_t Size, const size_t Alignment);
+
+			/**
+			 * @brief Get the current allocation counters.
+			 *
+			 * @return The counters.
+			 */
+			FAllocatorStats GetStats() const;
+
+			/**
+			 * @brief Reset all counters to zero, except BytesInUse.
+			 */
+			void ResetStats();
+
+		protected:
+			virtual void *DoAllocate(const size_t Size, const size_t Alignment) = 0;
+
+			virtual void DoFree(void *Pointer, const size_t Size, const size_t Alignment) = 0;
+
+			void SetBytesInUse(const uint64 Bytes);
+
+		private:
+			std::atomic<uint64> AllocationCount{0};
+			std::atomic<uint64> FreeCount{0};
+			std::atomic<uint64> FailedCount{0};
+			std::atomic<uint64> BytesInUse{0};
+			std::atomic<uint64> PeakBytesInUse{0};
+		};
+
+		/**
+		 * @brief Thread-safe allocator backed by the global aligned operator new.
+		 */
+		class FHeapAllocator final : public FAllocator
+		{
+		protected:
+			void *DoAllocate(const size_t Size, const size_t Alignment) override;
+
+			void DoFree(void *Pointer, const size_t Size, const size_t Alignment) override;
+		};
+
+		/**
+		 * @brief Get the heap allocator used when no allocator is supplied.
+		 *
+		 * Its counters show every heap allocation the library makes on its own behalf.
+		 *
+		 * @return The process-wide heap allocator.
+		 */
+		FAllocator &GetDefaultAllocator();
+
+		/**
+		 * @brief Linear (bump) allocator over one fixed block, meant to be reset once per frame.
+		 *
+		 * Free is a no-op; memory is reclaimed all at once by Reset or ResetToMarker.
+		 */
+		class FLinearArena final : public FAllocator
+		{
+		public:
+			/**
+			 * @brief Constructor that reserves the arena's block from a backing allocator.
+			 *
+			 * @param InCapacity The number of bytes the arena can hand out between resets.
+			 * @param InBacking The allocator the block is taken from.
+			 */
+			explicit FLinearArena(const size_t InCapacity, FAllocator &InBacking = GetDefaultAllocator());
+
+			~FLinearArena() override;
+
+			FLinearArena(const FLinearArena &) = delete;
+			FLinearArena &operator=(const FLinearArena &) = delete;
+
+			/**
+			 * @brief Get the current fill level, to be passed to ResetToMarker later.
+			 *
+			 * @return The number of bytes used so far.
+			 */
+			size_t GetMarker() const;
+
+			/**
+			 * @brief Release everything allocated after a marker was taken.
+			 *
+			 * @param Marker A value returned by GetMarker.
+			 */
+			void ResetToMarker(const size_t Marker);
+
+			/**
+			 * @brief Release everything allocated from the arena.
+			 */
+			void Reset();
+
+			/**
+			 * @brief Get the size of the arena's block.
+			 *
+			 * @return The capacity in bytes.
+			 */
+			size_t GetCapacity() const;
+
+		protected:
+			void *DoAllocate(const size_t Size, const size_t Alignment) override;
+
+			void DoFree(void *Pointer, const size_t Size, const size_t Alignment) override;
+
+		private:
+			FAllocator &Backing;
+			uint8 *Base;
+			size_t Capacity;
+			size_t Offset = 0;
+		};
+
+		/**
+		 * @brief Pool of fixed-size blocks with an intrusive free list.
+		 *
+		 * Requests larger than the block size or more aligned than the block alignment fail.
+		 */
+		class FPoolAllocator final : public FAllocator
+		{
+		public:
+			/**
+			 * @brief Constructor that reserves all blocks up front from a backing allocator.
+			 *
+			 * @param InBlockSize The size of every block in bytes.
+			 * @param InBlockAlignment The alignment of every block, a power of two.
+			 * @param InBlockCount The number of blocks in the pool.
+			 * @param InBacking The allocator the blocks are taken from.
+			 */
+			FPoolAllocator(const size_t InBlockSize, const size_t InBlockAlignment, const size_t InBlockCount, FAllocator &InBacking = GetDefaultAllocator());
+
+			~FPoolAllocator() override;
+
+			FPoolAllocator(const FPoolAllocator &) = delete;
+			FPoolAllocator &operator=(const FPoolAllocator &) = delete;
+
+			/**
+			 * @brief Get the size of every block.
+			 *
+			 * @return The block size in bytes.
+			 */
+			size_t GetBlockSize() const;
+
+			/**
+			 * @brief Get the number of blocks currently available.
+			 *
+			 * @return The number of free blocks.
+			 */
+			size_t GetFreeBlockCount() const;
+
+		protected:
+			void *DoAllocate(const size_t Size, const size_t Alignment) override;
+
+			void DoFree(void *Pointer, const size_t Size, const size_t Alignment) override;
+
+		private:
+			struct FFreeBlock
+			{
+				FFreeBlock *Next;
+			};
+
+			FAllocator &Backing;
+			uint8 *Base;
+			size_t BlockSize;
+			size_t BlockAlignment;
+			size_t BlockCount;
+			size_t FreeBlockCount;
+			FFreeBlock *FreeList = nullptr;
+		};
+	}
+}
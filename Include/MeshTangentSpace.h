@@ -0,0 +1,97 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Per-frame vertex normal and tangent generation for an indexed triangle mesh.
+	 *
+	 * The topology is set once. It builds the list of triangle corners of every vertex. Each frame, the face
+	 * terms are computed per triangle, then every vertex sums over its own corners. No two workers write the
+	 * same vertex, so no atomics or per-thread copies are needed. The results do not depend on the number of
+	 * worker threads. Both passes run several triangles or vertices per SIMD register, and nothing is
+	 * allocated after SetTopology.
+	 *
+	 * @tparam T The floating-point type of the vertex streams.
+	 */
+	template <FloatingPoint T>
+	class FMeshTangentSpace
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty mesh.
+		 *
+		 * @param InAllocator The allocator the adjacency and scratch storage is taken from.
+		 */
+		explicit FMeshTangentSpace(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Set the triangles of the mesh and build the vertex adjacency.
+		 *
+		 * @param InIndices Three vertex indices per triangle, counter-clockwise seen from the front.
+		 * @param VertexCount The number of vertices the indices refer to.
+		 * @return false if the index count is not a multiple of 3 or an index is out of range, in which case the mesh is left empty.
+		 */
+		bool SetTopology(std::span<const uint32> InIndices, const int64 VertexCount);
+
+		/**
+		 * @brief Compute area-weighted vertex normals: the normalized sum of the unnormalized normals of the
+		 *        triangles around each vertex.
+		 *
+		 * Vertices without a triangle of non-zero area get a zero normal.
+		 *
+		 * @param Positions The vertex positions.
+		 * @param OutNormals Receives the unit normals. Must not overlap Positions.
+		 * @return false if the stream lengths don't match the vertex count, in which case nothing is written.
+		 */
+		bool ComputeNormals(const std::type_identity_t<FVector3DStreams<const T>> &Positions, const FVector3DStreams<T> &OutNormals);
+
+		/**
+		 * @brief Compute MikkTSpace tangents.
+		 *
+		 * Like MikkTSpace, each triangle's UV gradient is projected onto the vertex normal and normalized.
+		 * Each corner is weighted by its angle and the result is normalized. The bitangent is
+		 * Sign * Cross(Normal, Tangent). The results match MikkTSpace when vertices are already split where
+		 * the normals, UVs or UV orientation change, as exported meshes are. MikkTSpace would split a vertex
+		 * shared across a UV mirror seam. Here it gets the angle-weighted majority orientation instead.
+		 * Vertices whose triangles all have degenerate UVs get a zero tangent.
+		 *
+		 * @param Positions The vertex positions.
+		 * @param UVs The vertex texture coordinates.
+		 * @param Normals The unit vertex normals, for example from ComputeNormals.
+		 * @param OutTangents Receives the unit tangents. Must not overlap the inputs.
+		 * @param OutSigns Receives the bitangent sign of every vertex, 1 or -1.
+		 * @return false if the stream lengths don't match the vertex count, in which case nothing is written.
+		 */
+		bool ComputeTangents(const std::type_identity_t<FVector3DStreams<const T>> &Positions, const std::type_identity_t<FVector2DStreams<const T>> &UVs,
+							 const std::type_identity_t<FVector3DStreams<const T>> &Normals, const FVector3DStreams<T> &OutTangents,
+							 std::type_identity_t<std::span<T>> OutSigns);
+
+		/**
+		 * @brief Get the number of triangles.
+		 */
+		int64 GetTriangleCount() const;
+
+		/**
+		 * @brief Get the number of vertices.
+		 */
+		int64 GetVertexCount() const;
+
+	private:
+		Memory::FAlignedBuffer<uint32> Indices;
+		Memory::FAlignedBuffer<uint32> CornerOffsets; // Per vertex plus one, the range of its corners in VertexCorners
+		Memory::FAlignedBuffer<uint32> VertexCorners; // Corner k of triangle t is 3t + k
+
+		// Scratch: unnormalized normals per triangle, or weighted tangents and UV orientations per corner
+		Memory::FAlignedBuffer<T> CornerVectors[4];
+	};
+}
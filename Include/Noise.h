@@ -0,0 +1,85 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Kind of coherent noise.
+	 */
+	enum class ENoiseType : uint8
+	{
+		Perlin,	 // Gradient noise on the square lattice, about [-1, 1]
+		Simplex, // Gradient noise on the simplex lattice, about [-1, 1]; cheaper than Perlin in 3D and 4D
+		Worley	 // Distance to the nearest of one jittered feature point per cell, in cell widths; mostly below 1
+	};
+
+	/**
+	 * @brief Fractal Brownian motion: the octaves summed and divided by the sum of their amplitudes, so the
+	 *        range of the noise is kept.
+	 */
+	template <FloatingPoint T>
+	struct FNoiseSettings
+	{
+		int32 Octaves = 1;	 // Number of layers of noise
+		T Frequency = 1;	 // Frequency of the first octave
+		T Lacunarity = 2;	 // Frequency ratio of consecutive octaves
+		T Gain = T(0.5);	 // Amplitude ratio of consecutive octaves
+	};
+
+	namespace Noise
+	{
+		/**
+		 * @brief Evaluate noise at many 2D positions, spread over the worker pool.
+		 *
+		 * Lattice cells are hashed with integer arithmetic only, so a seed gives the same field on every
+		 * platform. Values are bit-identical wherever the compiler does not contract multiply-adds. Positions
+		 * times the highest octave's frequency must lie within the int32 range.
+		 *
+		 * @param Type The kind of noise.
+		 * @param Positions The positions.
+		 * @param OutValues Receives the noise values.
+		 * @param Seed Selects the noise field; every octave uses a different field.
+		 * @param Settings The octaves.
+		 * @return false if the stream lengths don't match or there are no octaves, in which case nothing is written.
+		 */
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector2DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings = {});
+
+		/**
+		 * @brief Evaluate noise at many 3D positions, spread over the worker pool.
+		 *
+		 * @param Type The kind of noise.
+		 * @param Positions The positions.
+		 * @param OutValues Receives the noise values.
+		 * @param Seed Selects the noise field; every octave uses a different field.
+		 * @param Settings The octaves.
+		 * @return false if the stream lengths don't match or there are no octaves, in which case nothing is written.
+		 */
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector3DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings = {});
+
+		/**
+		 * @brief Evaluate noise at many 4D positions, such as 3D positions and time, spread over the worker pool.
+		 *
+		 * @param Type The kind of noise.
+		 * @param Positions The positions.
+		 * @param OutValues Receives the noise values.
+		 * @param Seed Selects the noise field; every octave uses a different field.
+		 * @param Settings The octaves.
+		 * @return false if the stream lengths don't match or there are no octaves, in which case nothing is written.
+		 */
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector4DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings = {});
+	}
+}
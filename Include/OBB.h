@@ -0,0 +1,151 @@
+#pragma once
+
+// external includes
+#include <limits>
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "Platform.h"
+#include "Quat.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Oriented bounding box.
+	 *
+	 * @tparam T The floating-point type of the box.
+	 */
+	template <FloatingPoint T>
+	struct FOBB
+	{
+		FVector3D<T> Center;
+		FVector3D<T> HalfExtents; // Along the box axes
+		FQuat<T> Rotation;		  // From the box frame to the world; a unit quaternion
+
+		/**
+		 * @brief Get the box axes, the world directions of the box frame's X, Y and Z.
+		 *
+		 * @param OutAxes Receives the three unit axes.
+		 */
+		void GetAxes(FVector3D<T> (&OutAxes)[3]) const;
+
+		/**
+		 * @brief Get the point of the box closest to a point; the point itself if it is inside.
+		 *
+		 * @param Point The point.
+		 * @return The closest point.
+		 */
+		FVector3D<T> ClosestPoint(const FVector3D<T> &Point) const;
+
+		/**
+		 * @brief Get the volume of the box.
+		 *
+		 * @return The volume.
+		 */
+		T GetVolume() const;
+	};
+
+	/**
+	 * @brief Test two boxes for overlap with the separating axis theorem over the 15 candidate axes.
+	 *
+	 * Touching boxes overlap. Near-parallel edge pairs are made slightly conservative so round-off never
+	 * separates boxes that overlap.
+	 *
+	 * @param A The first box.
+	 * @param B The second box.
+	 * @return true if the boxes overlap.
+	 */
+	template <FloatingPoint T>
+	bool Overlap(const FOBB<T> &A, const FOBB<T> &B);
+
+	/**
+	 * @brief Test a box and a sphere for overlap.
+	 *
+	 * @param Box The box.
+	 * @param Center The center of the sphere.
+	 * @param Radius The radius of the sphere.
+	 * @return true if they overlap.
+	 */
+	template <FloatingPoint T>
+	bool OverlapSphere(const FOBB<T> &Box, const FVector3D<T> &Center, const std::type_identity_t<T> Radius);
+
+	/**
+	 * @brief Intersect a ray with a box.
+	 *
+	 * @param Box The box.
+	 * @param Origin The origin of the ray.
+	 * @param Direction The direction of the ray; distances are in multiples of its length.
+	 * @param OutDistance Receives the distance to the entry point, 0 if the origin is inside the box.
+	 * @param MaxDistance The length of the ray.
+	 * @return true if the ray hits the box within MaxDistance.
+	 */
+	template <FloatingPoint T>
+	bool IntersectRay(const FOBB<T> &Box, const FVector3D<T> &Origin, const FVector3D<T> &Direction, T &OutDistance,
+					  const std::type_identity_t<T> MaxDistance = std::numeric_limits<T>::infinity());
+
+	/**
+	 * @brief Test many box pairs (A[i], B[i]) for overlap, several per SIMD register, across the worker pool.
+	 *
+	 * @param A The first box of every pair.
+	 * @param B The second box of every pair.
+	 * @param OutOverlaps Receives whether each pair overlaps.
+	 * @return false if the lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool OverlapMany(std::span<const FOBB<T>> A, std::type_identity_t<std::span<const FOBB<T>>> B, std::span<bool> OutOverlaps);
+
+	/**
+	 * @brief Test many boxes against one sphere, several per SIMD register, across the worker pool.
+	 *
+	 * @param Boxes The boxes.
+	 * @param Center The center of the sphere.
+	 * @param Radius The radius of the sphere.
+	 * @param OutOverlaps Receives whether each box overlaps the sphere.
+	 * @return false if the lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool OverlapSphereMany(std::span<const FOBB<T>> Boxes, const FVector3D<T> &Center, const std::type_identity_t<T> Radius, std::span<bool> OutOverlaps);
+
+	/**
+	 * @brief Intersect one ray with many boxes, several per SIMD register, across the worker pool.
+	 *
+	 * @param Boxes The boxes.
+	 * @param Origin The origin of the ray.
+	 * @param Direction The direction of the ray; distances are in multiples of its length.
+	 * @param MaxDistance The length of the ray.
+	 * @param OutDistances Receives the distance to each box as IntersectRay would, or infinity for a miss.
+	 * @return false if the lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool IntersectRayMany(std::span<const FOBB<T>> Boxes, const FVector3D<T> &Origin, const FVector3D<T> &Direction, const std::type_identity_t<T> MaxDistance,
+						  std::type_identity_t<std::span<T>> OutDistances);
+
+	/**
+	 * @brief Fit a box to a point set along its principal axes.
+	 *
+	 * The axes are the eigenvectors of the covariance matrix of the points. Cheap to reason about, but the
+	 * box can be far from tight when the points are unevenly distributed over the shape.
+	 *
+	 * @param Points The points.
+	 * @return The box; empty at the origin for no points.
+	 */
+	template <FloatingPoint T>
+	FOBB<T> FitOBBPCA(std::span<const FVector3D<T>> Points);
+
+	/**
+	 * @brief Fit a box to a point set with the DiTO-14 heuristic (Larsson and Källberg, Fast Computation of
+	 *        Tight-Fitting Oriented Bounding Boxes).
+	 *
+	 * The extreme points along 7 fixed directions seed a triangle and the two tetrahedra on it; the edges and
+	 * normals of those triangles give candidate orientations, the one with the smallest box around the extreme
+	 * points wins, and a final pass fits it to all points. Usually tighter than PCA and about as fast.
+	 *
+	 * @param Points The points.
+	 * @return The box; empty at the origin for no points.
+	 */
+	template <FloatingPoint T>
+	FOBB<T> FitOBBDiTO(std::span<const FVector3D<T>> Points);
+}
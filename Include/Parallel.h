@@ -0,0 +1,61 @@
+#pragma once
+
+// external includes
+#include <memory>
+#include <type_traits>
+
+// internal includes
+#include "Platform.h"
+
+namespace Ratchet
+{
+	namespace Parallel
+	{
+		/**
+		 * @brief Non-owning reference to a callable invoked for a contiguous sub-range [Begin, End) of a parallel loop.
+		 *
+		 * Unlike std::function it never allocates, so parallel loops stay heap-free. The referenced callable
+		 * must outlive the call it is passed to.
+		 */
+		class FRangeFunction
+		{
+		public:
+			template <typename FunctionType>
+				requires(!std::is_same_v<std::remove_cvref_t<FunctionType>, FRangeFunction>)
+			FRangeFunction(FunctionType &&Function)
+				: Object(const_cast<void *>(static_cast<const void *>(std::addressof(Function)))),
+				  Invoker([](void *InObject, const int64 Begin, const int64 End)
+						  { (*static_cast<std::remove_reference_t<FunctionType> *>(InObject))(Begin, End); })
+			{
+			}
+
+			void operator()(const int64 Begin, const int64 End) const
+			{
+				Invoker(Object, Begin, End);
+			}
+
+		private:
+			void *Object;
+			void (*Invoker)(void *, int64, int64);
+		};
+
+		/**
+		 * @brief Get the number of threads that participate in a parallel loop, including the caller.
+		 *
+		 * @return The worker count (always at least 1).
+		 */
+		int32 GetWorkerCount();
+
+		/**
+		 * @brief Split [0, Count) into batches and run them on the shared worker pool.
+		 *
+		 * The calling thread takes part in the work and the call returns once every batch has finished.
+		 * Calls made from inside a running batch execute inline on the current thread.
+		 *
+		 * @param Count The number of elements to process.
+		 * @param MinBatchSize The smallest batch worth handing to another thread.
+		 * @param Body The function to invoke for every batch.
+		 */
+		void ParallelFor(const int64 Count, const int64 MinBatchSize, const FRangeFunction &Body);
+	}
+}
@@ -131,4 +131,6 @@ namespace Ratchet
 #error "Unsupported compiler"
 
 #endif
+
+	constexpr uint64 CacheLineSize = 64;
 }
\ No newline at end of file
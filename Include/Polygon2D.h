@@ -0,0 +1,274 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "Vector2D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Boolean operation of two polygons.
+	 */
+	enum class EPolygonBoolean : uint8
+	{
+		Intersection, // Area in both
+		Union,		  // Area in either
+		Difference	  // Area in the subject but not in the clip polygon
+	};
+
+	/**
+	 * @brief Shape of the outer corners of an offset polygon.
+	 */
+	enum class EPolygonJoin : uint8
+	{
+		Miter,	// Sharp corner, squared off beyond the miter limit
+		Square, // Corner cut at the offset distance
+		Round	// Circular arc
+	};
+
+	/**
+	 * @brief Packed list of polygons: the vertices of all polygons back to back and the offset of each.
+	 *
+	 * Storage keeps its capacity when cleared, so a set reused every frame stops allocating once it has
+	 * grown to its working size.
+	 *
+	 * @tparam T The floating-point type of the vertices.
+	 */
+	template <FloatingPoint T>
+	class FPolygonSet2D
+	{
+	public:
+		/**
+		 * @brief Constructor that creates an empty set.
+		 *
+		 * @param InAllocator The allocator the storage is taken from.
+		 */
+		explicit FPolygonSet2D(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Remove all polygons, keeping the storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Append a polygon.
+		 *
+		 * @param Vertices The vertices of the polygon.
+		 */
+		void AddPolygon(std::span<const FVector2D<T>> Vertices);
+
+		/**
+		 * @brief Append a vertex to the polygon under construction.
+		 *
+		 * @param Vertex The vertex.
+		 */
+		void AddVertex(const FVector2D<T> &Vertex);
+
+		/**
+		 * @brief Finish the polygon under construction, possibly with no vertices.
+		 */
+		void ClosePolygon();
+
+		/**
+		 * @brief Append all polygons of another set.
+		 *
+		 * @param Other The set to copy from.
+		 */
+		void Append(const FPolygonSet2D &Other);
+
+		/**
+		 * @brief Get the number of finished polygons.
+		 */
+		int64 Num() const;
+
+		/**
+		 * @brief Get the vertices of a polygon.
+		 *
+		 * @param Index The index of the polygon.
+		 * @return The vertices.
+		 */
+		std::span<const FVector2D<T>> GetPolygon(const int64 Index) const;
+
+		/**
+		 * @brief Get the vertices of all finished polygons.
+		 */
+		std::span<const FVector2D<T>> GetVertices() const;
+
+		/**
+		 * @brief Get the offsets of the polygons in GetVertices, Num() + 1 entries, or none for an empty set.
+		 */
+		std::span<const uint32> GetOffsets() const;
+
+		/**
+		 * @brief Get the number of indices triangulating every polygon takes, 3 * (VertexCount - 2) per polygon
+		 *        of at least 3 vertices.
+		 */
+		int64 GetTriangleIndexCount() const;
+
+	private:
+		Memory::FAlignedBuffer<FVector2D<T>> Vertices;
+		Memory::FAlignedBuffer<uint32> Offsets; // Polygon i is [Offsets[i], Offsets[i + 1]); empty until the first polygon is closed
+	};
+
+	/**
+	 * @brief Boolean operations, triangulation and offsetting of simple polygons, one at a time or in batches
+	 *        spread over the worker pool.
+	 *
+	 * Polygons are simple: closed, without self-intersections or holes, in either orientation. Outputs are
+	 * counterclockwise, with holes as clockwise loops. Scratch memory lives in per-partition workspaces that
+	 * keep their capacity between calls, so steady-state use allocates nothing. The allocator must be
+	 * thread-safe if a batch spans several partitions. The processor itself is not thread-safe.
+	 *
+	 * @tparam T The floating-point type of the vertices.
+	 */
+	template <FloatingPoint T>
+	class FPolygonProcessor2D
+	{
+	public:
+		/**
+		 * @brief Constructor that creates a processor without workspaces.
+		 *
+		 * @param InAllocator The allocator the workspaces are taken from.
+		 */
+		explicit FPolygonProcessor2D(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Boolean operation of two polygons with the Greiner-Hormann algorithm.
+		 *
+		 * Edge crossings are classified with exact predicates. Touching or overlapping edges are resolved by
+		 * translating the clip polygon by a few units in the last place of the polygons' extent and retrying. The
+		 * output is exact up to that displacement, and loops no wider than it, left where edges overlapped, are
+		 * dropped. Takes O(n * m) time for n and m vertices.
+		 *
+		 * @param Subject The subject polygon.
+		 * @param Clip The clip polygon.
+		 * @param Operation The operation.
+		 * @param OutPolygons Receives the resulting loops, appended.
+		 * @return false if a degenerate configuration could not be resolved, in which case nothing is appended.
+		 */
+		bool Boolean(std::span<const FVector2D<T>> Subject, std::type_identity_t<std::span<const FVector2D<T>>> Clip, const EPolygonBoolean Operation,
+					 FPolygonSet2D<T> &OutPolygons);
+
+		/**
+		 * @brief Triangulate a polygon by ear clipping, testing ears against the reflex vertices only.
+		 *
+		 * Always produces VertexCount - 2 triangles with the polygon's winding. If the input is not simple, the
+		 * triangles cover it approximately.
+		 *
+		 * @param Polygon The polygon.
+		 * @param OutIndices Receives 3 * (VertexCount - 2) indices into Polygon.
+		 * @return false if OutIndices has the wrong length, in which case nothing is written.
+		 */
+		bool Triangulate(std::span<const FVector2D<T>> Polygon, std::span<uint32> OutIndices);
+
+		/**
+		 * @brief Offset a polygon by a distance along the outward normals.
+		 *
+		 * Corners that open up get the join, corners that close get the intersection of the offset edges.
+		 * Self-intersections of the result are not removed. Such loops appear when an inward offset exceeds the
+		 * local feature size. A polygon that collapses entirely gives an empty polygon.
+		 *
+		 * @param Polygon The polygon.
+		 * @param Distance The offset, positive to grow and negative to shrink.
+		 * @param Join The shape of the opening corners.
+		 * @param OutPolygons Receives the offset polygon, appended; empty if degenerate or collapsed.
+		 * @param MiterLimit The largest miter length, in multiples of |Distance|, before a miter is squared off.
+		 * @param ArcTolerance The largest distance between a round join and its true arc; 0 for |Distance| / 100.
+		 */
+		void Offset(std::span<const FVector2D<T>> Polygon, const std::type_identity_t<T> Distance, const EPolygonJoin Join, FPolygonSet2D<T> &OutPolygons,
+					const std::type_identity_t<T> MiterLimit = 2, const std::type_identity_t<T> ArcTolerance = 0);
+
+		/**
+		 * @brief Boolean operation of many polygon pairs, spread over the worker pool.
+		 *
+		 * @param Subjects The subject polygons.
+		 * @param Clips Either one clip polygon for all subjects or one per subject.
+		 * @param Operation The operation.
+		 * @param OutPolygons Receives the resulting loops; cleared first.
+		 * @param OutFirstPolygons Receives Subjects.Num() + 1 entries. Subject i produced the loops
+		 *        [OutFirstPolygons[i], OutFirstPolygons[i + 1]).
+		 * @return false if the sizes don't match, in which case nothing is written, or if some pair could not be
+		 *         resolved, in which case it produced no loops.
+		 */
+		bool BooleanMany(const FPolygonSet2D<T> &Subjects, const FPolygonSet2D<T> &Clips, const EPolygonBoolean Operation, FPolygonSet2D<T> &OutPolygons,
+						 std::span<uint32> OutFirstPolygons);
+
+		/**
+		 * @brief Triangulate many polygons, spread over the worker pool.
+		 *
+		 * @param Polygons The polygons.
+		 * @param OutIndices Receives Polygons.GetTriangleIndexCount() indices into Polygons.GetVertices(), polygon by polygon.
+		 * @return false if OutIndices has the wrong length, in which case nothing is written.
+		 */
+		bool TriangulateMany(const FPolygonSet2D<T> &Polygons, std::span<uint32> OutIndices);
+
+		/**
+		 * @brief Offset many polygons by the same distance, spread over the worker pool.
+		 *
+		 * @param Polygons The polygons.
+		 * @param Distance The offset, positive to grow and negative to shrink.
+		 * @param Join The shape of the opening corners.
+		 * @param OutPolygons Receives one polygon per input polygon, as Offset would; cleared first.
+		 * @param MiterLimit The largest miter length, in multiples of |Distance|, before a miter is squared off.
+		 * @param ArcTolerance The largest distance between a round join and its true arc; 0 for |Distance| / 100.
+		 */
+		void OffsetMany(const FPolygonSet2D<T> &Polygons, const std::type_identity_t<T> Distance, const EPolygonJoin Join, FPolygonSet2D<T> &OutPolygons,
+						const std::type_identity_t<T> MiterLimit = 2, const std::type_identity_t<T> ArcTolerance = 0);
+
+	private:
+		// Vertex of the Greiner-Hormann lists; both polygons and their intersections share one array
+		struct FClipNode
+		{
+			T X;
+			T Y;
+			int32 Next;
+			int32 Prev;
+			int32 Neighbor; // The same intersection in the other polygon's list, -1 for original vertices
+			T Alpha;		// Position of an intersection along its original edge
+			bool bEntry;
+			bool bVisited;
+		};
+
+		// Scratch of one partition
+		struct FWorkspace
+		{
+			FWorkspace() = default;
+			explicit FWorkspace(Memory::FAllocator &InAllocator);
+
+			Memory::FAlignedBuffer<FClipNode> Nodes;
+			Memory::FAlignedBuffer<FVector2D<T>> Points; // Translated clip polygon
+			Memory::FAlignedBuffer<T> Loop;				 // Output loop under construction, as X, Y pairs
+			Memory::FAlignedBuffer<T> Cleaned;			 // Offset input, counterclockwise without repeated vertices, as X, Y pairs
+			Memory::FAlignedBuffer<T> Tangents;			 // Unit edge directions of the offset input, as X, Y pairs
+			Memory::FAlignedBuffer<int32> Links;		 // Ear clipping list, Prev then Next
+			Memory::FAlignedBuffer<uint8> Reflex;
+			FPolygonSet2D<T> Output; // Results of the partition in a batch
+			bool bSucceeded = true;
+		};
+
+		enum class ETraceResult : uint8
+		{
+			Done,
+			Degenerate
+		};
+
+		int64 PreparePartitions(const int64 Count);
+		static bool BooleanInto(FWorkspace &Work, std::span<const FVector2D<T>> Subject, std::span<const FVector2D<T>> Clip, const EPolygonBoolean Operation,
+								FPolygonSet2D<T> &OutPolygons);
+		static ETraceResult Trace(FWorkspace &Work, std::span<const FVector2D<T>> Subject, const bool bSubjectReversed, std::span<const FVector2D<T>> Clip,
+								  const bool bClipReversed, const EPolygonBoolean Operation, const T MinWidth, FPolygonSet2D<T> &OutPolygons);
+		static void TriangulateInto(FWorkspace &Work, std::span<const FVector2D<T>> Polygon, const uint32 BaseIndex, uint32 *OutIndices);
+		static void OffsetInto(FWorkspace &Work, std::span<const FVector2D<T>> Polygon, const T Distance, const EPolygonJoin Join, const T MiterLimit,
+							   const T ArcTolerance, FPolygonSet2D<T> &OutPolygons);
+
+		Memory::FAllocator *Allocator;
+		Memory::FAlignedBuffer<FWorkspace> Workspaces;
+		Memory::FAlignedBuffer<int64> TriangleOffsets; // Per polygon of a triangulation batch, where its indices start
+	};
+}
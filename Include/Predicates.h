@@ -0,0 +1,81 @@
+#pragma once
+
+// internal includes
+#include "Types.h"
+#include "Vector2D.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Robust geometric predicates in the style of Shewchuk's adaptive precision arithmetic.
+	 *
+	 * Every predicate first evaluates its determinant in plain double arithmetic together with a bound on the
+	 * round-off error. Only when the result is smaller than the bound, which happens for nearly degenerate
+	 * inputs, is the determinant recomputed exactly with floating-point expansions. The sign of the result is
+	 * always exact; its magnitude is an approximation of the determinant.
+	 *
+	 * float and double coordinates are supported, float being widened to double without loss. The exact
+	 * stage assumes IEEE double arithmetic with round-to-nearest, so the library must not be built with
+	 * fast-math style reassociation or x87 extended precision, and it assumes no intermediate overflow or
+	 * underflow, i.e. coordinates roughly within [1e-70, 1e70] in magnitude or zero.
+	 *
+	 * With instrumentation enabled, every predicate has a counter for all calls and one for the calls that
+	 * needed the exact stage, so their ratio is the fallback rate.
+	 */
+	namespace Predicates
+	{
+		/**
+		 * @brief Orientation of three points in the plane.
+		 *
+		 * @param A The first point.
+		 * @param B The second point.
+		 * @param C The third point.
+		 * @return Positive if A, B and C are in counterclockwise order, negative if clockwise, zero if collinear.
+		 *         Approximately twice the signed area of the triangle.
+		 */
+		template <FloatingPoint T>
+		double Orient2D(const FVector2D<T> &A, const FVector2D<T> &B, const FVector2D<T> &C);
+
+		/**
+		 * @brief Orientation of four points in space.
+		 *
+		 * @param A The first point of the plane.
+		 * @param B The second point of the plane.
+		 * @param C The third point of the plane.
+		 * @param D The point to test.
+		 * @return Positive if D lies below the plane through A, B and C, where below is the side from which A,
+		 *         B and C appear clockwise; negative if above, zero if coplanar. Approximately six times the
+		 *         signed volume of the tetrahedron.
+		 */
+		template <FloatingPoint T>
+		double Orient3D(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3D<T> &D);
+
+		/**
+		 * @brief Position of a point relative to the circle through three others.
+		 *
+		 * @param A The first point on the circle.
+		 * @param B The second point on the circle.
+		 * @param C The third point on the circle.
+		 * @param D The point to test.
+		 * @return Positive if D is inside the circle, negative if outside, zero if on it, when A, B and C are
+		 *         counterclockwise; the sign flips when they are clockwise.
+		 */
+		template <FloatingPoint T>
+		double InCircle(const FVector2D<T> &A, const FVector2D<T> &B, const FVector2D<T> &C, const FVector2D<T> &D);
+
+		/**
+		 * @brief Position of a point relative to the sphere through four others.
+		 *
+		 * @param A The first point on the sphere.
+		 * @param B The second point on the sphere.
+		 * @param C The third point on the sphere.
+		 * @param D The fourth point on the sphere.
+		 * @param E The point to test.
+		 * @return Positive if E is inside the sphere, negative if outside, zero if on it, when Orient3D(A, B,
+		 *         C, D) is positive; the sign flips when it is negative.
+		 */
+		template <FloatingPoint T>
+		double InSphere(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3D<T> &D, const FVector3D<T> &E);
+	}
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Quaternion class template, X * i + Y * j + Z * k + W.
+	 *
+	 * Unit quaternions represent rotations; products compose them right to left, so (A * B) rotates by B first.
+	 *
+	 * @tparam T The floating-point type to use for quaternion components.
+	 */
+	template <FloatingPoint T>
+	class FQuat
+	{
+	public:
+		/**
+		 * @brief Default constructor. Initializes the identity rotation.
+		 */
+		FQuat();
+
+		/**
+		 * @brief Constructor that initializes the components with given values.
+		 *
+		 * @param InX The X component value.
+		 * @param InY The Y component value.
+		 * @param InZ The Z component value.
+		 * @param InW The W (scalar) component value.
+		 */
+		FQuat(const T InX, const T InY, const T InZ, const T InW);
+
+		/**
+		 * @brief Constructor that creates a rotation about an axis.
+		 *
+		 * @param Axis The rotation axis; must be a unit vector.
+		 * @param Angle The rotation angle in radians.
+		 */
+		FQuat(const FVector3D<T> &Axis, const T Angle);
+
+		/**
+		 * @brief Access individual components by index, X, Y, Z, W.
+		 *
+		 * @param i The index of the component.
+		 * @return Reference to the component at the specified index.
+		 */
+		T &operator[](const int8 i)
+		{
+			return Components[i];
+		}
+
+		/**
+		 * @brief Access individual components by index (const version).
+		 *
+		 * @param i The index of the component.
+		 * @return Const reference to the component at the specified index.
+		 */
+		const T &operator[](const int8 i) const
+		{
+			return Components[i];
+		}
+
+		T GetX() const { return Components[0]; }
+		T GetY() const { return Components[1]; }
+		T GetZ() const { return Components[2]; }
+		T GetW() const { return Components[3]; }
+
+		/**
+		 * @brief Get the vector part X, Y, Z.
+		 *
+		 * @return The vector part.
+		 */
+		FVector3D<T> GetVector() const;
+
+		/**
+		 * @brief Calculate the magnitude (norm) of the quaternion.
+		 *
+		 * @return The magnitude of the quaternion.
+		 */
+		T Magnitude() const;
+
+		/**
+		 * @brief Normalize the quaternion to have a magnitude of 1.
+		 *
+		 * @return Reference to the normalized quaternion.
+		 */
+		FQuat &Normalize();
+
+		/**
+		 * @brief Get the conjugate, which is the inverse rotation for unit quaternions.
+		 *
+		 * @return The conjugate quaternion.
+		 */
+		FQuat GetConjugate() const;
+
+		/**
+		 * @brief Rotate a vector by this unit quaternion.
+		 *
+		 * @param Vector The vector to rotate.
+		 * @return The rotated vector.
+		 */
+		FVector3D<T> RotateVector(const FVector3D<T> &Vector) const;
+
+		/**
+		 * @brief Compound assignment operator for quaternion addition.
+		 *
+		 * @param Other The quaternion to add.
+		 * @return Reference to the modified quaternion.
+		 */
+		FQuat &operator+=(const FQuat &Other);
+
+		/**
+		 * @brief Compound assignment operator for scalar multiplication.
+		 *
+		 * @param Scalar The scalar value to multiply by.
+		 * @return Reference to the modified quaternion.
+		 */
+		FQuat &operator*=(const T Scalar);
+
+	private:
+		T Components[4]; // Components of the quaternion, X, Y, Z, W
+	};
+
+	/**
+	 * @brief Binary operator for the quaternion (Hamilton) product.
+	 *
+	 * @param A The left quaternion.
+	 * @param B The right quaternion.
+	 * @return The product A * B.
+	 */
+	template <FloatingPoint T>
+	FQuat<T> operator*(const FQuat<T> &A, const FQuat<T> &B);
+
+	/**
+	 * @brief Binary operator for quaternion-scalar multiplication.
+	 *
+	 * @param LHS The quaternion to multiply.
+	 * @param Scalar The scalar value to multiply by.
+	 * @return The result of the multiplication.
+	 */
+	template <FloatingPoint T>
+	FQuat<T> operator*(const FQuat<T> &LHS, const T Scalar);
+
+	/**
+	 * @brief Binary operator for quaternion addition.
+	 *
+	 * @param A The first quaternion.
+	 * @param B The second quaternion.
+	 * @return The result of the addition.
+	 */
+	template <FloatingPoint T>
+	FQuat<T> operator+(const FQuat<T> &A, const FQuat<T> &B);
+
+	/**
+	 * @brief Calculate the four-dimensional dot product of two quaternions.
+	 *
+	 * @param A The first quaternion.
+	 * @param B The second quaternion.
+	 * @return The dot product of the two quaternions.
+	 */
+	template <FloatingPoint T>
+	T Dot(const FQuat<T> &A, const FQuat<T> &B);
+}
@@ -8,6 +8,7 @@
 // external includes
 #include <concepts>
 #include <limits>
+#include <span>
 
 // internal includes
 #include "Types.h"
@@ -24,5 +25,164 @@ namespace Ratchet
 
 		template <FloatingPoint T>
 		T Sqrt(T value);
+
+		/**
+		 * @brief Accuracy tier of the polynomial approximations below.
+		 *
+		 * Worst absolute error measured in float against libm over |x| <= 100 (Exp: relative error):
+		 *
+		 *   Function   Low       Medium    Full
+		 *   Sin/Cos    1.5e-4    6.4e-7    8.6e-8
+		 *   Atan2      1.2e-4    3.8e-6    2.9e-7
+		 *   Acos       3.3e-4    5.1e-6    3.2e-7
+		 *   Exp        7.5e-5    2.7e-6    1.1e-7
+		 *   Log        7.7e-6    7.7e-6    1.2e-7
+		 *
+		 * Full is close to float round-off; double inputs get the same polynomials, so use std:: functions
+		 * when double accuracy is required. Only float and double are supported.
+		 */
+		enum class EPrecision : uint8
+		{
+			Low,	// About 1e-3
+			Medium, // About 1e-5
+			Full	// Float precision
+		};
+
+		/**
+		 * @brief Approximate sine. Accurate for |Value| up to about 1e4, with error growing beyond that.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The angle in radians.
+		 * @return The sine of the angle.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Sin(T Value);
+
+		/**
+		 * @brief Approximate cosine. Accurate for |Value| up to about 1e4, with error growing beyond that.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The angle in radians.
+		 * @return The cosine of the angle.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Cos(T Value);
+
+		/**
+		 * @brief Approximate sine and cosine of the same angle, sharing the range reduction.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The angle in radians.
+		 * @param OutSin Receives the sine.
+		 * @param OutCos Receives the cosine.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void SinCos(T Value, T &OutSin, T &OutCos);
+
+		/**
+		 * @brief Approximate four-quadrant arctangent of Y / X.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Y The Y coordinate.
+		 * @param X The X coordinate.
+		 * @return The angle in [-pi, pi]; 0 when both inputs are 0.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Atan2(T Y, T X);
+
+		/**
+		 * @brief Approximate arccosine. Inputs are clamped to [-1, 1].
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The cosine.
+		 * @return The angle in [0, pi].
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Acos(T Value);
+
+		/**
+		 * @brief Approximate natural exponential. Results that would be subnormal are flushed to zero.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The exponent.
+		 * @return e raised to the exponent.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Exp(T Value);
+
+		/**
+		 * @brief Approximate natural logarithm. Subnormal inputs are treated as zero.
+		 *
+		 * @tparam Precision The accuracy tier.
+		 * @param Value The argument.
+		 * @return The logarithm; -infinity for 0 and NaN for negative inputs.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		T Log(T Value);
+
+		/**
+		 * @brief Sin over a stream of values. Large streams are split across the worker pool.
+		 *
+		 * @param Values The angles in radians.
+		 * @param OutValues Receives the results; may alias Values. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Sin(std::span<const T> Values, std::span<T> OutValues);
+
+		/**
+		 * @brief Cos over a stream of values.
+		 *
+		 * @param Values The angles in radians.
+		 * @param OutValues Receives the results; may alias Values. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Cos(std::span<const T> Values, std::span<T> OutValues);
+
+		/**
+		 * @brief SinCos over a stream of values.
+		 *
+		 * @param Values The angles in radians.
+		 * @param OutSin Receives the sines. Must be at least as long as Values.
+		 * @param OutCos Receives the cosines. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void SinCos(std::span<const T> Values, std::span<T> OutSin, std::span<T> OutCos);
+
+		/**
+		 * @brief Atan2 over two streams of coordinates.
+		 *
+		 * @param Y The Y coordinates.
+		 * @param X The X coordinates. Must be at least as long as Y.
+		 * @param OutValues Receives the angles. Must be at least as long as Y.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Atan2(std::span<const T> Y, std::span<const T> X, std::span<T> OutValues);
+
+		/**
+		 * @brief Acos over a stream of values.
+		 *
+		 * @param Values The cosines.
+		 * @param OutValues Receives the angles; may alias Values. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Acos(std::span<const T> Values, std::span<T> OutValues);
+
+		/**
+		 * @brief Exp over a stream of values.
+		 *
+		 * @param Values The exponents.
+		 * @param OutValues Receives the results; may alias Values. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Exp(std::span<const T> Values, std::span<T> OutValues);
+
+		/**
+		 * @brief Log over a stream of values.
+		 *
+		 * @param Values The arguments.
+		 * @param OutValues Receives the results; may alias Values. Must be at least as long as Values.
+		 */
+		template <EPrecision Precision = EPrecision::Full, FloatingPoint T>
+		void Log(std::span<const T> Values, std::span<T> OutValues);
 	}
 }
@@ -0,0 +1,173 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "Vector2D.h"
+#include "Vector3D.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Batch random sampling of numbers, directions and points into structure-of-arrays streams.
+	 *
+	 * Numbers come from the Philox4x32-10 counter-based generator. Sample i of a batch is a pure function
+	 * of the seed and the stream position plus i. Batches therefore split over the worker pool and over
+	 * SIMD lanes without sharing state, and the results do not depend on the number of worker threads.
+	 * Every call advances the position past the counters it used, so successive calls give fresh samples.
+	 * All distributions are sampled by direct mapping, without rejection loops.
+	 *
+	 * @tparam T The floating-point type of the samples.
+	 */
+	template <FloatingPoint T>
+	class FRandomSampler
+	{
+	public:
+		/**
+		 * @brief Constructor that starts a stream at position 0.
+		 *
+		 * @param InSeed The seed, the generator's key.
+		 * @param InAllocator The allocator the Poisson disk scratch storage is taken from.
+		 */
+		explicit FRandomSampler(const uint64 InSeed = 0, Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Restart the stream with a new seed at position 0.
+		 *
+		 * @param InSeed The seed.
+		 */
+		void SetSeed(const uint64 InSeed);
+
+		/**
+		 * @brief Get the seed.
+		 */
+		uint64 GetSeed() const;
+
+		/**
+		 * @brief Move the stream to a position, for example to replay a frame.
+		 *
+		 * @param InPosition The counter of the next sample.
+		 */
+		void SetPosition(const uint64 InPosition);
+
+		/**
+		 * @brief Get the counter of the next sample.
+		 */
+		uint64 GetPosition() const;
+
+		/**
+		 * @brief Fill a stream with numbers uniformly distributed between Min and Max.
+		 *
+		 * @param OutValues Receives the numbers.
+		 * @param Min The lower bound.
+		 * @param Max The upper bound.
+		 */
+		void Uniform(std::span<T> OutValues, const std::type_identity_t<T> Min = 0, const std::type_identity_t<T> Max = 1);
+
+		/**
+		 * @brief Uniformly distributed unit vectors.
+		 *
+		 * @param OutVectors Receives the vectors.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool UnitVectors(const FVector3DStreams<T> &OutVectors);
+
+		/**
+		 * @brief Uniformly distributed points in the unit ball.
+		 *
+		 * @param OutPoints Receives the points.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool PointsInSphere(const FVector3DStreams<T> &OutPoints);
+
+		/**
+		 * @brief Uniformly distributed points in the unit disk.
+		 *
+		 * @param OutPoints Receives the points.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool PointsInDisk(const FVector2DStreams<T> &OutPoints);
+
+		/**
+		 * @brief Unit vectors in the hemisphere around +Z with density proportional to their Z, as used for
+		 *        diffuse and ambient occlusion rays.
+		 *
+		 * @param OutVectors Receives the vectors.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool CosineHemisphere(const FVector3DStreams<T> &OutVectors);
+
+		/**
+		 * @brief Barycentric coordinates of uniformly distributed points in a triangle.
+		 *
+		 * The weights of the three corners go to X, Y and Z and sum to 1, so one batch can place points on
+		 * many triangles.
+		 *
+		 * @param OutWeights Receives the weights.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool Barycentrics(const FVector3DStreams<T> &OutWeights);
+
+		/**
+		 * @brief Uniformly distributed points in a triangle.
+		 *
+		 * @param A The first corner.
+		 * @param B The second corner.
+		 * @param C The third corner.
+		 * @param OutPoints Receives the points.
+		 * @return false if the streams differ in length, in which case nothing is written.
+		 */
+		bool PointsInTriangle(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3DStreams<T> &OutPoints);
+
+		/**
+		 * @brief Poisson disk sampling of a rectangle with Bridson's algorithm: points at least Radius apart
+		 *        until no more fit, or until the output is full.
+		 *
+		 * Runs on the calling thread. Candidates around each active point are generated a lane block at a
+		 * time. The acceleration grid has about Area / (Radius^2 / 2) cells.
+		 *
+		 * @param Min The lower corner of the rectangle.
+		 * @param Max The upper corner of the rectangle.
+		 * @param Radius The smallest distance between two points.
+		 * @param OutPoints Receives the points.
+		 * @param Attempts The candidates tried around a point before it is retired.
+		 * @return The number of points written, 0 if the rectangle or radius is empty or the streams differ in length.
+		 */
+		int64 PoissonDisk2D(const FVector2D<T> &Min, const FVector2D<T> &Max, const std::type_identity_t<T> Radius, const FVector2DStreams<T> &OutPoints,
+							const int32 Attempts = 30);
+
+		/**
+		 * @brief Poisson disk sampling of a box with Bridson's algorithm: points at least Radius apart until
+		 *        no more fit, or until the output is full.
+		 *
+		 * Runs on the calling thread. The acceleration grid has about Volume / (Radius^3 / 5.2) cells.
+		 *
+		 * @param Min The lower corner of the box.
+		 * @param Max The upper corner of the box.
+		 * @param Radius The smallest distance between two points.
+		 * @param OutPoints Receives the points.
+		 * @param Attempts The candidates tried around a point before it is retired.
+		 * @return The number of points written, 0 if the box or radius is empty or the streams differ in length.
+		 */
+		int64 PoissonDisk3D(const FVector3D<T> &Min, const FVector3D<T> &Max, const std::type_identity_t<T> Radius, const FVector3DStreams<T> &OutPoints,
+							const int32 Attempts = 30);
+
+	private:
+		template <int32 Dimension>
+		int64 PoissonDisk(const T (&Min)[Dimension], const T (&Max)[Dimension], const T Radius, T *const (&OutPoints)[Dimension], const int64 Capacity,
+						  const int32 Attempts);
+
+		uint64 Seed;
+		uint64 Position;
+
+		// Poisson disk scratch: the point in each grid cell or -1, and the points that may still have neighbors
+		Memory::FAlignedBuffer<int32> Grid;
+		Memory::FAlignedBuffer<int32> Active;
+	};
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "DualQuat.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorStreams.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Number of bone influences stored per vertex. Unused influences have a weight of zero.
+	 */
+	constexpr int32 MaxSkinInfluences = 4;
+
+	/**
+	 * @brief Bone influences of a vertex stream, MaxSkinInfluences consecutive entries per vertex.
+	 */
+	template <FloatingPoint T>
+	struct FSkinInfluences
+	{
+		std::span<const uint16> BoneIndices; // Indices into the bone palette; must be in range
+		std::span<const T> Weights;			 // Non-negative; need not sum to one, the blend is normalized
+	};
+
+	/**
+	 * @brief Dual quaternion skinning of a vertex stream.
+	 *
+	 * Every vertex blends the dual quaternions of its bones, flipping those in the opposite hemisphere of the
+	 * first influence so the blend takes the short path, normalizes the result and transforms its position
+	 * and normal. Vertices are processed several per SIMD register and distributed over the worker pool.
+	 * Vertices whose weights are all zero are passed through unchanged.
+	 *
+	 * @param Palette The bone transforms as unit dual quaternions, bind pose to current pose.
+	 * @param Influences The bone indices and weights, MaxSkinInfluences per vertex.
+	 * @param Positions The bind-pose positions.
+	 * @param Normals The bind-pose normals, or empty streams to skip normals.
+	 * @param OutPositions Receives the skinned positions. May be the same streams as Positions but must not partially overlap them.
+	 * @param OutNormals Receives the skinned normals; ignored if Normals is empty. Same aliasing rules as OutPositions.
+	 * @return false if the stream lengths don't match, in which case nothing is written.
+	 */
+	template <FloatingPoint T>
+	bool SkinDualQuat(std::span<const FDualQuat<T>> Palette, const FSkinInfluences<T> &Influences,
+					  const std::type_identity_t<FVector3DStreams<const T>> &Positions, const std::type_identity_t<FVector3DStreams<const T>> &Normals,
+					  const FVector3DStreams<T> &OutPositions, const FVector3DStreams<T> &OutNormals);
+}
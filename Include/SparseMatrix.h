@@ -0,0 +1,141 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Position of a stored block in a sparse matrix, in block rows and columns.
+	 */
+	struct FSparseIndex
+	{
+		int64 Row;
+		int64 Column;
+	};
+
+	/**
+	 * @brief Sparse matrix in compressed sparse row (CSR) form with square BlockSize x BlockSize blocks.
+	 *
+	 * With BlockSize 1 this is a plain scalar CSR matrix; with BlockSize 3 every block couples two FVector3D
+	 * unknowns, as in cloth and soft-body systems. The sparsity pattern is set once with SetPattern; after that
+	 * the values can be cleared and reassembled every frame without allocating.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 * @tparam BlockSize The size of the blocks, 1 or 3.
+	 */
+	template <FloatingPoint T, int32 BlockSize = 1>
+	class FSparseMatrix
+	{
+		static_assert(BlockSize == 1 || BlockSize == 3, "Only scalar and 3x3 blocks are supported");
+
+	public:
+		// Type of one block of unknowns: T for scalar matrices, FVector3D<T> for 3x3 blocks
+		using VectorType = std::conditional_t<BlockSize == 1, T, FVector3D<T>>;
+
+		// Number of scalar entries per block
+		static constexpr int32 BlockEntryCount = BlockSize * BlockSize;
+
+		/**
+		 * @brief Constructor that creates an empty 0x0 matrix.
+		 *
+		 * @param InAllocator The allocator the pattern and values are taken from.
+		 */
+		explicit FSparseMatrix(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Set the sparsity pattern and reset all values to zero.
+		 *
+		 * Storage is only reallocated when the new pattern does not fit the current capacity.
+		 *
+		 * @param InRows The number of block rows.
+		 * @param InColumns The number of block columns.
+		 * @param Entries The stored blocks, in any order. Duplicates are merged; indices out of range are ignored.
+		 */
+		void SetPattern(const int64 InRows, const int64 InColumns, std::span<const FSparseIndex> Entries);
+
+		/**
+		 * @brief Set every stored value to zero, keeping the pattern.
+		 */
+		void SetZero();
+
+		/**
+		 * @brief Find a stored block.
+		 *
+		 * @param Row The block row.
+		 * @param Column The block column.
+		 * @return Pointer to the BlockEntryCount row-major entries of the block, or nullptr if it is not in the pattern.
+		 */
+		T *Find(const int64 Row, const int64 Column);
+		const T *Find(const int64 Row, const int64 Column) const;
+
+		/**
+		 * @brief Compute Y = A * X across the worker pool.
+		 *
+		 * @param X The input, one entry per block column.
+		 * @param Y The output, one entry per block row. Must not overlap X.
+		 * @return false if the lengths don't match, in which case Y is left unchanged.
+		 */
+		bool Multiply(std::span<const VectorType> X, std::span<VectorType> Y) const;
+
+		/**
+		 * @brief Compute rows [BeginRow, EndRow) of Y = A * X on the calling thread, for kernels that fuse other work with the product.
+		 *
+		 * @param BeginRow The first block row.
+		 * @param EndRow One past the last block row.
+		 * @param X The input, one entry per block column.
+		 * @param Y The output, one entry per block row. Must not overlap X.
+		 */
+		void MultiplyRows(const int64 BeginRow, const int64 EndRow, const VectorType *RESTRICT X, VectorType *RESTRICT Y) const;
+
+		/**
+		 * @brief Compute rows [BeginRow, EndRow) of Y = A * X on the calling thread, with X and Y given as BlockSize
+		 *        scalars per block, e.g. the scratch vectors of an iterative solver. Scalar matrices use the overload above.
+		 *
+		 * @param BeginRow The first block row.
+		 * @param EndRow One past the last block row.
+		 * @param X The input, BlockSize entries per block column.
+		 * @param Y The output, BlockSize entries per block row. Must not overlap X.
+		 */
+		void MultiplyRows(const int64 BeginRow, const int64 EndRow, const T *RESTRICT X, T *RESTRICT Y) const
+			requires(BlockSize > 1);
+
+		int64 GetRows() const;
+		int64 GetColumns() const;
+
+		/**
+		 * @brief Get the number of stored blocks.
+		 */
+		int64 GetBlockCount() const;
+
+		// Offsets of every block row into the column indices, GetRows() + 1 entries
+		std::span<const int64> GetRowOffsets() const;
+
+		// Block column of every stored block, sorted within each row
+		std::span<const int32> GetColumnIndices() const;
+
+		// BlockEntryCount row-major entries per stored block, in the order of the column indices
+		std::span<T> GetValues();
+		std::span<const T> GetValues() const;
+
+	private:
+		Memory::FAlignedBuffer<int64> RowOffsets;
+		Memory::FAlignedBuffer<int32> ColumnIndices; // 32-bit indices halve the index traffic of Multiply
+		Memory::FAlignedBuffer<T, CacheLineSize> Values;
+		int64 Rows = 0;
+		int64 Columns = 0;
+	};
+
+	/**
+	 * @brief Sparse matrix with 3x3 blocks over FVector3D unknowns.
+	 */
+	template <FloatingPoint T>
+	using FBlockSparseMatrix3x3 = FSparseMatrix<T, 3>;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Parallel.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorReduce.h"
+#include "VectorTraits.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Concept to check if a type can hold a space-filling curve code.
+	 *
+	 * @tparam T The type to check.
+	 */
+	template <typename T>
+	concept SpatialCode = std::is_same_v<T, uint32> || std::is_same_v<T, uint64>;
+
+	/**
+	 * @brief Sorting points along a space-filling curve, so that points close in space end up close in memory.
+	 *
+	 * The usual sequence is to encode the points within their bounds, sort the codes into a permutation,
+	 * then apply the permutation to the points and to every attribute stream that goes with them.
+	 * Codes are 30-bit in a uint32 (10 bits per axis in 3D, 15 in 2D) or 63-bit in a uint64 (21 bits per
+	 * axis in 3D, 31 in 2D).
+	 */
+	namespace SpatialOrder
+	{
+		/**
+		 * @brief Compute the Morton (Z-order) codes of points, spread over the worker pool.
+		 *
+		 * Every axis of the bounds is split into 2^bits cells, and the cell coordinates are interleaved with X
+		 * in the lowest bit. Uses the BMI2 pdep instruction when the build targets it. Points outside the
+		 * bounds are clamped to the border cells.
+		 *
+		 * @param Points The points.
+		 * @param Bounds The region to encode, e.g. from Bounds().
+		 * @param OutCodes Receives one code per point.
+		 * @return false if the spans differ in length, in which case nothing is written.
+		 */
+		template <typename VectorType, SpatialCode CodeType>
+		bool MortonCodes(std::span<const VectorType> Points, const FBounds<VectorType> &Bounds, std::span<CodeType> OutCodes);
+
+		/**
+		 * @brief Compute the Hilbert curve codes of points, spread over the worker pool.
+		 *
+		 * Consecutive Hilbert cells always share a face, unlike Morton cells, which makes for better locality
+		 * at about five times the encoding cost. Uses Skilling's transform, without branches.
+		 *
+		 * @param Points The points.
+		 * @param Bounds The region to encode, e.g. from Bounds().
+		 * @param OutCodes Receives one code per point.
+		 * @return false if the spans differ in length, in which case nothing is written.
+		 */
+		template <typename VectorType, SpatialCode CodeType>
+		bool HilbertCodes(std::span<const VectorType> Points, const FBounds<VectorType> &Bounds, std::span<CodeType> OutCodes);
+
+		/**
+		 * @brief Sort codes with a parallel least-significant-digit radix sort and return the sorting permutation.
+		 *
+		 * The sort is stable, so the result does not depend on the number of worker threads. Digits on which
+		 * all codes agree are skipped, so codes of a small region cost fewer passes.
+		 *
+		 * @param Codes The codes to sort.
+		 * @param OutPermutation Receives, for every position in sorted order, the index of its code.
+		 * @param Allocator The allocator the scratch storage, two copies of the codes and one of the indices, is taken from.
+		 * @return false if the spans differ in length or hold more than 2^31 - 1 entries, in which case nothing is written.
+		 */
+		template <SpatialCode CodeType>
+		bool SortPermutation(std::span<const CodeType> Codes, std::span<int32> OutPermutation, Memory::FAllocator &Allocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Gather the elements of a stream in permutation order, spread over the worker pool.
+		 *
+		 * @param Permutation The source index of every output element, as from SortPermutation.
+		 * @param Source The elements to reorder. Must not overlap the output.
+		 * @param OutElements Receives Source[Permutation[i]] at position i.
+		 * @return false if the spans differ in length, in which case nothing is written.
+		 */
+		template <typename ElementType>
+		bool ApplyPermutation(std::span<const int32> Permutation, std::span<const std::type_identity_t<ElementType>> Source, std::span<ElementType> OutElements)
+		{
+			if (Source.size() != Permutation.size() || OutElements.size() != Permutation.size())
+				return false;
+
+			Parallel::ParallelFor(static_cast<int64>(Permutation.size()), 4096, [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 i = Begin; i < End; ++i)
+					OutElements[i] = Source[Permutation[i]]; });
+			return true;
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Symmetric 3x3 matrix stored as its six unique entries, e.g. a covariance or inertia tensor.
+	 *
+	 * @tparam T The floating-point type of the entries.
+	 */
+	template <FloatingPoint T>
+	struct FSymmetricMatrix3x3
+	{
+		T XX = 0;
+		T XY = 0;
+		T XZ = 0;
+		T YY = 0;
+		T YZ = 0;
+		T ZZ = 0;
+
+		/**
+		 * @brief Get an entry by row and column.
+		 *
+		 * @param Row The row index (0-2).
+		 * @param Column The column index (0-2).
+		 * @return The entry; (Row, Column) and (Column, Row) are the same entry.
+		 */
+		T operator()(const int32 Row, const int32 Column) const
+		{
+			const int32 Min = Row < Column ? Row : Column;
+			const int32 Max = Row < Column ? Column : Row;
+			// Entries are numbered as the upper triangle in row order
+			switch (Min * 3 - Min * (Min + 1) / 2 + Max)
+			{
+			case 0:
+				return XX;
+			case 1:
+				return XY;
+			case 2:
+				return XZ;
+			case 3:
+				return YY;
+			case 4:
+				return YZ;
+			default:
+				return ZZ;
+			}
+		}
+	};
+}
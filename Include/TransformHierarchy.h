@@ -0,0 +1,147 @@
+#pragma once
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Quat.h"
+#include "Types.h"
+#include "Vector3D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Scale, then rotation, then translation.
+	 */
+	template <FloatingPoint T>
+	struct FTransform
+	{
+		FVector3D<T> Translation;
+		FQuat<T> Rotation;
+		FVector3D<T> Scale = FVector3D<T>(1, 1, 1);
+	};
+
+	/**
+	 * @brief Scene graph of local transforms and the world transforms derived from them.
+	 *
+	 * Nodes are kept in structure-of-arrays form in breadth-first order: all roots, then all their children,
+	 * and so on, with siblings next to each other. Every depth level is a contiguous range whose parents lie in
+	 * the level before, so UpdateWorldTransforms is one linear pass per level with the nodes of a level spread
+	 * over the worker pool. Changing a local transform marks the node dirty, and an update only recomputes
+	 * dirty nodes and their descendants.
+	 *
+	 * World scale is the component-wise product of the scales along the path, ignoring the shear a rotated
+	 * non-uniform scale would introduce.
+	 *
+	 * Nodes are referred to by handles that stay valid when the layout is rebuilt after nodes are added.
+	 *
+	 * @tparam T The floating-point type of the transforms.
+	 */
+	template <FloatingPoint T>
+	class FTransformHierarchy
+	{
+	public:
+		// Handle of "no node", used as the parent of roots
+		static constexpr int32 InvalidNode = -1;
+
+		/**
+		 * @brief Constructor that creates an empty hierarchy.
+		 *
+		 * @param InAllocator The allocator the node arrays are taken from.
+		 */
+		explicit FTransformHierarchy(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Reserve storage for a number of nodes.
+		 *
+		 * @param Capacity The number of nodes.
+		 */
+		void Reserve(const int32 Capacity);
+
+		/**
+		 * @brief Add a node. Its world transform is valid after the next UpdateWorldTransforms.
+		 *
+		 * @param Parent The handle of the parent, or InvalidNode for a root.
+		 * @param Local The transform relative to the parent.
+		 * @return The handle of the new node, or InvalidNode if Parent is not a node of this hierarchy.
+		 */
+		int32 AddNode(const int32 Parent, const FTransform<T> &Local = FTransform<T>());
+
+		/**
+		 * @brief Replace the local transform of a node and mark it dirty.
+		 *
+		 * @param Node The handle of the node.
+		 * @param Local The transform relative to the parent.
+		 */
+		void SetLocalTransform(const int32 Node, const FTransform<T> &Local);
+
+		void SetLocalTranslation(const int32 Node, const FVector3D<T> &Translation);
+		void SetLocalRotation(const int32 Node, const FQuat<T> &Rotation);
+		void SetLocalScale(const int32 Node, const FVector3D<T> &Scale);
+
+		/**
+		 * @brief Get the local transform of a node.
+		 *
+		 * @param Node The handle of the node.
+		 * @return The transform relative to the parent.
+		 */
+		FTransform<T> GetLocalTransform(const int32 Node) const;
+
+		/**
+		 * @brief Get the world transform of a node as of the last UpdateWorldTransforms.
+		 *
+		 * @param Node The handle of the node.
+		 * @return The transform relative to the world.
+		 */
+		FTransform<T> GetWorldTransform(const int32 Node) const;
+
+		/**
+		 * @brief Get the parent of a node.
+		 *
+		 * @param Node The handle of the node.
+		 * @return The handle of the parent, or InvalidNode for a root.
+		 */
+		int32 GetParent(const int32 Node) const;
+
+		int32 GetNodeCount() const;
+
+		/**
+		 * @brief Recompute the world transforms of all dirty nodes and their descendants, then clear the dirty flags.
+		 *
+		 * Rebuilds the breadth-first layout first if nodes were added since the last update.
+		 *
+		 * @return The number of nodes whose world transform was recomputed.
+		 */
+		int32 UpdateWorldTransforms();
+
+	private:
+		// Translation X, Y, Z, rotation X, Y, Z, W, scale X, Y, Z
+		static constexpr int32 ComponentCount = 10;
+
+		void SetLocal(const int32 Slot, const int32 First, const int32 Count, const T *Values);
+
+		FTransform<T> GetTransform(const Memory::FAlignedBuffer<T, CacheLineSize> (&Components)[ComponentCount], const int32 Slot) const;
+
+		void RebuildLayout();
+
+		// Per slot, in layout order
+		Memory::FAlignedBuffer<T, CacheLineSize> Local[ComponentCount];
+		Memory::FAlignedBuffer<T, CacheLineSize> World[ComponentCount];
+		Memory::FAlignedBuffer<int32> Parents; // Slot of the parent, InvalidNode for roots
+		Memory::FAlignedBuffer<int32> Handles; // Handle of the node in the slot
+		Memory::FAlignedBuffer<uint8> Dirty;
+
+		// Per handle
+		Memory::FAlignedBuffer<int32> Slots;
+
+		// Slot ranges of the depth levels, valid while the layout is
+		Memory::FAlignedBuffer<int32> LevelOffsets;
+
+		// Scratch storage for rebuilding the layout
+		Memory::FAlignedBuffer<int32> Order;
+		Memory::FAlignedBuffer<int32> ChildOffsets;
+		Memory::FAlignedBuffer<int32> Children;
+		Memory::FAlignedBuffer<T, CacheLineSize> Scratch;
+
+		bool bLayoutValid = true;
+	};
+}
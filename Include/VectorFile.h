@@ -0,0 +1,215 @@
+#pragma once
+
+// external includes
+#include <cstdio>
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorTraits.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Arrangement of the components of a vector array on disk.
+	 */
+	enum class EVectorFileLayout : uint8
+	{
+		AoS = 0, // X0 Y0 Z0 X1 Y1 Z1 ...
+		SoA = 1	 // X0 X1 ... then Y0 Y1 ... then Z0 Z1 ..., every stream aligned
+	};
+
+	/**
+	 * @brief Outcome of a vector file operation.
+	 */
+	enum class EVectorFileStatus : uint8
+	{
+		Ok,
+		CannotOpen,
+		BadMagic,
+		UnsupportedVersion,
+		Truncated,
+		ChecksumMismatch,
+		WriteFailed,
+		InvalidArgument
+	};
+
+	/**
+	 * @brief On-disk header at the start of every vector file. All fields are little-endian.
+	 */
+	struct FVectorFileHeader
+	{
+		static constexpr uint32 ExpectedMagic = 0x43455652; // "RVEC"
+		static constexpr uint16 CurrentVersion = 1;
+		static constexpr int32 MaxStreams = 4;
+
+		uint32 Magic = ExpectedMagic;
+		uint16 Version = CurrentVersion;
+		uint8 Dimension = 0;   // Components per vector: 2, 3 or 4
+		uint8 ScalarSize = 0;  // Bytes per component: 4 (float) or 8 (double)
+		uint8 Layout = 0;	   // EVectorFileLayout
+		uint8 Reserved[3] = {};
+		uint32 Alignment = 0;  // Alignment of every stream relative to the start of the file
+		uint64 Count = 0;	   // Number of vectors
+		uint64 DataOffset = 0; // Offset of the first stream
+		uint64 StreamStride = 0; // Distance between consecutive SoA streams, 0 for AoS
+		uint64 Checksums[MaxStreams] = {}; // Checksum of every stream; AoS uses only the first
+	};
+
+	/**
+	 * @brief Checksum used by vector files: FNV-1a over 32-bit words with a 64-bit state.
+	 *
+	 * @param Data The bytes to hash. The size must be a multiple of 4.
+	 * @param Size The number of bytes.
+	 * @param Seed The state to continue from, to hash a stream in chunks.
+	 * @return The updated checksum.
+	 */
+	uint64 VectorFileChecksum(const void *Data, const uint64 Size, const uint64 Seed = 0xcbf29ce484222325ull);
+
+	/**
+	 * @brief Read-only, memory-mapped view of a vector file.
+	 *
+	 * Data is never copied: the spans returned point straight into the mapping and stay valid until
+	 * the reader is closed or destroyed.
+	 */
+	class FVectorFileReader
+	{
+	public:
+		/**
+		 * @brief Default constructor. Creates a reader with no file open.
+		 */
+		FVectorFileReader();
+
+		~FVectorFileReader();
+
+		FVectorFileReader(const FVectorFileReader &) = delete;
+		FVectorFileReader &operator=(const FVectorFileReader &) = delete;
+
+		/**
+		 * @brief Map a vector file and validate its header.
+		 *
+		 * @param Path The file to open.
+		 * @param bVerifyChecksums Whether to hash the whole payload now, which touches every page.
+		 * @return Ok on success, the reason otherwise.
+		 */
+		EVectorFileStatus Open(const char *Path, const bool bVerifyChecksums = false);
+
+		/**
+		 * @brief Unmap the file.
+		 */
+		void Close();
+
+		/**
+		 * @brief Hash every stream and compare against the header.
+		 *
+		 * @return Ok if all checksums match, ChecksumMismatch otherwise.
+		 */
+		EVectorFileStatus VerifyChecksums() const;
+
+		/**
+		 * @brief Ask the OS to start reading the whole payload in the background.
+		 */
+		void Prefetch() const;
+
+		bool IsOpen() const;
+
+		const FVectorFileHeader &GetHeader() const;
+
+		/**
+		 * @brief View an AoS file as an array of vectors.
+		 *
+		 * @tparam VectorType The vector type the file was written with.
+		 * @return The vectors, or an empty span if the file is SoA or holds a different type.
+		 */
+		template <typename VectorType>
+		std::span<const VectorType> GetElements() const;
+
+		/**
+		 * @brief View one component stream of a SoA file.
+		 *
+		 * @tparam T The scalar type the file was written with.
+		 * @param Component The component index, 0 for X.
+		 * @return The stream, or an empty span if the file is AoS, holds a different precision or has no such component.
+		 */
+		template <FloatingPoint T>
+		std::span<const T> GetComponent(const int32 Component) const;
+
+	private:
+		const uint8 *GetStreamData(const int32 Stream) const;
+
+		uint64 GetStreamSize() const;
+
+		int32 GetStreamCount() const;
+
+		FVectorFileHeader Header;
+		const uint8 *Mapping = nullptr;
+		uint64 MappingSize = 0;
+		machine_address FileHandle = 0;
+		machine_address MappingHandle = 0;
+	};
+
+	/**
+	 * @brief Writes a vector file incrementally, chunk by chunk.
+	 *
+	 * AoS files may grow to any size; SoA files need the final count up front so every stream can be placed.
+	 *
+	 * @tparam VectorType FVector2D, FVector3D or FVector4D of float or double.
+	 */
+	template <typename VectorType>
+	class FVectorFileWriter
+	{
+	public:
+		using ScalarType = typename TVectorTraits<VectorType>::ScalarType;
+
+		static constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+
+		/**
+		 * @brief Constructor that creates a writer with no file open.
+		 *
+		 * @param InAllocator The allocator used for the SoA staging buffer.
+		 */
+		explicit FVectorFileWriter(Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		~FVectorFileWriter();
+
+		FVectorFileWriter(const FVectorFileWriter &) = delete;
+		FVectorFileWriter &operator=(const FVectorFileWriter &) = delete;
+
+		/**
+		 * @brief Create the file and write a provisional header.
+		 *
+		 * @param Path The file to create.
+		 * @param Layout The layout to write.
+		 * @param TotalCount The number of vectors that will be appended. Required for SoA, ignored for AoS.
+		 * @param Alignment The alignment of every stream in the file, a power of two.
+		 * @return Ok on success, the reason otherwise.
+		 */
+		EVectorFileStatus Open(const char *Path, const EVectorFileLayout Layout, const uint64 TotalCount = 0, const uint32 Alignment = 64);
+
+		/**
+		 * @brief Append a chunk of vectors.
+		 *
+		 * @param Elements The vectors to append.
+		 * @return Ok on success, the reason otherwise.
+		 */
+		EVectorFileStatus Append(std::span<const VectorType> Elements);
+
+		/**
+		 * @brief Write the final header and close the file.
+		 *
+		 * @return Ok on success, Truncated if a SoA file received fewer vectors than announced.
+		 */
+		EVectorFileStatus Close();
+
+	private:
+		bool WriteAt(const uint64 Offset, const void *Data, const uint64 Size);
+
+		FVectorFileHeader Header;
+		Memory::FAlignedBuffer<ScalarType, CacheLineSize> Staging;
+		std::FILE *File = nullptr;
+		uint64 Written = 0;
+		bool bFailed = false;
+	};
+}
@@ -0,0 +1,483 @@
+#pragma once
+
+// external includes
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Check whether FVector is explicitly instantiated for a number of components. Its out-of-line
+	 *        members and operators only link for these.
+	 *
+	 * @param N The number of components.
+	 */
+	constexpr bool IsInstantiatedDimension(const int32 N)
+	{
+		return N == 2 || N == 3 || N == 4 || N == 8 || N == 16;
+	}
+
+	/**
+	 * @brief Component letters of a swizzle, passed as a string literal template argument: x, y, z and w
+	 *        pick components, 0 and 1 insert constants.
+	 */
+	struct FSwizzlePattern
+	{
+		/**
+		 * @brief Constructor from a string literal of two to four letters.
+		 *
+		 * @param InLetters The letters, e.g. "yzx".
+		 */
+		template <size_t Length>
+			requires(Length >= 3 && Length <= 5)
+		consteval FSwizzlePattern(const char (&InLetters)[Length])
+		{
+			for (size_t i = 0; i + 1 < Length; ++i)
+				Letters[i] = InLetters[i];
+			Count = static_cast<int32>(Length - 1);
+		}
+
+		/**
+		 * @brief Get the component a letter picks.
+		 *
+		 * @param Letter The letter.
+		 * @return The component index, or -1 for the constants and unknown letters.
+		 */
+		static constexpr int32 GetIndex(const char Letter)
+		{
+			return Letter == 'x' ? 0 : Letter == 'y' ? 1 : Letter == 'z' ? 2 : Letter == 'w' ? 3 : -1;
+		}
+
+		/**
+		 * @brief Check that every letter is a constant or picks one of the first Dimension components.
+		 *
+		 * @param Dimension The number of components of the source vector.
+		 */
+		constexpr bool IsValidFor(const int32 Dimension) const
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const int32 Index = GetIndex(Letters[i]);
+				if (Letters[i] != '0' && Letters[i] != '1' && (Index < 0 || Index >= Dimension))
+					return false;
+			}
+			return true;
+		}
+
+		char Letters[4] = {}; // The letters in output order
+		int32 Count = 0;	  // Number of components of the result
+	};
+
+	/**
+	 * @brief Vector class template for any number of components.
+	 *
+	 * FVector2D, FVector3D and FVector4D are aliases of it. Component-wise operations are unrolled at
+	 * compile time, so they are written once for every dimension, including the 8 and 16 component
+	 * vectors used for batched lanes. Explicitly instantiated for 2, 3, 4, 8 and 16 components.
+	 *
+	 * @tparam N The number of components.
+	 * @tparam T The floating-point type to use for vector components.
+	 */
+	template <int32 N, FloatingPoint T>
+	class FVector
+	{
+		static_assert(N >= 1, "A vector needs at least one component");
+
+	public:
+		/**
+		 * @brief Default constructor. Initializes all components to zero.
+		 */
+		FVector();
+
+		/**
+		 * @brief Constructor that initializes vector components with given values.
+		 *
+		 * @param InComponents The N component values, X first.
+		 */
+		template <typename... ArgTypes>
+			requires(sizeof...(ArgTypes) == N && (std::is_convertible_v<ArgTypes, T> && ...))
+		explicit(N == 1) FVector(const ArgTypes... InComponents)
+			: Components{static_cast<T>(InComponents)...}
+		{
+		}
+
+		/**
+		 * @brief Copy constructor.
+		 *
+		 * @param Other The vector to copy.
+		 */
+		FVector(const FVector &Other) = default;
+
+		/**
+		 * @brief Copy assignment operator.
+		 *
+		 * @param Other The vector to copy.
+		 * @return Reference to this vector.
+		 */
+		FVector &operator=(const FVector &Other) = default;
+
+		/**
+		 * @brief Equality operator.
+		 *
+		 * @param Other The vector to compare.
+		 * @return true if all components are equal, false otherwise.
+		 */
+		bool operator==(const FVector &Other) const;
+
+		/**
+		 * @brief Access individual components of the vector by index.
+		 *
+		 * @param i The index of the component.
+		 * @return Reference to the component at the specified index.
+		 */
+		T &operator[](const int8 i)
+		{
+			return Components[i];
+		}
+
+		/**
+		 * @brief Access individual components of the vector by index (const version).
+		 *
+		 * @param i The index of the component.
+		 * @return Const reference to the component at the specified index.
+		 */
+		const T &operator[](const int8 i) const
+		{
+			return Components[i];
+		}
+
+		/**
+		 * @brief Get the X component value.
+		 *
+		 * @return The X component value.
+		 */
+		T GetX() const
+		{
+			return Components[0];
+		}
+
+		/**
+		 * @brief Get the Y component value.
+		 *
+		 * @return The Y component value.
+		 */
+		T GetY() const
+			requires(N >= 2)
+		{
+			return Components[1];
+		}
+
+		/**
+		 * @brief Get the Z component value.
+		 *
+		 * @return The Z component value.
+		 */
+		T GetZ() const
+			requires(N >= 3)
+		{
+			return Components[2];
+		}
+
+		/**
+		 * @brief Get the W component value.
+		 *
+		 * @return The W component value.
+		 */
+		T GetW() const
+			requires(N >= 4)
+		{
+			return Components[3];
+		}
+
+		/**
+		 * @brief Set the X component value.
+		 *
+		 * @param InX The new X component value.
+		 */
+		void SetX(const T InX)
+		{
+			Components[0] = InX;
+		}
+
+		/**
+		 * @brief Set the Y component value.
+		 *
+		 * @param InY The new Y component value.
+		 */
+		void SetY(const T InY)
+			requires(N >= 2)
+		{
+			Components[1] = InY;
+		}
+
+		/**
+		 * @brief Set the Z component value.
+		 *
+		 * @param InZ The new Z component value.
+		 */
+		void SetZ(const T InZ)
+			requires(N >= 3)
+		{
+			Components[2] = InZ;
+		}
+
+		/**
+		 * @brief Set the W component value.
+		 *
+		 * @param InW The new W component value.
+		 */
+		void SetW(const T InW)
+			requires(N >= 4)
+		{
+			Components[3] = InW;
+		}
+
+		/**
+		 * @brief Build a vector from components of this one picked at compile time, e.g. Swizzle<1, 2, 0>()
+		 *        for (Y, Z, X). The result can have a different number of components, as long as FVector is
+		 *        instantiated for it.
+		 *
+		 * Defined inline so it compiles to register moves, or a single shuffle when the vector is held in
+		 * a SIMD register.
+		 *
+		 * @tparam Index The component indices, in output order.
+		 * @return The swizzled vector.
+		 */
+		template <int32... Index>
+			requires(IsInstantiatedDimension(sizeof...(Index)) && ((Index >= 0 && Index < N) && ...))
+		FVector<static_cast<int32>(sizeof...(Index)), T> Swizzle() const
+		{
+			return FVector<static_cast<int32>(sizeof...(Index)), T>(Components[Index]...);
+		}
+
+		/**
+		 * @brief Build a vector from components of this one named by letters, e.g. Swizzle<"yzx">() for
+		 *        (Y, Z, X) or Swizzle<"xyz1">() for a point in homogeneous coordinates.
+		 *
+		 * @tparam Pattern The letters, in output order.
+		 * @return The swizzled vector.
+		 */
+		template <FSwizzlePattern Pattern>
+			requires(IsInstantiatedDimension(Pattern.Count) && Pattern.IsValidFor(N))
+		FVector<Pattern.Count, T> Swizzle() const
+		{
+			return [&]<int32... Slot>(std::integer_sequence<int32, Slot...>)
+			{ return FVector<Pattern.Count, T>(GetSwizzled<Pattern.Letters[Slot]>()...); }(std::make_integer_sequence<int32, Pattern.Count>());
+		}
+
+		/**
+		 * @brief Append a component, e.g. to turn an FVector3D into a point (X, Y, Z, 1) or a direction (X, Y, Z, 0).
+		 *        Only available where FVector is instantiated for N + 1 components.
+		 *
+		 * @param InLast The new last component.
+		 * @return The extended vector.
+		 */
+		FVector<N + 1, T> Extend(const T InLast) const
+			requires(IsInstantiatedDimension(N + 1))
+		{
+			return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+			{ return FVector<N + 1, T>(Components[Index]..., InLast); }(std::make_integer_sequence<int32, N>());
+		}
+
+		/**
+		 * @brief Calculate the magnitude (length) of the vector.
+		 *
+		 * @return The magnitude of the vector.
+		 */
+		T Magnitude() const;
+
+		/**
+		 * @brief Normalize the vector to have a magnitude of 1.
+		 *
+		 * @return Reference to the normalized vector.
+		 */
+		FVector &Normalize();
+
+		/**
+		 * @brief Calculate the distance between this vector and another vector.
+		 *
+		 * @param Other The other vector.
+		 * @return The distance between this vector and the other vector.
+		 */
+		T DistanceTo(const FVector &Other) const;
+
+		/**
+		 * @brief Compound assignment operator for vector addition.
+		 *
+		 * @param Other The vector to add.
+		 * @return Reference to the modified vector.
+		 */
+		FVector &operator+=(const FVector &Other);
+
+		/**
+		 * @brief Compound assignment operator for vector subtraction.
+		 *
+		 * @param Other The vector to subtract.
+		 * @return Reference to the modified vector.
+		 */
+		FVector &operator-=(const FVector &Other);
+
+		/**
+		 * @brief Compound assignment operator for scalar multiplication.
+		 *
+		 * @param Scalar The scalar value to multiply by.
+		 * @return Reference to the modified vector.
+		 */
+		FVector &operator*=(const T Scalar);
+
+		/**
+		 * @brief Compound assignment operator for scalar division.
+		 *
+		 * @param Scalar The scalar value to divide by.
+		 * @return Reference to the modified vector.
+		 */
+		FVector &operator/=(const T Scalar);
+
+	private:
+		template <char Letter>
+		T GetSwizzled() const
+		{
+			if constexpr (Letter == '0')
+				return T(0);
+			else if constexpr (Letter == '1')
+				return T(1);
+			else
+				return Components[FSwizzlePattern::GetIndex(Letter)];
+		}
+
+		T Components[N]; // Components of the vector, X first
+	};
+
+	/**
+	 * @brief Binary operator for vector-scalar multiplication.
+	 *
+	 * @param LHS The vector to multiply.
+	 * @param Scalar The scalar value to multiply by.
+	 * @return The result of the multiplication.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator*(const FVector<N, T> &LHS, const T Scalar);
+
+	/**
+	 * @brief Binary operator for vector-scalar division.
+	 *
+	 * @param LHS The vector to divide.
+	 * @param Scalar The scalar value to divide by.
+	 * @return The result of the division.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator/(const FVector<N, T> &LHS, const T Scalar);
+
+	/**
+	 * @brief Binary operator for vector addition.
+	 *
+	 * @param A The first vector.
+	 * @param B The second vector.
+	 * @return The result of the addition.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator+(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Binary operator for vector subtraction.
+	 *
+	 * @param A The vector to subtract from.
+	 * @param B The vector to subtract.
+	 * @return The result of the subtraction.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator-(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Unary negation operator for a vector.
+	 *
+	 * @param Vector The vector to negate.
+	 * @return The negated vector.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator-(const FVector<N, T> &Vector);
+
+	/**
+	 * @brief Calculate the magnitude (length) of a vector.
+	 *
+	 * @param Vector The vector to calculate the magnitude of.
+	 * @return The magnitude of the vector.
+	 */
+	template <int32 N, FloatingPoint T>
+	T Magnitude(const FVector<N, T> &Vector);
+
+	/**
+	 * @brief Get a normalized (unit) vector from a given vector.
+	 *
+	 * @param Vector The vector to normalize.
+	 * @return The normalized vector.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> GetNormalized(const FVector<N, T> &Vector);
+
+	/**
+	 * @brief Calculate the dot product of two vectors.
+	 *
+	 * @param A The first vector.
+	 * @param B The second vector.
+	 * @return The dot product of the two vectors.
+	 */
+	template <int32 N, FloatingPoint T>
+	T Dot(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Calculate the distance between two vectors.
+	 *
+	 * @param A The first vector.
+	 * @param B The second vector.
+	 * @return The distance between the two vectors.
+	 */
+	template <int32 N, FloatingPoint T>
+	T Distance(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Calculate the squared distance between two vectors.
+	 *
+	 * @param A The first vector.
+	 * @param B The second vector.
+	 * @return The squared distance between the two vectors.
+	 */
+	template <int32 N, FloatingPoint T>
+	T DistanceSquared(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Projects vector A onto vector B.
+	 *
+	 * @param A The vector to be projected.
+	 * @param B The vector onto which A will be projected.
+	 * @return The projected vector.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Project(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Rejects vector A from vector B: A minus its projection onto B.
+	 *
+	 * @param A The vector to be rejected.
+	 * @param B The vector from which A will be rejected.
+	 * @return The rejected vector.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Reject(const FVector<N, T> &A, const FVector<N, T> &B);
+
+	/**
+	 * @brief Linearly interpolate between two vectors.
+	 *
+	 * @param A The vector at Alpha = 0.
+	 * @param B The vector at Alpha = 1.
+	 * @param Alpha The interpolation parameter; values outside [0, 1] extrapolate.
+	 * @return A + (B - A) * Alpha.
+	 */
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Lerp(const FVector<N, T> &A, const FVector<N, T> &B, const T Alpha);
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+// external includes
+#include <functional>
+#include <span>
+
+// internal includes
+#include "AlignedBuffer.h"
+#include "Platform.h"
+#include "Types.h"
+#include "VectorFile.h"
+#include "VectorTraits.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Producer of vector chunks for FVectorPipeline.
+	 *
+	 * @tparam VectorType The vector type produced.
+	 */
+	template <typename VectorType>
+	class IVectorSource
+	{
+	public:
+		virtual ~IVectorSource() = default;
+
+		/**
+		 * @brief Fill a chunk with the next vectors of the stream.
+		 *
+		 * @param OutChunk The chunk to fill.
+		 * @return The number of vectors written to the chunk, 0 at the end of the stream.
+		 */
+		virtual uint64 Read(std::span<VectorType> OutChunk) = 0;
+	};
+
+	/**
+	 * @brief Consumer of vector chunks for FVectorPipeline.
+	 *
+	 * @tparam VectorType The vector type consumed.
+	 */
+	template <typename VectorType>
+	class IVectorSink
+	{
+	public:
+		virtual ~IVectorSink() = default;
+
+		/**
+		 * @brief Consume a processed chunk.
+		 *
+		 * @param Chunk The vectors to consume.
+		 * @return true on success, false to abort the pipeline.
+		 */
+		virtual bool Write(std::span<const VectorType> Chunk) = 0;
+	};
+
+	/**
+	 * @brief Source reading an AoS or SoA vector file through its memory mapping.
+	 */
+	template <typename VectorType>
+	class FVectorFileSource final : public IVectorSource<VectorType>
+	{
+	public:
+		/**
+		 * @brief Constructor that reads from an open file. The reader must outlive the source.
+		 *
+		 * @param InReader The file to read.
+		 */
+		explicit FVectorFileSource(const FVectorFileReader &InReader);
+
+		uint64 Read(std::span<VectorType> OutChunk) override;
+
+	private:
+		const FVectorFileReader &Reader;
+		uint64 Position = 0;
+	};
+
+	/**
+	 * @brief Sink appending to a vector file writer.
+	 */
+	template <typename VectorType>
+	class FVectorFileSink final : public IVectorSink<VectorType>
+	{
+	public:
+		/**
+		 * @brief Constructor that appends to an open writer. The writer must outlive the sink.
+		 *
+		 * @param InWriter The file to write.
+		 */
+		explicit FVectorFileSink(FVectorFileWriter<VectorType> &InWriter);
+
+		bool Write(std::span<const VectorType> Chunk) override;
+
+	private:
+		FVectorFileWriter<VectorType> &Writer;
+	};
+
+	/**
+	 * @brief Operation applied by a pipeline stage to every vector.
+	 */
+	enum class EVectorPipelineOp : uint8
+	{
+		Scale,	   // V * Scalar
+		Translate, // V + Operand
+		Normalize, // V / |V|
+		Project,   // Projection of V onto Operand
+		Reject,	   // V minus its projection onto Operand
+		Custom	   // User function over a whole sub-chunk
+	};
+
+	/**
+	 * @brief Timing and volume of a pipeline run.
+	 */
+	struct FVectorPipelineStats
+	{
+		uint64 ElementCount = 0; // Vectors processed
+		uint64 ChunkCount = 0;	 // Chunks processed
+		uint64 BytesRead = 0;	 // Bytes produced by the source
+		uint64 BytesWritten = 0; // Bytes consumed by the sink
+		double Seconds = 0;		 // Wall-clock duration of the run
+		bool bSucceeded = false; // false if the sink aborted
+
+		/**
+		 * @brief Get the end-to-end throughput, counting bytes both read and written.
+		 *
+		 * @return The throughput in GB/s (10^9 bytes per second).
+		 */
+		double GetThroughputGBs() const;
+	};
+
+	/**
+	 * @brief Out-of-core processing pipeline: reads chunks, runs a chain of batched operations, writes chunks.
+	 *
+	 * Chunks rotate through a fixed ring of buffers. A dedicated I/O thread reads ahead and writes behind
+	 * while the calling thread and the worker pool process the current chunk, so memory use is bounded by
+	 * BufferCount * ChunkSize vectors regardless of the input size.
+	 *
+	 * @tparam VectorType FVector2D, FVector3D or FVector4D.
+	 */
+	template <typename VectorType>
+	class FVectorPipeline
+	{
+	public:
+		using ScalarType = typename TVectorTraits<VectorType>::ScalarType;
+		using FCustomFunction = std::function<void(std::span<VectorType>)>;
+
+		static constexpr int32 BufferCount = 3; // One chunk each being read, processed and written
+
+		/**
+		 * @brief Constructor that sets the chunk size.
+		 *
+		 * @param InChunkSize The number of vectors per chunk.
+		 * @param InAllocator The allocator the chunk buffers are taken from.
+		 */
+		explicit FVectorPipeline(const uint64 InChunkSize = 1 << 16, Memory::FAllocator &InAllocator = Memory::GetDefaultAllocator());
+
+		/**
+		 * @brief Append a stage multiplying every vector by a scalar.
+		 */
+		FVectorPipeline &Scale(const ScalarType Scalar);
+
+		/**
+		 * @brief Append a stage adding an offset to every vector.
+		 */
+		FVectorPipeline &Translate(const VectorType &Offset);
+
+		/**
+		 * @brief Append a stage normalizing every vector.
+		 */
+		FVectorPipeline &Normalize();
+
+		/**
+		 * @brief Append a stage projecting every vector onto a direction.
+		 */
+		FVectorPipeline &Project(const VectorType &Direction);
+
+		/**
+		 * @brief Append a stage removing the component of every vector along a direction.
+		 */
+		FVectorPipeline &Reject(const VectorType &Direction);
+
+		/**
+		 * @brief Append a user stage. It is called concurrently on disjoint sub-chunks.
+		 *
+		 * @param Function The function to apply in place.
+		 */
+		FVectorPipeline &Custom(FCustomFunction Function);
+
+		/**
+		 * @brief Remove all stages.
+		 */
+		void ClearStages();
+
+		/**
+		 * @brief Stream the source through every stage into the sink.
+		 *
+		 * @param Source The producer of input chunks.
+		 * @param Sink The consumer of output chunks.
+		 * @return Volume and timing of the run.
+		 */
+		FVectorPipelineStats Run(IVectorSource<VectorType> &Source, IVectorSink<VectorType> &Sink);
+
+	private:
+		struct FStage
+		{
+			EVectorPipelineOp Op;
+			VectorType Operand;
+			ScalarType Scalar;
+			FCustomFunction Function;
+		};
+
+		void Process(std::span<VectorType> Chunk) const;
+
+		Memory::FAlignedBuffer<FStage> Stages;
+		Memory::FAlignedBuffer<VectorType, CacheLineSize> Buffers;
+		uint64 ChunkSize;
+	};
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+// external includes
+#include <span>
+
+// internal includes
+#include "Platform.h"
+#include "SymmetricMatrix3x3.h"
+#include "Types.h"
+#include "VectorTraits.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Summation algorithm of the reductions.
+	 *
+	 * Large inputs are always split into fixed partitions whose partial results are combined as a tree,
+	 * so results do not depend on the number of worker threads.
+	 */
+	enum class ESummation : uint8
+	{
+		Fast,	 // Several independent accumulators per component; error grows linearly with the partition size
+		Kahan,	 // Compensated summation; error independent of the input size, about 4x the arithmetic of Fast
+		Pairwise // Recursive halving down to small blocks; error grows logarithmically, close to Fast in speed
+	};
+
+	/**
+	 * @brief Axis-aligned bounds of a set of vectors.
+	 */
+	template <typename VectorType>
+	struct FBounds
+	{
+		VectorType Min; // Component-wise minimum
+		VectorType Max; // Component-wise maximum
+	};
+
+	/**
+	 * @brief Sum the vectors of an array.
+	 *
+	 * @param Vectors The vectors to sum.
+	 * @param Summation The summation algorithm.
+	 * @return The sum; the zero vector for an empty array.
+	 */
+	template <typename VectorType>
+	VectorType Sum(std::span<const VectorType> Vectors, const ESummation Summation = ESummation::Fast);
+
+	/**
+	 * @brief Average the vectors of an array, e.g. the centroid of a point cloud.
+	 *
+	 * @param Vectors The vectors to average.
+	 * @param Summation The summation algorithm.
+	 * @return The mean; the zero vector for an empty array.
+	 */
+	template <typename VectorType>
+	VectorType Mean(std::span<const VectorType> Vectors, const ESummation Summation = ESummation::Fast);
+
+	/**
+	 * @brief Get the component-wise minimum of an array.
+	 *
+	 * @param Vectors The vectors to scan.
+	 * @return The minimum; every component is the largest finite value for an empty array.
+	 */
+	template <typename VectorType>
+	VectorType ComponentMin(std::span<const VectorType> Vectors);
+
+	/**
+	 * @brief Get the component-wise maximum of an array.
+	 *
+	 * @param Vectors The vectors to scan.
+	 * @return The maximum; every component is the lowest finite value for an empty array.
+	 */
+	template <typename VectorType>
+	VectorType ComponentMax(std::span<const VectorType> Vectors);
+
+	/**
+	 * @brief Get the axis-aligned bounds of an array in a single pass.
+	 *
+	 * @param Vectors The vectors to scan.
+	 * @return The bounds; inverted (Min above Max) for an empty array, so merging with it is a no-op.
+	 */
+	template <typename VectorType>
+	FBounds<VectorType> Bounds(std::span<const VectorType> Vectors);
+
+	/**
+	 * @brief Compute the covariance matrix of a point set, e.g. for PCA.
+	 *
+	 * Uses two passes, the mean first and then the centered outer products, which avoids the cancellation
+	 * of the one-pass formula for point sets far from the origin.
+	 *
+	 * @param Points The points.
+	 * @param Summation The summation algorithm used by both passes.
+	 * @return The population covariance (divided by the point count); zero for an empty array.
+	 */
+	template <FloatingPoint T>
+	FSymmetricMatrix3x3<T> Covariance3x3(std::span<const FVector3D<T>> Points, const ESummation Summation = ESummation::Fast);
+}
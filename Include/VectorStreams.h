@@ -0,0 +1,129 @@
+#pragma once
+
+// external includes
+#include <span>
+#include <type_traits>
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Structure-of-arrays view of 2D vectors: one contiguous stream per component.
+	 *
+	 * @tparam T The floating-point type of the components, const-qualified for read-only views.
+	 */
+	template <FloatingPoint T>
+	struct FVector2DStreams
+	{
+		std::span<T> X;
+		std::span<T> Y;
+
+		/**
+		 * @brief Get the number of vectors.
+		 */
+		int64 Num() const
+		{
+			return static_cast<int64>(X.size());
+		}
+
+		/**
+		 * @brief Check that the two streams have the same length.
+		 */
+		bool IsValid() const
+		{
+			return Y.size() == X.size();
+		}
+
+		/**
+		 * @brief Conversion to a read-only view.
+		 */
+		operator FVector2DStreams<const T>() const
+			requires(!std::is_const_v<T>)
+		{
+			return {X, Y};
+		}
+	};
+
+	/**
+	 * @brief Structure-of-arrays view of 3D vectors: one contiguous stream per component.
+	 *
+	 * Kernels over many vectors read and write these views so that every component loads into SIMD
+	 * registers with plain contiguous accesses. The streams must all have the same length.
+	 *
+	 * @tparam T The floating-point type of the components, const-qualified for read-only views.
+	 */
+	template <FloatingPoint T>
+	struct FVector3DStreams
+	{
+		std::span<T> X;
+		std::span<T> Y;
+		std::span<T> Z;
+
+		/**
+		 * @brief Get the number of vectors.
+		 */
+		int64 Num() const
+		{
+			return static_cast<int64>(X.size());
+		}
+
+		/**
+		 * @brief Check that the three streams have the same length.
+		 */
+		bool IsValid() const
+		{
+			return Y.size() == X.size() && Z.size() == X.size();
+		}
+
+		/**
+		 * @brief Conversion to a read-only view.
+		 */
+		operator FVector3DStreams<const T>() const
+			requires(!std::is_const_v<T>)
+		{
+			return {X, Y, Z};
+		}
+	};
+
+	/**
+	 * @brief Structure-of-arrays view of 4D vectors: one contiguous stream per component.
+	 *
+	 * @tparam T The floating-point type of the components, const-qualified for read-only views.
+	 */
+	template <FloatingPoint T>
+	struct FVector4DStreams
+	{
+		std::span<T> X;
+		std::span<T> Y;
+		std::span<T> Z;
+		std::span<T> W;
+
+		/**
+		 * @brief Get the number of vectors.
+		 */
+		int64 Num() const
+		{
+			return static_cast<int64>(X.size());
+		}
+
+		/**
+		 * @brief Check that the four streams have the same length.
+		 */
+		bool IsValid() const
+		{
+			return Y.size() == X.size() && Z.size() == X.size() && W.size() == X.size();
+		}
+
+		/**
+		 * @brief Conversion to a read-only view.
+		 */
+		operator FVector4DStreams<const T>() const
+			requires(!std::is_const_v<T>)
+		{
+			return {X, Y, Z, W};
+		}
+	};
+}
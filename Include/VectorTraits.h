@@ -0,0 +1,26 @@
+#pragma once
+
+// internal includes
+#include "Platform.h"
+#include "Types.h"
+#include "Vector2D.h"
+#include "Vector3D.h"
+#include "Vector4D.h"
+
+namespace Ratchet
+{
+	/**
+	 * @brief Compile-time description of a vector type, used by algorithms templated over the vector type.
+	 *
+	 * @tparam VectorType The vector type to describe.
+	 */
+	template <typename VectorType>
+	struct TVectorTraits;
+
+	template <int32 N, FloatingPoint T>
+	struct TVectorTraits<FVector<N, T>>
+	{
+		using ScalarType = T;
+		static constexpr int32 Dimension = N;
+	};
+}
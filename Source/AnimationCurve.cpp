@@ -0,0 +1,461 @@
+#include "AnimationCurve.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Samples evaluated side by side; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Samples per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 1024;
+
+		// Coefficients per segment: constant, linear, quadratic and cubic vectors
+		constexpr int32 SegmentStride = 12;
+
+		// What an empty curve evaluates with
+		template <typename T>
+		constexpr T ZeroCoefficients[SegmentStride] = {};
+
+		/**
+		 * Writes the power-form coefficients of the cubic Hermite segment from P0 with derivative M0 to P1 with
+		 * derivative M1, the derivatives already scaled to the segment parameter.
+		 */
+		template <typename T>
+		void SetHermite(const FVector3D<T> &P0, const FVector3D<T> &M0, const FVector3D<T> &P1, const FVector3D<T> &M1, T *Out)
+		{
+			const FVector3D<T> C = P0 * T(-3) - M0 * T(2) + P1 * T(3) - M1;
+			const FVector3D<T> D = P0 * T(2) + M0 - P1 * T(2) + M1;
+			const FVector3D<T> Terms[4] = {P0, M0, C, D};
+			for (int32 k = 0; k < 4; ++k)
+			{
+				Out[3 * k + 0] = Terms[k].GetX();
+				Out[3 * k + 1] = Terms[k].GetY();
+				Out[3 * k + 2] = Terms[k].GetZ();
+			}
+		}
+
+		template <typename T>
+		FVector3D<T> EvaluateSegment(const T *Coefficients, const T U)
+		{
+			FVector3D<T> Result;
+			for (int32 c = 0; c < 3; ++c)
+				Result[c] = Coefficients[c] + U * (Coefficients[3 + c] + U * (Coefficients[6 + c] + U * Coefficients[9 + c]));
+			return Result;
+		}
+
+		// Derivative with respect to the segment parameter
+		template <typename T>
+		FVector3D<T> EvaluateSegmentDerivative(const T *Coefficients, const T U)
+		{
+			FVector3D<T> Result;
+			for (int32 c = 0; c < 3; ++c)
+				Result[c] = Coefficients[3 + c] + U * (T(2) * Coefficients[6 + c] + U * T(3) * Coefficients[9 + c]);
+			return Result;
+		}
+
+		/**
+		 * Finds the segment of Time starting from Hint, updates Hint and returns the segment's coefficients and
+		 * the clamped segment parameter.
+		 */
+		template <typename T>
+		const T *Locate(const FVector3DCurve<T> &Curve, const T Time, int32 &Hint, T &U)
+		{
+			if (Curve.GetKeyCount() == 0)
+			{
+				U = 0;
+				return ZeroCoefficients<T>;
+			}
+
+			Hint = Curve.FindSegment(Time, Hint);
+			U = std::clamp((Time - Curve.GetTimes()[Hint]) * Curve.GetInverseDuration(Hint), T(0), T(1));
+			return Curve.GetCoefficients(Hint);
+		}
+
+		/**
+		 * Evaluates the gathered segments of LaneCount samples and stores the first Count of them from Begin on.
+		 */
+		template <typename T>
+		void EvaluateLanes(const T *const (&Coefficients)[LaneCount], const T (&U)[LaneCount], const FVector3DStreams<T> &Out,
+						   const int64 Begin, const int32 Count)
+		{
+			T Gathered[SegmentStride][LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				for (int32 k = 0; k < SegmentStride; ++k)
+					Gathered[k][Lane] = Coefficients[Lane][k];
+			}
+
+			T *const Streams[3] = {Out.X.data(), Out.Y.data(), Out.Z.data()};
+			for (int32 c = 0; c < 3; ++c)
+			{
+				T Values[LaneCount];
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Values[Lane] = Gathered[c][Lane] + U[Lane] * (Gathered[3 + c][Lane] + U[Lane] * (Gathered[6 + c][Lane] + U[Lane] * Gathered[9 + c][Lane]));
+				for (int32 Lane = 0; Lane < Count; ++Lane)
+					Streams[c][Begin + Lane] = Values[Lane];
+			}
+		}
+	}
+
+	template <FloatingPoint T>
+	FVector3DCurve<T>::FVector3DCurve(Memory::FAllocator &InAllocator)
+		: Times(InAllocator), InverseDurations(InAllocator), Coefficients(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	bool FVector3DCurve<T>::SetKeys(const ECurveInterpolation Interpolation, std::span<const T> InTimes, std::span<const FVector3D<T>> Values,
+									std::span<const FVector3D<T>> Controls)
+	{
+		const int32 KeyCount = static_cast<int32>(InTimes.size());
+		if (KeyCount == 0 || Values.size() != InTimes.size())
+			return false;
+		for (int32 Key = 0; Key + 1 < KeyCount; ++Key)
+		{
+			if (!(InTimes[Key] < InTimes[Key + 1]))
+				return false;
+		}
+		if (Interpolation == ECurveInterpolation::Hermite && static_cast<int32>(Controls.size()) != KeyCount)
+			return false;
+		if (Interpolation == ECurveInterpolation::Bezier && static_cast<int32>(Controls.size()) != 2 * (KeyCount - 1))
+			return false;
+
+		const int32 SegmentCount = std::max(KeyCount - 1, 1);
+		Times.Resize(KeyCount);
+		InverseDurations.Resize(SegmentCount);
+		Coefficients.Resize(static_cast<size_t>(SegmentCount) * SegmentStride);
+		std::copy(InTimes.begin(), InTimes.end(), Times.GetData());
+
+		if (KeyCount == 1)
+		{
+			InverseDurations[0] = 0;
+			SetHermite(Values[0], FVector3D<T>(), Values[0], FVector3D<T>(), Coefficients.GetData());
+			return true;
+		}
+
+		// Catmull-Rom tangent of a key: the slope between its neighbours, one-sided at the ends
+		const auto Tangent = [&InTimes, &Values, KeyCount](const int32 Key)
+		{
+			const int32 Previous = std::max(Key - 1, 0);
+			const int32 Next = std::min(Key + 1, KeyCount - 1);
+			return (Values[Next] - Values[Previous]) / (InTimes[Next] - InTimes[Previous]);
+		};
+
+		for (int32 Segment = 0; Segment < SegmentCount; ++Segment)
+		{
+			const T Duration = InTimes[Segment + 1] - InTimes[Segment];
+			const FVector3D<T> &P0 = Values[Segment];
+			const FVector3D<T> &P1 = Values[Segment + 1];
+			T *const Out = Coefficients.GetData() + static_cast<size_t>(Segment) * SegmentStride;
+			InverseDurations[Segment] = T(1) / Duration;
+
+			switch (Interpolation)
+			{
+			case ECurveInterpolation::Linear:
+				SetHermite(P0, P1 - P0, P1, P1 - P0, Out);
+				break;
+			case ECurveInterpolation::Hermite:
+				SetHermite(P0, Controls[Segment] * Duration, P1, Controls[Segment + 1] * Duration, Out);
+				break;
+			case ECurveInterpolation::CatmullRom:
+				SetHermite(P0, Tangent(Segment) * Duration, P1, Tangent(Segment + 1) * Duration, Out);
+				break;
+			case ECurveInterpolation::Bezier:
+				// A Bezier segment leaves P0 along 3 (C0 - P0) and arrives at P1 along 3 (P1 - C1)
+				SetHermite(P0, (Controls[2 * Segment] - P0) * T(3), P1, (P1 - Controls[2 * Segment + 1]) * T(3), Out);
+				break;
+			}
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FVector3DCurve<T>::Evaluate(const T Time) const
+	{
+		int32 Segment = 0;
+		return Evaluate(Time, Segment);
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FVector3DCurve<T>::Evaluate(const T Time, int32 &InOutSegment) const
+	{
+		T U;
+		const T *const Segment = Locate(*this, Time, InOutSegment, U);
+		return EvaluateSegment(Segment, U);
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FVector3DCurve<T>::EvaluateDerivative(const T Time) const
+	{
+		if (Times.Num() < 2 || Time < GetStartTime() || Time > GetEndTime())
+			return FVector3D<T>();
+
+		int32 Segment = 0;
+		T U;
+		const T *const Coefficients = Locate(*this, Time, Segment, U);
+		return EvaluateSegmentDerivative(Coefficients, U) * InverseDurations[Segment];
+	}
+
+	template <FloatingPoint T>
+	bool FVector3DCurve<T>::EvaluateMany(std::span<const T> InTimes, const FVector3DStreams<T> &Out) const
+	{
+		const int64 Count = static_cast<int64>(InTimes.size());
+		if (!Out.IsValid() || Out.Num() != Count)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(CurveEvaluateMany, Count);
+
+		Parallel::ParallelFor(Count, BatchSize, [this, InTimes, &Out](const int64 Begin, const int64 End)
+							  {
+								  int32 Hint = 0;
+								  for (int64 Sample = Begin; Sample < End; Sample += LaneCount)
+								  {
+									  const int32 Valid = static_cast<int32>(std::min<int64>(LaneCount, End - Sample));
+									  const T *Segments[LaneCount];
+									  T U[LaneCount];
+									  for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+										  Segments[Lane] = Locate(*this, InTimes[Sample + std::min(Lane, Valid - 1)], Hint, U[Lane]);
+									  EvaluateLanes(Segments, U, Out, Sample, Valid);
+								  } });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	int32 FVector3DCurve<T>::GetKeyCount() const
+	{
+		return static_cast<int32>(Times.Num());
+	}
+
+	template <FloatingPoint T>
+	int32 FVector3DCurve<T>::GetSegmentCount() const
+	{
+		return static_cast<int32>(InverseDurations.Num());
+	}
+
+	template <FloatingPoint T>
+	T FVector3DCurve<T>::GetStartTime() const
+	{
+		return Times.Num() > 0 ? Times[0] : T(0);
+	}
+
+	template <FloatingPoint T>
+	T FVector3DCurve<T>::GetEndTime() const
+	{
+		return Times.Num() > 0 ? Times[Times.Num() - 1] : T(0);
+	}
+
+	template <FloatingPoint T>
+	std::span<const T> FVector3DCurve<T>::GetTimes() const
+	{
+		return {Times.GetData(), Times.Num()};
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FVector3DCurve<T>::GetKeyValue(const int32 Key) const
+	{
+		// The last key is the end of the last segment, every other key the start of its own
+		const int32 SegmentCount = GetSegmentCount();
+		return Key < SegmentCount ? EvaluateSegment(GetCoefficients(Key), T(0)) : EvaluateSegment(GetCoefficients(SegmentCount - 1), T(1));
+	}
+
+	template <FloatingPoint T>
+	int32 FVector3DCurve<T>::FindSegment(const T Time, const int32 Hint) const
+	{
+		const int32 SegmentCount = GetSegmentCount();
+		const T *const Keys = Times.GetData();
+		const auto Contains = [Keys, SegmentCount, Time](const int32 Segment)
+		{
+			return (Segment == 0 || Keys[Segment] <= Time) && (Segment == SegmentCount - 1 || Time < Keys[Segment + 1]);
+		};
+
+		// Monotonic sampling stays in the hinted segment or moves to the next one
+		const int32 Start = std::clamp(Hint, 0, SegmentCount - 1);
+		if (Contains(Start))
+			return Start;
+		if (Start + 1 < SegmentCount && Contains(Start + 1))
+			return Start + 1;
+
+		const int32 Upper = static_cast<int32>(std::upper_bound(Keys, Keys + Times.Num(), Time) - Keys);
+		return std::clamp(Upper - 1, 0, SegmentCount - 1);
+	}
+
+	template <FloatingPoint T>
+	const T *FVector3DCurve<T>::GetCoefficients(const int32 Segment) const
+	{
+		return Coefficients.GetData() + static_cast<size_t>(Segment) * SegmentStride;
+	}
+
+	template <FloatingPoint T>
+	T FVector3DCurve<T>::GetInverseDuration(const int32 Segment) const
+	{
+		return InverseDurations[Segment];
+	}
+
+	template <FloatingPoint T>
+	bool EvaluateCurves(std::type_identity_t<std::span<const FVector3DCurve<T>>> Curves, const std::type_identity_t<T> Time, std::span<int32> InOutSegments,
+						const FVector3DStreams<T> &Out)
+	{
+		const int64 Count = static_cast<int64>(Curves.size());
+		if (static_cast<int64>(InOutSegments.size()) != Count || !Out.IsValid() || Out.Num() != Count)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(CurveEvaluateCurves, Count);
+
+		Parallel::ParallelFor(Count, BatchSize, [Curves, Time, InOutSegments, &Out](const int64 Begin, const int64 End)
+							  {
+								  for (int64 Curve = Begin; Curve < End; Curve += LaneCount)
+								  {
+									  const int32 Valid = static_cast<int32>(std::min<int64>(LaneCount, End - Curve));
+									  const T *Segments[LaneCount];
+									  T U[LaneCount];
+									  for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+									  {
+										  // Unused lanes repeat the last curve on a copy of its hint
+										  const int64 Index = Curve + std::min(Lane, Valid - 1);
+										  int32 Hint = InOutSegments[Index];
+										  Segments[Lane] = Locate(Curves[Index], Time, Hint, U[Lane]);
+										  if (Lane < Valid)
+											  InOutSegments[Index] = Hint;
+									  }
+									  EvaluateLanes(Segments, U, Out, Curve, Valid);
+								  } });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	FVector3DCurve<T> CompressCurve(const FVector3DCurve<T> &Source, const T Tolerance, const int32 SamplesPerSegment, Memory::FAllocator &InAllocator)
+	{
+		FVector3DCurve<T> Result(InAllocator);
+		const int32 KeyCount = Source.GetKeyCount();
+		if (KeyCount == 0)
+			return Result;
+
+		const T *const Times = Source.Times.GetData();
+		const T SquaredTolerance = Tolerance * Tolerance;
+		const int32 Samples = std::max(SamplesPerSegment, 0);
+
+		// One-sided derivatives at the keys, per time unit, so the kept keys reproduce any kink of the source
+		const auto Outgoing = [&Source](const int32 Key)
+		{
+			return EvaluateSegmentDerivative(Source.GetCoefficients(Key), T(0)) * Source.GetInverseDuration(Key);
+		};
+		const auto Incoming = [&Source](const int32 Key)
+		{
+			return EvaluateSegmentDerivative(Source.GetCoefficients(Key - 1), T(1)) * Source.GetInverseDuration(Key - 1);
+		};
+
+		// The cubic joining two kept keys; joining neighbouring keys reproduces the source segment exactly
+		const auto Join = [&Source, &Outgoing, &Incoming, Times](const int32 First, const int32 Last, T *Out)
+		{
+			const T Duration = Times[Last] - Times[First];
+			SetHermite(Source.GetKeyValue(First), Outgoing(First) * Duration, Source.GetKeyValue(Last), Incoming(Last) * Duration, Out);
+		};
+
+		// Split the key ranges at their worst key until every range is within the tolerance
+		Memory::FAlignedBuffer<uint8> Kept(static_cast<size_t>(KeyCount), InAllocator);
+		std::fill(Kept.GetData(), Kept.GetData() + KeyCount, uint8(0));
+		Kept[0] = 1;
+		Kept[KeyCount - 1] = 1;
+
+		Memory::FAlignedBuffer<int32> Ranges(InAllocator);
+		if (KeyCount > 2)
+		{
+			Ranges.Add(0);
+			Ranges.Add(KeyCount - 1);
+		}
+		while (Ranges.Num() > 0)
+		{
+			const int32 Last = Ranges[Ranges.Num() - 1];
+			const int32 First = Ranges[Ranges.Num() - 2];
+			Ranges.Resize(Ranges.Num() - 2);
+
+			T Joined[SegmentStride];
+			Join(First, Last, Joined);
+			const T InverseDuration = T(1) / (Times[Last] - Times[First]);
+
+			T WorstError = SquaredTolerance;
+			int32 Split = -1;
+			for (int32 Segment = First; Segment < Last; ++Segment)
+			{
+				// The segment's start key, then its interior samples; a failing sample splits at the nearer key
+				// that is inside the range
+				for (int32 Sample = 0; Sample <= Samples; ++Sample)
+				{
+					const T Alpha = T(Sample) / T(Samples + 1);
+					const T Time = Times[Segment] + (Times[Segment + 1] - Times[Segment]) * Alpha;
+					const FVector3D<T> Reference = EvaluateSegment(Source.GetCoefficients(Segment), Alpha);
+					const T Error = DistanceSquared(EvaluateSegment(Joined, (Time - Times[First]) * InverseDuration), Reference);
+					if (Error > WorstError)
+					{
+						WorstError = Error;
+						Split = (Alpha < T(0.5) && Segment > First) || Segment + 1 == Last ? Segment : Segment + 1;
+					}
+				}
+			}
+
+			if (Split > First && Split < Last)
+			{
+				Kept[Split] = 1;
+				if (Split - First > 1)
+				{
+					Ranges.Add(First);
+					Ranges.Add(Split);
+				}
+				if (Last - Split > 1)
+				{
+					Ranges.Add(Split);
+					Ranges.Add(Last);
+				}
+			}
+		}
+
+		int32 KeptCount = 0;
+		for (int32 Key = 0; Key < KeyCount; ++Key)
+			KeptCount += Kept[Key];
+
+		const int32 SegmentCount = std::max(KeptCount - 1, 1);
+		Result.Times.Resize(KeptCount);
+		Result.InverseDurations.Resize(SegmentCount);
+		Result.Coefficients.Resize(static_cast<size_t>(SegmentCount) * SegmentStride);
+		if (KeyCount == 1)
+		{
+			Result.Times[0] = Times[0];
+			Result.InverseDurations[0] = 0;
+			std::copy(Source.GetCoefficients(0), Source.GetCoefficients(0) + SegmentStride, Result.Coefficients.GetData());
+			return Result;
+		}
+
+		int32 Previous = 0;
+		int32 Segment = 0;
+		Result.Times[0] = Times[0];
+		for (int32 Key = 1; Key < KeyCount; ++Key)
+		{
+			if (Kept[Key] == 0)
+				continue;
+			Join(Previous, Key, Result.Coefficients.GetData() + static_cast<size_t>(Segment) * SegmentStride);
+			Result.InverseDurations[Segment] = T(1) / (Times[Key] - Times[Previous]);
+			Result.Times[++Segment] = Times[Key];
+			Previous = Key;
+		}
+		return Result;
+	}
+
+	// Explicit instantiation for float
+	template class FVector3DCurve<float>;
+	template bool EvaluateCurves<float>(std::span<const FVector3DCurve<float>> Curves, const float Time, std::span<int32> InOutSegments,
+										const FVector3DStreams<float> &Out);
+	template FVector3DCurve<float> CompressCurve(const FVector3DCurve<float> &Source, const float Tolerance, const int32 SamplesPerSegment,
+												 Memory::FAllocator &InAllocator);
+
+	// Explicit instantiation for double
+	template class FVector3DCurve<double>;
+	template bool EvaluateCurves<double>(std::span<const FVector3DCurve<double>> Curves, const double Time, std::span<int32> InOutSegments,
+										 const FVector3DStreams<double> &Out);
+	template FVector3DCurve<double> CompressCurve(const FVector3DCurve<double> &Source, const double Tolerance, const int32 SamplesPerSegment,
+												  Memory::FAllocator &InAllocator);
+}
@@ -0,0 +1,779 @@
+#include "Collision.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Iteration limits; GJK converges in a handful of iterations on smooth shapes and exactly on polytopes
+		constexpr int32 GJKMaxIterations = 64;
+		constexpr int32 EPAMaxIterations = 64;
+
+		// EPA polytope capacity, enough for every iteration to add a vertex
+		constexpr int32 EPAMaxVertices = 4 + EPAMaxIterations;
+		constexpr int32 EPAMaxFaces = 2 * EPAMaxVertices;
+
+		// GJK stops when the distance bounds agree to this relative precision
+		template <FloatingPoint T>
+		constexpr T GJKRelativeTolerance = T(1000) * std::numeric_limits<T>::epsilon();
+
+		// The cores touch when the closest simplex point is this close to the origin, relative to the simplex size
+		template <FloatingPoint T>
+		constexpr T GJKContactTolerance = T(100) * std::numeric_limits<T>::epsilon();
+
+		// EPA stops when the support along the closest face normal gets this close to the face, relative to the polytope size
+		template <FloatingPoint T>
+		constexpr T EPATolerance = T(10000) * std::numeric_limits<T>::epsilon();
+
+		// A new EPA vertex sees a face when it is above the face by more than rounding error, relative to the polytope size,
+		// so that a vertex on the plane of coplanar faces leaves them all in place
+		template <FloatingPoint T>
+		constexpr T EPAVisibilityTolerance = T(64) * std::numeric_limits<T>::epsilon();
+
+		/**
+		 * @brief Vertices of a GJK simplex in the Minkowski difference A - B, with the shape points and search
+		 *        directions that produced them.
+		 */
+		template <FloatingPoint T>
+		struct FSimplex
+		{
+			FVector3D<T> W[4];
+			FVector3D<T> A[4];
+			FVector3D<T> B[4];
+			FVector3D<T> Directions[4];
+			T Weights[4]; // Barycentric coordinates of the point closest to the origin
+			int32 Count = 0;
+		};
+
+		template <FloatingPoint T>
+		T SquaredLength(const FVector3D<T> &Vector)
+		{
+			return Dot(Vector, Vector);
+		}
+
+		template <FloatingPoint T>
+		void AddSupport(FSimplex<T> &Simplex, const FSupportFunction<T> &SupportA, const FSupportFunction<T> &SupportB, const FVector3D<T> &Direction)
+		{
+			const int32 i = Simplex.Count++;
+			Simplex.A[i] = SupportA(Direction);
+			Simplex.B[i] = SupportB(-Direction);
+			Simplex.W[i] = Simplex.A[i] - Simplex.B[i];
+			Simplex.Directions[i] = Direction;
+		}
+
+		/**
+		 * @brief Keep the simplex vertices with the given indices and weights, in that order.
+		 */
+		template <FloatingPoint T>
+		void Reduce(FSimplex<T> &Simplex, const int32 Count, const int32 (&Indices)[4], const T (&Weights)[4])
+		{
+			FSimplex<T> Reduced;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Reduced.W[i] = Simplex.W[Indices[i]];
+				Reduced.A[i] = Simplex.A[Indices[i]];
+				Reduced.B[i] = Simplex.B[Indices[i]];
+				Reduced.Directions[i] = Simplex.Directions[Indices[i]];
+				Reduced.Weights[i] = Weights[i];
+			}
+			Reduced.Count = Count;
+			Simplex = Reduced;
+		}
+
+		/**
+		 * @brief Closest point to the origin on the segment or triangle of the given simplex vertices, as the
+		 *        indices and barycentric weights of the feature it lies on (Ericson, Real-Time Collision Detection 5.1.5).
+		 */
+		template <FloatingPoint T>
+		int32 ClosestOnTriangle(const FVector3D<T> *W, const int32 I0, const int32 I1, const int32 I2, int32 (&Indices)[4], T (&Weights)[4])
+		{
+			const auto SetVertex = [&](const int32 Index)
+			{
+				Indices[0] = Index;
+				Weights[0] = 1;
+				return 1;
+			};
+			const auto SetEdge = [&](const int32 First, const int32 Second, const T Parameter)
+			{
+				Indices[0] = First;
+				Indices[1] = Second;
+				Weights[0] = 1 - Parameter;
+				Weights[1] = Parameter;
+				return 2;
+			};
+
+			const FVector3D<T> AB = W[I1] - W[I0];
+			const FVector3D<T> AC = W[I2] - W[I0];
+			const T D1 = -Dot(AB, W[I0]);
+			const T D2 = -Dot(AC, W[I0]);
+			if (D1 <= 0 && D2 <= 0)
+				return SetVertex(I0);
+
+			const T D3 = -Dot(AB, W[I1]);
+			const T D4 = -Dot(AC, W[I1]);
+			if (D3 >= 0 && D4 <= D3)
+				return SetVertex(I1);
+
+			const T VC = D1 * D4 - D3 * D2;
+			if (VC <= 0 && D1 >= 0 && D3 <= 0)
+				return SetEdge(I0, I1, D1 / (D1 - D3));
+
+			const T D5 = -Dot(AB, W[I2]);
+			const T D6 = -Dot(AC, W[I2]);
+			if (D6 >= 0 && D5 <= D6)
+				return SetVertex(I2);
+
+			const T VB = D5 * D2 - D1 * D6;
+			if (VB <= 0 && D2 >= 0 && D6 <= 0)
+				return SetEdge(I0, I2, D2 / (D2 - D6));
+
+			const T VA = D3 * D6 - D5 * D4;
+			if (VA <= 0 && D4 - D3 >= 0 && D5 - D6 >= 0)
+				return SetEdge(I1, I2, (D4 - D3) / ((D4 - D3) + (D5 - D6)));
+
+			// A degenerate triangle whose regions all failed falls back to its longest edge
+			const T Denominator = VA + VB + VC;
+			if (!(Denominator > 0))
+			{
+				const T Lengths[3] = {SquaredLength(AB), SquaredLength(AC), SquaredLength(W[I2] - W[I1])};
+				const int32 Longest = Lengths[0] >= Lengths[1] ? (Lengths[0] >= Lengths[2] ? 0 : 2) : (Lengths[1] >= Lengths[2] ? 1 : 2);
+				const int32 First = Longest == 2 ? I1 : I0;
+				const int32 Second = Longest == 0 ? I1 : I2;
+				const FVector3D<T> Edge = W[Second] - W[First];
+				const T Length = SquaredLength(Edge);
+				return Length > 0 ? SetEdge(First, Second, std::clamp(-Dot(W[First], Edge) / Length, T(0), T(1))) : SetVertex(First);
+			}
+
+			Indices[0] = I0;
+			Indices[1] = I1;
+			Indices[2] = I2;
+			Weights[1] = VB / Denominator;
+			Weights[2] = VC / Denominator;
+			Weights[0] = 1 - Weights[1] - Weights[2];
+			return 3;
+		}
+
+		/**
+		 * @brief Reduce the simplex to the feature closest to the origin and return that point.
+		 *
+		 * @return true if the simplex is a tetrahedron containing the origin, in which case it is left as is.
+		 */
+		template <FloatingPoint T>
+		bool Solve(FSimplex<T> &Simplex, FVector3D<T> &Closest)
+		{
+			int32 Indices[4] = {0, 1, 2, 3};
+			T Weights[4] = {1, 0, 0, 0};
+			int32 Count = 1;
+
+			if (Simplex.Count == 2)
+			{
+				const FVector3D<T> Edge = Simplex.W[1] - Simplex.W[0];
+				const T Length = SquaredLength(Edge);
+				const T Parameter = Length > 0 ? -Dot(Simplex.W[0], Edge) / Length : T(0);
+				if (Parameter >= 1)
+					Indices[0] = 1;
+				else if (Parameter > 0)
+				{
+					Count = 2;
+					Weights[0] = 1 - Parameter;
+					Weights[1] = Parameter;
+				}
+			}
+			else if (Simplex.Count == 3)
+			{
+				Count = ClosestOnTriangle(Simplex.W, 0, 1, 2, Indices, Weights);
+			}
+			else if (Simplex.Count == 4)
+			{
+				// The origin is outside every face whose plane separates it from the opposite vertex
+				constexpr int32 FaceVertices[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+				const FVector3D<T> *const W = Simplex.W;
+				const T Volume = Dot(W[3] - W[0], Cross(W[1] - W[0], W[2] - W[0]));
+				const T Scale = std::sqrt(std::max({SquaredLength(W[1] - W[0]), SquaredLength(W[2] - W[0]), SquaredLength(W[3] - W[0])}));
+				const bool bFlat = std::abs(Volume) <= GJKContactTolerance<T> * Scale * Scale * Scale;
+
+				T ClosestDistance = std::numeric_limits<T>::infinity();
+				for (const auto &Face : FaceVertices)
+				{
+					const FVector3D<T> Normal = Cross(W[Face[1]] - W[Face[0]], W[Face[2]] - W[Face[0]]);
+					const T OriginSide = -Dot(Normal, W[Face[0]]);
+					const T OppositeSide = Dot(Normal, W[Face[3]] - W[Face[0]]);
+					if (!bFlat && OriginSide * OppositeSide >= 0)
+						continue;
+
+					int32 FaceIndices[4];
+					T FaceWeights[4];
+					const int32 FaceCount = ClosestOnTriangle(W, Face[0], Face[1], Face[2], FaceIndices, FaceWeights);
+					FVector3D<T> Point;
+					for (int32 i = 0; i < FaceCount; ++i)
+						Point += W[FaceIndices[i]] * FaceWeights[i];
+					const T Distance = SquaredLength(Point);
+					if (Distance < ClosestDistance)
+					{
+						ClosestDistance = Distance;
+						Count = FaceCount;
+						std::copy(FaceIndices, FaceIndices + 4, Indices);
+						std::copy(FaceWeights, FaceWeights + 4, Weights);
+					}
+				}
+
+				// Inside: the weights of the origin are the volumes of the tetrahedra it cuts off
+				if (ClosestDistance == std::numeric_limits<T>::infinity())
+				{
+					const FVector3D<T> Origin;
+					Simplex.Weights[0] = Dot(W[3], Cross(W[1], W[2])) / Volume;
+					Simplex.Weights[1] = Dot(W[3] - W[0], Cross(Origin - W[0], W[2] - W[0])) / Volume;
+					Simplex.Weights[2] = Dot(W[3] - W[0], Cross(W[1] - W[0], Origin - W[0])) / Volume;
+					Simplex.Weights[3] = 1 - Simplex.Weights[0] - Simplex.Weights[1] - Simplex.Weights[2];
+					Closest = Origin;
+					return true;
+				}
+			}
+
+			Reduce(Simplex, Count, Indices, Weights);
+			Closest = FVector3D<T>();
+			for (int32 i = 0; i < Simplex.Count; ++i)
+				Closest += Simplex.W[i] * Simplex.Weights[i];
+			return false;
+		}
+
+		template <FloatingPoint T>
+		struct FGJKState
+		{
+			FSimplex<T> Simplex;
+			FVector3D<T> Closest; // Point of the core difference closest to the origin
+			bool bOverlap;		  // The cores intersect, or touch within the tolerance
+			bool bSeparated;	  // Stopped early on a separating axis
+			int32 Iterations;
+		};
+
+		/**
+		 * @brief Run GJK on the cores of A and B.
+		 *
+		 * @param Separation Stop as soon as the cores are known to be further apart than this, or negative to
+		 *        always converge to the distance.
+		 */
+		template <FloatingPoint T>
+		FGJKState<T> RunGJK(const FSupportFunction<T> &SupportA, const FSupportFunction<T> &SupportB, FGJKCache<T> *Cache, const T Separation)
+		{
+			FGJKState<T> State{};
+			FSimplex<T> &Simplex = State.Simplex;
+
+			// Rebuild the cached simplex on the current poses; its vertices can coincide now, so skip duplicates
+			if (Cache && Cache->Count > 0)
+			{
+				for (int32 i = 0; i < std::min(Cache->Count, 4); ++i)
+				{
+					AddSupport(Simplex, SupportA, SupportB, Cache->Directions[i]);
+					for (int32 j = 0; j + 1 < Simplex.Count; ++j)
+					{
+						if (SquaredLength(Simplex.W[j] - Simplex.W[Simplex.Count - 1]) == 0)
+						{
+							--Simplex.Count;
+							break;
+						}
+					}
+				}
+			}
+			else
+			{
+				AddSupport(Simplex, SupportA, SupportB, FVector3D<T>(1, 0, 0));
+			}
+			State.Iterations = Simplex.Count;
+			State.bOverlap = Solve(Simplex, State.Closest);
+
+			while (!State.bOverlap && State.Iterations < GJKMaxIterations)
+			{
+				const T ClosestSquared = SquaredLength(State.Closest);
+				T Size = 0;
+				for (int32 i = 0; i < Simplex.Count; ++i)
+					Size = std::max(Size, SquaredLength(Simplex.W[i]));
+				if (ClosestSquared <= GJKContactTolerance<T> * GJKContactTolerance<T> * Size)
+				{
+					State.bOverlap = true;
+					break;
+				}
+
+				const FVector3D<T> Direction = -State.Closest;
+				const FVector3D<T> A = SupportA(Direction);
+				const FVector3D<T> B = SupportB(State.Closest);
+				const FVector3D<T> W = A - B;
+				++State.Iterations;
+
+				// Dot(Closest, W) / |Closest| is a lower bound of the distance, |Closest| an upper one
+				const T Projection = Dot(State.Closest, W);
+				if (Separation >= 0 && Projection > 0 && Projection * Projection > Separation * Separation * ClosestSquared)
+				{
+					State.bSeparated = true;
+					break;
+				}
+				if (ClosestSquared - Projection <= GJKRelativeTolerance<T> * ClosestSquared)
+					break;
+
+				bool bDuplicate = false;
+				for (int32 i = 0; i < Simplex.Count; ++i)
+					bDuplicate = bDuplicate || SquaredLength(Simplex.W[i] - W) == 0;
+				if (bDuplicate)
+					break;
+
+				const int32 i = Simplex.Count++;
+				Simplex.A[i] = A;
+				Simplex.B[i] = B;
+				Simplex.W[i] = W;
+				Simplex.Directions[i] = Direction;
+
+				const FSimplex<T> Previous = Simplex;
+				const FVector3D<T> PreviousClosest = State.Closest;
+				State.bOverlap = Solve(Simplex, State.Closest);
+
+				// Round-off can stall the descent; keep the better of the two simplices and stop
+				if (!State.bOverlap && SquaredLength(State.Closest) >= ClosestSquared)
+				{
+					Simplex = Previous;
+					--Simplex.Count;
+					State.Closest = PreviousClosest;
+					break;
+				}
+			}
+
+			if (Cache)
+			{
+				Cache->Count = Simplex.Count;
+				std::copy(Simplex.Directions, Simplex.Directions + Simplex.Count, Cache->Directions);
+			}
+			return State;
+		}
+
+		template <FloatingPoint T>
+		void GetWitnessPoints(const FSimplex<T> &Simplex, FVector3D<T> &PointA, FVector3D<T> &PointB)
+		{
+			PointA = FVector3D<T>();
+			PointB = FVector3D<T>();
+			for (int32 i = 0; i < Simplex.Count; ++i)
+			{
+				PointA += Simplex.A[i] * Simplex.Weights[i];
+				PointB += Simplex.B[i] * Simplex.Weights[i];
+			}
+		}
+
+		/**
+		 * @brief Polytope in the core difference that EPA expands towards its boundary closest to the origin.
+		 *        Faces are counterclockwise seen from outside.
+		 */
+		template <FloatingPoint T>
+		struct FPolytope
+		{
+			FVector3D<T> W[EPAMaxVertices];
+			FVector3D<T> A[EPAMaxVertices];
+			FVector3D<T> B[EPAMaxVertices];
+			int32 VertexCount = 0;
+
+			int32 Faces[EPAMaxFaces][3];
+			FVector3D<T> Normals[EPAMaxFaces];
+			T Distances[EPAMaxFaces];
+			int32 FaceCount = 0;
+
+			int32 AddVertex(const FVector3D<T> &InA, const FVector3D<T> &InB)
+			{
+				A[VertexCount] = InA;
+				B[VertexCount] = InB;
+				W[VertexCount] = InA - InB;
+				return VertexCount++;
+			}
+
+			void AddFace(const int32 I0, const int32 I1, const int32 I2)
+			{
+				// Callers check the capacity before they change the polytope; this only keeps a miss in bounds
+				if (FaceCount == EPAMaxFaces)
+					return;
+
+				const FVector3D<T> Normal = Cross(W[I1] - W[I0], W[I2] - W[I0]);
+				const T Length = Magnitude(Normal);
+				Faces[FaceCount][0] = I0;
+				Faces[FaceCount][1] = I1;
+				Faces[FaceCount][2] = I2;
+
+				// A sliver face has no reliable plane; it never becomes the closest face but still closes the surface
+				Normals[FaceCount] = Length > 0 ? Normal / Length : Normal;
+				Distances[FaceCount] = Length > 0 ? Dot(Normals[FaceCount], W[I0]) : std::numeric_limits<T>::infinity();
+				++FaceCount;
+			}
+
+			void RemoveFace(const int32 Face)
+			{
+				--FaceCount;
+				std::copy(Faces[FaceCount], Faces[FaceCount] + 3, Faces[Face]);
+				Normals[Face] = Normals[FaceCount];
+				Distances[Face] = Distances[FaceCount];
+			}
+
+			// The face across the edge Start -> End of another face, -1 if the surface is open there
+			int32 FindNeighbour(const int32 Start, const int32 End) const
+			{
+				for (int32 Face = 0; Face < FaceCount; ++Face)
+				{
+					for (int32 k = 0; k < 3; ++k)
+					{
+						if (Faces[Face][k] == End && Faces[Face][(k + 1) % 3] == Start)
+							return Face;
+					}
+				}
+				return -1;
+			}
+
+			// Whether a point is above a face by more than the tolerance; sliver faces have no plane and always give way
+			bool IsVisible(const int32 Face, const FVector3D<T> &Point, const T Tolerance) const
+			{
+				return Distances[Face] == std::numeric_limits<T>::infinity() || Dot(Normals[Face], Point) - Distances[Face] > Tolerance;
+			}
+		};
+
+		/**
+		 * @brief Grow a simplex around the origin into a tetrahedron with volume.
+		 *
+		 * @param Candidates Receives the directions tried, for the fallback of flat differences.
+		 * @return false if the core difference is flat, a segment or a point.
+		 */
+		template <FloatingPoint T>
+		bool GrowSimplex(FSimplex<T> &Simplex, const FSupportFunction<T> &SupportA, const FSupportFunction<T> &SupportB, const T Tolerance,
+						 FVector3D<T> (&Candidates)[8], int32 &CandidateCount)
+		{
+			const auto TryDirection = [&](const FVector3D<T> &Direction, const auto &IsFarEnough)
+			{
+				Candidates[CandidateCount++ % 8] = Direction;
+				AddSupport(Simplex, SupportA, SupportB, Direction);
+				if (IsFarEnough(Simplex.W[Simplex.Count - 1]))
+					return true;
+				--Simplex.Count;
+				return false;
+			};
+
+			const FVector3D<T> Axes[3] = {FVector3D<T>(1, 0, 0), FVector3D<T>(0, 1, 0), FVector3D<T>(0, 0, 1)};
+			while (Simplex.Count < 4)
+			{
+				bool bGrown = false;
+				if (Simplex.Count == 1)
+				{
+					const auto IsFarEnough = [&](const FVector3D<T> &W) { return SquaredLength(W - Simplex.W[0]) > Tolerance * Tolerance; };
+					for (int32 Axis = 0; Axis < 3 && !bGrown; ++Axis)
+						bGrown = TryDirection(Axes[Axis], IsFarEnough) || TryDirection(-Axes[Axis], IsFarEnough);
+				}
+				else if (Simplex.Count == 2)
+				{
+					// Perpendiculars to the segment, starting from the axis it is least aligned with
+					const FVector3D<T> Edge = Simplex.W[1] - Simplex.W[0];
+					const T Components[3] = {std::abs(Edge.GetX()), std::abs(Edge.GetY()), std::abs(Edge.GetZ())};
+					const int32 Axis = Components[0] <= Components[1] ? (Components[0] <= Components[2] ? 0 : 2) : (Components[1] <= Components[2] ? 1 : 2);
+					const FVector3D<T> First = Cross(Edge, Axes[Axis]);
+					const FVector3D<T> Second = Cross(Edge, First);
+					const T EdgeLength = Magnitude(Edge);
+					const auto IsFarEnough = [&](const FVector3D<T> &W) { return Magnitude(Cross(W - Simplex.W[0], Edge)) > Tolerance * EdgeLength; };
+					bGrown = TryDirection(First, IsFarEnough) || TryDirection(-First, IsFarEnough) || TryDirection(Second, IsFarEnough) ||
+							 TryDirection(-Second, IsFarEnough);
+				}
+				else
+				{
+					const FVector3D<T> Normal = GetNormalized(Cross(Simplex.W[1] - Simplex.W[0], Simplex.W[2] - Simplex.W[0]));
+					const auto IsFarEnough = [&](const FVector3D<T> &W) { return std::abs(Dot(Normal, W - Simplex.W[0])) > Tolerance; };
+					bGrown = TryDirection(Normal, IsFarEnough) || TryDirection(-Normal, IsFarEnough);
+				}
+
+				if (!bGrown)
+					return false;
+			}
+			return true;
+		}
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FSphereShape<T>::Support(const FVector3D<T> &) const
+	{
+		return Center;
+	}
+
+	template <FloatingPoint T>
+	T FSphereShape<T>::GetRadius() const
+	{
+		return Radius;
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FCapsuleShape<T>::Support(const FVector3D<T> &Direction) const
+	{
+		return Dot(Direction, End - Start) > 0 ? End : Start;
+	}
+
+	template <FloatingPoint T>
+	T FCapsuleShape<T>::GetRadius() const
+	{
+		return Radius;
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FBoxShape<T>::Support(const FVector3D<T> &Direction) const
+	{
+		const FVector3D<T> Local = Rotation.GetConjugate().RotateVector(Direction);
+		const FVector3D<T> Corner(Local.GetX() < 0 ? -HalfExtents.GetX() : HalfExtents.GetX(), Local.GetY() < 0 ? -HalfExtents.GetY() : HalfExtents.GetY(),
+								  Local.GetZ() < 0 ? -HalfExtents.GetZ() : HalfExtents.GetZ());
+		return Center + Rotation.RotateVector(Corner);
+	}
+
+	template <FloatingPoint T>
+	T FBoxShape<T>::GetRadius() const
+	{
+		return 0;
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FConvexPolytopeShape<T>::Support(const FVector3D<T> &Direction) const
+	{
+		const FVector3D<T> Local = Rotation.GetConjugate().RotateVector(Direction);
+		const T X = Local.GetX(), Y = Local.GetY(), Z = Local.GetZ();
+
+		size_t Best = 0;
+		T BestProjection = -std::numeric_limits<T>::infinity();
+		for (size_t i = 0; i < Vertices.size(); ++i)
+		{
+			const T Projection = X * Vertices[i].GetX() + Y * Vertices[i].GetY() + Z * Vertices[i].GetZ();
+			if (Projection > BestProjection)
+			{
+				BestProjection = Projection;
+				Best = i;
+			}
+		}
+		return Vertices.empty() ? Position : Position + Rotation.RotateVector(Vertices[Best]);
+	}
+
+	template <FloatingPoint T>
+	T FConvexPolytopeShape<T>::GetRadius() const
+	{
+		return 0;
+	}
+
+	template <FloatingPoint T>
+	FGJKResult<T> ComputeDistance(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+								  const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache)
+	{
+		RATCHET_INSTRUMENT_SCOPE(GJKDistance);
+
+		const FGJKState<T> State = RunGJK(SupportA, SupportB, Cache, T(-1));
+
+		FGJKResult<T> Result;
+		Result.Iterations = State.Iterations;
+		GetWitnessPoints(State.Simplex, Result.PointA, Result.PointB);
+
+		const T CoreDistance = State.bOverlap ? T(0) : Magnitude(State.Closest);
+		Result.bIntersecting = CoreDistance <= RadiusA + RadiusB;
+		Result.Distance = Result.bIntersecting ? T(0) : CoreDistance - RadiusA - RadiusB;
+		if (!Result.bIntersecting)
+		{
+			// Closest runs from B to A, so the surfaces are reached against it on A and along it on B
+			const FVector3D<T> Normal = State.Closest / CoreDistance;
+			Result.PointA -= Normal * RadiusA;
+			Result.PointB += Normal * RadiusB;
+		}
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	bool ComputeIntersection(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+							 const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache)
+	{
+		RATCHET_INSTRUMENT_SCOPE(GJKIntersect);
+
+		const FGJKState<T> State = RunGJK(SupportA, SupportB, Cache, RadiusA + RadiusB);
+		return !State.bSeparated && (State.bOverlap || SquaredLength(State.Closest) <= (RadiusA + RadiusB) * (RadiusA + RadiusB));
+	}
+
+	template <FloatingPoint T>
+	FPenetrationResult<T> ComputePenetration(const FSupportFunction<T> &SupportA, const std::type_identity_t<T> RadiusA, const FSupportFunction<T> &SupportB,
+											 const std::type_identity_t<T> RadiusB, FGJKCache<T> *Cache)
+	{
+		RATCHET_INSTRUMENT_SCOPE(EPAPenetration);
+
+		const FGJKState<T> State = RunGJK(SupportA, SupportB, Cache, T(-1));
+
+		FPenetrationResult<T> Result;
+		GetWitnessPoints(State.Simplex, Result.PointA, Result.PointB);
+
+		// Separate cores: the contact follows from their closest points
+		if (!State.bOverlap)
+		{
+			const T CoreDistance = Magnitude(State.Closest);
+			Result.Normal = -State.Closest / CoreDistance;
+			Result.Depth = RadiusA + RadiusB - CoreDistance;
+			Result.bPenetrating = Result.Depth >= 0;
+			Result.PointA += Result.Normal * RadiusA;
+			Result.PointB -= Result.Normal * RadiusB;
+			return Result;
+		}
+
+		T Size = 0;
+		for (int32 i = 0; i < State.Simplex.Count; ++i)
+			Size = std::max(Size, Magnitude(State.Simplex.W[i]));
+
+		FSimplex<T> Simplex = State.Simplex;
+		FVector3D<T> Candidates[8];
+		int32 CandidateCount = 0;
+		if (!GrowSimplex(Simplex, SupportA, SupportB, EPATolerance<T> * std::max(Size, T(1)), Candidates, CandidateCount))
+		{
+			// The core difference has no volume, so its boundary passes through the origin: take the direction it is thinnest in
+			T BestDepth = std::numeric_limits<T>::infinity();
+			for (int32 i = 0; i < std::min(CandidateCount, 8); ++i)
+			{
+				const FVector3D<T> Direction = GetNormalized(Candidates[i]);
+				const T Depth = Dot(SupportA(Direction) - SupportB(-Direction), Direction);
+				if (Depth < BestDepth)
+				{
+					BestDepth = Depth;
+					Result.Normal = Direction;
+				}
+			}
+			Result.Depth = std::max(BestDepth, T(0)) + RadiusA + RadiusB;
+			Result.bPenetrating = true;
+			Result.PointA += Result.Normal * RadiusA;
+			Result.PointB -= Result.Normal * RadiusB;
+			return Result;
+		}
+
+		FPolytope<T> Polytope;
+		for (int32 i = 0; i < 4; ++i)
+			Polytope.AddVertex(Simplex.A[i], Simplex.B[i]);
+		const FVector3D<T> *const W = Polytope.W;
+		const bool bFlipped = Dot(W[3] - W[0], Cross(W[1] - W[0], W[2] - W[0])) > 0;
+		const int32 Tetrahedron[4][3] = {{0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2}};
+		for (const auto &Face : Tetrahedron)
+		{
+			if (bFlipped)
+				Polytope.AddFace(Face[0], Face[2], Face[1]);
+			else
+				Polytope.AddFace(Face[0], Face[1], Face[2]);
+		}
+
+		int32 Closest = 0;
+		int32 Edges[3 * EPAMaxFaces][2];
+		for (int32 Iteration = 0;; ++Iteration)
+		{
+			Closest = 0;
+			for (int32 Face = 1; Face < Polytope.FaceCount; ++Face)
+			{
+				if (Polytope.Distances[Face] < Polytope.Distances[Closest])
+					Closest = Face;
+			}
+
+			const FVector3D<T> Normal = Polytope.Normals[Closest];
+			const T Distance = Polytope.Distances[Closest];
+			const FVector3D<T> A = SupportA(Normal);
+			const FVector3D<T> B = SupportB(-Normal);
+			const T Gap = Dot(A - B, Normal) - Distance;
+			const T Scale = std::max(Size, Distance);
+			if (Gap <= EPATolerance<T> * Scale || Iteration == EPAMaxIterations || Polytope.VertexCount == EPAMaxVertices)
+				break;
+
+			// Flood-fill the faces the new vertex sees from the closest one, so the removed region stays connected
+			// even where coplanar faces are within the tolerance; the edges it borders on form the horizon
+			bool bVisible[EPAMaxFaces] = {};
+			int32 Visible[EPAMaxFaces];
+			int32 VisibleCount = 0;
+			int32 Pending[EPAMaxFaces];
+			int32 PendingCount = 0;
+			int32 EdgeCount = 0;
+			bVisible[Closest] = true;
+			Pending[PendingCount++] = Closest;
+			while (PendingCount > 0)
+			{
+				const int32 Face = Pending[--PendingCount];
+				Visible[VisibleCount++] = Face;
+				for (int32 k = 0; k < 3; ++k)
+				{
+					const int32 Start = Polytope.Faces[Face][k];
+					const int32 End = Polytope.Faces[Face][(k + 1) % 3];
+					const int32 Neighbour = Polytope.FindNeighbour(Start, End);
+					if (Neighbour >= 0 && bVisible[Neighbour])
+						continue;
+
+					if (Neighbour >= 0 && Polytope.IsVisible(Neighbour, A - B, EPAVisibilityTolerance<T> * Scale))
+					{
+						bVisible[Neighbour] = true;
+						Pending[PendingCount++] = Neighbour;
+					}
+					else
+					{
+						Edges[EdgeCount][0] = Start;
+						Edges[EdgeCount][1] = End;
+						++EdgeCount;
+					}
+				}
+			}
+
+			// Out of room: keep the closest face found so far
+			if (Polytope.FaceCount - VisibleCount + EdgeCount > EPAMaxFaces)
+				break;
+
+			// Highest index first, as removal moves the last face into the freed slot
+			std::sort(Visible, Visible + VisibleCount);
+			for (int32 i = VisibleCount; i-- > 0;)
+				Polytope.RemoveFace(Visible[i]);
+
+			const int32 Vertex = Polytope.AddVertex(A, B);
+			for (int32 Edge = 0; Edge < EdgeCount; ++Edge)
+				Polytope.AddFace(Edges[Edge][0], Edges[Edge][1], Vertex);
+		}
+
+		// Barycentric coordinates of the origin's projection onto the closest face carry over to the shapes
+		const int32 *const Face = Polytope.Faces[Closest];
+		const FVector3D<T> Normal = Polytope.Normals[Closest];
+		const FVector3D<T> Projection = Normal * Polytope.Distances[Closest];
+		const T Area = Dot(Cross(Polytope.W[Face[1]] - Polytope.W[Face[0]], Polytope.W[Face[2]] - Polytope.W[Face[0]]), Normal);
+		T Weights[3] = {T(1) / 3, T(1) / 3, T(1) / 3};
+		if (Area > 0)
+		{
+			Weights[1] = Dot(Cross(Projection - Polytope.W[Face[0]], Polytope.W[Face[2]] - Polytope.W[Face[0]]), Normal) / Area;
+			Weights[2] = Dot(Cross(Polytope.W[Face[1]] - Polytope.W[Face[0]], Projection - Polytope.W[Face[0]]), Normal) / Area;
+			Weights[0] = 1 - Weights[1] - Weights[2];
+		}
+
+		Result.PointA = FVector3D<T>();
+		Result.PointB = FVector3D<T>();
+		for (int32 k = 0; k < 3; ++k)
+		{
+			Result.PointA += Polytope.A[Face[k]] * Weights[k];
+			Result.PointB += Polytope.B[Face[k]] * Weights[k];
+		}
+		Result.Normal = Normal;
+		Result.Depth = Polytope.Distances[Closest] + RadiusA + RadiusB;
+		Result.bPenetrating = true;
+		Result.PointA += Normal * RadiusA;
+		Result.PointB -= Normal * RadiusB;
+		return Result;
+	}
+
+	// Explicit instantiation for float
+	template struct FSphereShape<float>;
+	template struct FCapsuleShape<float>;
+	template struct FBoxShape<float>;
+	template struct FConvexPolytopeShape<float>;
+	template FGJKResult<float> ComputeDistance(const FSupportFunction<float> &SupportA, const float RadiusA, const FSupportFunction<float> &SupportB,
+											   const float RadiusB, FGJKCache<float> *Cache);
+	template bool ComputeIntersection(const FSupportFunction<float> &SupportA, const float RadiusA, const FSupportFunction<float> &SupportB,
+									  const float RadiusB, FGJKCache<float> *Cache);
+	template FPenetrationResult<float> ComputePenetration(const FSupportFunction<float> &SupportA, const float RadiusA, const FSupportFunction<float> &SupportB,
+														  const float RadiusB, FGJKCache<float> *Cache);
+
+	// Explicit instantiation for double
+	template struct FSphereShape<double>;
+	template struct FCapsuleShape<double>;
+	template struct FBoxShape<double>;
+	template struct FConvexPolytopeShape<double>;
+	template FGJKResult<double> ComputeDistance(const FSupportFunction<double> &SupportA, const double RadiusA, const FSupportFunction<double> &SupportB,
+												const double RadiusB, FGJKCache<double> *Cache);
+	template bool ComputeIntersection(const FSupportFunction<double> &SupportA, const double RadiusA, const FSupportFunction<double> &SupportB,
+									  const double RadiusB, FGJKCache<double> *Cache);
+	template FPenetrationResult<double> ComputePenetration(const FSupportFunction<double> &SupportA, const double RadiusA, const FSupportFunction<double> &SupportB,
+														   const double RadiusB, FGJKCache<double> *Cache);
+}
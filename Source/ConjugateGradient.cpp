@@ -0,0 +1,431 @@
+#include "ConjugateGradient.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Block rows per partition of the vector kernels. Partitions are fixed by the row count alone, so the
+		// partial dot products, and with them the iterates, are the same for any number of workers.
+		constexpr int64 PartitionRows = 4096;
+
+		// Diagonal shifts tried, relative to the diagonal, when the incomplete factorization breaks down
+		constexpr int32 MaxShiftAttempts = 8;
+		constexpr double InitialShift = 1e-3;
+
+		int64 GetPartitionCount(const int64 Rows)
+		{
+			return (Rows + PartitionRows - 1) / PartitionRows;
+		}
+
+		// Runs Function(BeginRow, EndRow) on every partition across the worker pool and adds up what it returns
+		template <typename T, typename FunctionType>
+		T ParallelSum(const int64 Rows, Memory::FAlignedBuffer<T> &PartialSums, const FunctionType &Function)
+		{
+			const int64 PartitionCount = GetPartitionCount(Rows);
+			T *const Partials = PartialSums.GetData();
+			Parallel::ParallelFor(PartitionCount, 1, [Rows, Partials, &Function](const int64 Begin, const int64 End)
+								  {
+									  for (int64 Partition = Begin; Partition < End; ++Partition)
+									  {
+										  const int64 BeginRow = Partition * PartitionRows;
+										  Partials[Partition] = Function(BeginRow, std::min(BeginRow + PartitionRows, Rows));
+									  } });
+
+			T Sum = 0;
+			for (int64 Partition = 0; Partition < PartitionCount; ++Partition)
+				Sum += Partials[Partition];
+			return Sum;
+		}
+
+		// Component c of one block of unknowns, which is the value itself for scalar systems
+		template <int32 BlockSize, typename VectorType>
+		decltype(auto) GetComponent(VectorType &Vector, const int32 c)
+		{
+			if constexpr (BlockSize == 1)
+				return (Vector);
+			else
+				return Vector[c];
+		}
+
+		template <typename T>
+		T Dot(const T *RESTRICT A, const T *RESTRICT B, const int64 Begin, const int64 End)
+		{
+			T Sum = 0;
+			for (int64 i = Begin; i < End; ++i)
+				Sum += A[i] * B[i];
+			return Sum;
+		}
+
+		// Inverts a symmetric positive-definite 3x3 block; false if it is not positive definite
+		template <typename T>
+		bool InvertBlock3x3(const T *RESTRICT Block, T *RESTRICT Inverse)
+		{
+			const T C00 = Block[4] * Block[8] - Block[5] * Block[7];
+			const T C01 = Block[5] * Block[6] - Block[3] * Block[8];
+			const T C02 = Block[3] * Block[7] - Block[4] * Block[6];
+			const T Determinant = Block[0] * C00 + Block[1] * C01 + Block[2] * C02;
+			if (!(Block[0] > 0) || !(Determinant > 0))
+				return false;
+
+			const T InverseDeterminant = 1 / Determinant;
+			Inverse[0] = C00 * InverseDeterminant;
+			Inverse[1] = (Block[2] * Block[7] - Block[1] * Block[8]) * InverseDeterminant;
+			Inverse[2] = (Block[1] * Block[5] - Block[2] * Block[4]) * InverseDeterminant;
+			Inverse[3] = C01 * InverseDeterminant;
+			Inverse[4] = (Block[0] * Block[8] - Block[2] * Block[6]) * InverseDeterminant;
+			Inverse[5] = (Block[2] * Block[3] - Block[0] * Block[5]) * InverseDeterminant;
+			Inverse[6] = C02 * InverseDeterminant;
+			Inverse[7] = (Block[1] * Block[6] - Block[0] * Block[7]) * InverseDeterminant;
+			Inverse[8] = (Block[0] * Block[4] - Block[1] * Block[3]) * InverseDeterminant;
+			return true;
+		}
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	FConjugateGradientSolver<T, BlockSize>::FConjugateGradientSolver(Memory::FAllocator &InAllocator)
+		: InverseDiagonal(InAllocator), FactorOffsets(InAllocator), FactorColumns(InAllocator), FactorValues(InAllocator),
+		  Residual(InAllocator), Direction(InAllocator), Product(InAllocator), Preconditioned(InAllocator), PartialSums(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	bool FConjugateGradientSolver<T, BlockSize>::Compute(const MatrixType &InMatrix, const EPreconditioner InPreconditioner)
+	{
+		Matrix = &InMatrix;
+		Preconditioner = InPreconditioner;
+		bValid = false;
+
+		const int64 Rows = InMatrix.GetRows();
+		if (InMatrix.GetColumns() != Rows)
+			return false;
+
+		const int64 Count = Rows * BlockSize;
+		Residual.Resize(Count);
+		Direction.Resize(Count);
+		Product.Resize(Count);
+		Preconditioned.Resize(Preconditioner == EPreconditioner::None ? 0 : Count);
+		PartialSums.Resize(GetPartitionCount(Rows));
+
+		if (Preconditioner == EPreconditioner::Jacobi)
+		{
+			constexpr int32 BlockEntryCount = MatrixType::BlockEntryCount;
+			InverseDiagonal.Resize(Rows * BlockEntryCount);
+			for (int64 Row = 0; Row < Rows; ++Row)
+			{
+				const T *const Block = InMatrix.Find(Row, Row);
+				if (Block == nullptr)
+					return false;
+
+				T *const Inverse = InverseDiagonal.GetData() + Row * BlockEntryCount;
+				if constexpr (BlockSize == 1)
+				{
+					if (!(Block[0] > 0))
+						return false;
+					Inverse[0] = 1 / Block[0];
+				}
+				else if (!InvertBlock3x3(Block, Inverse))
+				{
+					return false;
+				}
+			}
+		}
+		else if (Preconditioner == EPreconditioner::IncompleteCholesky)
+		{
+			if (!FactorIncompleteCholesky())
+				return false;
+		}
+
+		bValid = true;
+		return true;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	bool FConjugateGradientSolver<T, BlockSize>::FactorIncompleteCholesky()
+	{
+		const int64 Rows = Matrix->GetRows();
+		const int64 Count = Rows * BlockSize;
+		const std::span<const int64> RowOffsets = Matrix->GetRowOffsets();
+		const std::span<const int32> ColumnIndices = Matrix->GetColumnIndices();
+		const std::span<const T> Values = Matrix->GetValues();
+
+		// The factor works on scalar rows: scalar row Row * BlockSize + a keeps the lower triangle of the blocks
+		// left of and on the block diagonal. Block columns are sorted, so the scalar diagonal ends up last.
+		FactorOffsets.Resize(Count + 1);
+		FactorOffsets[0] = 0;
+		for (int64 Row = 0; Row < Rows; ++Row)
+		{
+			int64 LowerBlocks = 0;
+			bool bHasDiagonal = false;
+			for (int64 k = RowOffsets[Row]; k < RowOffsets[Row + 1] && ColumnIndices[k] <= Row; ++k)
+			{
+				++LowerBlocks;
+				bHasDiagonal = ColumnIndices[k] == Row;
+			}
+			if (!bHasDiagonal)
+				return false;
+
+			for (int32 a = 0; a < BlockSize; ++a)
+			{
+				const int64 ScalarRow = Row * BlockSize + a;
+				FactorOffsets[ScalarRow + 1] = FactorOffsets[ScalarRow] + (LowerBlocks - 1) * BlockSize + a + 1;
+			}
+		}
+		FactorColumns.Resize(FactorOffsets[Count]);
+		FactorValues.Resize(FactorOffsets[Count]);
+
+		int64 *const Offsets = FactorOffsets.GetData();
+		int32 *const Columns = FactorColumns.GetData();
+		T *const Factor = FactorValues.GetData();
+
+		T Shift = 0;
+		for (int32 Attempt = 0; Attempt < MaxShiftAttempts; ++Attempt)
+		{
+			// Gather the lower triangle, scaling the diagonal by 1 + Shift
+			for (int64 Row = 0; Row < Rows; ++Row)
+			{
+				for (int32 a = 0; a < BlockSize; ++a)
+				{
+					int64 Write = Offsets[Row * BlockSize + a];
+					for (int64 k = RowOffsets[Row]; k < RowOffsets[Row + 1] && ColumnIndices[k] <= Row; ++k)
+					{
+						const bool bDiagonalBlock = ColumnIndices[k] == Row;
+						for (int32 b = 0; b < (bDiagonalBlock ? a + 1 : BlockSize); ++b)
+						{
+							const T Value = Values[k * MatrixType::BlockEntryCount + a * BlockSize + b];
+							Columns[Write] = static_cast<int32>(ColumnIndices[k] * BlockSize + b);
+							Factor[Write] = bDiagonalBlock && b == a ? Value * (1 + Shift) : Value;
+							++Write;
+						}
+					}
+				}
+			}
+
+			// Row-oriented IC(0): entries left of the current one are final, so every L(i, j) only needs the
+			// dot product of the finished parts of rows i and j over their common columns
+			bool bSuccess = true;
+			for (int64 i = 0; i < Count && bSuccess; ++i)
+			{
+				const int64 RowBegin = Offsets[i];
+				const int64 Diagonal = Offsets[i + 1] - 1;
+				for (int64 k = RowBegin; k < Diagonal; ++k)
+				{
+					const int64 j = Columns[k];
+					T Sum = 0;
+					int64 p = RowBegin, q = Offsets[j];
+					const int64 OtherDiagonal = Offsets[j + 1] - 1;
+					while (p < k && q < OtherDiagonal)
+					{
+						if (Columns[p] < Columns[q])
+							++p;
+						else if (Columns[p] > Columns[q])
+							++q;
+						else
+							Sum += Factor[p++] * Factor[q++];
+					}
+					Factor[k] = (Factor[k] - Sum) / Factor[OtherDiagonal];
+				}
+
+				T Pivot = Factor[Diagonal];
+				for (int64 k = RowBegin; k < Diagonal; ++k)
+					Pivot -= Factor[k] * Factor[k];
+				bSuccess = Pivot > 0;
+				Factor[Diagonal] = std::sqrt(Pivot);
+			}
+
+			if (bSuccess)
+				return true;
+
+			Shift = Shift == 0 ? T(InitialShift) : 4 * Shift;
+		}
+		return false;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	T FConjugateGradientSolver<T, BlockSize>::ApplyPreconditioner()
+	{
+		const int64 Rows = Matrix->GetRows();
+		const T *const R = Residual.GetData();
+		T *const Z = Preconditioned.GetData();
+
+		if (Preconditioner == EPreconditioner::Jacobi)
+		{
+			const T *const Inverse = InverseDiagonal.GetData();
+			return ParallelSum(Rows, PartialSums, [R, Z, Inverse](const int64 BeginRow, const int64 EndRow)
+							   {
+								   T Sum = 0;
+								   for (int64 Row = BeginRow; Row < EndRow; ++Row)
+								   {
+									   const T *const Block = Inverse + Row * MatrixType::BlockEntryCount;
+									   const int64 Base = Row * BlockSize;
+									   for (int32 a = 0; a < BlockSize; ++a)
+									   {
+										   T Value = 0;
+										   for (int32 b = 0; b < BlockSize; ++b)
+											   Value += Block[a * BlockSize + b] * R[Base + b];
+										   Z[Base + a] = Value;
+										   Sum += R[Base + a] * Value;
+									   }
+								   }
+								   return Sum; });
+		}
+
+		if (Preconditioner == EPreconditioner::IncompleteCholesky)
+		{
+			// Forward substitution with L, then backward substitution with L^T column by column; both are
+			// inherently sequential
+			const int64 Count = Rows * BlockSize;
+			const int64 *const Offsets = FactorOffsets.GetData();
+			const int32 *const Columns = FactorColumns.GetData();
+			const T *const Factor = FactorValues.GetData();
+
+			for (int64 i = 0; i < Count; ++i)
+			{
+				T Value = R[i];
+				const int64 Diagonal = Offsets[i + 1] - 1;
+				for (int64 k = Offsets[i]; k < Diagonal; ++k)
+					Value -= Factor[k] * Z[Columns[k]];
+				Z[i] = Value / Factor[Diagonal];
+			}
+			for (int64 i = Count - 1; i >= 0; --i)
+			{
+				const int64 Diagonal = Offsets[i + 1] - 1;
+				const T Value = Z[i] / Factor[Diagonal];
+				Z[i] = Value;
+				for (int64 k = Offsets[i]; k < Diagonal; ++k)
+					Z[Columns[k]] -= Factor[k] * Value;
+			}
+		}
+		else if (Preconditioner == EPreconditioner::None)
+		{
+			return ParallelSum(Rows, PartialSums, [R](const int64 BeginRow, const int64 EndRow)
+							   { return Dot(R, R, BeginRow * BlockSize, EndRow * BlockSize); });
+		}
+
+		return ParallelSum(Rows, PartialSums, [R, Z](const int64 BeginRow, const int64 EndRow)
+						   { return Dot(R, Z, BeginRow * BlockSize, EndRow * BlockSize); });
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	FConjugateGradientResult<T> FConjugateGradientSolver<T, BlockSize>::Solve(std::span<const VectorType> B, std::span<VectorType> X, const T Tolerance, const int64 MaxIterations)
+	{
+		FConjugateGradientResult<T> Result;
+		if (!bValid || static_cast<int64>(B.size()) != Matrix->GetRows() || static_cast<int64>(X.size()) != Matrix->GetRows())
+			return Result;
+
+		const int64 Rows = Matrix->GetRows();
+		RATCHET_INSTRUMENT_BATCH(SparseConjugateGradient, Rows);
+
+		T *const R = Residual.GetData();
+		T *const P = Direction.GetData();
+		T *const Q = Product.GetData();
+		const T *const Z = Preconditioner == EPreconditioner::None ? R : Preconditioned.GetData();
+		const MatrixType *const A = Matrix;
+
+		// B . B, fused with copying X into P so that the products only see scalar vectors
+		const T BNormSquared = ParallelSum(Rows, PartialSums, [B, X, P](const int64 BeginRow, const int64 EndRow)
+										   {
+											   T Sum = 0;
+											   for (int64 Row = BeginRow; Row < EndRow; ++Row)
+											   {
+												   for (int32 c = 0; c < BlockSize; ++c)
+												   {
+													   const T Value = GetComponent<BlockSize>(B[Row], c);
+													   P[Row * BlockSize + c] = GetComponent<BlockSize>(X[Row], c);
+													   Sum += Value * Value;
+												   }
+											   }
+											   return Sum; });
+		if (BNormSquared == 0)
+		{
+			std::fill(X.begin(), X.end(), VectorType{});
+			Result.bConverged = true;
+			return Result;
+		}
+
+		// R = B - A * X
+		T ResidualSquared = ParallelSum(Rows, PartialSums, [A, B, R, P, Q](const int64 BeginRow, const int64 EndRow)
+										{
+											A->MultiplyRows(BeginRow, EndRow, P, Q);
+											T Sum = 0;
+											for (int64 Row = BeginRow; Row < EndRow; ++Row)
+											{
+												for (int32 c = 0; c < BlockSize; ++c)
+												{
+													const int64 i = Row * BlockSize + c;
+													R[i] = GetComponent<BlockSize>(B[Row], c) - Q[i];
+													Sum += R[i] * R[i];
+												}
+											}
+											return Sum; });
+
+		const T Threshold = Tolerance * Tolerance * BNormSquared;
+		T ResidualDotZ = ApplyPreconditioner();
+		std::copy(Z, Z + Rows * BlockSize, P);
+
+		while (ResidualSquared > Threshold && Result.Iterations < MaxIterations)
+		{
+			// Q = A * P, fused with P . Q
+			const T Curvature = ParallelSum(Rows, PartialSums, [A, P, Q](const int64 BeginRow, const int64 EndRow)
+											{
+												A->MultiplyRows(BeginRow, EndRow, P, Q);
+												return Dot(P, Q, BeginRow * BlockSize, EndRow * BlockSize); });
+
+			// A is not positive definite along P, or the iteration has stagnated
+			if (!(Curvature > 0))
+				break;
+
+			// X += Alpha * P and R -= Alpha * Q, fused with R . R
+			const T Alpha = ResidualDotZ / Curvature;
+			ResidualSquared = ParallelSum(Rows, PartialSums, [Alpha, X, R, P, Q](const int64 BeginRow, const int64 EndRow)
+										  {
+											  T Sum = 0;
+											  for (int64 Row = BeginRow; Row < EndRow; ++Row)
+											  {
+												  for (int32 c = 0; c < BlockSize; ++c)
+												  {
+													  const int64 i = Row * BlockSize + c;
+													  GetComponent<BlockSize>(X[Row], c) += Alpha * P[i];
+													  R[i] -= Alpha * Q[i];
+													  Sum += R[i] * R[i];
+												  }
+											  }
+											  return Sum; });
+			++Result.Iterations;
+
+			if (ResidualSquared <= Threshold)
+				break;
+
+			const T NextResidualDotZ = ApplyPreconditioner();
+			const T Beta = NextResidualDotZ / ResidualDotZ;
+			ResidualDotZ = NextResidualDotZ;
+
+			Parallel::ParallelFor(Rows, PartitionRows, [Beta, P, Z](const int64 BeginRow, const int64 EndRow)
+								  {
+									  for (int64 i = BeginRow * BlockSize; i < EndRow * BlockSize; ++i)
+										  P[i] = Z[i] + Beta * P[i]; });
+		}
+
+		RATCHET_INSTRUMENT_VALUE(SparseConjugateGradientIterations, Result.Iterations);
+
+		Result.RelativeResidual = std::sqrt(ResidualSquared / BNormSquared);
+		Result.bConverged = ResidualSquared <= Threshold;
+		return Result;
+	}
+
+	// Explicit instantiation for float
+	template class FConjugateGradientSolver<float, 1>;
+	template class FConjugateGradientSolver<float, 3>;
+
+	// Explicit instantiation for double
+	template class FConjugateGradientSolver<double, 1>;
+	template class FConjugateGradientSolver<double, 3>;
+
+	// Explicit instantiation for long double
+	template class FConjugateGradientSolver<long double, 1>;
+	template class FConjugateGradientSolver<long double, 3>;
+}
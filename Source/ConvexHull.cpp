@@ -0,0 +1,516 @@
+#include "ConvexHull.h"
+#include "Instrument.h"
+#include "Parallel.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Points per worker batch of the initial partition
+		constexpr int64 PartitionBatchSize = 4096;
+
+		constexpr int32 NoIndex = -1;
+	}
+
+	template <FloatingPoint T>
+	FConvexHull<T>::FConvexHull(Memory::FAllocator &InAllocator)
+		: Coordinates{Memory::FAlignedBuffer<T>(InAllocator), Memory::FAlignedBuffer<T>(InAllocator), Memory::FAlignedBuffer<T>(InAllocator)},
+		  WorkFaces(InAllocator), WorkVertices(InAllocator), WorkTwins(InAllocator), FreeFaces(InAllocator), NextConflicts(InAllocator),
+		  PointFaces(InAllocator), PointDistances(InAllocator), Queue(InAllocator), VisibleFaces(InAllocator), Stack(InAllocator),
+		  Horizon(InAllocator), NewFaces(InAllocator), Vertices(InAllocator), VertexIndices(InAllocator), Edges(InAllocator), Faces(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	bool FConvexHull<T>::Build(std::span<const FVector3D<T>> Points, const int32 MaxVertices)
+	{
+		RATCHET_INSTRUMENT_BATCH(ConvexHullBuild, Points.size());
+
+		WorkFaces.Clear();
+		WorkVertices.Clear();
+		WorkTwins.Clear();
+		FreeFaces.Clear();
+		Queue.Clear();
+		Vertices.Clear();
+		VertexIndices.Clear();
+		Edges.Clear();
+		Faces.Clear();
+		Mark = 0;
+
+		if (Points.size() < 4)
+			return false;
+
+		const int64 Count = static_cast<int64>(Points.size());
+		for (Memory::FAlignedBuffer<T> &Stream : Coordinates)
+			Stream.Resize(Count);
+		Parallel::ParallelFor(Count, PartitionBatchSize, [this, Points](const int64 Begin, const int64 End)
+							  {
+								  for (int64 i = Begin; i < End; ++i)
+								  {
+									  Coordinates[0][i] = Points[i].GetX();
+									  Coordinates[1][i] = Points[i].GetY();
+									  Coordinates[2][i] = Points[i].GetZ();
+								  } });
+
+		if (!BuildInitialSimplex(Points))
+			return false;
+
+		PartitionInitialPoints(Points);
+
+		int32 VertexCount = 4;
+		while (!Queue.IsEmpty() && (MaxVertices <= 0 || VertexCount < std::max(MaxVertices, 4)))
+		{
+			std::pop_heap(Queue.begin(), Queue.end());
+			const FQueueEntry Entry = Queue[Queue.Num() - 1];
+			Queue.Resize(Queue.Num() - 1);
+
+			const FWorkFace &Face = WorkFaces[Entry.Face];
+			if (!Face.bAlive || Face.Generation != Entry.Generation)
+				continue;
+
+			// Removing visible faces can leave older vertices inside, so this only bounds the final count
+			if (AddPoint(Points, Face.Furthest, Entry.Face))
+				++VertexCount;
+		}
+
+		Finish(Points);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FConvexHull<T>::BuildInitialSimplex(std::span<const FVector3D<T>> Points)
+	{
+		const int32 Count = static_cast<int32>(Points.size());
+
+		// Extreme points along the axes, and the largest coordinates for the tolerance
+		int32 Minimum[3] = {0, 0, 0};
+		int32 Maximum[3] = {0, 0, 0};
+		T Largest[3] = {0, 0, 0};
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const T *const Stream = Coordinates[Axis].GetData();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				if (Stream[i] < Stream[Minimum[Axis]])
+					Minimum[Axis] = i;
+				if (Stream[i] > Stream[Maximum[Axis]])
+					Maximum[Axis] = i;
+				Largest[Axis] = std::max(Largest[Axis], std::abs(Stream[i]));
+			}
+		}
+
+		// Round-off of the plane distances, as in Lloyd's Quickhull
+		Tolerance = 3 * std::numeric_limits<T>::epsilon() * (Largest[0] + Largest[1] + Largest[2]);
+
+		// The two extremes furthest apart along an axis
+		int32 Axis = 0;
+		for (int32 Candidate = 1; Candidate < 3; ++Candidate)
+		{
+			if (Coordinates[Candidate][Maximum[Candidate]] - Coordinates[Candidate][Minimum[Candidate]] > Coordinates[Axis][Maximum[Axis]] - Coordinates[Axis][Minimum[Axis]])
+				Axis = Candidate;
+		}
+		const int32 A = Minimum[Axis];
+		const int32 B = Maximum[Axis];
+		if (Coordinates[Axis][B] - Coordinates[Axis][A] <= Tolerance)
+			return false;
+
+		// The point furthest from their line
+		const FVector3D<T> Direction = Points[B] - Points[A];
+		int32 C = NoIndex;
+		T LineDistance = 0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const T Distance = Magnitude(Cross(Points[i] - Points[A], Direction));
+			if (Distance > LineDistance)
+			{
+				LineDistance = Distance;
+				C = i;
+			}
+		}
+		if (C == NoIndex || LineDistance <= Tolerance * Magnitude(Direction))
+			return false;
+
+		// The point furthest from their plane
+		const FVector3D<T> Normal = GetNormalized(Cross(Direction, Points[C] - Points[A]));
+		int32 D = NoIndex;
+		T PlaneDistance = 0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const T Distance = std::abs(Dot(Normal, Points[i] - Points[A]));
+			if (Distance > PlaneDistance)
+			{
+				PlaneDistance = Distance;
+				D = i;
+			}
+		}
+		if (D == NoIndex || PlaneDistance <= Tolerance)
+			return false;
+
+		// Make A, B, C counterclockwise seen from the side away from D, then close the tetrahedron
+		const double Orientation = Predicates::Orient3D(Points[A], Points[B], Points[C], Points[D]);
+		if (Orientation == 0)
+			return false;
+		const int32 First = A;
+		const int32 Second = Orientation > 0 ? B : C;
+		const int32 Third = Orientation > 0 ? C : B;
+
+		const int32 Tetrahedron[4][3] = {{First, Second, Third}, {First, Third, D}, {First, D, Second}, {Second, D, Third}};
+		for (const auto &Corners : Tetrahedron)
+			AddFace(Corners[0], Corners[1], Corners[2]);
+
+		// Edge k of every face runs from corner k to corner k + 1
+		const auto FindEdge = [this](const int32 Start, const int32 End)
+		{
+			for (int32 Edge = 0; Edge < 12; ++Edge)
+			{
+				if (WorkVertices[Edge] == Start && WorkVertices[3 * (Edge / 3) + (Edge + 1) % 3] == End)
+					return Edge;
+			}
+			return NoIndex;
+		};
+		for (int32 Edge = 0; Edge < 12; ++Edge)
+			WorkTwins[Edge] = FindEdge(WorkVertices[3 * (Edge / 3) + (Edge + 1) % 3], WorkVertices[Edge]);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	void FConvexHull<T>::PartitionInitialPoints(std::span<const FVector3D<T>> Points)
+	{
+		const int64 Count = static_cast<int64>(Points.size());
+		NextConflicts.Resize(Count);
+		PointFaces.Resize(Count);
+		PointDistances.Resize(Count);
+
+		// Every point goes to the first face it is clearly outside of; the linking below is cheap and serial
+		Parallel::ParallelFor(Count, PartitionBatchSize, [this](const int64 Begin, const int64 End)
+							  {
+								  for (int64 i = Begin; i < End; ++i)
+								  {
+									  PointFaces[i] = NoIndex;
+									  for (int32 Face = 0; Face < 4; ++Face)
+									  {
+										  const T Distance = GetDistance(Face, static_cast<int32>(i));
+										  if (Distance > Tolerance)
+										  {
+											  PointFaces[i] = Face;
+											  PointDistances[i] = Distance;
+											  break;
+										  }
+									  }
+								  } });
+
+		for (int64 i = 0; i < Count; ++i)
+		{
+			if (PointFaces[i] != NoIndex)
+				AddConflict(PointFaces[i], static_cast<int32>(i), PointDistances[i]);
+		}
+
+		for (int32 Face = 0; Face < 4; ++Face)
+		{
+			if (WorkFaces[Face].Furthest != NoIndex)
+			{
+				Queue.Add({WorkFaces[Face].FurthestDistance, Face, WorkFaces[Face].Generation});
+				std::push_heap(Queue.begin(), Queue.end());
+			}
+		}
+	}
+
+	template <FloatingPoint T>
+	T FConvexHull<T>::GetDistance(const int32 Face, const int32 Point) const
+	{
+		const FWorkFace &Work = WorkFaces[Face];
+		return Work.Normal[0] * Coordinates[0][Point] + Work.Normal[1] * Coordinates[1][Point] + Work.Normal[2] * Coordinates[2][Point] - Work.Offset;
+	}
+
+	template <FloatingPoint T>
+	int32 FConvexHull<T>::AddFace(const int32 A, const int32 B, const int32 C)
+	{
+		int32 Face;
+		if (!FreeFaces.IsEmpty())
+		{
+			Face = FreeFaces[FreeFaces.Num() - 1];
+			FreeFaces.Resize(FreeFaces.Num() - 1);
+		}
+		else
+		{
+			Face = static_cast<int32>(WorkFaces.Num());
+			WorkFaces.Add(FWorkFace{});
+			for (int32 k = 0; k < 3; ++k)
+			{
+				WorkVertices.Add(NoIndex);
+				WorkTwins.Add(NoIndex);
+			}
+		}
+
+		WorkVertices[3 * Face + 0] = A;
+		WorkVertices[3 * Face + 1] = B;
+		WorkVertices[3 * Face + 2] = C;
+
+		T First[3];
+		T Second[3];
+		T Centroid[3];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const T *const Stream = Coordinates[Axis].GetData();
+			First[Axis] = Stream[B] - Stream[A];
+			Second[Axis] = Stream[C] - Stream[A];
+			Centroid[Axis] = (Stream[A] + Stream[B] + Stream[C]) / T(3);
+		}
+
+		// The plane through the centroid is the most accurate for the whole triangle
+		FWorkFace &Work = WorkFaces[Face];
+		Work.Normal[0] = First[1] * Second[2] - First[2] * Second[1];
+		Work.Normal[1] = First[2] * Second[0] - First[0] * Second[2];
+		Work.Normal[2] = First[0] * Second[1] - First[1] * Second[0];
+		const T InverseLength = T(1) / std::sqrt(Work.Normal[0] * Work.Normal[0] + Work.Normal[1] * Work.Normal[1] + Work.Normal[2] * Work.Normal[2]);
+		for (T &Component : Work.Normal)
+			Component *= InverseLength;
+		Work.Offset = Work.Normal[0] * Centroid[0] + Work.Normal[1] * Centroid[1] + Work.Normal[2] * Centroid[2];
+		Work.Conflicts = NoIndex;
+		Work.Furthest = NoIndex;
+		Work.FurthestDistance = 0;
+		Work.Generation++;
+		Work.VisitedMark = 0;
+		Work.bAlive = true;
+		return Face;
+	}
+
+	template <FloatingPoint T>
+	void FConvexHull<T>::AddConflict(const int32 Face, const int32 Point, const T Distance)
+	{
+		FWorkFace &Work = WorkFaces[Face];
+		NextConflicts[Point] = Work.Conflicts;
+		Work.Conflicts = Point;
+		if (Work.Furthest == NoIndex || Distance > Work.FurthestDistance)
+		{
+			Work.Furthest = Point;
+			Work.FurthestDistance = Distance;
+		}
+	}
+
+	template <FloatingPoint T>
+	bool FConvexHull<T>::AddPoint(std::span<const FVector3D<T>> Points, const int32 Eye, const int32 EyeFace)
+	{
+		const auto IsVisible = [this, Points, Eye](const int32 Face)
+		{
+			const int32 *const Corners = &WorkVertices[3 * Face];
+			return Predicates::Orient3D(Points[Corners[0]], Points[Corners[1]], Points[Corners[2]], Points[Eye]) < 0;
+		};
+
+		// Collects the outside set of a face into Unclaimed, leaving out the eye
+		int32 Unclaimed = NoIndex;
+		const auto Release = [this, Eye, &Unclaimed](const int32 Face)
+		{
+			for (int32 Point = WorkFaces[Face].Conflicts; Point != NoIndex;)
+			{
+				const int32 Next = NextConflicts[Point];
+				if (Point != Eye)
+				{
+					NextConflicts[Point] = Unclaimed;
+					Unclaimed = Point;
+				}
+				Point = Next;
+			}
+			WorkFaces[Face].Conflicts = NoIndex;
+		};
+
+		// The distance filter let through a point the exact test puts on the face: drop it and requeue the face
+		if (!IsVisible(EyeFace))
+		{
+			Release(EyeFace);
+			WorkFaces[EyeFace].Furthest = NoIndex;
+			for (int32 Point = Unclaimed; Point != NoIndex;)
+			{
+				const int32 Next = NextConflicts[Point];
+				AddConflict(EyeFace, Point, GetDistance(EyeFace, Point));
+				Point = Next;
+			}
+			if (WorkFaces[EyeFace].Furthest != NoIndex)
+			{
+				Queue.Add({WorkFaces[EyeFace].FurthestDistance, EyeFace, WorkFaces[EyeFace].Generation});
+				std::push_heap(Queue.begin(), Queue.end());
+			}
+			return false;
+		}
+
+		// Depth-first walk over the visible faces. Entering a face through an edge and continuing with the edge
+		// after it traces the horizon as one counterclockwise loop. Frames are (face, first edge, edges done).
+		++Mark;
+		VisibleFaces.Clear();
+		Horizon.Clear();
+		Stack.Clear();
+		WorkFaces[EyeFace].VisitedMark = Mark;
+		VisibleFaces.Add(EyeFace);
+		Stack.Add(EyeFace);
+		Stack.Add(0);
+		Stack.Add(0);
+		while (!Stack.IsEmpty())
+		{
+			const size_t Frame = Stack.Num() - 3;
+			if (Stack[Frame + 2] == 3)
+			{
+				Stack.Resize(Frame);
+				continue;
+			}
+
+			const int32 Face = Stack[Frame];
+			const int32 Edge = 3 * Face + (Stack[Frame + 1] + Stack[Frame + 2]) % 3;
+			++Stack[Frame + 2];
+
+			const int32 Twin = WorkTwins[Edge];
+			const int32 Neighbour = Twin / 3;
+			if (WorkFaces[Neighbour].VisitedMark == Mark)
+				continue;
+
+			if (IsVisible(Neighbour))
+			{
+				WorkFaces[Neighbour].VisitedMark = Mark;
+				VisibleFaces.Add(Neighbour);
+				Stack.Add(Neighbour);
+				Stack.Add((Twin % 3 + 1) % 3);
+				Stack.Add(0);
+			}
+			else
+			{
+				Horizon.Add({WorkVertices[Edge], WorkVertices[3 * Face + (Edge + 1) % 3], Twin});
+			}
+		}
+
+		for (const int32 Face : VisibleFaces)
+		{
+			Release(Face);
+			WorkFaces[Face].bAlive = false;
+			FreeFaces.Add(Face);
+		}
+
+		// Cone from the eye over the horizon, stitched to the faces that stay and to each other
+		NewFaces.Clear();
+		for (const FHorizonEdge &Edge : Horizon)
+		{
+			const int32 Face = AddFace(Edge.Start, Edge.End, Eye);
+			WorkTwins[3 * Face] = Edge.Twin;
+			WorkTwins[Edge.Twin] = 3 * Face;
+			NewFaces.Add(Face);
+		}
+		const int32 NewCount = static_cast<int32>(NewFaces.Num());
+		for (int32 i = 0; i < NewCount; ++i)
+		{
+			const int32 Face = NewFaces[i];
+			const int32 Following = NewFaces[(i + 1) % NewCount];
+			WorkTwins[3 * Face + 1] = 3 * Following + 2;
+			WorkTwins[3 * Following + 2] = 3 * Face + 1;
+		}
+
+		// Points no new face is clearly below are inside the hull now, or within the tolerance of it
+		for (int32 Point = Unclaimed; Point != NoIndex;)
+		{
+			const int32 Next = NextConflicts[Point];
+			for (const int32 Face : NewFaces)
+			{
+				const T Distance = GetDistance(Face, Point);
+				if (Distance > Tolerance)
+				{
+					AddConflict(Face, Point, Distance);
+					break;
+				}
+			}
+			Point = Next;
+		}
+
+		for (const int32 Face : NewFaces)
+		{
+			if (WorkFaces[Face].Furthest != NoIndex)
+			{
+				Queue.Add({WorkFaces[Face].FurthestDistance, Face, WorkFaces[Face].Generation});
+				std::push_heap(Queue.begin(), Queue.end());
+			}
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	void FConvexHull<T>::Finish(std::span<const FVector3D<T>> Points)
+	{
+		// PointFaces becomes the map from input point to hull vertex and NewFaces the map from slot to face
+		const int32 SlotCount = static_cast<int32>(WorkFaces.Num());
+		std::fill(PointFaces.begin(), PointFaces.end(), NoIndex);
+		NewFaces.Resize(SlotCount);
+
+		int32 FaceCount = 0;
+		for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+		{
+			NewFaces[Slot] = WorkFaces[Slot].bAlive ? FaceCount++ : NoIndex;
+			if (!WorkFaces[Slot].bAlive)
+				continue;
+
+			for (int32 k = 0; k < 3; ++k)
+			{
+				const int32 Point = WorkVertices[3 * Slot + k];
+				if (PointFaces[Point] == NoIndex)
+				{
+					PointFaces[Point] = static_cast<int32>(VertexIndices.Num());
+					VertexIndices.Add(Point);
+					Vertices.Add(Points[Point]);
+				}
+			}
+		}
+
+		Faces.Resize(FaceCount);
+		Edges.Resize(3 * static_cast<size_t>(FaceCount));
+		for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+		{
+			const int32 Face = NewFaces[Slot];
+			if (Face == NoIndex)
+				continue;
+
+			const FWorkFace &Work = WorkFaces[Slot];
+			Faces[Face] = {3 * Face, FVector3D<T>(Work.Normal[0], Work.Normal[1], Work.Normal[2]), Work.Offset};
+			for (int32 k = 0; k < 3; ++k)
+			{
+				const int32 Twin = WorkTwins[3 * Slot + k];
+				Edges[3 * Face + k] = {PointFaces[WorkVertices[3 * Slot + k]], 3 * NewFaces[Twin / 3] + Twin % 3, 3 * Face + (k + 1) % 3, Face};
+			}
+		}
+	}
+
+	template <FloatingPoint T>
+	std::span<const FVector3D<T>> FConvexHull<T>::GetVertices() const
+	{
+		return {Vertices.GetData(), Vertices.Num()};
+	}
+
+	template <FloatingPoint T>
+	std::span<const int32> FConvexHull<T>::GetVertexIndices() const
+	{
+		return {VertexIndices.GetData(), VertexIndices.Num()};
+	}
+
+	template <FloatingPoint T>
+	std::span<const FHullHalfEdge> FConvexHull<T>::GetEdges() const
+	{
+		return {Edges.GetData(), Edges.Num()};
+	}
+
+	template <FloatingPoint T>
+	std::span<const FHullFace<T>> FConvexHull<T>::GetFaces() const
+	{
+		return {Faces.GetData(), Faces.Num()};
+	}
+
+	template <FloatingPoint T>
+	T FConvexHull<T>::GetTolerance() const
+	{
+		return Tolerance;
+	}
+
+	// Explicit instantiation for float
+	template class FConvexHull<float>;
+
+	// Explicit instantiation for double
+	template class FConvexHull<double>;
+}
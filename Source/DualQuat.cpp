@@ -0,0 +1,106 @@
+#include "DualQuat.h"
+
+namespace Ratchet
+{
+	template <FloatingPoint T>
+	FDualQuat<T>::FDualQuat()
+		: Real(), Dual(0, 0, 0, 0) {}
+
+	template <FloatingPoint T>
+	FDualQuat<T>::FDualQuat(const FQuat<T> &InReal, const FQuat<T> &InDual)
+		: Real(InReal), Dual(InDual) {}
+
+	template <FloatingPoint T>
+	FDualQuat<T>::FDualQuat(const FQuat<T> &Rotation, const FVector3D<T> &Translation)
+		: Real(Rotation), Dual(FQuat<T>(Translation.GetX(), Translation.GetY(), Translation.GetZ(), 0) * Rotation * static_cast<T>(0.5)) {}
+
+	template <FloatingPoint T>
+	FQuat<T> FDualQuat<T>::GetRotation() const
+	{
+		return Real;
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FDualQuat<T>::GetTranslation() const
+	{
+		// t = 2 * Dual * conj(Real); the scalar part vanishes for unit dual quaternions
+		const FQuat<T> Translation = Dual * Real.GetConjugate() * static_cast<T>(2);
+		return Translation.GetVector();
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> &FDualQuat<T>::Normalize()
+	{
+		return *this *= static_cast<T>(1) / Real.Magnitude();
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> FDualQuat<T>::GetConjugate() const
+	{
+		return {Real.GetConjugate(), Dual.GetConjugate()};
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FDualQuat<T>::TransformPoint(const FVector3D<T> &Point) const
+	{
+		return Real.RotateVector(Point) + GetTranslation();
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FDualQuat<T>::TransformVector(const FVector3D<T> &Vector) const
+	{
+		return Real.RotateVector(Vector);
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> &FDualQuat<T>::operator+=(const FDualQuat &Other)
+	{
+		Real += Other.Real;
+		Dual += Other.Dual;
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> &FDualQuat<T>::operator*=(const T Scalar)
+	{
+		Real *= Scalar;
+		Dual *= Scalar;
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> operator*(const FDualQuat<T> &A, const FDualQuat<T> &B)
+	{
+		return {A.GetReal() * B.GetReal(), A.GetReal() * B.GetDual() + A.GetDual() * B.GetReal()};
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> operator*(const FDualQuat<T> &LHS, const T Scalar)
+	{
+		return {LHS.GetReal() * Scalar, LHS.GetDual() * Scalar};
+	}
+
+	template <FloatingPoint T>
+	FDualQuat<T> operator+(const FDualQuat<T> &A, const FDualQuat<T> &B)
+	{
+		return {A.GetReal() + B.GetReal(), A.GetDual() + B.GetDual()};
+	}
+
+	// Explicit instantiation for float
+	template class FDualQuat<float>;
+	template FDualQuat<float> operator*(const FDualQuat<float> &A, const FDualQuat<float> &B);
+	template FDualQuat<float> operator*(const FDualQuat<float> &LHS, const float Scalar);
+	template FDualQuat<float> operator+(const FDualQuat<float> &A, const FDualQuat<float> &B);
+
+	// Explicit instantiation for double
+	template class FDualQuat<double>;
+	template FDualQuat<double> operator*(const FDualQuat<double> &A, const FDualQuat<double> &B);
+	template FDualQuat<double> operator*(const FDualQuat<double> &LHS, const double Scalar);
+	template FDualQuat<double> operator+(const FDualQuat<double> &A, const FDualQuat<double> &B);
+
+	// Explicit instantiation for long double
+	template class FDualQuat<long double>;
+	template FDualQuat<long double> operator*(const FDualQuat<long double> &A, const FDualQuat<long double> &B);
+	template FDualQuat<long double> operator*(const FDualQuat<long double> &LHS, const long double Scalar);
+	template FDualQuat<long double> operator+(const FDualQuat<long double> &A, const FDualQuat<long double> &B);
+}
@@ -0,0 +1,225 @@
+#include "Instrument.h"
+
+#include <iterator>
+
+namespace Ratchet
+{
+	namespace Instrument
+	{
+		namespace
+		{
+			constexpr int32 CounterCount = static_cast<int32>(ECounter::Count);
+
+			const char *const CounterNames[] = {
+				"Math::Sqrt",
+				"Math::Sqrt.Iterations",
+				"Vector::Magnitude",
+				"Vector::Normalize",
+				"Vector::GetNormalized",
+				"Vector::DistanceTo",
+				"Vector::Distance",
+				"KDTree::Build",
+				"KDTree::FindKNearest",
+				"KDTree::FindKNearestBatch",
+				"VectorFileWriter::Append",
+				"VectorPipeline::Run",
+				"Vector::Sum",
+				"Vector::Bounds",
+				"Vector::Covariance3x3",
+				"Matrix::Gemm",
+				"Matrix::Gemv",
+				"Matrix::EigenDecomposeBatch",
+				"Matrix::Solve3x3Batch",
+				"Sparse::Multiply",
+				"Sparse::ConjugateGradient",
+				"Sparse::ConjugateGradientIterations",
+				"Skinning::DualQuat",
+				"Transform::UpdateWorldTransforms",
+				"Curve::EvaluateMany",
+				"Curve::EvaluateCurves",
+				"Integrate::SymplecticEuler",
+				"Integrate::Verlet",
+				"Integrate::RungeKutta4",
+				"Predicates::Orient2D",
+				"Predicates::Orient2DExact",
+				"Predicates::Orient3D",
+				"Predicates::Orient3DExact",
+				"Predicates::InCircle",
+				"Predicates::InCircleExact",
+				"Predicates::InSphere",
+				"Predicates::InSphereExact",
+				"ConvexHull::Build",
+				"GJK::Distance",
+				"GJK::Intersect",
+				"EPA::Penetration",
+				"OBB::Fit",
+				"OBB::OverlapMany",
+				"OBB::OverlapSphereMany",
+				"OBB::IntersectRayMany",
+				"MeshTangentSpace::ComputeNormals",
+				"MeshTangentSpace::ComputeTangents",
+				"Polygon2D::Boolean",
+				"Polygon2D::BooleanMany",
+				"Polygon2D::Triangulate",
+				"Polygon2D::TriangulateMany",
+				"Polygon2D::Offset",
+				"Polygon2D::OffsetMany",
+				"RandomSampler::Uniform",
+				"RandomSampler::UnitVectors",
+				"RandomSampler::PointsInSphere",
+				"RandomSampler::PointsInDisk",
+				"RandomSampler::CosineHemisphere",
+				"RandomSampler::Barycentrics",
+				"RandomSampler::PointsInTriangle",
+				"RandomSampler::PoissonDisk2D",
+				"RandomSampler::PoissonDisk3D",
+				"Noise::Evaluate2D",
+				"Noise::Evaluate3D",
+				"Noise::Evaluate4D",
+				"SpatialOrder::MortonCodes",
+				"SpatialOrder::HilbertCodes",
+				"SpatialOrder::SortPermutation"};
+			static_assert(std::size(CounterNames) == CounterCount, "Every ECounter needs a name");
+
+#ifdef RATCHET_INSTRUMENT
+			// Lock-free list of every thread block ever registered; blocks are recycled, never freed
+			std::atomic<FThreadCounters *> ThreadCountersHead{nullptr};
+
+			FThreadCounters *AcquireThreadCounters()
+			{
+				for (FThreadCounters *Block = ThreadCountersHead.load(std::memory_order_acquire); Block != nullptr; Block = Block->Next)
+				{
+					bool bExpected = false;
+					if (Block->bInUse.compare_exchange_strong(bExpected, true, std::memory_order_acquire))
+						return Block;
+				}
+
+				FThreadCounters *Block = new FThreadCounters();
+				Block->Next = ThreadCountersHead.load(std::memory_order_relaxed);
+				while (!ThreadCountersHead.compare_exchange_weak(Block->Next, Block, std::memory_order_release, std::memory_order_relaxed))
+				{
+				}
+				return Block;
+			}
+
+			// Hands the block back for reuse when its thread exits; its totals stay in the merge
+			struct FThreadCountersOwner
+			{
+				FThreadCounters *Block = AcquireThreadCounters();
+
+				~FThreadCountersOwner()
+				{
+					Block->bInUse.store(false, std::memory_order_release);
+				}
+			};
+#endif
+
+			void DumpText(std::FILE *File, const FCounterTotals (&Totals)[CounterCount])
+			{
+				std::fprintf(File, "%-28s %14s %16s %18s %12s\n", "Function", "Calls", "Elements", "Cycles", "Cycles/Call");
+				for (int32 Counter = 0; Counter < CounterCount; ++Counter)
+				{
+					const FCounterTotals &Total = Totals[Counter];
+					if (Total.Calls == 0)
+						continue;
+
+					std::fprintf(File, "%-28s %14llu %16llu %18llu %12.1f\n", CounterNames[Counter],
+								 static_cast<unsigned long long>(Total.Calls), static_cast<unsigned long long>(Total.Elements),
+								 static_cast<unsigned long long>(Total.Cycles), static_cast<double>(Total.Cycles) / static_cast<double>(Total.Calls));
+
+					std::fprintf(File, "    histogram:");
+					for (int32 Bucket = 0; Bucket < HistogramBuckets; ++Bucket)
+					{
+						if (Total.Histogram[Bucket] != 0)
+							std::fprintf(File, " [%llu+]=%llu", Bucket == 0 ? 0ull : 1ull << Bucket, static_cast<unsigned long long>(Total.Histogram[Bucket]));
+					}
+					std::fprintf(File, "\n");
+				}
+			}
+
+			void DumpJson(std::FILE *File, const FCounterTotals (&Totals)[CounterCount])
+			{
+				std::fprintf(File, "{\n  \"enabled\": %s,\n  \"counters\": [", IsEnabled() ? "true" : "false");
+				bool bFirst = true;
+				for (int32 Counter = 0; Counter < CounterCount; ++Counter)
+				{
+					const FCounterTotals &Total = Totals[Counter];
+					if (Total.Calls == 0)
+						continue;
+
+					std::fprintf(File, "%s\n    {\"name\": \"%s\", \"calls\": %llu, \"elements\": %llu, \"cycles\": %llu, \"histogram\": [",
+								 bFirst ? "" : ",", CounterNames[Counter], static_cast<unsigned long long>(Total.Calls),
+								 static_cast<unsigned long long>(Total.Elements), static_cast<unsigned long long>(Total.Cycles));
+					for (int32 Bucket = 0; Bucket < HistogramBuckets; ++Bucket)
+						std::fprintf(File, "%s%llu", Bucket == 0 ? "" : ", ", static_cast<unsigned long long>(Total.Histogram[Bucket]));
+					std::fprintf(File, "]}");
+					bFirst = false;
+				}
+				std::fprintf(File, "\n  ]\n}\n");
+			}
+		}
+
+		const char *GetCounterName(const ECounter Counter)
+		{
+			return static_cast<int32>(Counter) < CounterCount ? CounterNames[static_cast<int32>(Counter)] : "Unknown";
+		}
+
+#ifdef RATCHET_INSTRUMENT
+		FThreadCounters &GetThreadCounters()
+		{
+			thread_local FThreadCountersOwner Owner;
+			return *Owner.Block;
+		}
+#endif
+
+		void Merge(FCounterTotals (&OutTotals)[static_cast<int32>(ECounter::Count)])
+		{
+			for (FCounterTotals &Total : OutTotals)
+				Total = FCounterTotals();
+
+#ifdef RATCHET_INSTRUMENT
+			for (FThreadCounters *Block = ThreadCountersHead.load(std::memory_order_acquire); Block != nullptr; Block = Block->Next)
+			{
+				for (int32 Counter = 0; Counter < CounterCount; ++Counter)
+				{
+					const FThreadCounters::FCounter &Data = Block->Counters[Counter];
+					FCounterTotals &Total = OutTotals[Counter];
+					Total.Calls += Data.Calls.load(std::memory_order_relaxed);
+					Total.Elements += Data.Elements.load(std::memory_order_relaxed);
+					Total.Cycles += Data.Cycles.load(std::memory_order_relaxed);
+					for (int32 Bucket = 0; Bucket < HistogramBuckets; ++Bucket)
+						Total.Histogram[Bucket] += Data.Histogram[Bucket].load(std::memory_order_relaxed);
+				}
+			}
+#endif
+		}
+
+		void Reset()
+		{
+#ifdef RATCHET_INSTRUMENT
+			for (FThreadCounters *Block = ThreadCountersHead.load(std::memory_order_acquire); Block != nullptr; Block = Block->Next)
+			{
+				for (FThreadCounters::FCounter &Data : Block->Counters)
+				{
+					Data.Calls.store(0, std::memory_order_relaxed);
+					Data.Elements.store(0, std::memory_order_relaxed);
+					Data.Cycles.store(0, std::memory_order_relaxed);
+					for (std::atomic<uint64> &Bucket : Data.Histogram)
+						Bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+#endif
+		}
+
+		void Dump(std::FILE *File, const EDumpFormat Format)
+		{
+			FCounterTotals Totals[CounterCount];
+			Merge(Totals);
+
+			if (Format == EDumpFormat::Json)
+				DumpJson(File, Totals);
+			else
+				DumpText(File, Totals);
+		}
+	}
+}
@@ -0,0 +1,366 @@
+#include "Integrators.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ratchet
+{
+	namespace
+	{
+		constexpr int32 LaneCount = IntegratorLaneCount;
+
+		// Particles per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 4096;
+
+		template <typename T>
+		struct FIntegratorJob
+		{
+			T *Positions[3];
+			T *Second[3]; // Velocities, or previous positions for Verlet
+			const T *Forces[3];
+			const T *InverseMasses; // nullptr for unit masses
+			T DeltaTime;
+			T DampingFactor;
+			T MaxSpeed;
+		};
+
+		template <typename T>
+		FIntegratorJob<T> MakeJob(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Second, const FVector3DStreams<const T> &Forces,
+								  std::span<const T> InverseMasses, const T DeltaTime, const FIntegratorSettings<T> &Settings)
+		{
+			return {{Positions.X.data(), Positions.Y.data(), Positions.Z.data()},
+					{Second.X.data(), Second.Y.data(), Second.Z.data()},
+					{Forces.X.data(), Forces.Y.data(), Forces.Z.data()},
+					InverseMasses.empty() ? nullptr : InverseMasses.data(),
+					DeltaTime,
+					std::exp(-Settings.Damping * DeltaTime),
+					Settings.MaxSpeed};
+		}
+
+		/**
+		 * Scales the vectors of the lanes that are longer than Limit down to it.
+		 */
+		template <typename T>
+		void ClampLanes(T (&Vectors)[3][LaneCount], const T Limit)
+		{
+			// Keeps the quotient finite for a zero vector without a branch
+			constexpr T Tiny = std::numeric_limits<T>::min();
+
+			T Scales[LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Scales[Lane] = Vectors[0][Lane] * Vectors[0][Lane] + Vectors[1][Lane] * Vectors[1][Lane] + Vectors[2][Lane] * Vectors[2][Lane] + Tiny;
+
+			// The square roots stay scalar since errno handling keeps them from vectorizing; the loops around
+			// them still do
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Scales[Lane] = std::sqrt(Scales[Lane]);
+
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T Scale = std::min(T(1), Limit / Scales[Lane]);
+				for (int32 c = 0; c < 3; ++c)
+					Vectors[c][Lane] *= Scale;
+			}
+		}
+
+		/**
+		 * Loads the particles [Begin, Begin + Count) of three streams into lanes. Partial blocks repeat their
+		 * last particle in the unused lanes.
+		 */
+		template <typename T, bool bPartial>
+		void LoadLanes(const T *const *Streams, const int64 Begin, const int32 Count, T (&Lanes)[3][LaneCount])
+		{
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Lanes[c][Lane] = Streams[c][Begin + (bPartial ? std::min(Lane, Count - 1) : Lane)];
+			}
+		}
+
+		template <typename T, bool bPartial>
+		void StoreLanes(T *const *Streams, const int64 Begin, const int32 Count, const T (&Lanes)[3][LaneCount])
+		{
+			const int32 StoreCount = bPartial ? Count : LaneCount;
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < StoreCount; ++Lane)
+					Streams[c][Begin + Lane] = Lanes[c][Lane];
+			}
+		}
+
+		// Per lane, Step divided by the particle's mass
+		template <typename T, bool bMasses, bool bPartial>
+		void LoadStepLanes(const FIntegratorJob<T> &Job, const T Step, const int64 Begin, const int32 Count, T (&Steps)[LaneCount])
+		{
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Steps[Lane] = bMasses ? Step * Job.InverseMasses[Begin + (bPartial ? std::min(Lane, Count - 1) : Lane)] : Step;
+		}
+
+		/**
+		 * One symplectic Euler step of the particles [Begin, Begin + Count) with Count <= LaneCount.
+		 */
+		template <typename T, bool bMasses, bool bClamp, bool bPartial>
+		void SymplecticEulerLanes(const FIntegratorJob<T> &Job, const int64 Begin, const int32 Count)
+		{
+			T Positions[3][LaneCount];
+			T Velocities[3][LaneCount];
+			T Forces[3][LaneCount];
+			T Steps[LaneCount];
+			LoadLanes<T, bPartial>(Job.Positions, Begin, Count, Positions);
+			LoadLanes<T, bPartial>(Job.Second, Begin, Count, Velocities);
+			LoadLanes<T, bPartial>(Job.Forces, Begin, Count, Forces);
+			LoadStepLanes<T, bMasses, bPartial>(Job, Job.DeltaTime, Begin, Count, Steps);
+
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Velocities[c][Lane] = (Velocities[c][Lane] + Forces[c][Lane] * Steps[Lane]) * Job.DampingFactor;
+			}
+			if constexpr (bClamp)
+				ClampLanes(Velocities, Job.MaxSpeed);
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Positions[c][Lane] += Velocities[c][Lane] * Job.DeltaTime;
+			}
+
+			StoreLanes<T, bPartial>(Job.Positions, Begin, Count, Positions);
+			StoreLanes<T, bPartial>(Job.Second, Begin, Count, Velocities);
+		}
+
+		/**
+		 * One position Verlet step of the particles [Begin, Begin + Count) with Count <= LaneCount.
+		 */
+		template <typename T, bool bMasses, bool bClamp, bool bPartial>
+		void VerletLanes(const FIntegratorJob<T> &Job, const int64 Begin, const int32 Count)
+		{
+			T Positions[3][LaneCount];
+			T Displacements[3][LaneCount];
+			T Forces[3][LaneCount];
+			T Steps[LaneCount];
+			LoadLanes<T, bPartial>(Job.Positions, Begin, Count, Positions);
+			LoadLanes<T, bPartial>(Job.Second, Begin, Count, Displacements);
+			LoadLanes<T, bPartial>(Job.Forces, Begin, Count, Forces);
+			LoadStepLanes<T, bMasses, bPartial>(Job, Job.DeltaTime * Job.DeltaTime, Begin, Count, Steps);
+
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Displacements[c][Lane] = (Positions[c][Lane] - Displacements[c][Lane]) * Job.DampingFactor;
+			}
+			if constexpr (bClamp)
+				ClampLanes(Displacements, Job.MaxSpeed * Job.DeltaTime);
+
+			// The current positions become the previous ones
+			StoreLanes<T, bPartial>(Job.Second, Begin, Count, Positions);
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Positions[c][Lane] += Displacements[c][Lane] + Forces[c][Lane] * Steps[Lane];
+			}
+			StoreLanes<T, bPartial>(Job.Positions, Begin, Count, Positions);
+		}
+
+		template <typename T, bool bMasses, bool bClamp>
+		void SymplecticEulerRange(const FIntegratorJob<T> &Job, const int64 Begin, const int64 End)
+		{
+			int64 Particle = Begin;
+			for (; Particle + LaneCount <= End; Particle += LaneCount)
+				SymplecticEulerLanes<T, bMasses, bClamp, false>(Job, Particle, LaneCount);
+			if (Particle < End)
+				SymplecticEulerLanes<T, bMasses, bClamp, true>(Job, Particle, static_cast<int32>(End - Particle));
+		}
+
+		template <typename T, bool bMasses, bool bClamp>
+		void VerletRange(const FIntegratorJob<T> &Job, const int64 Begin, const int64 End)
+		{
+			int64 Particle = Begin;
+			for (; Particle + LaneCount <= End; Particle += LaneCount)
+				VerletLanes<T, bMasses, bClamp, false>(Job, Particle, LaneCount);
+			if (Particle < End)
+				VerletLanes<T, bMasses, bClamp, true>(Job, Particle, static_cast<int32>(End - Particle));
+		}
+
+		template <typename T>
+		using FRangeKernel = void (*)(const FIntegratorJob<T> &, int64, int64);
+
+		/**
+		 * Runs the kernel variant for the job's masses and clamping over the particles on the worker pool.
+		 * Kernels are indexed by [bMasses][bClamp].
+		 */
+		template <typename T>
+		void Run(const FIntegratorJob<T> &Job, const int64 Count, const FRangeKernel<T> (&Kernels)[2][2])
+		{
+			const FRangeKernel<T> Kernel = Kernels[Job.InverseMasses != nullptr][Job.MaxSpeed < std::numeric_limits<T>::infinity()];
+			Parallel::ParallelFor(Count, BatchSize, [&Job, Kernel](const int64 Begin, const int64 End)
+								  { Kernel(Job, Begin, End); });
+		}
+
+		/**
+		 * One Runge-Kutta step of the particles [Begin, Begin + Count) with Count <= LaneCount. Partial blocks
+		 * repeat their last particle in the unused lanes and only store the valid ones.
+		 */
+		template <typename T>
+		void RungeKutta4Lanes(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Velocities, const FAccelerationFunction<T> &Acceleration,
+							  const T Time, const T DeltaTime, const T Damping, const T MaxSpeed, const int64 Begin, const int32 Count)
+		{
+			const std::span<T> PositionStreams[3] = {Positions.X, Positions.Y, Positions.Z};
+			const std::span<T> VelocityStreams[3] = {Velocities.X, Velocities.Y, Velocities.Z};
+
+			T X0[3][LaneCount];
+			T V0[3][LaneCount];
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					const int64 Particle = Begin + std::min(Lane, Count - 1);
+					X0[c][Lane] = PositionStreams[c][Particle];
+					V0[c][Lane] = VelocityStreams[c][Particle];
+				}
+			}
+
+			// Weighted sums of the stage derivatives: dx/dt is the stage velocity, dv/dt its acceleration
+			T SumX[3][LaneCount] = {};
+			T SumV[3][LaneCount] = {};
+			T Accelerations[3][LaneCount];
+			FParticleLanes<T> Stage;
+			Stage.First = Begin;
+			Stage.Count = Count;
+
+			constexpr T Offsets[4] = {0, T(0.5), T(0.5), 1}; // Where each stage samples, in steps from the start
+			constexpr T Weights[4] = {1, 2, 2, 1};
+			for (int32 k = 0; k < 4; ++k)
+			{
+				// Stage k starts from the state advanced along the derivatives of stage k - 1
+				const T Offset = Offsets[k] * DeltaTime;
+				Stage.Time = Time + Offset;
+				for (int32 c = 0; c < 3; ++c)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const T PreviousVelocity = k == 0 ? V0[c][Lane] : Stage.Velocities[c][Lane];
+						const T PreviousAcceleration = k == 0 ? T(0) : Accelerations[c][Lane];
+						Stage.Positions[c][Lane] = X0[c][Lane] + Offset * PreviousVelocity;
+						Stage.Velocities[c][Lane] = V0[c][Lane] + Offset * PreviousAcceleration;
+					}
+				}
+
+				Acceleration(Stage, Accelerations);
+
+				for (int32 c = 0; c < 3; ++c)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						SumX[c][Lane] += Weights[k] * Stage.Velocities[c][Lane];
+						SumV[c][Lane] += Weights[k] * Accelerations[c][Lane];
+					}
+				}
+			}
+
+			const T Sixth = DeltaTime / 6;
+			T V1[3][LaneCount];
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					V1[c][Lane] = (V0[c][Lane] + Sixth * SumV[c][Lane]) * Damping;
+			}
+			if (MaxSpeed < std::numeric_limits<T>::infinity())
+				ClampLanes(V1, MaxSpeed);
+
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < Count; ++Lane)
+				{
+					PositionStreams[c][Begin + Lane] = X0[c][Lane] + Sixth * SumX[c][Lane];
+					VelocityStreams[c][Begin + Lane] = V1[c][Lane];
+				}
+			}
+		}
+
+		template <typename T>
+		bool IsMatching(const FVector3DStreams<T> &Streams, const int64 Count)
+		{
+			return Streams.IsValid() && Streams.Num() == Count;
+		}
+	}
+
+	template <FloatingPoint T>
+	bool IntegrateSymplecticEuler(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Velocities,
+								  const std::type_identity_t<FVector3DStreams<const T>> &Forces, std::type_identity_t<std::span<const T>> InverseMasses,
+								  const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings)
+	{
+		const int64 Count = Positions.Num();
+		if (!IsMatching(Positions, Count) || !IsMatching(Velocities, Count) || !IsMatching(Forces, Count) ||
+			(!InverseMasses.empty() && static_cast<int64>(InverseMasses.size()) != Count))
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(IntegrateSymplecticEuler, Count);
+
+		constexpr FRangeKernel<T> Kernels[2][2] = {{&SymplecticEulerRange<T, false, false>, &SymplecticEulerRange<T, false, true>},
+												   {&SymplecticEulerRange<T, true, false>, &SymplecticEulerRange<T, true, true>}};
+		Run(MakeJob(Positions, Velocities, Forces, InverseMasses, DeltaTime, Settings), Count, Kernels);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool IntegrateVerlet(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &PreviousPositions,
+						 const std::type_identity_t<FVector3DStreams<const T>> &Forces, std::type_identity_t<std::span<const T>> InverseMasses,
+						 const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings)
+	{
+		const int64 Count = Positions.Num();
+		if (!IsMatching(Positions, Count) || !IsMatching(PreviousPositions, Count) || !IsMatching(Forces, Count) ||
+			(!InverseMasses.empty() && static_cast<int64>(InverseMasses.size()) != Count))
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(IntegrateVerlet, Count);
+
+		constexpr FRangeKernel<T> Kernels[2][2] = {{&VerletRange<T, false, false>, &VerletRange<T, false, true>},
+												   {&VerletRange<T, true, false>, &VerletRange<T, true, true>}};
+		Run(MakeJob(Positions, PreviousPositions, Forces, InverseMasses, DeltaTime, Settings), Count, Kernels);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool IntegrateRungeKutta4(const FVector3DStreams<T> &Positions, const FVector3DStreams<T> &Velocities, const FAccelerationFunction<T> &Acceleration,
+							  const std::type_identity_t<T> Time, const std::type_identity_t<T> DeltaTime, const FIntegratorSettings<T> &Settings)
+	{
+		const int64 Count = Positions.Num();
+		if (!IsMatching(Positions, Count) || !IsMatching(Velocities, Count))
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(IntegrateRungeKutta4, Count);
+
+		const T Damping = std::exp(-Settings.Damping * DeltaTime);
+		const T MaxSpeed = Settings.MaxSpeed;
+		Parallel::ParallelFor(Count, BatchSize, [&](const int64 Begin, const int64 End)
+							  {
+								  for (int64 Particle = Begin; Particle < End; Particle += LaneCount)
+									  RungeKutta4Lanes(Positions, Velocities, Acceleration, Time, DeltaTime, Damping, MaxSpeed, Particle,
+													   static_cast<int32>(std::min<int64>(LaneCount, End - Particle))); });
+		return true;
+	}
+
+	// Explicit instantiation for float
+	template bool IntegrateSymplecticEuler(const FVector3DStreams<float> &Positions, const FVector3DStreams<float> &Velocities,
+										   const FVector3DStreams<const float> &Forces, std::span<const float> InverseMasses,
+										   const float DeltaTime, const FIntegratorSettings<float> &Settings);
+	template bool IntegrateVerlet(const FVector3DStreams<float> &Positions, const FVector3DStreams<float> &PreviousPositions,
+								  const FVector3DStreams<const float> &Forces, std::span<const float> InverseMasses,
+								  const float DeltaTime, const FIntegratorSettings<float> &Settings);
+	template bool IntegrateRungeKutta4(const FVector3DStreams<float> &Positions, const FVector3DStreams<float> &Velocities,
+									   const FAccelerationFunction<float> &Acceleration, const float Time, const float DeltaTime,
+									   const FIntegratorSettings<float> &Settings);
+
+	// Explicit instantiation for double
+	template bool IntegrateSymplecticEuler(const FVector3DStreams<double> &Positions, const FVector3DStreams<double> &Velocities,
+										   const FVector3DStreams<const double> &Forces, std::span<const double> InverseMasses,
+										   const double DeltaTime, const FIntegratorSettings<double> &Settings);
+	template bool IntegrateVerlet(const FVector3DStreams<double> &Positions, const FVector3DStreams<double> &PreviousPositions,
+								  const FVector3DStreams<const double> &Forces, std::span<const double> InverseMasses,
+								  const double DeltaTime, const FIntegratorSettings<double> &Settings);
+	template bool IntegrateRungeKutta4(const FVector3DStreams<double> &Positions, const FVector3DStreams<double> &Velocities,
+									   const FAccelerationFunction<double> &Acceleration, const double Time, const double DeltaTime,
+									   const FIntegratorSettings<double> &Settings);
+}
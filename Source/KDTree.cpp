@@ -0,0 +1,276 @@
+#include "KDTree.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Inputs smaller than this are built on the calling thread
+		constexpr int32 ParallelBuildThreshold = 1 << 14;
+
+		// Queries handed to a worker at once by the batch API
+		constexpr int64 QueryBatchSize = 64;
+
+		template <FloatingPoint T>
+		bool CompareNeighbors(const FKDTreeNeighbor<T> &A, const FKDTreeNeighbor<T> &B)
+		{
+			return A.DistanceSquared < B.DistanceSquared;
+		}
+
+		template <FloatingPoint T>
+		void OfferNeighbor(std::span<FKDTreeNeighbor<T>> Heap, int32 &HeapSize, const FKDTreeNeighbor<T> &Candidate)
+		{
+			const int32 Capacity = static_cast<int32>(Heap.size());
+			if (HeapSize < Capacity)
+			{
+				Heap[HeapSize++] = Candidate;
+				std::push_heap(Heap.begin(), Heap.begin() + HeapSize, CompareNeighbors<T>);
+			}
+			else if (Candidate.DistanceSquared < Heap[0].DistanceSquared)
+			{
+				std::pop_heap(Heap.begin(), Heap.begin() + HeapSize, CompareNeighbors<T>);
+				Heap[HeapSize - 1] = Candidate;
+				std::push_heap(Heap.begin(), Heap.begin() + HeapSize, CompareNeighbors<T>);
+			}
+		}
+
+		// Get the range of the subtree at a given depth, numbered left to right
+		void GetSubtreeRange(const int32 Count, const int32 Depth, const int64 Subtree, int32 &OutBegin, int32 &OutEnd)
+		{
+			OutBegin = 0;
+			OutEnd = Count;
+			for (int32 Bit = Depth - 1; Bit >= 0; --Bit)
+			{
+				const int32 Mid = OutBegin + (OutEnd - OutBegin) / 2;
+				if ((Subtree >> Bit) & 1)
+					OutBegin = Mid + 1;
+				else
+					OutEnd = Mid;
+			}
+		}
+
+		// Split the node owning [Begin, End) along its widest axis and return the node position
+		template <typename VectorType>
+		int32 SplitNode(std::span<const VectorType> Source, std::span<int32> Indices, std::span<uint8> SplitAxes, const int32 Begin, const int32 End)
+		{
+			using T = typename TVectorTraits<VectorType>::ScalarType;
+			constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+
+			T Min[Dimension];
+			T Max[Dimension];
+			for (int32 Axis = 0; Axis < Dimension; ++Axis)
+			{
+				Min[Axis] = std::numeric_limits<T>::max();
+				Max[Axis] = std::numeric_limits<T>::lowest();
+			}
+
+			for (int32 i = Begin; i < End; ++i)
+			{
+				const VectorType &Point = Source[Indices[i]];
+				for (int8 Axis = 0; Axis < Dimension; ++Axis)
+				{
+					Min[Axis] = std::min(Min[Axis], Point[Axis]);
+					Max[Axis] = std::max(Max[Axis], Point[Axis]);
+				}
+			}
+
+			int8 SplitAxis = 0;
+			for (int8 Axis = 1; Axis < Dimension; ++Axis)
+			{
+				if (Max[Axis] - Min[Axis] > Max[SplitAxis] - Min[SplitAxis])
+					SplitAxis = Axis;
+			}
+
+			const int32 Mid = Begin + (End - Begin) / 2;
+			std::nth_element(Indices.begin() + Begin, Indices.begin() + Mid, Indices.begin() + End,
+							 [&](const int32 A, const int32 B)
+							 { return Source[A][SplitAxis] < Source[B][SplitAxis]; });
+			SplitAxes[Mid] = static_cast<uint8>(SplitAxis);
+
+			return Mid;
+		}
+	}
+
+	template <typename VectorType>
+	FKDTree<VectorType>::FKDTree(Memory::FAllocator &InAllocator)
+		: Points(InAllocator), Indices(InAllocator), SplitAxes(InAllocator) {}
+
+	template <typename VectorType>
+	FKDTree<VectorType>::FKDTree(std::span<const VectorType> InPoints, Memory::FAllocator &InAllocator)
+		: Points(InAllocator), Indices(InAllocator), SplitAxes(InAllocator)
+	{
+		Build(InPoints);
+	}
+
+	template <typename VectorType>
+	void FKDTree<VectorType>::Build(std::span<const VectorType> InPoints)
+	{
+		RATCHET_INSTRUMENT_BATCH(KDTreeBuild, InPoints.size());
+
+		const int32 Count = static_cast<int32>(InPoints.size());
+
+		Indices.Resize(Count);
+		std::iota(Indices.begin(), Indices.end(), 0);
+		SplitAxes.Resize(Count);
+		std::fill(SplitAxes.begin(), SplitAxes.end(), 0);
+
+		// Split the top levels one level at a time until there are enough independent subtrees to share out.
+		// Subtree ranges follow from the implicit layout, so no work list has to be stored.
+		int32 SplitDepth = 0;
+		if (Count >= ParallelBuildThreshold)
+		{
+			const int64 TargetSubtrees = static_cast<int64>(Parallel::GetWorkerCount()) * 4;
+			while ((int64(1) << SplitDepth) < TargetSubtrees)
+			{
+				Parallel::ParallelFor(int64(1) << SplitDepth, 1, [&](const int64 Begin, const int64 End)
+									  {
+					for (int64 Subtree = Begin; Subtree < End; ++Subtree)
+					{
+						int32 RangeBegin, RangeEnd;
+						GetSubtreeRange(Count, SplitDepth, Subtree, RangeBegin, RangeEnd);
+						if (RangeEnd - RangeBegin > 0)
+							SplitNode(InPoints, std::span<int32>(Indices), std::span<uint8>(SplitAxes), RangeBegin, RangeEnd);
+					} });
+				++SplitDepth;
+			}
+		}
+
+		Parallel::ParallelFor(int64(1) << SplitDepth, 1, [&](const int64 Begin, const int64 End)
+							  {
+			for (int64 Subtree = Begin; Subtree < End; ++Subtree)
+			{
+				int32 RangeBegin, RangeEnd;
+				GetSubtreeRange(Count, SplitDepth, Subtree, RangeBegin, RangeEnd);
+				BuildRange(InPoints, RangeBegin, RangeEnd);
+			} });
+
+		Points.Resize(Count);
+		Parallel::ParallelFor(Count, ParallelBuildThreshold, [&](const int64 Begin, const int64 End)
+							  {
+			for (int64 i = Begin; i < End; ++i)
+			{
+				Points[i] = InPoints[Indices[i]];
+			} });
+	}
+
+	template <typename VectorType>
+	void FKDTree<VectorType>::BuildRange(std::span<const VectorType> Source, int32 Begin, int32 End)
+	{
+		while (End - Begin > 1)
+		{
+			const int32 Mid = SplitNode(Source, std::span<int32>(Indices), std::span<uint8>(SplitAxes), Begin, End);
+			BuildRange(Source, Begin, Mid);
+			Begin = Mid + 1;
+		}
+	}
+
+	template <typename VectorType>
+	int32 FKDTree<VectorType>::Num() const
+	{
+		return static_cast<int32>(Points.Num());
+	}
+
+	template <typename VectorType>
+	bool FKDTree<VectorType>::IsEmpty() const
+	{
+		return Points.IsEmpty();
+	}
+
+	template <typename VectorType>
+	typename FKDTree<VectorType>::FNeighbor FKDTree<VectorType>::FindNearest(const VectorType &Query, const ScalarType Epsilon) const
+	{
+		FNeighbor Nearest;
+		FindKNearest(Query, std::span<FNeighbor>(&Nearest, 1), Epsilon);
+		return Nearest;
+	}
+
+	template <typename VectorType>
+	int32 FKDTree<VectorType>::FindKNearest(const VectorType &Query, std::span<FNeighbor> OutNeighbors, const ScalarType Epsilon) const
+	{
+		RATCHET_INSTRUMENT_SCOPE(KDTreeFindKNearest);
+
+		if (OutNeighbors.empty())
+			return 0;
+
+		const ScalarType PruneScale = (1 + Epsilon) * (1 + Epsilon);
+
+		int32 Found = 0;
+		SearchRange(Query, 0, Num(), OutNeighbors, Found, PruneScale);
+
+		std::sort_heap(OutNeighbors.begin(), OutNeighbors.begin() + Found, CompareNeighbors<ScalarType>);
+		std::fill(OutNeighbors.begin() + Found, OutNeighbors.end(), FNeighbor{});
+
+		return Found;
+	}
+
+	template <typename VectorType>
+	void FKDTree<VectorType>::SearchRange(const VectorType &Query, int32 Begin, int32 End, std::span<FNeighbor> Heap, int32 &HeapSize, const ScalarType PruneScale) const
+	{
+		const int32 Capacity = static_cast<int32>(Heap.size());
+
+		while (Begin < End)
+		{
+			const int32 Mid = Begin + (End - Begin) / 2;
+			const VectorType &Point = Points[Mid];
+
+			OfferNeighbor(Heap, HeapSize, FNeighbor{Indices[Mid], DistanceSquared(Query, Point)});
+
+			const int8 Axis = static_cast<int8>(SplitAxes[Mid]);
+			const ScalarType Difference = Query[Axis] - Point[Axis];
+
+			// Descend into the half containing the query first, the other half only if it can still hold a closer point
+			if (Difference < 0)
+			{
+				SearchRange(Query, Begin, Mid, Heap, HeapSize, PruneScale);
+				Begin = Mid + 1;
+			}
+			else
+			{
+				SearchRange(Query, Mid + 1, End, Heap, HeapSize, PruneScale);
+				End = Mid;
+			}
+
+			if (HeapSize == Capacity && Difference * Difference * PruneScale >= Heap[0].DistanceSquared)
+				return;
+		}
+	}
+
+	template <typename VectorType>
+	void FKDTree<VectorType>::FindKNearestBatch(std::span<const VectorType> Queries, const int32 K, std::span<FNeighbor> OutNeighbors, const ScalarType Epsilon) const
+	{
+		RATCHET_INSTRUMENT_BATCH(KDTreeFindKNearestBatch, Queries.size());
+
+		Parallel::ParallelFor(static_cast<int64>(Queries.size()), QueryBatchSize, [&](const int64 Begin, const int64 End)
+							  {
+			for (int64 i = Begin; i < End; ++i)
+			{
+				FindKNearest(Queries[i], OutNeighbors.subspan(i * K, K), Epsilon);
+			} });
+	}
+
+	template <typename VectorType>
+	std::span<const VectorType> FKDTree<VectorType>::GetPoints() const
+	{
+		return Points;
+	}
+
+	// Explicit instantiation for float
+	template class FKDTree<FVector2D<float>>;
+	template class FKDTree<FVector3D<float>>;
+	template class FKDTree<FVector4D<float>>;
+
+	// Explicit instantiation for double
+	template class FKDTree<FVector2D<double>>;
+	template class FKDTree<FVector3D<double>>;
+	template class FKDTree<FVector4D<double>>;
+
+	// Explicit instantiation for long double
+	template class FKDTree<FVector2D<long double>>;
+	template class FKDTree<FVector3D<long double>>;
+	template class FKDTree<FVector4D<long double>>;
+}
@@ -0,0 +1,567 @@
+#include "MatrixDecomposition.h"
+#include "Instrument.h"
+#include "Parallel.h"
+#include "REMath.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Problems solved side by side in the batched 3x3 kernels; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Problems per worker batch
+		constexpr int64 BatchSize = 4096;
+
+		// Cyclic Jacobi converges quadratically; this many sweeps reach round-off even for clustered eigenvalues
+		constexpr int32 JacobiSweepCount = 6;
+
+		template <typename T>
+		T GetMaxAbs(const FMatrixX<T> &A)
+		{
+			T Max = 0;
+			const T *const Data = A.GetData();
+			for (int64 i = 0; i < A.GetRows() * A.GetColumns(); ++i)
+				Max = std::max(Max, std::abs(Data[i]));
+			return Max;
+		}
+
+		// Rotates rows and columns P and Q of every lane's matrix so that entry (P, Q) vanishes
+		template <typename T, int32 Lanes>
+		void JacobiRotate(T (&A)[3][3][Lanes], T (&V)[3][3][Lanes], const int32 P, const int32 Q)
+		{
+			T Cosines[Lanes];
+			T Sines[Lanes];
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				// Symmetric Schur decomposition of the 2x2 block, Golub & Van Loan 8.5.2
+				const T OffDiagonal = A[P][Q][Lane];
+				const bool bDiagonal = OffDiagonal == 0;
+				const T Tau = (A[Q][Q][Lane] - A[P][P][Lane]) / (2 * (bDiagonal ? 1 : OffDiagonal));
+				const T Tangent = (Tau >= 0 ? 1 : -1) / (std::abs(Tau) + std::sqrt(1 + Tau * Tau));
+				const T T0 = bDiagonal ? 0 : Tangent;
+				Cosines[Lane] = 1 / std::sqrt(1 + T0 * T0);
+				Sines[Lane] = T0 * Cosines[Lane];
+			}
+
+			for (int32 k = 0; k < 3; ++k)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T KP = A[k][P][Lane];
+					const T KQ = A[k][Q][Lane];
+					A[k][P][Lane] = Cosines[Lane] * KP - Sines[Lane] * KQ;
+					A[k][Q][Lane] = Sines[Lane] * KP + Cosines[Lane] * KQ;
+
+					const T VP = V[k][P][Lane];
+					const T VQ = V[k][Q][Lane];
+					V[k][P][Lane] = Cosines[Lane] * VP - Sines[Lane] * VQ;
+					V[k][Q][Lane] = Sines[Lane] * VP + Cosines[Lane] * VQ;
+				}
+			}
+			for (int32 k = 0; k < 3; ++k)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T PK = A[P][k][Lane];
+					const T QK = A[Q][k][Lane];
+					A[P][k][Lane] = Cosines[Lane] * PK - Sines[Lane] * QK;
+					A[Q][k][Lane] = Sines[Lane] * PK + Cosines[Lane] * QK;
+				}
+			}
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				A[P][Q][Lane] = 0;
+				A[Q][P][Lane] = 0;
+			}
+		}
+
+		// Swaps eigenpairs I and J of every lane where eigenvalue J is larger
+		template <typename T, int32 Lanes>
+		void SortEigenPair(T (&A)[3][3][Lanes], T (&V)[3][3][Lanes], const int32 I, const int32 J)
+		{
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const bool bSwap = A[J][J][Lane] > A[I][I][Lane];
+				const T ValueI = A[I][I][Lane];
+				const T ValueJ = A[J][J][Lane];
+				A[I][I][Lane] = bSwap ? ValueJ : ValueI;
+				A[J][J][Lane] = bSwap ? ValueI : ValueJ;
+				for (int32 k = 0; k < 3; ++k)
+				{
+					const T VectorI = V[k][I][Lane];
+					const T VectorJ = V[k][J][Lane];
+					V[k][I][Lane] = bSwap ? VectorJ : VectorI;
+					V[k][J][Lane] = bSwap ? VectorI : VectorJ;
+				}
+			}
+		}
+
+		template <typename T, int32 Lanes>
+		void EigenDecomposeLanes(const FSymmetricMatrix3x3<T> *Matrices, FSymmetricEigen3x3<T> *OutResults, const int32 Count)
+		{
+			T A[3][3][Lanes];
+			T V[3][3][Lanes];
+
+			// Unused lanes repeat the first matrix
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const FSymmetricMatrix3x3<T> &Matrix = Matrices[Lane < Count ? Lane : 0];
+				for (int32 Row = 0; Row < 3; ++Row)
+				{
+					for (int32 Column = 0; Column < 3; ++Column)
+					{
+						A[Row][Column][Lane] = Matrix(Row, Column);
+						V[Row][Column][Lane] = Row == Column ? 1 : 0;
+					}
+				}
+			}
+
+			for (int32 Sweep = 0; Sweep < JacobiSweepCount; ++Sweep)
+			{
+				JacobiRotate(A, V, 0, 1);
+				JacobiRotate(A, V, 0, 2);
+				JacobiRotate(A, V, 1, 2);
+			}
+
+			SortEigenPair(A, V, 0, 1);
+			SortEigenPair(A, V, 0, 2);
+			SortEigenPair(A, V, 1, 2);
+
+			for (int32 Lane = 0; Lane < Count; ++Lane)
+			{
+				FSymmetricEigen3x3<T> &Result = OutResults[Lane];
+				Result.Eigenvalues = FVector3D<T>(A[0][0][Lane], A[1][1][Lane], A[2][2][Lane]);
+				for (int32 i = 0; i < 3; ++i)
+					Result.Eigenvectors[i] = FVector3D<T>(V[0][i][Lane], V[1][i][Lane], V[2][i][Lane]);
+			}
+		}
+
+		// Cramer's rule with the symmetric adjugate; returns the number of singular lanes among the first Count
+		template <typename T, int32 Lanes>
+		int32 Solve3x3Lanes(const FSymmetricMatrix3x3<T> *Matrices, const FVector3D<T> *B, FVector3D<T> *OutX, const int32 Count)
+		{
+			T Entries[6][Lanes];
+			T Rhs[3][Lanes];
+			T Solution[3][Lanes];
+			bool bSingular[Lanes];
+
+			// Unused lanes get the identity so they stay finite
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const bool bUsed = Lane < Count;
+				const FSymmetricMatrix3x3<T> Identity{1, 0, 0, 1, 0, 1};
+				const FSymmetricMatrix3x3<T> &Matrix = bUsed ? Matrices[Lane] : Identity;
+				Entries[0][Lane] = Matrix.XX;
+				Entries[1][Lane] = Matrix.XY;
+				Entries[2][Lane] = Matrix.XZ;
+				Entries[3][Lane] = Matrix.YY;
+				Entries[4][Lane] = Matrix.YZ;
+				Entries[5][Lane] = Matrix.ZZ;
+				for (int8 i = 0; i < 3; ++i)
+					Rhs[i][Lane] = bUsed ? B[Lane][i] : 0;
+			}
+
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const T XX = Entries[0][Lane], XY = Entries[1][Lane], XZ = Entries[2][Lane];
+				const T YY = Entries[3][Lane], YZ = Entries[4][Lane], ZZ = Entries[5][Lane];
+
+				const T C00 = YY * ZZ - YZ * YZ;
+				const T C01 = XZ * YZ - XY * ZZ;
+				const T C02 = XY * YZ - XZ * YY;
+				const T C11 = XX * ZZ - XZ * XZ;
+				const T C12 = XY * XZ - XX * YZ;
+				const T C22 = XX * YY - XY * XY;
+				const T Determinant = XX * C00 + XY * C01 + XZ * C02;
+
+				// Singular relative to the magnitude of the entries
+				const T Scale = std::max({std::abs(XX), std::abs(XY), std::abs(XZ), std::abs(YY), std::abs(YZ), std::abs(ZZ)});
+				const bool bLaneSingular = std::abs(Determinant) <= Math::Epsilon<T> * Scale * Scale * Scale;
+				const T InverseDeterminant = bLaneSingular ? 0 : 1 / (bLaneSingular ? 1 : Determinant);
+
+				const T B0 = Rhs[0][Lane], B1 = Rhs[1][Lane], B2 = Rhs[2][Lane];
+				Solution[0][Lane] = (C00 * B0 + C01 * B1 + C02 * B2) * InverseDeterminant;
+				Solution[1][Lane] = (C01 * B0 + C11 * B1 + C12 * B2) * InverseDeterminant;
+				Solution[2][Lane] = (C02 * B0 + C12 * B1 + C22 * B2) * InverseDeterminant;
+				bSingular[Lane] = bLaneSingular;
+			}
+
+			int32 SingularCount = 0;
+			for (int32 Lane = 0; Lane < Count; ++Lane)
+			{
+				OutX[Lane] = FVector3D<T>(Solution[0][Lane], Solution[1][Lane], Solution[2][Lane]);
+				SingularCount += bSingular[Lane] ? 1 : 0;
+			}
+			return SingularCount;
+		}
+	}
+
+	template <FloatingPoint T>
+	FLUDecomposition<T>::FLUDecomposition(Memory::FAllocator &InAllocator)
+		: LU(InAllocator), Pivots(InAllocator) {}
+
+	template <FloatingPoint T>
+	bool FLUDecomposition<T>::Compute(const FMatrixX<T> &A)
+	{
+		bValid = false;
+		if (A.GetRows() != A.GetColumns())
+			return false;
+
+		const int64 N = A.GetRows();
+		const T Tolerance = Math::Epsilon<T> * GetMaxAbs(A);
+
+		LU = A;
+		Pivots.Resize(static_cast<size_t>(N));
+		PivotSign = 1;
+
+		for (int64 k = 0; k < N; ++k)
+		{
+			int64 Pivot = k;
+			for (int64 i = k + 1; i < N; ++i)
+			{
+				if (std::abs(LU(i, k)) > std::abs(LU(Pivot, k)))
+					Pivot = i;
+			}
+
+			Pivots[static_cast<size_t>(k)] = Pivot;
+			if (std::abs(LU(Pivot, k)) <= Tolerance)
+				return false;
+
+			if (Pivot != k)
+			{
+				std::swap_ranges(LU.GetRow(k).begin(), LU.GetRow(k).end(), LU.GetRow(Pivot).begin());
+				PivotSign = -PivotSign;
+			}
+
+			const T InversePivot = 1 / LU(k, k);
+			const T *RESTRICT const RowK = LU.GetRow(k).data();
+			for (int64 i = k + 1; i < N; ++i)
+			{
+				T *RESTRICT const RowI = LU.GetRow(i).data();
+				const T Factor = RowI[k] * InversePivot;
+				RowI[k] = Factor;
+				for (int64 j = k + 1; j < N; ++j)
+					RowI[j] -= Factor * RowK[j];
+			}
+		}
+
+		bValid = true;
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FLUDecomposition<T>::Solve(std::span<const T> B, std::span<T> X) const
+	{
+		const int64 N = LU.GetRows();
+		if (!bValid || static_cast<int64>(B.size()) != N || static_cast<int64>(X.size()) != N)
+			return false;
+
+		if (X.data() != B.data())
+			std::copy(B.begin(), B.end(), X.begin());
+		for (int64 k = 0; k < N; ++k)
+			std::swap(X[static_cast<size_t>(k)], X[static_cast<size_t>(Pivots[static_cast<size_t>(k)])]);
+
+		// Forward substitution with the unit lower triangle, then back substitution with the upper one
+		for (int64 i = 1; i < N; ++i)
+		{
+			const T *const Row = LU.GetRow(i).data();
+			T Sum = X[static_cast<size_t>(i)];
+			for (int64 k = 0; k < i; ++k)
+				Sum -= Row[k] * X[static_cast<size_t>(k)];
+			X[static_cast<size_t>(i)] = Sum;
+		}
+		for (int64 i = N - 1; i >= 0; --i)
+		{
+			const T *const Row = LU.GetRow(i).data();
+			T Sum = X[static_cast<size_t>(i)];
+			for (int64 k = i + 1; k < N; ++k)
+				Sum -= Row[k] * X[static_cast<size_t>(k)];
+			X[static_cast<size_t>(i)] = Sum / Row[i];
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	T FLUDecomposition<T>::GetDeterminant() const
+	{
+		if (!bValid)
+			return 0;
+
+		T Determinant = PivotSign;
+		for (int64 i = 0; i < LU.GetRows(); ++i)
+			Determinant *= LU(i, i);
+		return Determinant;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <FloatingPoint T>
+	FCholeskyDecomposition<T>::FCholeskyDecomposition(Memory::FAllocator &InAllocator)
+		: L(InAllocator) {}
+
+	template <FloatingPoint T>
+	bool FCholeskyDecomposition<T>::Compute(const FMatrixX<T> &A)
+	{
+		bValid = false;
+		if (A.GetRows() != A.GetColumns())
+			return false;
+
+		const int64 N = A.GetRows();
+		L.Resize(N, N);
+
+		for (int64 j = 0; j < N; ++j)
+		{
+			const T *RESTRICT const RowJ = L.GetRow(j).data();
+
+			T Diagonal = A(j, j);
+			for (int64 k = 0; k < j; ++k)
+				Diagonal -= RowJ[k] * RowJ[k];
+			if (!(Diagonal > 0))
+				return false;
+
+			const T Root = std::sqrt(Diagonal);
+			L(j, j) = Root;
+
+			const T InverseRoot = 1 / Root;
+			for (int64 i = j + 1; i < N; ++i)
+			{
+				T *RESTRICT const RowI = L.GetRow(i).data();
+				T Sum = A(i, j);
+				for (int64 k = 0; k < j; ++k)
+					Sum -= RowI[k] * RowJ[k];
+				RowI[j] = Sum * InverseRoot;
+			}
+		}
+
+		bValid = true;
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FCholeskyDecomposition<T>::Solve(std::span<const T> B, std::span<T> X) const
+	{
+		const int64 N = L.GetRows();
+		if (!bValid || static_cast<int64>(B.size()) != N || static_cast<int64>(X.size()) != N)
+			return false;
+
+		// L * Y = B, then L^T * X = Y
+		for (int64 i = 0; i < N; ++i)
+		{
+			const T *const Row = L.GetRow(i).data();
+			T Sum = B[static_cast<size_t>(i)];
+			for (int64 k = 0; k < i; ++k)
+				Sum -= Row[k] * X[static_cast<size_t>(k)];
+			X[static_cast<size_t>(i)] = Sum / Row[i];
+		}
+		for (int64 i = N - 1; i >= 0; --i)
+		{
+			T Sum = X[static_cast<size_t>(i)];
+			for (int64 k = i + 1; k < N; ++k)
+				Sum -= L(k, i) * X[static_cast<size_t>(k)];
+			X[static_cast<size_t>(i)] = Sum / L(i, i);
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	const FMatrixX<T> &FCholeskyDecomposition<T>::GetL() const
+	{
+		return L;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <FloatingPoint T>
+	FQRDecomposition<T>::FQRDecomposition(Memory::FAllocator &InAllocator)
+		: QR(InAllocator), Scales(InAllocator), Workspace(InAllocator) {}
+
+	template <FloatingPoint T>
+	bool FQRDecomposition<T>::Compute(const FMatrixX<T> &A)
+	{
+		bValid = false;
+		const int64 M = A.GetRows();
+		const int64 N = A.GetColumns();
+		if (M < N)
+			return false;
+
+		const T Tolerance = Math::Epsilon<T> * GetMaxAbs(A) * static_cast<T>(M);
+
+		QR = A;
+		Scales.Resize(static_cast<size_t>(N));
+		Workspace.Resize(static_cast<size_t>(std::max(M, N)));
+		T *const Dots = Workspace.GetData();
+
+		for (int64 k = 0; k < N; ++k)
+		{
+			T NormSquared = 0;
+			for (int64 i = k; i < M; ++i)
+				NormSquared += QR(i, k) * QR(i, k);
+			const T Norm = std::sqrt(NormSquared);
+			if (Norm <= Tolerance)
+				return false;
+
+			// Reflect column k onto -sign(x_k) * |x| e_k, with the Householder vector scaled so its first entry is 1
+			const T Head = QR(k, k);
+			const T Alpha = Head >= 0 ? -Norm : Norm;
+			const T InverseLead = 1 / (Head - Alpha);
+			T TailSquared = 0;
+			for (int64 i = k + 1; i < M; ++i)
+			{
+				QR(i, k) *= InverseLead;
+				TailSquared += QR(i, k) * QR(i, k);
+			}
+			const T Beta = 2 / (1 + TailSquared);
+			Scales[static_cast<size_t>(k)] = Beta;
+			QR(k, k) = Alpha;
+
+			// Apply the reflection to the remaining columns, sweeping rows for contiguous access
+			const T *const RowK = QR.GetRow(k).data();
+			for (int64 j = k + 1; j < N; ++j)
+				Dots[j] = RowK[j];
+			for (int64 i = k + 1; i < M; ++i)
+			{
+				const T *RESTRICT const Row = QR.GetRow(i).data();
+				const T V = Row[k];
+				for (int64 j = k + 1; j < N; ++j)
+					Dots[j] += V * Row[j];
+			}
+			for (int64 j = k + 1; j < N; ++j)
+				QR(k, j) -= Beta * Dots[j];
+			for (int64 i = k + 1; i < M; ++i)
+			{
+				T *RESTRICT const Row = QR.GetRow(i).data();
+				const T V = Beta * Row[k];
+				for (int64 j = k + 1; j < N; ++j)
+					Row[j] -= V * Dots[j];
+			}
+		}
+
+		bValid = true;
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FQRDecomposition<T>::Solve(std::span<const T> B, std::span<T> X) const
+	{
+		const int64 M = QR.GetRows();
+		const int64 N = QR.GetColumns();
+		if (!bValid || static_cast<int64>(B.size()) != M || static_cast<int64>(X.size()) != N)
+			return false;
+
+		// Y = Q^T * B, one reflection at a time
+		T *const Y = Workspace.GetData();
+		std::copy(B.begin(), B.end(), Y);
+		for (int64 k = 0; k < N; ++k)
+		{
+			T Dot = Y[k];
+			for (int64 i = k + 1; i < M; ++i)
+				Dot += QR(i, k) * Y[i];
+			Dot *= Scales[static_cast<size_t>(k)];
+			Y[k] -= Dot;
+			for (int64 i = k + 1; i < M; ++i)
+				Y[i] -= Dot * QR(i, k);
+		}
+
+		for (int64 i = N - 1; i >= 0; --i)
+		{
+			const T *const Row = QR.GetRow(i).data();
+			T Sum = Y[i];
+			for (int64 k = i + 1; k < N; ++k)
+				Sum -= Row[k] * X[static_cast<size_t>(k)];
+			X[static_cast<size_t>(i)] = Sum / Row[i];
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T> FQRDecomposition<T>::GetR() const
+	{
+		const int64 N = QR.GetColumns();
+		FMatrixX<T> R(N, N);
+		for (int64 i = 0; i < N; ++i)
+		{
+			for (int64 j = i; j < N; ++j)
+				R(i, j) = QR(i, j);
+		}
+		return R;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <FloatingPoint T>
+	FSymmetricEigen3x3<T> EigenDecompose(const FSymmetricMatrix3x3<T> &A)
+	{
+		FSymmetricEigen3x3<T> Result;
+		EigenDecomposeLanes<T, 1>(&A, &Result, 1);
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	void EigenDecomposeBatch(std::span<const FSymmetricMatrix3x3<T>> Matrices, std::span<FSymmetricEigen3x3<T>> OutResults)
+	{
+		const int64 Count = static_cast<int64>(std::min(Matrices.size(), OutResults.size()));
+
+		RATCHET_INSTRUMENT_BATCH(MatrixEigen3x3Batch, Count);
+
+		Parallel::ParallelFor(Count, BatchSize, [&](const int64 Begin, const int64 End)
+							  {
+			for (int64 First = Begin; First < End; First += LaneCount)
+				EigenDecomposeLanes<T, LaneCount>(Matrices.data() + First, OutResults.data() + First, static_cast<int32>(std::min<int64>(LaneCount, End - First))); });
+	}
+
+	template <FloatingPoint T>
+	bool Solve3x3(const FSymmetricMatrix3x3<T> &A, const FVector3D<T> &B, FVector3D<T> &OutX)
+	{
+		return Solve3x3Lanes<T, 1>(&A, &B, &OutX, 1) == 0;
+	}
+
+	template <FloatingPoint T>
+	int64 Solve3x3Batch(std::span<const FSymmetricMatrix3x3<T>> A, std::span<const FVector3D<T>> B, std::span<FVector3D<T>> OutX)
+	{
+		const int64 Count = static_cast<int64>(std::min({A.size(), B.size(), OutX.size()}));
+
+		RATCHET_INSTRUMENT_BATCH(MatrixSolve3x3Batch, Count);
+
+		std::atomic<int64> SingularCount{0};
+		Parallel::ParallelFor(Count, BatchSize, [&](const int64 Begin, const int64 End)
+							  {
+			int64 BatchSingular = 0;
+			for (int64 First = Begin; First < End; First += LaneCount)
+				BatchSingular += Solve3x3Lanes<T, LaneCount>(A.data() + First, B.data() + First, OutX.data() + First, static_cast<int32>(std::min<int64>(LaneCount, End - First)));
+			SingularCount.fetch_add(BatchSingular, std::memory_order_relaxed); });
+		return SingularCount.load(std::memory_order_relaxed);
+	}
+
+	// Explicit instantiation for float
+	template class FLUDecomposition<float>;
+	template class FCholeskyDecomposition<float>;
+	template class FQRDecomposition<float>;
+	template FSymmetricEigen3x3<float> EigenDecompose<float>(const FSymmetricMatrix3x3<float> &A);
+	template void EigenDecomposeBatch<float>(std::span<const FSymmetricMatrix3x3<float>> Matrices, std::span<FSymmetricEigen3x3<float>> OutResults);
+	template bool Solve3x3<float>(const FSymmetricMatrix3x3<float> &A, const FVector3D<float> &B, FVector3D<float> &OutX);
+	template int64 Solve3x3Batch<float>(std::span<const FSymmetricMatrix3x3<float>> A, std::span<const FVector3D<float>> B, std::span<FVector3D<float>> OutX);
+
+	// Explicit instantiation for double
+	template class FLUDecomposition<double>;
+	template class FCholeskyDecomposition<double>;
+	template class FQRDecomposition<double>;
+	template FSymmetricEigen3x3<double> EigenDecompose<double>(const FSymmetricMatrix3x3<double> &A);
+	template void EigenDecomposeBatch<double>(std::span<const FSymmetricMatrix3x3<double>> Matrices, std::span<FSymmetricEigen3x3<double>> OutResults);
+	template bool Solve3x3<double>(const FSymmetricMatrix3x3<double> &A, const FVector3D<double> &B, FVector3D<double> &OutX);
+	template int64 Solve3x3Batch<double>(std::span<const FSymmetricMatrix3x3<double>> A, std::span<const FVector3D<double>> B, std::span<FVector3D<double>> OutX);
+
+	// Explicit instantiation for long double
+	template class FLUDecomposition<long double>;
+	template class FCholeskyDecomposition<long double>;
+	template class FQRDecomposition<long double>;
+	template FSymmetricEigen3x3<long double> EigenDecompose<long double>(const FSymmetricMatrix3x3<long double> &A);
+	template void EigenDecomposeBatch<long double>(std::span<const FSymmetricMatrix3x3<long double>> Matrices, std::span<FSymmetricEigen3x3<long double>> OutResults);
+	template bool Solve3x3<long double>(const FSymmetricMatrix3x3<long double> &A, const FVector3D<long double> &B, FVector3D<long double> &OutX);
+	template int64 Solve3x3Batch<long double>(std::span<const FSymmetricMatrix3x3<long double>> A, std::span<const FVector3D<long double>> B, std::span<FVector3D<long double>> OutX);
+}
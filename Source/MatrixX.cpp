@@ -0,0 +1,463 @@
+#include "MatrixX.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Ratchet
+{
+	namespace
+	{
+		/**
+		 * Blocking of the GEMM loops. A KC x NR panel of B stays in L1 while the MR x NR tile of C lives in
+		 * registers; the MC x KC block of A is sized for L2 and the KC x NC block of B for L3.
+		 */
+		template <typename T>
+		struct TGemmBlocking
+		{
+			static constexpr int64 MR = 4;
+			static constexpr int64 NR = sizeof(T) <= 16 ? 32 / sizeof(T) : 2;
+			static constexpr int64 KC = 256;
+			static constexpr int64 MC = (128 * 1024 / (KC * sizeof(T))) / MR * MR;
+			static constexpr int64 NC = 4096;
+		};
+
+		// Rows of A or B per worker batch in GEMV, and in the Beta scaling of C
+		constexpr int64 GemvBatchSize = 16384;
+
+		// Pack buffers of A are handed to fixed partitions of row blocks, a few per worker to balance the load
+		constexpr int64 PartitionsPerWorker = 4;
+
+		// Accessor for op(M)(Row, Column) on a row-major matrix
+		template <typename T>
+		struct FOperand
+		{
+			const T *Data;
+			int64 Stride;
+			bool bTranspose;
+
+			T operator()(const int64 Row, const int64 Column) const
+			{
+				return bTranspose ? Data[Column * Stride + Row] : Data[Row * Stride + Column];
+			}
+		};
+
+		// Packs an Rows x Depth block of op(A) into MR-row panels, each stored column by column, zero-padded
+		template <typename T>
+		void PackA(const FOperand<T> &A, const int64 RowBegin, const int64 Rows, const int64 DepthBegin, const int64 Depth, T *RESTRICT Out)
+		{
+			constexpr int64 MR = TGemmBlocking<T>::MR;
+			for (int64 PanelRow = 0; PanelRow < Rows; PanelRow += MR)
+			{
+				const int64 PanelRows = std::min(MR, Rows - PanelRow);
+				for (int64 k = 0; k < Depth; ++k)
+				{
+					for (int64 i = 0; i < MR; ++i)
+						*Out++ = i < PanelRows ? A(RowBegin + PanelRow + i, DepthBegin + k) : 0;
+				}
+			}
+		}
+
+		// Packs panel Panel of a Depth x Columns block of op(B) as NR-wide rows, zero-padded
+		template <typename T>
+		void PackBPanel(const FOperand<T> &B, const int64 DepthBegin, const int64 Depth, const int64 ColumnBegin, const int64 Columns, const int64 Panel, T *RESTRICT Out)
+		{
+			constexpr int64 NR = TGemmBlocking<T>::NR;
+			const int64 PanelColumn = Panel * NR;
+			const int64 PanelColumns = std::min(NR, Columns - PanelColumn);
+			Out += Panel * NR * Depth;
+			for (int64 k = 0; k < Depth; ++k)
+			{
+				for (int64 j = 0; j < NR; ++j)
+					*Out++ = j < PanelColumns ? B(DepthBegin + k, ColumnBegin + PanelColumn + j) : 0;
+			}
+		}
+
+		// C[0:Rows, 0:Columns] += Alpha * (packed A panel) * (packed B panel), accumulating a full MR x NR tile in registers
+		template <typename T>
+		void MicroKernel(const int64 Depth, const T *RESTRICT A, const T *RESTRICT B, T *RESTRICT C, const int64 StrideC,
+						 const int64 Rows, const int64 Columns, const T Alpha)
+		{
+			constexpr int64 MR = TGemmBlocking<T>::MR;
+			constexpr int64 NR = TGemmBlocking<T>::NR;
+
+			T Tile[MR][NR] = {};
+			for (int64 k = 0; k < Depth; ++k)
+			{
+				for (int64 i = 0; i < MR; ++i)
+				{
+					const T Value = A[k * MR + i];
+					for (int64 j = 0; j < NR; ++j)
+						Tile[i][j] += Value * B[k * NR + j];
+				}
+			}
+
+			if (Rows == MR && Columns == NR)
+			{
+				for (int64 i = 0; i < MR; ++i)
+				{
+					for (int64 j = 0; j < NR; ++j)
+						C[i * StrideC + j] += Alpha * Tile[i][j];
+				}
+			}
+			else
+			{
+				for (int64 i = 0; i < Rows; ++i)
+				{
+					for (int64 j = 0; j < Columns; ++j)
+						C[i * StrideC + j] += Alpha * Tile[i][j];
+				}
+			}
+		}
+
+		// Dot product with independent partial sums, which the compiler may keep in one SIMD register
+		template <typename T>
+		T DotProduct(const T *RESTRICT A, const T *RESTRICT B, const int64 Count)
+		{
+			constexpr int32 LaneCount = 8;
+			T Lanes[LaneCount] = {};
+
+			int64 i = 0;
+			for (; i + LaneCount <= Count; i += LaneCount)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Lanes[Lane] += A[i + Lane] * B[i + Lane];
+			}
+
+			T Result = 0;
+			for (; i < Count; ++i)
+				Result += A[i] * B[i];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Result += Lanes[Lane];
+			return Result;
+		}
+
+		template <typename T>
+		void ScaleRange(T *RESTRICT Values, const int64 Count, const T Scale)
+		{
+			if (Scale == 0)
+				std::fill_n(Values, Count, static_cast<T>(0));
+			else if (Scale != 1)
+			{
+				for (int64 i = 0; i < Count; ++i)
+					Values[i] *= Scale;
+			}
+		}
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T>::FMatrixX(Memory::FAllocator &InAllocator)
+		: Data(InAllocator) {}
+
+	template <FloatingPoint T>
+	FMatrixX<T>::FMatrixX(const int64 InRows, const int64 InColumns, Memory::FAllocator &InAllocator)
+		: Data(static_cast<size_t>(InRows * InColumns), InAllocator), Rows(InRows), Columns(InColumns) {}
+
+	template <FloatingPoint T>
+	FMatrixX<T>::FMatrixX(const FMatrixX &Other)
+		: Data(Other.Data.Num(), Other.Data.GetAllocator()), Rows(Other.Rows), Columns(Other.Columns)
+	{
+		std::copy_n(Other.Data.GetData(), Other.Data.Num(), Data.GetData());
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T> &FMatrixX<T>::operator=(const FMatrixX &Other)
+	{
+		if (this != &Other)
+		{
+			Data.Resize(Other.Data.Num());
+			std::copy_n(Other.Data.GetData(), Other.Data.Num(), Data.GetData());
+			Rows = Other.Rows;
+			Columns = Other.Columns;
+		}
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T>::FMatrixX(FMatrixX &&Other) noexcept
+		: Data(std::move(Other.Data)), Rows(std::exchange(Other.Rows, 0)), Columns(std::exchange(Other.Columns, 0)) {}
+
+	template <FloatingPoint T>
+	FMatrixX<T> &FMatrixX<T>::operator=(FMatrixX &&Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Data = std::move(Other.Data);
+			Rows = std::exchange(Other.Rows, 0);
+			Columns = std::exchange(Other.Columns, 0);
+		}
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	T &FMatrixX<T>::operator()(const int64 Row, const int64 Column)
+	{
+		return Data[static_cast<size_t>(Row * Columns + Column)];
+	}
+
+	template <FloatingPoint T>
+	const T &FMatrixX<T>::operator()(const int64 Row, const int64 Column) const
+	{
+		return Data[static_cast<size_t>(Row * Columns + Column)];
+	}
+
+	template <FloatingPoint T>
+	void FMatrixX<T>::Resize(const int64 InRows, const int64 InColumns)
+	{
+		Data.Resize(static_cast<size_t>(InRows * InColumns));
+		Rows = InRows;
+		Columns = InColumns;
+		SetZero();
+	}
+
+	template <FloatingPoint T>
+	void FMatrixX<T>::SetZero()
+	{
+		std::fill_n(Data.GetData(), Data.Num(), static_cast<T>(0));
+	}
+
+	template <FloatingPoint T>
+	void FMatrixX<T>::SetIdentity()
+	{
+		SetZero();
+		for (int64 i = 0; i < std::min(Rows, Columns); ++i)
+			Data[static_cast<size_t>(i * Columns + i)] = 1;
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T> FMatrixX<T>::GetTransposed() const
+	{
+		constexpr int64 TileSize = 32;
+
+		FMatrixX Result(Columns, Rows, Data.GetAllocator());
+		const T *RESTRICT const Source = Data.GetData();
+		T *RESTRICT const Target = Result.Data.GetData();
+
+		// Square tiles keep both the reads and the strided writes within a few cache lines
+		for (int64 RowTile = 0; RowTile < Rows; RowTile += TileSize)
+		{
+			for (int64 ColumnTile = 0; ColumnTile < Columns; ColumnTile += TileSize)
+			{
+				for (int64 Row = RowTile; Row < std::min(Rows, RowTile + TileSize); ++Row)
+				{
+					for (int64 Column = ColumnTile; Column < std::min(Columns, ColumnTile + TileSize); ++Column)
+						Target[Column * Rows + Row] = Source[Row * Columns + Column];
+				}
+			}
+		}
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	int64 FMatrixX<T>::GetRows() const
+	{
+		return Rows;
+	}
+
+	template <FloatingPoint T>
+	int64 FMatrixX<T>::GetColumns() const
+	{
+		return Columns;
+	}
+
+	template <FloatingPoint T>
+	bool FMatrixX<T>::IsEmpty() const
+	{
+		return Rows == 0 || Columns == 0;
+	}
+
+	template <FloatingPoint T>
+	std::span<T> FMatrixX<T>::GetRow(const int64 Row)
+	{
+		return {Data.GetData() + Row * Columns, static_cast<size_t>(Columns)};
+	}
+
+	template <FloatingPoint T>
+	std::span<const T> FMatrixX<T>::GetRow(const int64 Row) const
+	{
+		return {Data.GetData() + Row * Columns, static_cast<size_t>(Columns)};
+	}
+
+	template <FloatingPoint T>
+	T *FMatrixX<T>::GetData()
+	{
+		return Data.GetData();
+	}
+
+	template <FloatingPoint T>
+	const T *FMatrixX<T>::GetData() const
+	{
+		return Data.GetData();
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <FloatingPoint T>
+	bool Gemm(const FMatrixX<T> &A, const FMatrixX<T> &B, FMatrixX<T> &C, const T Alpha, const T Beta,
+			  const EMatrixTranspose TransposeA, const EMatrixTranspose TransposeB, Memory::FAllocator &Allocator)
+	{
+		using FBlocking = TGemmBlocking<T>;
+
+		const bool bTransposeA = TransposeA == EMatrixTranspose::Transpose;
+		const bool bTransposeB = TransposeB == EMatrixTranspose::Transpose;
+		const int64 M = bTransposeA ? A.GetColumns() : A.GetRows();
+		const int64 K = bTransposeA ? A.GetRows() : A.GetColumns();
+		const int64 N = bTransposeB ? B.GetRows() : B.GetColumns();
+
+		if ((bTransposeB ? B.GetColumns() : B.GetRows()) != K || C.GetRows() != M || C.GetColumns() != N)
+			return false;
+
+		// Counts multiply-adds
+		RATCHET_INSTRUMENT_BATCH(MatrixGemm, M * N * K);
+
+		T *const DataC = C.GetData();
+		Parallel::ParallelFor(M * N, GemvBatchSize, [&](const int64 Begin, const int64 End)
+							  { ScaleRange(DataC + Begin, End - Begin, Beta); });
+
+		if (M == 0 || N == 0 || K == 0 || Alpha == 0)
+			return true;
+
+		const FOperand<T> OperandA{A.GetData(), A.GetColumns(), bTransposeA};
+		const FOperand<T> OperandB{B.GetData(), B.GetColumns(), bTransposeB};
+
+		// Shrink the row blocks of small products so every worker gets one
+		const int64 WorkerCount = Parallel::GetWorkerCount();
+		const int64 RowsPerWorker = (M + WorkerCount - 1) / WorkerCount;
+		const int64 BlockRows = std::min(FBlocking::MC, (RowsPerWorker + FBlocking::MR - 1) / FBlocking::MR * FBlocking::MR);
+		const int64 RowBlockCount = (M + BlockRows - 1) / BlockRows;
+		const int64 PartitionCount = std::min(RowBlockCount, WorkerCount * PartitionsPerWorker);
+
+		// Scratch for one packed block of B and one packed block of A per partition, released on return
+		const int64 MaxDepth = std::min(FBlocking::KC, K);
+		const int64 MaxPanelCount = (std::min(FBlocking::NC, N) + FBlocking::NR - 1) / FBlocking::NR;
+		Memory::FAlignedBuffer<T, CacheLineSize> PackedB(static_cast<size_t>(MaxPanelCount * FBlocking::NR * MaxDepth), Allocator);
+		Memory::FAlignedBuffer<T, CacheLineSize> PackedA(static_cast<size_t>(PartitionCount * BlockRows * MaxDepth), Allocator);
+
+		for (int64 ColumnBlock = 0; ColumnBlock < N; ColumnBlock += FBlocking::NC)
+		{
+			const int64 BlockColumns = std::min(FBlocking::NC, N - ColumnBlock);
+			const int64 PanelCount = (BlockColumns + FBlocking::NR - 1) / FBlocking::NR;
+
+			for (int64 DepthBlock = 0; DepthBlock < K; DepthBlock += FBlocking::KC)
+			{
+				const int64 BlockDepth = std::min(FBlocking::KC, K - DepthBlock);
+
+				T *const BlockB = PackedB.GetData();
+				Parallel::ParallelFor(PanelCount, 16, [&](const int64 Begin, const int64 End)
+									  {
+					for (int64 Panel = Begin; Panel < End; ++Panel)
+						PackBPanel(OperandB, DepthBlock, BlockDepth, ColumnBlock, BlockColumns, Panel, BlockB); });
+
+				Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+									  {
+					for (int64 Partition = Begin; Partition < End; ++Partition)
+					{
+						T *const BlockA = PackedA.GetData() + Partition * BlockRows * MaxDepth;
+						const int64 LastRowBlock = RowBlockCount * (Partition + 1) / PartitionCount;
+						for (int64 RowBlock = RowBlockCount * Partition / PartitionCount; RowBlock < LastRowBlock; ++RowBlock)
+						{
+							const int64 FirstRow = RowBlock * BlockRows;
+							const int64 Rows = std::min(BlockRows, M - FirstRow);
+							PackA(OperandA, FirstRow, Rows, DepthBlock, BlockDepth, BlockA);
+
+							for (int64 PanelColumn = 0; PanelColumn < BlockColumns; PanelColumn += FBlocking::NR)
+							{
+								const T *const PanelB = BlockB + PanelColumn * BlockDepth;
+								for (int64 PanelRow = 0; PanelRow < Rows; PanelRow += FBlocking::MR)
+								{
+									MicroKernel(BlockDepth, BlockA + PanelRow * BlockDepth, PanelB,
+												DataC + (FirstRow + PanelRow) * N + ColumnBlock + PanelColumn, N,
+												std::min(FBlocking::MR, Rows - PanelRow), std::min(FBlocking::NR, BlockColumns - PanelColumn), Alpha);
+								}
+							}
+						}
+					} });
+			}
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool Gemv(const FMatrixX<T> &A, std::span<const T> X, std::span<T> Y, const T Alpha, const T Beta, const EMatrixTranspose TransposeA)
+	{
+		const int64 Rows = A.GetRows();
+		const int64 Columns = A.GetColumns();
+		const T *const DataA = A.GetData();
+		const T *const DataX = X.data();
+		T *const DataY = Y.data();
+
+		if (TransposeA == EMatrixTranspose::None)
+		{
+			if (static_cast<int64>(X.size()) != Columns || static_cast<int64>(Y.size()) != Rows)
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(MatrixGemv, Rows * Columns);
+
+			Parallel::ParallelFor(Rows, std::max<int64>(1, GemvBatchSize / std::max<int64>(1, Columns)), [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 Row = Begin; Row < End; ++Row)
+				{
+					const T Product = Alpha * DotProduct(DataA + Row * Columns, DataX, Columns);
+					DataY[Row] = Beta == 0 ? Product : Product + Beta * DataY[Row];
+				} });
+		}
+		else
+		{
+			if (static_cast<int64>(X.size()) != Rows || static_cast<int64>(Y.size()) != Columns)
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(MatrixGemv, Rows * Columns);
+
+			// Each batch owns a range of Y and sweeps the matching column strip of A row by row
+			Parallel::ParallelFor(Columns, 256, [&](const int64 Begin, const int64 End)
+								  {
+				T *RESTRICT const Out = DataY + Begin;
+				const int64 Count = End - Begin;
+				ScaleRange(Out, Count, Beta);
+				for (int64 Row = 0; Row < Rows; ++Row)
+				{
+					const T Scale = Alpha * DataX[Row];
+					const T *RESTRICT const In = DataA + Row * Columns + Begin;
+					for (int64 i = 0; i < Count; ++i)
+						Out[i] += Scale * In[i];
+				} });
+		}
+		return true;
+	}
+
+	template <FloatingPoint T>
+	FMatrixX<T> operator*(const FMatrixX<T> &A, const FMatrixX<T> &B)
+	{
+		if (A.GetColumns() != B.GetRows())
+			return FMatrixX<T>();
+
+		FMatrixX<T> Result(A.GetRows(), B.GetColumns());
+		Gemm(A, B, Result);
+		return Result;
+	}
+
+	// Explicit instantiation for float
+	template class FMatrixX<float>;
+	template bool Gemm<float>(const FMatrixX<float> &A, const FMatrixX<float> &B, FMatrixX<float> &C, const float Alpha, const float Beta,
+							  const EMatrixTranspose TransposeA, const EMatrixTranspose TransposeB, Memory::FAllocator &Allocator);
+	template bool Gemv<float>(const FMatrixX<float> &A, std::span<const float> X, std::span<float> Y, const float Alpha, const float Beta,
+							  const EMatrixTranspose TransposeA);
+	template FMatrixX<float> operator*<float>(const FMatrixX<float> &A, const FMatrixX<float> &B);
+
+	// Explicit instantiation for double
+	template class FMatrixX<double>;
+	template bool Gemm<double>(const FMatrixX<double> &A, const FMatrixX<double> &B, FMatrixX<double> &C, const double Alpha, const double Beta,
+							   const EMatrixTranspose TransposeA, const EMatrixTranspose TransposeB, Memory::FAllocator &Allocator);
+	template bool Gemv<double>(const FMatrixX<double> &A, std::span<const double> X, std::span<double> Y, const double Alpha, const double Beta,
+							   const EMatrixTranspose TransposeA);
+	template FMatrixX<double> operator*<double>(const FMatrixX<double> &A, const FMatrixX<double> &B);
+
+	// Explicit instantiation for long double
+	template class FMatrixX<long double>;
+	template bool Gemm<long double>(const FMatrixX<long double> &A, const FMatrixX<long double> &B, FMatrixX<long double> &C, const long double Alpha,
+									const long double Beta, const EMatrixTranspose TransposeA, const EMatrixTranspose TransposeB, Memory::FAllocator &Allocator);
+	template bool Gemv<long double>(const FMatrixX<long double> &A, std::span<const long double> X, std::span<long double> Y, const long double Alpha,
+									const long double Beta, const EMatrixTranspose TransposeA);
+	template FMatrixX<long double> operator*<long double>(const FMatrixX<long double> &A, const FMatrixX<long double> &B);
+}
@@ -0,0 +1,191 @@
+#include "Memory.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Ratchet
+{
+	namespace Memory
+	{
+		namespace
+		{
+			size_t AlignUp(const size_t Value, const size_t Alignment)
+			{
+				return (Value + Alignment - 1) & ~(Alignment - 1);
+			}
+		}
+
+		void *FAllocator::Allocate(const size_t Size, const size_t Alignment)
+		{
+			void *Pointer = DoAllocate(Size, std::max(Alignment, alignof(std::max_align_t)));
+			if (Pointer == nullptr)
+			{
+				FailedCount.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			AllocationCount.fetch_add(1, std::memory_order_relaxed);
+			const uint64 InUse = BytesInUse.fetch_add(Size, std::memory_order_relaxed) + Size;
+			uint64 Peak = PeakBytesInUse.load(std::memory_order_relaxed);
+			while (InUse > Peak && !PeakBytesInUse.compare_exchange_weak(Peak, InUse, std::memory_order_relaxed))
+			{
+			}
+
+			return Pointer;
+		}
+
+		void FAllocator::Free(void *Pointer, const size_t Size, const size_t Alignment)
+		{
+			if (Pointer == nullptr)
+				return;
+
+			DoFree(Pointer, Size, std::max(Alignment, alignof(std::max_align_t)));
+			FreeCount.fetch_add(1, std::memory_order_relaxed);
+			BytesInUse.fetch_sub(Size, std::memory_order_relaxed);
+		}
+
+		FAllocatorStats FAllocator::GetStats() const
+		{
+			FAllocatorStats Stats;
+			Stats.AllocationCount = AllocationCount.load(std::memory_order_relaxed);
+			Stats.FreeCount = FreeCount.load(std::memory_order_relaxed);
+			Stats.FailedCount = FailedCount.load(std::memory_order_relaxed);
+			Stats.BytesInUse = BytesInUse.load(std::memory_order_relaxed);
+			Stats.PeakBytesInUse = PeakBytesInUse.load(std::memory_order_relaxed);
+			return Stats;
+		}
+
+		void FAllocator::ResetStats()
+		{
+			AllocationCount.store(0, std::memory_order_relaxed);
+			FreeCount.store(0, std::memory_order_relaxed);
+			FailedCount.store(0, std::memory_order_relaxed);
+			PeakBytesInUse.store(BytesInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		void FAllocator::SetBytesInUse(const uint64 Bytes)
+		{
+			BytesInUse.store(Bytes, std::memory_order_relaxed);
+		}
+
+		void *FHeapAllocator::DoAllocate(const size_t Size, const size_t Alignment)
+		{
+			return ::operator new(Size, std::align_val_t(Alignment), std::nothrow);
+		}
+
+		void FHeapAllocator::DoFree(void *Pointer, const size_t, const size_t Alignment)
+		{
+			::operator delete(Pointer, std::align_val_t(Alignment));
+		}
+
+		FAllocator &GetDefaultAllocator()
+		{
+			static FHeapAllocator DefaultAllocator;
+			return DefaultAllocator;
+		}
+
+		FLinearArena::FLinearArena(const size_t InCapacity, FAllocator &InBacking)
+			: Backing(InBacking),
+			  Base(static_cast<uint8 *>(InBacking.Allocate(InCapacity, CacheLineSize))),
+			  Capacity(Base != nullptr ? InCapacity : 0) {}
+
+		FLinearArena::~FLinearArena()
+		{
+			Backing.Free(Base, Capacity, CacheLineSize);
+		}
+
+		size_t FLinearArena::GetMarker() const
+		{
+			return Offset;
+		}
+
+		void FLinearArena::ResetToMarker(const size_t Marker)
+		{
+			Offset = std::min(Marker, Offset);
+			SetBytesInUse(Offset);
+		}
+
+		void FLinearArena::Reset()
+		{
+			ResetToMarker(0);
+		}
+
+		size_t FLinearArena::GetCapacity() const
+		{
+			return Capacity;
+		}
+
+		void *FLinearArena::DoAllocate(const size_t Size, const size_t Alignment)
+		{
+			const size_t Begin = AlignUp(reinterpret_cast<machine_address>(Base) + Offset, Alignment) - reinterpret_cast<machine_address>(Base);
+			if (Begin + Size > Capacity)
+				return nullptr;
+
+			Offset = Begin + Size;
+			return Base + Begin;
+		}
+
+		void FLinearArena::DoFree(void *, const size_t, const size_t)
+		{
+		}
+
+		FPoolAllocator::FPoolAllocator(const size_t InBlockSize, const size_t InBlockAlignment, const size_t InBlockCount, FAllocator &InBacking)
+			: Backing(InBacking),
+			  Base(nullptr),
+			  BlockSize(AlignUp(std::max(InBlockSize, sizeof(FFreeBlock)), std::max(InBlockAlignment, alignof(FFreeBlock)))),
+			  BlockAlignment(std::max(InBlockAlignment, alignof(FFreeBlock))),
+			  BlockCount(InBlockCount),
+			  FreeBlockCount(0)
+		{
+			Base = static_cast<uint8 *>(Backing.Allocate(BlockSize * BlockCount, BlockAlignment));
+			if (Base == nullptr)
+			{
+				BlockCount = 0;
+				return;
+			}
+
+			// Thread the free list front to back so consecutive allocations are contiguous
+			for (size_t i = BlockCount; i-- > 0;)
+			{
+				FFreeBlock *Block = reinterpret_cast<FFreeBlock *>(Base + i * BlockSize);
+				Block->Next = FreeList;
+				FreeList = Block;
+			}
+			FreeBlockCount = BlockCount;
+		}
+
+		FPoolAllocator::~FPoolAllocator()
+		{
+			Backing.Free(Base, BlockSize * BlockCount, BlockAlignment);
+		}
+
+		size_t FPoolAllocator::GetBlockSize() const
+		{
+			return BlockSize;
+		}
+
+		size_t FPoolAllocator::GetFreeBlockCount() const
+		{
+			return FreeBlockCount;
+		}
+
+		void *FPoolAllocator::DoAllocate(const size_t Size, const size_t Alignment)
+		{
+			if (Size > BlockSize || Alignment > BlockAlignment || FreeList == nullptr)
+				return nullptr;
+
+			FFreeBlock *Block = FreeList;
+			FreeList = Block->Next;
+			--FreeBlockCount;
+			return Block;
+		}
+
+		void FPoolAllocator::DoFree(void *Pointer, const size_t, const size_t)
+		{
+			FFreeBlock *Block = static_cast<FFreeBlock *>(Pointer);
+			Block->Next = FreeList;
+			FreeList = Block;
+			++FreeBlockCount;
+		}
+	}
+}
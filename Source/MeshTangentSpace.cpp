@@ -0,0 +1,380 @@
+#include "MeshTangentSpace.h"
+#include "Instrument.h"
+#include "Parallel.h"
+#include "REMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Triangles or vertices processed side by side; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Triangles or vertices per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 2048;
+
+		// Lengths and areas at or below this are treated as zero, as MikkTSpace does
+		template <typename T>
+		constexpr T Tiny = std::numeric_limits<T>::min();
+
+		/**
+		 * Normalizes the vectors of a lane block and returns their lengths; zero vectors stay zero.
+		 */
+		template <typename T>
+		void NormalizeLanes(T (&Vectors)[3][LaneCount], T (&OutLengths)[LaneCount])
+		{
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				OutLengths[Lane] = Vectors[0][Lane] * Vectors[0][Lane] + Vectors[1][Lane] * Vectors[1][Lane] + Vectors[2][Lane] * Vectors[2][Lane];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				OutLengths[Lane] = std::sqrt(OutLengths[Lane]);
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T Scale = OutLengths[Lane] > Tiny<T> ? 1 / OutLengths[Lane] : T(0);
+				for (int32 c = 0; c < 3; ++c)
+					Vectors[c][Lane] *= Scale;
+			}
+		}
+
+		/**
+		 * Projects the vectors of a lane block onto the planes of unit normals, then normalizes them.
+		 */
+		template <typename T>
+		void ProjectLanes(const T (&Normals)[3][LaneCount], T (&Vectors)[3][LaneCount], T (&OutLengths)[LaneCount])
+		{
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T Along = Normals[0][Lane] * Vectors[0][Lane] + Normals[1][Lane] * Vectors[1][Lane] + Normals[2][Lane] * Vectors[2][Lane];
+				for (int32 c = 0; c < 3; ++c)
+					Vectors[c][Lane] -= Along * Normals[c][Lane];
+			}
+			NormalizeLanes(Vectors, OutLengths);
+		}
+
+		/**
+		 * Gathers the corner positions of the triangles [Begin, Begin + Count). Partial blocks repeat their last
+		 * triangle in the unused lanes.
+		 */
+		template <typename T, bool bPartial>
+		void LoadTriangleLanes(const uint32 *Indices, const T *const (&Positions)[3], const int64 Begin, const int32 Count, uint32 (&OutCorners)[3][LaneCount],
+							   T (&OutPositions)[3][3][LaneCount])
+		{
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const int64 Triangle = Begin + (bPartial ? std::min(Lane, Count - 1) : Lane);
+				for (int32 k = 0; k < 3; ++k)
+					OutCorners[k][Lane] = Indices[3 * Triangle + k];
+			}
+			for (int32 k = 0; k < 3; ++k)
+			{
+				for (int32 c = 0; c < 3; ++c)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutPositions[k][c][Lane] = Positions[c][OutCorners[k][Lane]];
+				}
+			}
+		}
+
+		/**
+		 * Runs Kernel<bPartial>(Begin, Count) over the lane blocks of [Begin, End), the last one partial.
+		 */
+		template <typename KernelType>
+		void ForEachBlock(const int64 Begin, const int64 End, const KernelType &Kernel)
+		{
+			int64 Item = Begin;
+			for (; Item + LaneCount <= End; Item += LaneCount)
+				Kernel.template operator()<false>(Item, LaneCount);
+			if (Item < End)
+				Kernel.template operator()<true>(Item, static_cast<int32>(End - Item));
+		}
+	}
+
+	template <FloatingPoint T>
+	FMeshTangentSpace<T>::FMeshTangentSpace(Memory::FAllocator &InAllocator)
+		: Indices(InAllocator), CornerOffsets(InAllocator), VertexCorners(InAllocator),
+		  CornerVectors{Memory::FAlignedBuffer<T>(InAllocator), Memory::FAlignedBuffer<T>(InAllocator), Memory::FAlignedBuffer<T>(InAllocator),
+						Memory::FAlignedBuffer<T>(InAllocator)}
+	{
+	}
+
+	template <FloatingPoint T>
+	bool FMeshTangentSpace<T>::SetTopology(std::span<const uint32> InIndices, const int64 VertexCount)
+	{
+		Indices.Clear();
+		CornerOffsets.Clear();
+		VertexCorners.Clear();
+
+		const bool bValidCounts = InIndices.size() % 3 == 0 && InIndices.size() <= std::numeric_limits<uint32>::max() && VertexCount >= 0;
+		if (!bValidCounts || std::any_of(InIndices.begin(), InIndices.end(), [VertexCount](const uint32 Index)
+										 { return static_cast<int64>(Index) >= VertexCount; }))
+			return false;
+
+		const int64 CornerCount = static_cast<int64>(InIndices.size());
+		Indices.Resize(InIndices.size());
+		std::copy(InIndices.begin(), InIndices.end(), Indices.GetData());
+
+		// Counting sort of the corners by vertex; corners stay in ascending order within a vertex, which fixes
+		// the summation order
+		CornerOffsets.Resize(static_cast<size_t>(VertexCount) + 1, 0);
+		uint32 *const Offsets = CornerOffsets.GetData();
+		for (int64 Corner = 0; Corner < CornerCount; ++Corner)
+			++Offsets[InIndices[Corner] + 1];
+		for (int64 Vertex = 0; Vertex < VertexCount; ++Vertex)
+			Offsets[Vertex + 1] += Offsets[Vertex];
+
+		VertexCorners.Resize(InIndices.size());
+		for (int64 Corner = 0; Corner < CornerCount; ++Corner)
+			VertexCorners.GetData()[Offsets[InIndices[Corner]]++] = static_cast<uint32>(Corner);
+
+		// The fill advanced every offset to the start of the next vertex
+		for (int64 Vertex = VertexCount; Vertex > 0; --Vertex)
+			Offsets[Vertex] = Offsets[Vertex - 1];
+		Offsets[0] = 0;
+
+		for (Memory::FAlignedBuffer<T> &Stream : CornerVectors)
+			Stream.Resize(InIndices.size());
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FMeshTangentSpace<T>::ComputeNormals(const std::type_identity_t<FVector3DStreams<const T>> &Positions, const FVector3DStreams<T> &OutNormals)
+	{
+		const int64 VertexCount = GetVertexCount();
+		if (!Positions.IsValid() || !OutNormals.IsValid() || Positions.Num() != VertexCount || OutNormals.Num() != VertexCount)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(MeshComputeNormals, GetTriangleCount());
+
+		const uint32 *const TriangleIndices = Indices.GetData();
+		const T *const PositionStreams[3] = {Positions.X.data(), Positions.Y.data(), Positions.Z.data()};
+		T *const Faces[3] = {CornerVectors[0].GetData(), CornerVectors[1].GetData(), CornerVectors[2].GetData()};
+
+		// The cross product of two edges, twice the area times the unit normal
+		Parallel::ParallelFor(GetTriangleCount(), BatchSize, [&](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Count)
+											 {
+												 uint32 Corners[3][LaneCount];
+												 T P[3][3][LaneCount];
+												 LoadTriangleLanes<T, bPartial>(TriangleIndices, PositionStreams, First, Count, Corners, P);
+
+												 T Normals[3][LaneCount];
+												 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+												 {
+													 const T E1X = P[1][0][Lane] - P[0][0][Lane], E1Y = P[1][1][Lane] - P[0][1][Lane], E1Z = P[1][2][Lane] - P[0][2][Lane];
+													 const T E2X = P[2][0][Lane] - P[0][0][Lane], E2Y = P[2][1][Lane] - P[0][1][Lane], E2Z = P[2][2][Lane] - P[0][2][Lane];
+													 Normals[0][Lane] = E1Y * E2Z - E1Z * E2Y;
+													 Normals[1][Lane] = E1Z * E2X - E1X * E2Z;
+													 Normals[2][Lane] = E1X * E2Y - E1Y * E2X;
+												 }
+
+												 for (int32 c = 0; c < 3; ++c)
+												 {
+													 for (int32 Lane = 0; Lane < (bPartial ? Count : LaneCount); ++Lane)
+														 Faces[c][First + Lane] = Normals[c][Lane];
+												 }
+											 }); });
+
+		const uint32 *const Offsets = CornerOffsets.GetData();
+		const uint32 *const Corners = VertexCorners.GetData();
+		T *const NormalStreams[3] = {OutNormals.X.data(), OutNormals.Y.data(), OutNormals.Z.data()};
+
+		// Every vertex sums the faces around it
+		Parallel::ParallelFor(VertexCount, BatchSize, [&](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Count)
+											 {
+												 T Normals[3][LaneCount];
+												 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+												 {
+													 const int64 Vertex = First + (bPartial ? std::min(Lane, Count - 1) : Lane);
+													 T Sum[3] = {0, 0, 0};
+													 for (uint32 i = Offsets[Vertex]; i < Offsets[Vertex + 1]; ++i)
+													 {
+														 const uint32 Triangle = Corners[i] / 3;
+														 for (int32 c = 0; c < 3; ++c)
+															 Sum[c] += Faces[c][Triangle];
+													 }
+													 for (int32 c = 0; c < 3; ++c)
+														 Normals[c][Lane] = Sum[c];
+												 }
+
+												 T Lengths[LaneCount];
+												 NormalizeLanes(Normals, Lengths);
+												 for (int32 c = 0; c < 3; ++c)
+												 {
+													 for (int32 Lane = 0; Lane < (bPartial ? Count : LaneCount); ++Lane)
+														 NormalStreams[c][First + Lane] = Normals[c][Lane];
+												 }
+											 }); });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FMeshTangentSpace<T>::ComputeTangents(const std::type_identity_t<FVector3DStreams<const T>> &Positions, const std::type_identity_t<FVector2DStreams<const T>> &UVs,
+											   const std::type_identity_t<FVector3DStreams<const T>> &Normals, const FVector3DStreams<T> &OutTangents,
+											   std::type_identity_t<std::span<T>> OutSigns)
+	{
+		const int64 VertexCount = GetVertexCount();
+		if (!Positions.IsValid() || !UVs.IsValid() || !Normals.IsValid() || !OutTangents.IsValid() || Positions.Num() != VertexCount || UVs.Num() != VertexCount ||
+			Normals.Num() != VertexCount || OutTangents.Num() != VertexCount || static_cast<int64>(OutSigns.size()) != VertexCount)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(MeshComputeTangents, GetTriangleCount());
+
+		const uint32 *const TriangleIndices = Indices.GetData();
+		const T *const PositionStreams[3] = {Positions.X.data(), Positions.Y.data(), Positions.Z.data()};
+		const T *const UVStreams[2] = {UVs.X.data(), UVs.Y.data()};
+		const T *const NormalStreams[3] = {Normals.X.data(), Normals.Y.data(), Normals.Z.data()};
+		T *const CornerStreams[4] = {CornerVectors[0].GetData(), CornerVectors[1].GetData(), CornerVectors[2].GetData(), CornerVectors[3].GetData()};
+
+		// Every corner's share of its vertex: the direction of increasing U on the triangle (MikkTSpace's vOs),
+		// projected onto the tangent plane of the vertex normal, and the orientation of the UVs, both weighted
+		// by the corner angle in that plane. Triangles with degenerate UVs do not vote on the bitangent sign.
+		Parallel::ParallelFor(GetTriangleCount(), BatchSize, [&](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Count)
+											 {
+												 uint32 Corners[3][LaneCount];
+												 T P[3][3][LaneCount];
+												 LoadTriangleLanes<T, bPartial>(TriangleIndices, PositionStreams, First, Count, Corners, P);
+
+												 T UV[3][2][LaneCount];
+												 for (int32 k = 0; k < 3; ++k)
+												 {
+													 for (int32 c = 0; c < 2; ++c)
+													 {
+														 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+															 UV[k][c][Lane] = UVStreams[c][Corners[k][Lane]];
+													 }
+												 }
+
+												 T Gradients[3][LaneCount];
+												 T Orientations[LaneCount];
+												 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+												 {
+													 const T T21X = UV[1][0][Lane] - UV[0][0][Lane], T21Y = UV[1][1][Lane] - UV[0][1][Lane];
+													 const T T31X = UV[2][0][Lane] - UV[0][0][Lane], T31Y = UV[2][1][Lane] - UV[0][1][Lane];
+													 const T Area = T21X * T31Y - T21Y * T31X;
+													 Orientations[Lane] = std::abs(Area) > Tiny<T> ? std::copysign(T(1), Area) : T(0);
+													 for (int32 c = 0; c < 3; ++c)
+														 Gradients[c][Lane] = T31Y * (P[1][c][Lane] - P[0][c][Lane]) - T21Y * (P[2][c][Lane] - P[0][c][Lane]);
+												 }
+
+												 // Point the gradient along increasing U on mirrored triangles too; the projection below normalizes it
+												 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+												 {
+													 const T Sign = Orientations[Lane] < 0 ? T(-1) : T(1);
+													 for (int32 c = 0; c < 3; ++c)
+														 Gradients[c][Lane] *= Sign;
+												 }
+
+												 for (int32 k = 0; k < 3; ++k)
+												 {
+													 T Normal[3][LaneCount];
+													 for (int32 c = 0; c < 3; ++c)
+													 {
+														 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+															 Normal[c][Lane] = NormalStreams[c][Corners[k][Lane]];
+													 }
+
+													 T ToNext[3][LaneCount];
+													 T ToPrevious[3][LaneCount];
+													 T Tangent[3][LaneCount];
+													 for (int32 c = 0; c < 3; ++c)
+													 {
+														 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+														 {
+															 ToNext[c][Lane] = P[(k + 1) % 3][c][Lane] - P[k][c][Lane];
+															 ToPrevious[c][Lane] = P[(k + 2) % 3][c][Lane] - P[k][c][Lane];
+															 Tangent[c][Lane] = Gradients[c][Lane];
+														 }
+													 }
+
+													 T NextLengths[LaneCount];
+													 T PreviousLengths[LaneCount];
+													 T TangentLengths[LaneCount];
+													 ProjectLanes(Normal, ToNext, NextLengths);
+													 ProjectLanes(Normal, ToPrevious, PreviousLengths);
+													 ProjectLanes(Normal, Tangent, TangentLengths);
+
+													 T Weights[LaneCount];
+													 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+														 Weights[Lane] = ToNext[0][Lane] * ToPrevious[0][Lane] + ToNext[1][Lane] * ToPrevious[1][Lane] + ToNext[2][Lane] * ToPrevious[2][Lane];
+													 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+														 Weights[Lane] = Math::Acos(Weights[Lane]);
+
+													 // A collapsed corner has no angle
+													 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+													 {
+														 const bool bCollapsed = !(NextLengths[Lane] > Tiny<T>) || !(PreviousLengths[Lane] > Tiny<T>);
+														 Weights[Lane] = bCollapsed ? T(0) : Weights[Lane];
+														 for (int32 c = 0; c < 3; ++c)
+															 Tangent[c][Lane] *= Weights[Lane];
+													 }
+
+													 for (int32 Lane = 0; Lane < (bPartial ? Count : LaneCount); ++Lane)
+													 {
+														 const int64 Corner = 3 * (First + Lane) + k;
+														 for (int32 c = 0; c < 3; ++c)
+															 CornerStreams[c][Corner] = Tangent[c][Lane];
+														 CornerStreams[3][Corner] = Weights[Lane] * Orientations[Lane];
+													 }
+												 }
+											 }); });
+
+		const uint32 *const Offsets = CornerOffsets.GetData();
+		const uint32 *const Corners = VertexCorners.GetData();
+		T *const TangentStreams[3] = {OutTangents.X.data(), OutTangents.Y.data(), OutTangents.Z.data()};
+		T *const Signs = OutSigns.data();
+
+		// Every vertex sums its corners
+		Parallel::ParallelFor(VertexCount, BatchSize, [&](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Count)
+											 {
+												 T Tangents[3][LaneCount];
+												 T Votes[LaneCount];
+												 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+												 {
+													 const int64 Vertex = First + (bPartial ? std::min(Lane, Count - 1) : Lane);
+													 T Sum[4] = {0, 0, 0, 0};
+													 for (uint32 i = Offsets[Vertex]; i < Offsets[Vertex + 1]; ++i)
+													 {
+														 for (int32 c = 0; c < 4; ++c)
+															 Sum[c] += CornerStreams[c][Corners[i]];
+													 }
+													 for (int32 c = 0; c < 3; ++c)
+														 Tangents[c][Lane] = Sum[c];
+													 Votes[Lane] = Sum[3];
+												 }
+
+												 T Lengths[LaneCount];
+												 NormalizeLanes(Tangents, Lengths);
+												 for (int32 Lane = 0; Lane < (bPartial ? Count : LaneCount); ++Lane)
+												 {
+													 for (int32 c = 0; c < 3; ++c)
+														 TangentStreams[c][First + Lane] = Tangents[c][Lane];
+													 Signs[First + Lane] = Votes[Lane] < 0 ? T(-1) : T(1);
+												 }
+											 }); });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	int64 FMeshTangentSpace<T>::GetTriangleCount() const
+	{
+		return static_cast<int64>(Indices.Num() / 3);
+	}
+
+	template <FloatingPoint T>
+	int64 FMeshTangentSpace<T>::GetVertexCount() const
+	{
+		return CornerOffsets.IsEmpty() ? 0 : static_cast<int64>(CornerOffsets.Num() - 1);
+	}
+
+	// Explicit instantiation for float
+	template class FMeshTangentSpace<float>;
+
+	// Explicit instantiation for double
+	template class FMeshTangentSpace<double>;
+}
@@ -0,0 +1,432 @@
+#include "Noise.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ratchet
+{
+	namespace Noise
+	{
+		namespace
+		{
+			// Positions evaluated side by side; the lane loops are what the compiler vectorizes
+			constexpr int32 LaneCount = 8;
+
+			// Positions per worker batch, a multiple of LaneCount
+			constexpr int64 BatchSize = 1024;
+
+			// Per-axis multipliers of the lattice hash and the seed step between octaves
+			constexpr uint32 AxisPrimes[4] = {0x8DA6B343u, 0xD8163841u, 0xCB1AB31Fu, 0x165667B1u};
+			constexpr uint32 OctaveSeedStep = 0x9E3779B9u;
+
+			// Skew and unskew factors of the simplex lattice, (sqrt(D + 1) - 1) / D and (1 - 1 / sqrt(D + 1)) / D
+			template <int32 Dimension>
+			constexpr double SimplexSkew = Dimension == 2 ? 0.36602540378443864676 : Dimension == 3 ? 1.0 / 3 : 0.30901699437494742410;
+			template <int32 Dimension>
+			constexpr double SimplexUnskew = Dimension == 2 ? 0.21132486540518711775 : Dimension == 3 ? 1.0 / 6 : 0.13819660112501051518;
+
+			// Scales that bring the gradient noises to about [-1, 1], from the extremes of a few million random samples
+			template <int32 Dimension>
+			constexpr double PerlinScale = Dimension == 2 ? 1.0 : Dimension == 3 ? 1.0 : 0.87;
+			template <int32 Dimension>
+			constexpr double SimplexScale = Dimension == 2 ? 70.0 : Dimension == 3 ? 76.0 : 62.0;
+
+			/**
+			 * Hashes of lattice points, the cells plus offsets, ending in Wellons' lowbias32 finalizer.
+			 */
+			template <int32 Dimension>
+			void HashLanes(const uint32 Seed, const int32 (&Cells)[Dimension][LaneCount], const int32 (&Offsets)[Dimension][LaneCount],
+						   uint32 (&RESTRICT OutHashes)[LaneCount])
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutHashes[Lane] = Seed;
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutHashes[Lane] ^= static_cast<uint32>(Cells[d][Lane] + Offsets[d][Lane]) * AxisPrimes[d];
+				}
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					uint32 Hash = OutHashes[Lane];
+					Hash ^= Hash >> 16;
+					Hash *= 0x7FEB352Du;
+					Hash ^= Hash >> 15;
+					Hash *= 0x846CA68Bu;
+					Hash ^= Hash >> 16;
+					OutHashes[Lane] = Hash;
+				}
+			}
+
+			/**
+			 * Dot products of hashed gradients and offsets. Gradients have components 0 or +-1 with at most one
+			 * zero: the 8 directions of the square in 2D, the 12 cube edges in 3D, the 32 of Gustavson's 4D set.
+			 */
+			template <int32 Dimension, typename T>
+			void GradientDotLanes(const uint32 (&Hashes)[LaneCount], const T (&Deltas)[Dimension][LaneCount], T (&RESTRICT OutDots)[LaneCount])
+			{
+				constexpr uint32 ZeroChoices = Dimension == 2 ? 3 : Dimension;
+				uint32 Zero[LaneCount];
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					Zero[Lane] = (Hashes[Lane] >> 8) % ZeroChoices;
+					OutDots[Lane] = 0;
+				}
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const T Signed = ((Hashes[Lane] >> d) & 1) != 0 ? -Deltas[d][Lane] : Deltas[d][Lane];
+						OutDots[Lane] += Zero[Lane] == static_cast<uint32>(d) ? T(0) : Signed;
+					}
+				}
+			}
+
+			/**
+			 * Splits coordinates into their lattice cells and the positions within them.
+			 */
+			template <int32 Dimension, typename T>
+			void FloorLanes(const T (&Positions)[Dimension][LaneCount], int32 (&RESTRICT OutCells)[Dimension][LaneCount], T (&RESTRICT OutFractions)[Dimension][LaneCount])
+			{
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const int32 Truncated = static_cast<int32>(Positions[d][Lane]);
+						OutCells[d][Lane] = Truncated - (Positions[d][Lane] < static_cast<T>(Truncated));
+						OutFractions[d][Lane] = Positions[d][Lane] - static_cast<T>(OutCells[d][Lane]);
+					}
+				}
+			}
+
+			/**
+			 * Perlin noise with the quintic fade curve; every lattice corner contributes its fade-weighted gradient.
+			 */
+			template <int32 Dimension, typename T>
+			void PerlinLanes(const T (&Positions)[Dimension][LaneCount], const uint32 Seed, T (&RESTRICT OutValues)[LaneCount])
+			{
+				int32 Cells[Dimension][LaneCount];
+				T Fractions[Dimension][LaneCount], Fades[Dimension][LaneCount];
+				FloorLanes(Positions, Cells, Fractions);
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const T F = Fractions[d][Lane];
+						Fades[d][Lane] = F * F * F * (F * (F * 6 - 15) + 10);
+					}
+				}
+
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] = 0;
+				for (int32 Corner = 0; Corner < (1 << Dimension); ++Corner)
+				{
+					int32 Offsets[Dimension][LaneCount];
+					T Deltas[Dimension][LaneCount];
+					T Weights[LaneCount];
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Weights[Lane] = 1;
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						const bool bUpper = ((Corner >> d) & 1) != 0;
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						{
+							Offsets[d][Lane] = bUpper;
+							Deltas[d][Lane] = bUpper ? Fractions[d][Lane] - 1 : Fractions[d][Lane];
+							Weights[Lane] *= bUpper ? Fades[d][Lane] : 1 - Fades[d][Lane];
+						}
+					}
+
+					uint32 Hashes[LaneCount];
+					T Dots[LaneCount];
+					HashLanes(Seed, Cells, Offsets, Hashes);
+					GradientDotLanes(Hashes, Deltas, Dots);
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutValues[Lane] += Weights[Lane] * Dots[Lane];
+				}
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] *= static_cast<T>(PerlinScale<Dimension>);
+			}
+
+			/**
+			 * Simplex noise. The corners of the simplex holding a point follow from the ranks of its coordinates
+			 * within the skewed cell (Gustavson's 4D method, used for every dimension), so there are no branches.
+			 */
+			template <int32 Dimension, typename T>
+			void SimplexLanes(const T (&Positions)[Dimension][LaneCount], const uint32 Seed, T (&RESTRICT OutValues)[LaneCount])
+			{
+				constexpr T Skew = static_cast<T>(SimplexSkew<Dimension>);
+				constexpr T Unskew = static_cast<T>(SimplexUnskew<Dimension>);
+
+				T Skewed[Dimension][LaneCount];
+				T Shift[LaneCount] = {};
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Shift[Lane] += Positions[d][Lane];
+				}
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Skewed[d][Lane] = Positions[d][Lane] + Shift[Lane] * Skew;
+				}
+
+				int32 Cells[Dimension][LaneCount];
+				T Origins[Dimension][LaneCount];
+				FloorLanes(Skewed, Cells, Origins);
+
+				// Offset from the cell origin in unskewed space
+				T Unskewed[LaneCount] = {};
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Unskewed[Lane] += static_cast<T>(Cells[d][Lane]);
+				}
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Origins[d][Lane] = Positions[d][Lane] - (static_cast<T>(Cells[d][Lane]) - Unskewed[Lane] * Unskew);
+				}
+
+				int32 Ranks[Dimension][LaneCount] = {};
+				for (int32 i = 0; i < Dimension; ++i)
+				{
+					for (int32 j = i + 1; j < Dimension; ++j)
+					{
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						{
+							const int32 bGreater = Origins[i][Lane] > Origins[j][Lane];
+							Ranks[i][Lane] += bGreater;
+							Ranks[j][Lane] += 1 - bGreater;
+						}
+					}
+				}
+
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] = 0;
+				for (int32 Corner = 0; Corner <= Dimension; ++Corner)
+				{
+					int32 Offsets[Dimension][LaneCount];
+					T Deltas[Dimension][LaneCount];
+					T Falloffs[LaneCount];
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Falloffs[Lane] = T(0.5);
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						{
+							Offsets[d][Lane] = Ranks[d][Lane] >= Dimension - Corner;
+							Deltas[d][Lane] = Origins[d][Lane] - static_cast<T>(Offsets[d][Lane]) + static_cast<T>(Corner) * Unskew;
+							Falloffs[Lane] -= Deltas[d][Lane] * Deltas[d][Lane];
+						}
+					}
+
+					uint32 Hashes[LaneCount];
+					T Dots[LaneCount];
+					HashLanes(Seed, Cells, Offsets, Hashes);
+					GradientDotLanes(Hashes, Deltas, Dots);
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const T Falloff = std::max(Falloffs[Lane], T(0));
+						const T Squared = Falloff * Falloff;
+						OutValues[Lane] += Squared * Squared * Dots[Lane];
+					}
+				}
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] *= static_cast<T>(SimplexScale<Dimension>);
+			}
+
+			/**
+			 * Worley noise: the distance to the nearest feature point, one per cell at a hashed position, among
+			 * the 3^D cells around the point.
+			 */
+			template <int32 Dimension, typename T>
+			void WorleyLanes(const T (&Positions)[Dimension][LaneCount], const uint32 Seed, T (&RESTRICT OutValues)[LaneCount])
+			{
+				constexpr int32 NeighborCount = Dimension == 2 ? 9 : Dimension == 3 ? 27 : 81;
+
+				int32 Cells[Dimension][LaneCount];
+				T Fractions[Dimension][LaneCount];
+				FloorLanes(Positions, Cells, Fractions);
+
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] = static_cast<T>(Dimension);
+				for (int32 Neighbor = 0; Neighbor < NeighborCount; ++Neighbor)
+				{
+					int32 Offsets[Dimension][LaneCount];
+					int32 Digits = Neighbor;
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+							Offsets[d][Lane] = Digits % 3 - 1;
+						Digits /= 3;
+					}
+
+					// Successive PCG steps of the cell hash give the coordinates of its feature point
+					uint32 Hashes[LaneCount];
+					T DistancesSquared[LaneCount] = {};
+					HashLanes(Seed, Cells, Offsets, Hashes);
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						{
+							Hashes[Lane] = Hashes[Lane] * 747796405u + 2891336453u;
+							const T Feature = static_cast<T>(Offsets[d][Lane]) + static_cast<T>(static_cast<int32>(Hashes[Lane] >> 8)) * T(1.0 / 16777216);
+							DistancesSquared[Lane] += (Feature - Fractions[d][Lane]) * (Feature - Fractions[d][Lane]);
+						}
+					}
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutValues[Lane] = std::min(OutValues[Lane], DistancesSquared[Lane]);
+				}
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutValues[Lane] = std::sqrt(OutValues[Lane]);
+			}
+
+			/**
+			 * Runs Kernel<bPartial>(Begin, Count) over the lane blocks of [Begin, End), the last one partial.
+			 */
+			template <typename KernelType>
+			void ForEachBlock(const int64 Begin, const int64 End, const KernelType &Kernel)
+			{
+				int64 Item = Begin;
+				for (; Item + LaneCount <= End; Item += LaneCount)
+					Kernel.template operator()<false>(Item, LaneCount);
+				if (Item < End)
+					Kernel.template operator()<true>(Item, static_cast<int32>(End - Item));
+			}
+
+			/**
+			 * Sums the octaves of one kind of noise over the positions. Partial blocks repeat their last position
+			 * in the unused lanes.
+			 */
+			template <int32 Dimension, typename T, typename NoiseType>
+			void EvaluateOctaves(const T *const (&Positions)[Dimension], const int64 Count, T *const OutValues, const uint32 Seed, const FNoiseSettings<T> &Settings,
+								 const NoiseType &NoiseLanes)
+			{
+				T Normalization = 0;
+				T Amplitude = 1;
+				for (int32 Octave = 0; Octave < Settings.Octaves; ++Octave)
+				{
+					Normalization += Amplitude;
+					Amplitude *= Settings.Gain;
+				}
+				Normalization = Normalization != 0 ? 1 / Normalization : T(0);
+
+				Parallel::ParallelFor(Count, BatchSize, [&](const int64 Begin, const int64 End)
+									  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Valid)
+													 {
+														 T Loaded[Dimension][LaneCount];
+														 for (int32 d = 0; d < Dimension; ++d)
+														 {
+															 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+																 Loaded[d][Lane] = Positions[d][First + (bPartial ? std::min(Lane, Valid - 1) : Lane)];
+														 }
+
+														 T Sum[LaneCount] = {};
+														 T Frequency = Settings.Frequency;
+														 T Weight = 1;
+														 for (int32 Octave = 0; Octave < Settings.Octaves; ++Octave)
+														 {
+															 T Scaled[Dimension][LaneCount];
+															 for (int32 d = 0; d < Dimension; ++d)
+															 {
+																 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+																	 Scaled[d][Lane] = Loaded[d][Lane] * Frequency;
+															 }
+
+															 T Values[LaneCount];
+															 NoiseLanes(Scaled, Seed + static_cast<uint32>(Octave) * OctaveSeedStep, Values);
+															 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+																 Sum[Lane] += Weight * Values[Lane];
+
+															 Frequency *= Settings.Lacunarity;
+															 Weight *= Settings.Gain;
+														 }
+
+														 for (int32 Lane = 0; Lane < (bPartial ? Valid : LaneCount); ++Lane)
+															 OutValues[First + Lane] = Sum[Lane] * Normalization;
+													 }); });
+			}
+
+			template <int32 Dimension, typename T>
+			void EvaluateType(const ENoiseType Type, const T *const (&Positions)[Dimension], const int64 Count, T *const OutValues, const uint32 Seed,
+							  const FNoiseSettings<T> &Settings)
+			{
+				switch (Type)
+				{
+				case ENoiseType::Perlin:
+					EvaluateOctaves<Dimension>(Positions, Count, OutValues, Seed, Settings, [](const T (&Scaled)[Dimension][LaneCount], const uint32 OctaveSeed, T (&Values)[LaneCount])
+											   { PerlinLanes<Dimension>(Scaled, OctaveSeed, Values); });
+					break;
+				case ENoiseType::Simplex:
+					EvaluateOctaves<Dimension>(Positions, Count, OutValues, Seed, Settings, [](const T (&Scaled)[Dimension][LaneCount], const uint32 OctaveSeed, T (&Values)[LaneCount])
+											   { SimplexLanes<Dimension>(Scaled, OctaveSeed, Values); });
+					break;
+				case ENoiseType::Worley:
+					EvaluateOctaves<Dimension>(Positions, Count, OutValues, Seed, Settings, [](const T (&Scaled)[Dimension][LaneCount], const uint32 OctaveSeed, T (&Values)[LaneCount])
+											   { WorleyLanes<Dimension>(Scaled, OctaveSeed, Values); });
+					break;
+				}
+			}
+		}
+
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector2DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings)
+		{
+			if (!Positions.IsValid() || Positions.Num() != static_cast<int64>(OutValues.size()) || Settings.Octaves < 1)
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(Noise2D, Positions.Num());
+
+			const T *const Streams[2] = {Positions.X.data(), Positions.Y.data()};
+			EvaluateType<2>(Type, Streams, Positions.Num(), OutValues.data(), Seed, Settings);
+			return true;
+		}
+
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector3DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings)
+		{
+			if (!Positions.IsValid() || Positions.Num() != static_cast<int64>(OutValues.size()) || Settings.Octaves < 1)
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(Noise3D, Positions.Num());
+
+			const T *const Streams[3] = {Positions.X.data(), Positions.Y.data(), Positions.Z.data()};
+			EvaluateType<3>(Type, Streams, Positions.Num(), OutValues.data(), Seed, Settings);
+			return true;
+		}
+
+		template <FloatingPoint T>
+		bool Evaluate(const ENoiseType Type, const std::type_identity_t<FVector4DStreams<const T>> &Positions, std::span<T> OutValues, const uint32 Seed,
+					  const FNoiseSettings<T> &Settings)
+		{
+			if (!Positions.IsValid() || Positions.Num() != static_cast<int64>(OutValues.size()) || Settings.Octaves < 1)
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(Noise4D, Positions.Num());
+
+			const T *const Streams[4] = {Positions.X.data(), Positions.Y.data(), Positions.Z.data(), Positions.W.data()};
+			EvaluateType<4>(Type, Streams, Positions.Num(), OutValues.data(), Seed, Settings);
+			return true;
+		}
+
+		// Explicit instantiation for float
+		template bool Evaluate<float>(const ENoiseType Type, const FVector2DStreams<const float> &Positions, std::span<float> OutValues, const uint32 Seed,
+									  const FNoiseSettings<float> &Settings);
+		template bool Evaluate<float>(const ENoiseType Type, const FVector3DStreams<const float> &Positions, std::span<float> OutValues, const uint32 Seed,
+									  const FNoiseSettings<float> &Settings);
+		template bool Evaluate<float>(const ENoiseType Type, const FVector4DStreams<const float> &Positions, std::span<float> OutValues, const uint32 Seed,
+									  const FNoiseSettings<float> &Settings);
+
+		// Explicit instantiation for double
+		template bool Evaluate<double>(const ENoiseType Type, const FVector2DStreams<const double> &Positions, std::span<double> OutValues, const uint32 Seed,
+									   const FNoiseSettings<double> &Settings);
+		template bool Evaluate<double>(const ENoiseType Type, const FVector3DStreams<const double> &Positions, std::span<double> OutValues, const uint32 Seed,
+									   const FNoiseSettings<double> &Settings);
+		template bool Evaluate<double>(const ENoiseType Type, const FVector4DStreams<const double> &Positions, std::span<double> OutValues, const uint32 Seed,
+									   const FNoiseSettings<double> &Settings);
+	}
+}
@@ -0,0 +1,690 @@
+#include "OBB.h"
+#include "Instrument.h"
+#include "MatrixDecomposition.h"
+#include "Parallel.h"
+#include "VectorReduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		constexpr int32 LaneCount = 8;
+
+		// Boxes per worker batch of the batched tests, a multiple of LaneCount
+		constexpr int64 BatchSize = 1024;
+
+		// Points are split into at most MaxPartitionCount partitions of at least MinPartitionSize for the fitting passes
+		constexpr int64 MinPartitionSize = 16384;
+		constexpr int64 MaxPartitionCount = 256;
+
+		// Added to the rotation terms of the SAT so edge pairs that are parallel up to round-off never separate
+		template <FloatingPoint T>
+		constexpr T SeparationEpsilon = T(1000) * std::numeric_limits<T>::epsilon();
+
+		/**
+		 * @brief Boxes of a lane block with their rotations expanded to axes; Axes[i][c] is component c of axis i.
+		 */
+		template <typename T, int32 Lanes>
+		struct FOBBLanes
+		{
+			T Center[3][Lanes];
+			T Extents[3][Lanes];
+			T Axes[3][3][Lanes];
+		};
+
+		/**
+		 * Loads the boxes [Begin, Begin + Count) into lanes. Partial blocks repeat their last box in the unused lanes.
+		 */
+		template <typename T, int32 Lanes, bool bPartial>
+		void LoadLanes(const FOBB<T> *Boxes, const int64 Begin, const int32 Count, FOBBLanes<T, Lanes> &Out)
+		{
+			T Quats[4][Lanes];
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const FOBB<T> &Box = Boxes[Begin + (bPartial ? std::min(Lane, Count - 1) : Lane)];
+				for (int32 c = 0; c < 3; ++c)
+				{
+					Out.Center[c][Lane] = Box.Center[c];
+					Out.Extents[c][Lane] = Box.HalfExtents[c];
+				}
+				for (int32 c = 0; c < 4; ++c)
+					Quats[c][Lane] = Box.Rotation[c];
+			}
+
+			// The columns of the rotation matrix
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				const T X = Quats[0][Lane], Y = Quats[1][Lane], Z = Quats[2][Lane], W = Quats[3][Lane];
+				Out.Axes[0][0][Lane] = 1 - 2 * (Y * Y + Z * Z);
+				Out.Axes[0][1][Lane] = 2 * (X * Y + W * Z);
+				Out.Axes[0][2][Lane] = 2 * (X * Z - W * Y);
+				Out.Axes[1][0][Lane] = 2 * (X * Y - W * Z);
+				Out.Axes[1][1][Lane] = 1 - 2 * (X * X + Z * Z);
+				Out.Axes[1][2][Lane] = 2 * (Y * Z + W * X);
+				Out.Axes[2][0][Lane] = 2 * (X * Z + W * Y);
+				Out.Axes[2][1][Lane] = 2 * (Y * Z - W * X);
+				Out.Axes[2][2][Lane] = 1 - 2 * (X * X + Y * Y);
+			}
+		}
+
+		/**
+		 * Per lane, the largest gap between the two boxes' projections over the 15 SAT axes (Ericson, Real-Time
+		 * Collision Detection 4.4.1); positive if the boxes are separated.
+		 */
+		template <typename T, int32 Lanes>
+		void SeparationLanes(const FOBBLanes<T, Lanes> &A, const FOBBLanes<T, Lanes> &B, T (&Separations)[Lanes])
+		{
+			// B's axes and center in A's frame
+			T Rotation[3][3][Lanes];
+			T AbsRotation[3][3][Lanes];
+			T Translation[3][Lanes];
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					Translation[i][Lane] = (B.Center[0][Lane] - A.Center[0][Lane]) * A.Axes[i][0][Lane] + (B.Center[1][Lane] - A.Center[1][Lane]) * A.Axes[i][1][Lane] +
+										   (B.Center[2][Lane] - A.Center[2][Lane]) * A.Axes[i][2][Lane];
+				}
+				for (int32 j = 0; j < 3; ++j)
+				{
+					for (int32 Lane = 0; Lane < Lanes; ++Lane)
+					{
+						Rotation[i][j][Lane] = A.Axes[i][0][Lane] * B.Axes[j][0][Lane] + A.Axes[i][1][Lane] * B.Axes[j][1][Lane] + A.Axes[i][2][Lane] * B.Axes[j][2][Lane];
+						AbsRotation[i][j][Lane] = std::abs(Rotation[i][j][Lane]) + SeparationEpsilon<T>;
+					}
+				}
+			}
+
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				Separations[Lane] = -std::numeric_limits<T>::infinity();
+
+			// A's axes
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T Radius = A.Extents[i][Lane] + B.Extents[0][Lane] * AbsRotation[i][0][Lane] + B.Extents[1][Lane] * AbsRotation[i][1][Lane] +
+									 B.Extents[2][Lane] * AbsRotation[i][2][Lane];
+					Separations[Lane] = std::max(Separations[Lane], std::abs(Translation[i][Lane]) - Radius);
+				}
+			}
+
+			// B's axes
+			for (int32 j = 0; j < 3; ++j)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T Radius = B.Extents[j][Lane] + A.Extents[0][Lane] * AbsRotation[0][j][Lane] + A.Extents[1][Lane] * AbsRotation[1][j][Lane] +
+									 A.Extents[2][Lane] * AbsRotation[2][j][Lane];
+					const T Distance = Translation[0][Lane] * Rotation[0][j][Lane] + Translation[1][Lane] * Rotation[1][j][Lane] + Translation[2][Lane] * Rotation[2][j][Lane];
+					Separations[Lane] = std::max(Separations[Lane], std::abs(Distance) - Radius);
+				}
+			}
+
+			// Cross products of A's axis i and B's axis j
+			for (int32 i = 0; i < 3; ++i)
+			{
+				const int32 I1 = (i + 1) % 3, I2 = (i + 2) % 3;
+				for (int32 j = 0; j < 3; ++j)
+				{
+					const int32 J1 = (j + 1) % 3, J2 = (j + 2) % 3;
+					for (int32 Lane = 0; Lane < Lanes; ++Lane)
+					{
+						const T Radius = A.Extents[I1][Lane] * AbsRotation[I2][j][Lane] + A.Extents[I2][Lane] * AbsRotation[I1][j][Lane] +
+										 B.Extents[J1][Lane] * AbsRotation[i][J2][Lane] + B.Extents[J2][Lane] * AbsRotation[i][J1][Lane];
+						const T Distance = Translation[I2][Lane] * Rotation[I1][j][Lane] - Translation[I1][Lane] * Rotation[I2][j][Lane];
+						Separations[Lane] = std::max(Separations[Lane], std::abs(Distance) - Radius);
+					}
+				}
+			}
+		}
+
+		/**
+		 * Per lane, the squared distance from a point to the box.
+		 */
+		template <typename T, int32 Lanes>
+		void SquaredDistanceLanes(const FOBBLanes<T, Lanes> &Boxes, const T (&Point)[3], T (&SquaredDistances)[Lanes])
+		{
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				SquaredDistances[Lane] = 0;
+
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T Local = (Point[0] - Boxes.Center[0][Lane]) * Boxes.Axes[i][0][Lane] + (Point[1] - Boxes.Center[1][Lane]) * Boxes.Axes[i][1][Lane] +
+									(Point[2] - Boxes.Center[2][Lane]) * Boxes.Axes[i][2][Lane];
+					const T Excess = std::max(std::abs(Local) - Boxes.Extents[i][Lane], T(0));
+					SquaredDistances[Lane] += Excess * Excess;
+				}
+			}
+		}
+
+		/**
+		 * Per lane, the slab test of a ray; infinity for a miss. A direction component of zero makes the
+		 * reciprocal infinite, which the min and max resolve correctly.
+		 */
+		template <typename T, int32 Lanes>
+		void RayLanes(const FOBBLanes<T, Lanes> &Boxes, const T (&Origin)[3], const T (&Direction)[3], const T MaxDistance, T (&Distances)[Lanes])
+		{
+			T Near[Lanes];
+			T Far[Lanes];
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+			{
+				Near[Lane] = 0;
+				Far[Lane] = MaxDistance;
+			}
+
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				{
+					const T Local = (Origin[0] - Boxes.Center[0][Lane]) * Boxes.Axes[i][0][Lane] + (Origin[1] - Boxes.Center[1][Lane]) * Boxes.Axes[i][1][Lane] +
+									(Origin[2] - Boxes.Center[2][Lane]) * Boxes.Axes[i][2][Lane];
+					const T Slope = Direction[0] * Boxes.Axes[i][0][Lane] + Direction[1] * Boxes.Axes[i][1][Lane] + Direction[2] * Boxes.Axes[i][2][Lane];
+					const T Reciprocal = T(1) / Slope;
+					const T First = (-Boxes.Extents[i][Lane] - Local) * Reciprocal;
+					const T Second = (Boxes.Extents[i][Lane] - Local) * Reciprocal;
+					Near[Lane] = std::max(Near[Lane], std::min(First, Second));
+					Far[Lane] = std::min(Far[Lane], std::max(First, Second));
+				}
+			}
+
+			for (int32 Lane = 0; Lane < Lanes; ++Lane)
+				Distances[Lane] = Near[Lane] <= Far[Lane] ? Near[Lane] : std::numeric_limits<T>::infinity();
+		}
+
+		/**
+		 * Runs Kernel(Begin, Count) over lane blocks of the boxes [Begin, End), the last one partial.
+		 */
+		template <typename KernelType>
+		void ForEachBlock(const int64 Begin, const int64 End, const KernelType &Kernel)
+		{
+			int64 Box = Begin;
+			for (; Box + LaneCount <= End; Box += LaneCount)
+				Kernel.template operator()<false>(Box, LaneCount);
+			if (Box < End)
+				Kernel.template operator()<true>(Box, static_cast<int32>(End - Box));
+		}
+
+		/**
+		 * @brief Projection intervals of a point set on K directions, with the points attaining them.
+		 */
+		template <typename T, int32 K>
+		struct FExtents
+		{
+			T Min[K];
+			T Max[K];
+			int64 MinIndex[K];
+			int64 MaxIndex[K];
+		};
+
+		template <typename T, int32 K>
+		void MergeExtents(FExtents<T, K> &Into, const FExtents<T, K> &Other)
+		{
+			for (int32 k = 0; k < K; ++k)
+			{
+				if (Other.Min[k] < Into.Min[k])
+				{
+					Into.Min[k] = Other.Min[k];
+					Into.MinIndex[k] = Other.MinIndex[k];
+				}
+				if (Other.Max[k] > Into.Max[k])
+				{
+					Into.Max[k] = Other.Max[k];
+					Into.MaxIndex[k] = Other.MaxIndex[k];
+				}
+			}
+		}
+
+		/**
+		 * Projects the points on K directions in fixed partitions across the worker pool; the result does not
+		 * depend on the number of worker threads.
+		 */
+		template <typename T, int32 K>
+		FExtents<T, K> ProjectExtents(std::span<const FVector3D<T>> Points, const T (&Directions)[K][3])
+		{
+			const int64 Count = static_cast<int64>(Points.size());
+			const int64 PartitionCount = std::clamp((Count + MinPartitionSize - 1) / MinPartitionSize, int64(1), MaxPartitionCount);
+
+			FExtents<T, K> Partitions[MaxPartitionCount];
+			Parallel::ParallelFor(PartitionCount, 1, [&](const int64 PartitionBegin, const int64 PartitionEnd)
+								  {
+									  for (int64 Partition = PartitionBegin; Partition < PartitionEnd; ++Partition)
+									  {
+										  FExtents<T, K> &Extents = Partitions[Partition];
+										  std::fill(Extents.Min, Extents.Min + K, std::numeric_limits<T>::infinity());
+										  std::fill(Extents.Max, Extents.Max + K, -std::numeric_limits<T>::infinity());
+										  std::fill(Extents.MinIndex, Extents.MinIndex + K, int64(0));
+										  std::fill(Extents.MaxIndex, Extents.MaxIndex + K, int64(0));
+
+										  const int64 End = Count * (Partition + 1) / PartitionCount;
+										  for (int64 i = Count * Partition / PartitionCount; i < End; ++i)
+										  {
+											  const FVector3D<T> &Point = Points[i];
+											  for (int32 k = 0; k < K; ++k)
+											  {
+												  const T Projection = Point.GetX() * Directions[k][0] + Point.GetY() * Directions[k][1] + Point.GetZ() * Directions[k][2];
+												  if (Projection < Extents.Min[k])
+												  {
+													  Extents.Min[k] = Projection;
+													  Extents.MinIndex[k] = i;
+												  }
+												  if (Projection > Extents.Max[k])
+												  {
+													  Extents.Max[k] = Projection;
+													  Extents.MaxIndex[k] = i;
+												  }
+											  }
+										  }
+									  } });
+
+			for (int64 Partition = 1; Partition < PartitionCount; ++Partition)
+				MergeExtents(Partitions[0], Partitions[Partition]);
+			return Partitions[0];
+		}
+
+		/**
+		 * Rotation whose matrix has the given orthonormal, right-handed axes as columns (Shepperd's method).
+		 */
+		template <typename T>
+		FQuat<T> QuatFromAxes(const T (&Axes)[3][3])
+		{
+			// M(Row, Column) is component Row of axis Column
+			const auto M = [&Axes](const int32 Row, const int32 Column)
+			{ return Axes[Column][Row]; };
+
+			const T Trace = M(0, 0) + M(1, 1) + M(2, 2);
+			FQuat<T> Result;
+			if (Trace > 0)
+			{
+				const T S = std::sqrt(Trace + 1) * 2;
+				Result = FQuat<T>((M(2, 1) - M(1, 2)) / S, (M(0, 2) - M(2, 0)) / S, (M(1, 0) - M(0, 1)) / S, S / 4);
+			}
+			else if (M(0, 0) >= M(1, 1) && M(0, 0) >= M(2, 2))
+			{
+				const T S = std::sqrt(1 + M(0, 0) - M(1, 1) - M(2, 2)) * 2;
+				Result = FQuat<T>(S / 4, (M(0, 1) + M(1, 0)) / S, (M(0, 2) + M(2, 0)) / S, (M(2, 1) - M(1, 2)) / S);
+			}
+			else if (M(1, 1) >= M(2, 2))
+			{
+				const T S = std::sqrt(1 + M(1, 1) - M(0, 0) - M(2, 2)) * 2;
+				Result = FQuat<T>((M(0, 1) + M(1, 0)) / S, S / 4, (M(1, 2) + M(2, 1)) / S, (M(0, 2) - M(2, 0)) / S);
+			}
+			else
+			{
+				const T S = std::sqrt(1 + M(2, 2) - M(0, 0) - M(1, 1)) * 2;
+				Result = FQuat<T>((M(0, 2) + M(2, 0)) / S, (M(1, 2) + M(2, 1)) / S, S / 4, (M(1, 0) - M(0, 1)) / S);
+			}
+			Result.Normalize();
+			return Result;
+		}
+
+		/**
+		 * Completes a unit first axis and an approximate second one to an orthonormal right-handed frame.
+		 * Returns false if the second axis is (nearly) parallel to the first.
+		 */
+		template <typename T>
+		bool MakeFrame(const FVector3D<T> &First, const FVector3D<T> &Second, T (&Axes)[3][3])
+		{
+			const FVector3D<T> Orthogonal = Second - First * Dot(First, Second);
+			const T Length = Magnitude(Orthogonal);
+			if (!(Length > std::sqrt(std::numeric_limits<T>::epsilon()) * Magnitude(Second)))
+				return false;
+
+			const FVector3D<T> Frame[3] = {First, Orthogonal / Length, Cross(First, Orthogonal / Length)};
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 c = 0; c < 3; ++c)
+					Axes[i][c] = Frame[i][c];
+			}
+			return true;
+		}
+
+		/**
+		 * Any frame whose first axis is the given unit vector.
+		 */
+		template <typename T>
+		void MakeFrame(const FVector3D<T> &First, T (&Axes)[3][3])
+		{
+			const FVector3D<T> Candidates[3] = {FVector3D<T>(1, 0, 0), FVector3D<T>(0, 1, 0), FVector3D<T>(0, 0, 1)};
+			for (const FVector3D<T> &Candidate : Candidates)
+			{
+				if (MakeFrame(First, Candidate, Axes))
+					return;
+			}
+		}
+
+		/**
+		 * The box with the given axes around all points.
+		 */
+		template <typename T>
+		FOBB<T> FitToAxes(std::span<const FVector3D<T>> Points, const T (&Axes)[3][3])
+		{
+			const FExtents<T, 3> Extents = ProjectExtents(Points, Axes);
+
+			FVector3D<T> Center;
+			T HalfExtents[3];
+			for (int32 i = 0; i < 3; ++i)
+			{
+				Center += FVector3D<T>(Axes[i][0], Axes[i][1], Axes[i][2]) * ((Extents.Min[i] + Extents.Max[i]) / 2);
+				HalfExtents[i] = (Extents.Max[i] - Extents.Min[i]) / 2;
+			}
+			return {Center, FVector3D<T>(HalfExtents[0], HalfExtents[1], HalfExtents[2]), QuatFromAxes(Axes)};
+		}
+
+		/**
+		 * Half the surface area of the box with the given axes around a few points, the quality measure of DiTO.
+		 */
+		template <typename T>
+		T GetHalfArea(const FVector3D<T> *Points, const int32 Count, const T (&Axes)[3][3])
+		{
+			T Sizes[3];
+			for (int32 i = 0; i < 3; ++i)
+			{
+				T Min = std::numeric_limits<T>::infinity();
+				T Max = -std::numeric_limits<T>::infinity();
+				for (int32 p = 0; p < Count; ++p)
+				{
+					const T Projection = Points[p].GetX() * Axes[i][0] + Points[p].GetY() * Axes[i][1] + Points[p].GetZ() * Axes[i][2];
+					Min = std::min(Min, Projection);
+					Max = std::max(Max, Projection);
+				}
+				Sizes[i] = Max - Min;
+			}
+			return Sizes[0] * Sizes[1] + Sizes[1] * Sizes[2] + Sizes[2] * Sizes[0];
+		}
+	}
+
+	template <FloatingPoint T>
+	void FOBB<T>::GetAxes(FVector3D<T> (&OutAxes)[3]) const
+	{
+		FOBBLanes<T, 1> Lanes;
+		LoadLanes<T, 1, false>(this, 0, 1, Lanes);
+		for (int32 i = 0; i < 3; ++i)
+			OutAxes[i] = FVector3D<T>(Lanes.Axes[i][0][0], Lanes.Axes[i][1][0], Lanes.Axes[i][2][0]);
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FOBB<T>::ClosestPoint(const FVector3D<T> &Point) const
+	{
+		FVector3D<T> Axes[3];
+		GetAxes(Axes);
+
+		const FVector3D<T> Offset = Point - Center;
+		FVector3D<T> Result = Center;
+		for (int32 i = 0; i < 3; ++i)
+			Result += Axes[i] * std::clamp(Dot(Offset, Axes[i]), -HalfExtents[i], HalfExtents[i]);
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	T FOBB<T>::GetVolume() const
+	{
+		return 8 * HalfExtents.GetX() * HalfExtents.GetY() * HalfExtents.GetZ();
+	}
+
+	template <FloatingPoint T>
+	bool Overlap(const FOBB<T> &A, const FOBB<T> &B)
+	{
+		FOBBLanes<T, 1> LanesA;
+		FOBBLanes<T, 1> LanesB;
+		LoadLanes<T, 1, false>(&A, 0, 1, LanesA);
+		LoadLanes<T, 1, false>(&B, 0, 1, LanesB);
+
+		T Separations[1];
+		SeparationLanes(LanesA, LanesB, Separations);
+		return Separations[0] <= 0;
+	}
+
+	template <FloatingPoint T>
+	bool OverlapSphere(const FOBB<T> &Box, const FVector3D<T> &Center, const std::type_identity_t<T> Radius)
+	{
+		FOBBLanes<T, 1> Lanes;
+		LoadLanes<T, 1, false>(&Box, 0, 1, Lanes);
+
+		const T Point[3] = {Center.GetX(), Center.GetY(), Center.GetZ()};
+		T SquaredDistances[1];
+		SquaredDistanceLanes(Lanes, Point, SquaredDistances);
+		return SquaredDistances[0] <= Radius * Radius;
+	}
+
+	template <FloatingPoint T>
+	bool IntersectRay(const FOBB<T> &Box, const FVector3D<T> &Origin, const FVector3D<T> &Direction, T &OutDistance, const std::type_identity_t<T> MaxDistance)
+	{
+		FOBBLanes<T, 1> Lanes;
+		LoadLanes<T, 1, false>(&Box, 0, 1, Lanes);
+
+		const T RayOrigin[3] = {Origin.GetX(), Origin.GetY(), Origin.GetZ()};
+		const T RayDirection[3] = {Direction.GetX(), Direction.GetY(), Direction.GetZ()};
+		T Distances[1];
+		RayLanes(Lanes, RayOrigin, RayDirection, MaxDistance, Distances);
+		OutDistance = Distances[0];
+		return Distances[0] != std::numeric_limits<T>::infinity();
+	}
+
+	template <FloatingPoint T>
+	bool OverlapMany(std::span<const FOBB<T>> A, std::type_identity_t<std::span<const FOBB<T>>> B, std::span<bool> OutOverlaps)
+	{
+		if (B.size() != A.size() || OutOverlaps.size() != A.size())
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(OBBOverlapMany, A.size());
+
+		Parallel::ParallelFor(static_cast<int64>(A.size()), BatchSize, [A, B, OutOverlaps](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [A, B, OutOverlaps]<bool bPartial>(const int64 First, const int32 Count)
+													{
+														FOBBLanes<T, LaneCount> LanesA;
+														FOBBLanes<T, LaneCount> LanesB;
+														LoadLanes<T, LaneCount, bPartial>(A.data(), First, Count, LanesA);
+														LoadLanes<T, LaneCount, bPartial>(B.data(), First, Count, LanesB);
+
+														T Separations[LaneCount];
+														SeparationLanes(LanesA, LanesB, Separations);
+														for (int32 Lane = 0; Lane < Count; ++Lane)
+															OutOverlaps[First + Lane] = Separations[Lane] <= 0;
+													}); });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool OverlapSphereMany(std::span<const FOBB<T>> Boxes, const FVector3D<T> &Center, const std::type_identity_t<T> Radius, std::span<bool> OutOverlaps)
+	{
+		if (OutOverlaps.size() != Boxes.size())
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(OBBOverlapSphereMany, Boxes.size());
+
+		const T Point[3] = {Center.GetX(), Center.GetY(), Center.GetZ()};
+		const T SquaredRadius = Radius * Radius;
+		Parallel::ParallelFor(static_cast<int64>(Boxes.size()), BatchSize, [Boxes, &Point, SquaredRadius, OutOverlaps](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [Boxes, &Point, SquaredRadius, OutOverlaps]<bool bPartial>(const int64 First, const int32 Count)
+													{
+														FOBBLanes<T, LaneCount> Lanes;
+														LoadLanes<T, LaneCount, bPartial>(Boxes.data(), First, Count, Lanes);
+
+														T SquaredDistances[LaneCount];
+														SquaredDistanceLanes(Lanes, Point, SquaredDistances);
+														for (int32 Lane = 0; Lane < Count; ++Lane)
+															OutOverlaps[First + Lane] = SquaredDistances[Lane] <= SquaredRadius;
+													}); });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool IntersectRayMany(std::span<const FOBB<T>> Boxes, const FVector3D<T> &Origin, const FVector3D<T> &Direction, const std::type_identity_t<T> MaxDistance,
+						  std::type_identity_t<std::span<T>> OutDistances)
+	{
+		if (OutDistances.size() != Boxes.size())
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(OBBIntersectRayMany, Boxes.size());
+
+		const T RayOrigin[3] = {Origin.GetX(), Origin.GetY(), Origin.GetZ()};
+		const T RayDirection[3] = {Direction.GetX(), Direction.GetY(), Direction.GetZ()};
+		Parallel::ParallelFor(static_cast<int64>(Boxes.size()), BatchSize, [&, Boxes, OutDistances](const int64 Begin, const int64 End)
+							  { ForEachBlock(Begin, End, [&, Boxes, OutDistances]<bool bPartial>(const int64 First, const int32 Count)
+													{
+														FOBBLanes<T, LaneCount> Lanes;
+														LoadLanes<T, LaneCount, bPartial>(Boxes.data(), First, Count, Lanes);
+
+														T Distances[LaneCount];
+														RayLanes(Lanes, RayOrigin, RayDirection, MaxDistance, Distances);
+														std::copy(Distances, Distances + Count, OutDistances.data() + First);
+													}); });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	FOBB<T> FitOBBPCA(std::span<const FVector3D<T>> Points)
+	{
+		RATCHET_INSTRUMENT_BATCH(OBBFit, Points.size());
+
+		if (Points.empty())
+			return {FVector3D<T>(), FVector3D<T>(), FQuat<T>()};
+
+		const FSymmetricEigen3x3<T> Eigen = EigenDecompose(Covariance3x3(Points));
+		T Axes[3][3];
+		if (!MakeFrame(Eigen.Eigenvectors[0], Eigen.Eigenvectors[1], Axes))
+			MakeFrame(Eigen.Eigenvectors[0], Axes);
+		return FitToAxes(Points, Axes);
+	}
+
+	template <FloatingPoint T>
+	FOBB<T> FitOBBDiTO(std::span<const FVector3D<T>> Points)
+	{
+		RATCHET_INSTRUMENT_BATCH(OBBFit, Points.size());
+
+		if (Points.empty())
+			return {FVector3D<T>(), FVector3D<T>(), FQuat<T>()};
+
+		// The 7 DiTO-14 directions: the coordinate axes and the cube diagonals
+		constexpr T Directions[7][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}};
+		const FExtents<T, 7> Extents = ProjectExtents(Points, Directions);
+
+		FVector3D<T> Extremes[14];
+		for (int32 k = 0; k < 7; ++k)
+		{
+			Extremes[2 * k] = Points[Extents.MinIndex[k]];
+			Extremes[2 * k + 1] = Points[Extents.MaxIndex[k]];
+		}
+
+		// The axis-aligned box is the first candidate; it is exact on the extremes since they include the axis extremes
+		T BestAxes[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+		T BestArea = GetHalfArea(Extremes, 14, BestAxes);
+
+		// Base triangle: the most distant pair of extremes and the extreme furthest from their line
+		int32 First = 0;
+		T FirstLength = -1;
+		for (int32 k = 0; k < 7; ++k)
+		{
+			const T Length = DistanceSquared(Extremes[2 * k], Extremes[2 * k + 1]);
+			if (Length > FirstLength)
+			{
+				FirstLength = Length;
+				First = 2 * k;
+			}
+		}
+		if (!(FirstLength > 0))
+			return FitToAxes(Points, BestAxes);
+
+		const FVector3D<T> P0 = Extremes[First];
+		const FVector3D<T> P1 = Extremes[First + 1];
+		const FVector3D<T> Edge = GetNormalized(P1 - P0);
+		int32 Third = 0;
+		T ThirdDistance = -1;
+		for (int32 p = 0; p < 14; ++p)
+		{
+			const FVector3D<T> Offset = Extremes[p] - P0;
+			const T Distance = DistanceSquared(Offset, Edge * Dot(Offset, Edge));
+			if (Distance > ThirdDistance)
+			{
+				ThirdDistance = Distance;
+				Third = p;
+			}
+		}
+
+		// Collinear points: any frame around the line
+		T Axes[3][3];
+		if (!(ThirdDistance > std::numeric_limits<T>::epsilon() * FirstLength))
+		{
+			MakeFrame(Edge, Axes);
+			return FitToAxes(Points, Axes);
+		}
+
+		// Every triangle contributes the frames of its three edges and its normal
+		const auto TryTriangle = [&](const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C)
+		{
+			const FVector3D<T> Normal = Cross(B - A, C - A);
+			const T NormalLength = Magnitude(Normal);
+			if (!(NormalLength > 0))
+				return;
+
+			const FVector3D<T> Sides[3] = {B - A, C - B, A - C};
+			for (const FVector3D<T> &Side : Sides)
+			{
+				const T SideLength = Magnitude(Side);
+				if (!(SideLength > 0) || !MakeFrame(Side / SideLength, Normal / NormalLength, Axes))
+					continue;
+
+				const T Area = GetHalfArea(Extremes, 14, Axes);
+				if (Area < BestArea)
+				{
+					BestArea = Area;
+					std::copy(&Axes[0][0], &Axes[0][0] + 9, &BestAxes[0][0]);
+				}
+			}
+		};
+
+		const FVector3D<T> P2 = Extremes[Third];
+		TryTriangle(P0, P1, P2);
+
+		// The two tetrahedra on the base triangle, apexed at the extremes furthest on either side of it
+		const FVector3D<T> Normal = GetNormalized(Cross(P1 - P0, P2 - P0));
+		int32 Above = 0;
+		int32 Below = 0;
+		for (int32 p = 1; p < 14; ++p)
+		{
+			if (Dot(Extremes[p] - P0, Normal) > Dot(Extremes[Above] - P0, Normal))
+				Above = p;
+			if (Dot(Extremes[p] - P0, Normal) < Dot(Extremes[Below] - P0, Normal))
+				Below = p;
+		}
+		for (const int32 Apex : {Above, Below})
+		{
+			TryTriangle(P0, P1, Extremes[Apex]);
+			TryTriangle(P1, P2, Extremes[Apex]);
+			TryTriangle(P2, P0, Extremes[Apex]);
+		}
+
+		return FitToAxes(Points, BestAxes);
+	}
+
+	// Explicit instantiation for float
+	template struct FOBB<float>;
+	template bool Overlap(const FOBB<float> &A, const FOBB<float> &B);
+	template bool OverlapSphere(const FOBB<float> &Box, const FVector3D<float> &Center, const float Radius);
+	template bool IntersectRay(const FOBB<float> &Box, const FVector3D<float> &Origin, const FVector3D<float> &Direction, float &OutDistance, const float MaxDistance);
+	template bool OverlapMany(std::span<const FOBB<float>> A, std::span<const FOBB<float>> B, std::span<bool> OutOverlaps);
+	template bool OverlapSphereMany(std::span<const FOBB<float>> Boxes, const FVector3D<float> &Center, const float Radius, std::span<bool> OutOverlaps);
+	template bool IntersectRayMany(std::span<const FOBB<float>> Boxes, const FVector3D<float> &Origin, const FVector3D<float> &Direction, const float MaxDistance,
+								   std::span<float> OutDistances);
+	template FOBB<float> FitOBBPCA(std::span<const FVector3D<float>> Points);
+	template FOBB<float> FitOBBDiTO(std::span<const FVector3D<float>> Points);
+
+	// Explicit instantiation for double
+	template struct FOBB<double>;
+	template bool Overlap(const FOBB<double> &A, const FOBB<double> &B);
+	template bool OverlapSphere(const FOBB<double> &Box, const FVector3D<double> &Center, const double Radius);
+	template bool IntersectRay(const FOBB<double> &Box, const FVector3D<double> &Origin, const FVector3D<double> &Direction, double &OutDistance, const double MaxDistance);
+	template bool OverlapMany(std::span<const FOBB<double>> A, std::span<const FOBB<double>> B, std::span<bool> OutOverlaps);
+	template bool OverlapSphereMany(std::span<const FOBB<double>> Boxes, const FVector3D<double> &Center, const double Radius, std::span<bool> OutOverlaps);
+	template bool IntersectRayMany(std::span<const FOBB<double>> Boxes, const FVector3D<double> &Origin, const FVector3D<double> &Direction, const double MaxDistance,
+								   std::span<double> OutDistances);
+	template FOBB<double> FitOBBPCA(std::span<const FVector3D<double>> Points);
+	template FOBB<double> FitOBBDiTO(std::span<const FVector3D<double>> Points);
+}
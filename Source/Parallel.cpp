@@ -0,0 +1,157 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ratchet
+{
+	namespace Parallel
+	{
+		namespace
+		{
+			thread_local bool bInsideParallelFor = false;
+
+			class FWorkerPool
+			{
+			public:
+				static FWorkerPool &Get()
+				{
+					static FWorkerPool Pool;
+					return Pool;
+				}
+
+				int32 GetWorkerCount() const
+				{
+					return static_cast<int32>(Workers.size()) + 1;
+				}
+
+				void Run(const FRangeFunction &InBody, const int64 InCount, const int64 InBatchSize)
+				{
+					std::lock_guard<std::mutex> SubmitLock(SubmitMutex);
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						Body = &InBody;
+						Count = InCount;
+						BatchSize = InBatchSize;
+						Next.store(0, std::memory_order_relaxed);
+						Busy = static_cast<int32>(Workers.size());
+						++Generation;
+					}
+					WakeCondition.notify_all();
+
+					Drain();
+
+					std::unique_lock<std::mutex> Lock(Mutex);
+					DoneCondition.wait(Lock, [this]
+									   { return Busy == 0; });
+					Body = nullptr;
+				}
+
+			private:
+				FWorkerPool()
+				{
+					const uint32 HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+					Workers.reserve(HardwareThreads - 1);
+					for (uint32 i = 1; i < HardwareThreads; ++i)
+					{
+						Workers.emplace_back([this]
+											 { WorkerMain(); });
+					}
+				}
+
+				~FWorkerPool()
+				{
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						bStop = true;
+					}
+					WakeCondition.notify_all();
+					for (std::thread &Worker : Workers)
+					{
+						Worker.join();
+					}
+				}
+
+				void WorkerMain()
+				{
+					uint64 SeenGeneration = 0;
+					for (;;)
+					{
+						{
+							std::unique_lock<std::mutex> Lock(Mutex);
+							WakeCondition.wait(Lock, [&]
+											   { return bStop || Generation != SeenGeneration; });
+							if (bStop)
+								return;
+							SeenGeneration = Generation;
+						}
+
+						Drain();
+
+						std::lock_guard<std::mutex> Lock(Mutex);
+						if (--Busy == 0)
+							DoneCondition.notify_one();
+					}
+				}
+
+				void Drain()
+				{
+					bInsideParallelFor = true;
+					for (int64 Begin = Next.fetch_add(BatchSize); Begin < Count; Begin = Next.fetch_add(BatchSize))
+					{
+						(*Body)(Begin, std::min(Begin + BatchSize, Count));
+					}
+					bInsideParallelFor = false;
+				}
+
+				std::vector<std::thread> Workers;
+				std::mutex SubmitMutex;
+				std::mutex Mutex;
+				std::condition_variable WakeCondition;
+				std::condition_variable DoneCondition;
+
+				const FRangeFunction *Body = nullptr;
+				int64 Count = 0;
+				int64 BatchSize = 1;
+				std::atomic<int64> Next{0};
+				int32 Busy = 0;
+				uint64 Generation = 0;
+				bool bStop = false;
+			};
+		}
+
+		int32 GetWorkerCount()
+		{
+			return FWorkerPool::Get().GetWorkerCount();
+		}
+
+		void ParallelFor(const int64 Count, const int64 MinBatchSize, const FRangeFunction &Body)
+		{
+			if (Count <= 0)
+				return;
+
+			const int64 MinBatch = std::max<int64>(1, MinBatchSize);
+			if (bInsideParallelFor || Count <= MinBatch)
+			{
+				Body(0, Count);
+				return;
+			}
+
+			FWorkerPool &Pool = FWorkerPool::Get();
+			const int64 WorkerCount = Pool.GetWorkerCount();
+			if (WorkerCount == 1)
+			{
+				Body(0, Count);
+				return;
+			}
+
+			// A few batches per worker keeps the load balanced without flooding the shared counter
+			const int64 BatchSize = std::max(MinBatch, (Count + WorkerCount * 4 - 1) / (WorkerCount * 4));
+			Pool.Run(Body, Count, BatchSize);
+		}
+	}
+}
@@ -0,0 +1,862 @@
+#include "Polygon2D.h"
+#include "Instrument.h"
+#include "Parallel.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Batches are split into at most MaxPartitionCount partitions of at least MinPartitionSize polygons,
+		// each with its own workspace
+		constexpr int64 MinPartitionSize = 32;
+		constexpr int64 MaxPartitionCount = 64;
+
+		// Translations of the clip polygon tried before a degenerate boolean operation gives up
+		constexpr int32 MaxPerturbations = 8;
+
+		/**
+		 * Twice the signed area of a polygon given as interleaved X, Y pairs, positive if counterclockwise.
+		 * Measured from the first vertex to keep the products small.
+		 */
+		template <typename T>
+		T GetDoubleArea(const T *Coordinates, const int64 Count)
+		{
+			T Area = 0;
+			for (int64 i = 1; i + 1 < Count; ++i)
+			{
+				const T AX = Coordinates[2 * i] - Coordinates[0], AY = Coordinates[2 * i + 1] - Coordinates[1];
+				const T BX = Coordinates[2 * i + 2] - Coordinates[0], BY = Coordinates[2 * i + 3] - Coordinates[1];
+				Area += AX * BY - AY * BX;
+			}
+			return Area;
+		}
+
+		/**
+		 * Twice the signed area of a polygon, positive if counterclockwise.
+		 */
+		template <typename T>
+		T GetDoubleArea(std::span<const FVector2D<T>> Polygon)
+		{
+			T Area = 0;
+			for (size_t i = 1; i + 1 < Polygon.size(); ++i)
+			{
+				const T AX = Polygon[i].GetX() - Polygon[0].GetX(), AY = Polygon[i].GetY() - Polygon[0].GetY();
+				const T BX = Polygon[i + 1].GetX() - Polygon[0].GetX(), BY = Polygon[i + 1].GetY() - Polygon[0].GetY();
+				Area += AX * BY - AY * BX;
+			}
+			return Area;
+		}
+
+		/**
+		 * Predicates::Orient2D with its floating-point filter inlined so that only near-collinear triples leave the loop.
+		 */
+		template <typename T>
+		double Orient(const FVector2D<T> &A, const FVector2D<T> &B, const FVector2D<T> &C)
+		{
+			constexpr double Epsilon = std::numeric_limits<double>::epsilon() / 2;
+			constexpr double ErrorBound = (3 + 16 * Epsilon) * Epsilon;
+
+			const double Left = (double(A.GetX()) - double(C.GetX())) * (double(B.GetY()) - double(C.GetY()));
+			const double Right = (double(A.GetY()) - double(C.GetY())) * (double(B.GetX()) - double(C.GetX()));
+			const double Determinant = Left - Right;
+			if (std::abs(Determinant) > ErrorBound * (std::abs(Left) + std::abs(Right)))
+				return Determinant;
+
+			return Predicates::Orient2D(A, B, C);
+		}
+
+		int32 GetSign(const double Value)
+		{
+			return (Value > 0) - (Value < 0);
+		}
+
+		/**
+		 * Exact winding number test of a point that is not on the polygon's boundary.
+		 */
+		template <typename T>
+		bool IsInside(const FVector2D<T> &Point, std::span<const FVector2D<T>> Polygon)
+		{
+			const T Y = Point.GetY();
+			const int64 Count = static_cast<int64>(Polygon.size());
+
+			int32 Winding = 0;
+			for (int64 i = 0; i < Count; ++i)
+			{
+				const int64 Next = i + 1 < Count ? i + 1 : 0;
+				const T AY = Polygon[i].GetY(), BY = Polygon[Next].GetY();
+				if (AY <= Y)
+				{
+					if (BY > Y && Orient(Polygon[i], Polygon[Next], Point) > 0)
+						++Winding;
+				}
+				else if (BY <= Y && Orient(Polygon[i], Polygon[Next], Point) < 0)
+					--Winding;
+			}
+			return Winding != 0;
+		}
+
+		template <typename T>
+		void AddPolygon(std::span<const FVector2D<T>> Polygon, const bool bReversed, FPolygonSet2D<T> &OutPolygons)
+		{
+			const int64 Count = static_cast<int64>(Polygon.size());
+			for (int64 i = 0; i < Count; ++i)
+				OutPolygons.AddVertex(Polygon[bReversed ? Count - 1 - i : i]);
+			OutPolygons.ClosePolygon();
+		}
+
+		/**
+		 * Adds a loop given as X, Y pairs unless it has fewer than 3 vertices or is no wider than MinWidth. A strip
+		 * of width w has a double area of about w times its perimeter.
+		 */
+		template <typename T>
+		void AddLoop(const Memory::FAlignedBuffer<T> &Loop, const T MinWidth, FPolygonSet2D<T> &OutPolygons)
+		{
+			if (Loop.Num() < 6)
+				return;
+			if (MinWidth > 0)
+			{
+				const int64 Count = static_cast<int64>(Loop.Num() / 2);
+				T Perimeter = 0;
+				for (int64 i = 0, Prev = Count - 1; i < Count; Prev = i++)
+					Perimeter += std::hypot(Loop[2 * i] - Loop[2 * Prev], Loop[2 * i + 1] - Loop[2 * Prev + 1]);
+				if (std::abs(GetDoubleArea(Loop.GetData(), Count)) <= MinWidth * Perimeter)
+					return;
+			}
+			for (size_t i = 0; i < Loop.Num(); i += 2)
+				OutPolygons.AddVertex(FVector2D<T>(Loop[i], Loop[i + 1]));
+			OutPolygons.ClosePolygon();
+		}
+	}
+
+	template <FloatingPoint T>
+	FPolygonSet2D<T>::FPolygonSet2D(Memory::FAllocator &InAllocator)
+		: Vertices(InAllocator), Offsets(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	void FPolygonSet2D<T>::Clear()
+	{
+		Vertices.Clear();
+		Offsets.Clear();
+	}
+
+	template <FloatingPoint T>
+	void FPolygonSet2D<T>::AddPolygon(std::span<const FVector2D<T>> InVertices)
+	{
+		for (const FVector2D<T> &Vertex : InVertices)
+			Vertices.Add(Vertex);
+		ClosePolygon();
+	}
+
+	template <FloatingPoint T>
+	void FPolygonSet2D<T>::AddVertex(const FVector2D<T> &Vertex)
+	{
+		Vertices.Add(Vertex);
+	}
+
+	template <FloatingPoint T>
+	void FPolygonSet2D<T>::ClosePolygon()
+	{
+		if (Offsets.IsEmpty())
+			Offsets.Add(0);
+		Offsets.Add(static_cast<uint32>(Vertices.Num()));
+	}
+
+	template <FloatingPoint T>
+	void FPolygonSet2D<T>::Append(const FPolygonSet2D &Other)
+	{
+		// Drops a polygon under construction, which the offsets don't cover
+		const uint32 Base = Offsets.IsEmpty() ? 0 : Offsets[Offsets.Num() - 1];
+		Vertices.Resize(Base);
+		if (Other.Num() == 0)
+			return;
+
+		if (Offsets.IsEmpty())
+			Offsets.Add(0);
+		const std::span<const FVector2D<T>> OtherVertices = Other.GetVertices();
+		Vertices.Reserve(Base + OtherVertices.size());
+		for (const FVector2D<T> &Vertex : OtherVertices)
+			Vertices.Add(Vertex);
+
+		Offsets.Reserve(Offsets.Num() + Other.Num());
+		for (int64 i = 1; i <= Other.Num(); ++i)
+			Offsets.Add(Base + Other.Offsets[i]);
+	}
+
+	template <FloatingPoint T>
+	int64 FPolygonSet2D<T>::Num() const
+	{
+		return Offsets.IsEmpty() ? 0 : static_cast<int64>(Offsets.Num()) - 1;
+	}
+
+	template <FloatingPoint T>
+	std::span<const FVector2D<T>> FPolygonSet2D<T>::GetPolygon(const int64 Index) const
+	{
+		return {Vertices.GetData() + Offsets[Index], Offsets[Index + 1] - Offsets[Index]};
+	}
+
+	template <FloatingPoint T>
+	std::span<const FVector2D<T>> FPolygonSet2D<T>::GetVertices() const
+	{
+		return {Vertices.GetData(), Offsets.IsEmpty() ? 0 : Offsets[Offsets.Num() - 1]};
+	}
+
+	template <FloatingPoint T>
+	std::span<const uint32> FPolygonSet2D<T>::GetOffsets() const
+	{
+		return Offsets;
+	}
+
+	template <FloatingPoint T>
+	int64 FPolygonSet2D<T>::GetTriangleIndexCount() const
+	{
+		int64 Count = 0;
+		for (int64 i = 0; i < Num(); ++i)
+			Count += 3 * std::max<int64>(Offsets[i + 1] - Offsets[i] - 2, 0);
+		return Count;
+	}
+
+	template <FloatingPoint T>
+	FPolygonProcessor2D<T>::FWorkspace::FWorkspace(Memory::FAllocator &InAllocator)
+		: Nodes(InAllocator), Points(InAllocator), Loop(InAllocator), Cleaned(InAllocator), Tangents(InAllocator), Links(InAllocator), Reflex(InAllocator),
+		  Output(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	FPolygonProcessor2D<T>::FPolygonProcessor2D(Memory::FAllocator &InAllocator)
+		: Allocator(&InAllocator), Workspaces(InAllocator), TriangleOffsets(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	int64 FPolygonProcessor2D<T>::PreparePartitions(const int64 Count)
+	{
+		const int64 PartitionCount = std::clamp((Count + MinPartitionSize - 1) / MinPartitionSize, int64(1), MaxPartitionCount);
+		const int64 Existing = static_cast<int64>(Workspaces.Num());
+		if (Existing < PartitionCount)
+		{
+			Workspaces.Resize(PartitionCount);
+			for (int64 Partition = Existing; Partition < PartitionCount; ++Partition)
+				Workspaces[Partition] = FWorkspace(*Allocator);
+		}
+		return PartitionCount;
+	}
+
+	template <FloatingPoint T>
+	typename FPolygonProcessor2D<T>::ETraceResult FPolygonProcessor2D<T>::Trace(FWorkspace &Work, std::span<const FVector2D<T>> Subject, const bool bSubjectReversed,
+																				 std::span<const FVector2D<T>> Clip, const bool bClipReversed,
+																				 const EPolygonBoolean Operation, const T MinWidth, FPolygonSet2D<T> &OutPolygons)
+	{
+		const int32 SubjectCount = static_cast<int32>(Subject.size());
+		const int32 ClipCount = static_cast<int32>(Clip.size());
+
+		// Both lists run counterclockwise
+		const auto SubjectIndex = [SubjectCount, bSubjectReversed](const int32 i)
+		{ return bSubjectReversed ? SubjectCount - 1 - i : i; };
+		const auto ClipIndex = [ClipCount, bClipReversed](const int32 i)
+		{ return bClipReversed ? ClipCount - 1 - i : i; };
+
+		Memory::FAlignedBuffer<FClipNode> &Nodes = Work.Nodes;
+		Nodes.Clear();
+		for (int32 i = 0; i < SubjectCount; ++i)
+		{
+			const int32 Vertex = SubjectIndex(i);
+			Nodes.Add({Subject[Vertex].GetX(), Subject[Vertex].GetY(), (i + 1) % SubjectCount, (i + SubjectCount - 1) % SubjectCount, -1, 0, false, false});
+		}
+		for (int32 j = 0; j < ClipCount; ++j)
+		{
+			const int32 Vertex = ClipIndex(j);
+			Nodes.Add({Clip[Vertex].GetX(), Clip[Vertex].GetY(), SubjectCount + (j + 1) % ClipCount, SubjectCount + (j + ClipCount - 1) % ClipCount, -1, 0, false, false});
+		}
+
+		// Links an intersection into the edge that starts at an original vertex, sorted along the edge
+		const auto Insert = [&Nodes](const int32 Node, int32 After)
+		{
+			while (Nodes[Nodes[After].Next].Neighbor >= 0 && Nodes[Nodes[After].Next].Alpha < Nodes[Node].Alpha)
+				After = Nodes[After].Next;
+			Nodes[Node].Prev = After;
+			Nodes[Node].Next = Nodes[After].Next;
+			Nodes[Nodes[After].Next].Prev = Node;
+			Nodes[After].Next = Node;
+		};
+
+		const int32 FirstIntersection = SubjectCount + ClipCount;
+		for (int32 i = 0; i < SubjectCount; ++i)
+		{
+			const FVector2D<T> &A = Subject[SubjectIndex(i)];
+			const FVector2D<T> &B = Subject[SubjectIndex((i + 1) % SubjectCount)];
+			const T AX = Nodes[i].X, AY = Nodes[i].Y;
+			const T BX = Nodes[(i + 1) % SubjectCount].X, BY = Nodes[(i + 1) % SubjectCount].Y;
+
+			for (int32 j = 0; j < ClipCount; ++j)
+			{
+				const T CX = Nodes[SubjectCount + j].X, CY = Nodes[SubjectCount + j].Y;
+				const T DX = Nodes[SubjectCount + (j + 1) % ClipCount].X, DY = Nodes[SubjectCount + (j + 1) % ClipCount].Y;
+				if (std::max(CX, DX) < std::min(AX, BX) || std::min(CX, DX) > std::max(AX, BX) || std::max(CY, DY) < std::min(AY, BY) ||
+					std::min(CY, DY) > std::max(AY, BY))
+					continue;
+
+				const FVector2D<T> &CVertex = Clip[ClipIndex(j)];
+				const FVector2D<T> &DVertex = Clip[ClipIndex((j + 1) % ClipCount)];
+				const int32 SideA = GetSign(Orient(CVertex, DVertex, A));
+				const int32 SideB = GetSign(Orient(CVertex, DVertex, B));
+				if (SideA == SideB && SideA != 0)
+					continue;
+				const int32 SideC = GetSign(Orient(A, B, CVertex));
+				const int32 SideD = GetSign(Orient(A, B, DVertex));
+				if (SideC == SideD && SideC != 0)
+					continue;
+
+				// The edges touch or overlap rather than cross
+				if (SideA == 0 || SideB == 0 || SideC == 0 || SideD == 0)
+					return ETraceResult::Degenerate;
+
+				const T SubjectX = BX - AX, SubjectY = BY - AY;
+				const T ClipX = DX - CX, ClipY = DY - CY;
+				const T OffsetX = CX - AX, OffsetY = CY - AY;
+				const T Denominator = SubjectX * ClipY - SubjectY * ClipX;
+				const T SubjectAlpha = std::clamp((OffsetX * ClipY - OffsetY * ClipX) / Denominator, T(0), T(1));
+				const T ClipAlpha = std::clamp((OffsetX * SubjectY - OffsetY * SubjectX) / Denominator, T(0), T(1));
+				const T X = AX + SubjectX * SubjectAlpha, Y = AY + SubjectY * SubjectAlpha;
+
+				const int32 Node = static_cast<int32>(Nodes.Num());
+				Nodes.Add({X, Y, -1, -1, Node + 1, SubjectAlpha, false, false});
+				Nodes.Add({X, Y, -1, -1, Node, ClipAlpha, false, false});
+				Insert(Node, i);
+				Insert(Node + 1, SubjectCount + j);
+			}
+		}
+
+		// Without crossings, one polygon contains the other or they are disjoint
+		if (static_cast<int32>(Nodes.Num()) == FirstIntersection)
+		{
+			const bool bSubjectInside = IsInside(Subject[0], Clip);
+			const bool bClipInside = IsInside(Clip[0], Subject);
+			switch (Operation)
+			{
+			case EPolygonBoolean::Intersection:
+				if (bSubjectInside)
+					AddPolygon(Subject, bSubjectReversed, OutPolygons);
+				else if (bClipInside)
+					AddPolygon(Clip, bClipReversed, OutPolygons);
+				break;
+			case EPolygonBoolean::Union:
+				if (!bClipInside)
+					AddPolygon(Clip, bClipReversed, OutPolygons);
+				if (!bSubjectInside)
+					AddPolygon(Subject, bSubjectReversed, OutPolygons);
+				break;
+			case EPolygonBoolean::Difference:
+				if (!bSubjectInside)
+					AddPolygon(Subject, bSubjectReversed, OutPolygons);
+				if (bClipInside)
+					AddPolygon(Clip, !bClipReversed, OutPolygons);
+				break;
+			}
+			return ETraceResult::Done;
+		}
+
+		// Crossings alternate between entering and leaving the other polygon. Following the subject forward
+		// where it enters the clip polygon traces the intersection; flipping the subject's flags keeps its
+		// outside parts instead, and flipping the clip polygon's as well gives the union.
+		const bool bFlipSubject = Operation != EPolygonBoolean::Intersection;
+		const bool bFlipClip = Operation == EPolygonBoolean::Union;
+		const auto MarkEntries = [&Nodes](const int32 First, bool bInside, const bool bFlip)
+		{
+			int32 Node = First;
+			do
+			{
+				if (Nodes[Node].Neighbor >= 0)
+				{
+					Nodes[Node].bEntry = !bInside != bFlip;
+					bInside = !bInside;
+				}
+				Node = Nodes[Node].Next;
+			} while (Node != First);
+		};
+		MarkEntries(0, IsInside(Subject[SubjectIndex(0)], Clip), bFlipSubject);
+		MarkEntries(SubjectCount, IsInside(Clip[ClipIndex(0)], Subject), bFlipClip);
+
+		// Intersections are added in pairs, the subject's node first. Starting where the subject is followed
+		// forward keeps every loop counterclockwise, and every loop has such a node.
+		for (int32 Start = FirstIntersection; Start < static_cast<int32>(Nodes.Num()); Start += 2)
+		{
+			if (Nodes[Start].bVisited || !Nodes[Start].bEntry)
+				continue;
+
+			Work.Loop.Clear();
+			int32 Node = Start;
+			for (;;)
+			{
+				Nodes[Node].bVisited = Nodes[Nodes[Node].Neighbor].bVisited = true;
+				Work.Loop.Add(Nodes[Node].X);
+				Work.Loop.Add(Nodes[Node].Y);
+
+				const bool bForward = Nodes[Node].bEntry;
+				for (Node = bForward ? Nodes[Node].Next : Nodes[Node].Prev; Nodes[Node].Neighbor < 0; Node = bForward ? Nodes[Node].Next : Nodes[Node].Prev)
+				{
+					Work.Loop.Add(Nodes[Node].X);
+					Work.Loop.Add(Nodes[Node].Y);
+				}
+
+				// Continue along the other polygon, unless the loop has closed
+				Node = Nodes[Node].Neighbor;
+				if (Nodes[Node].bVisited)
+					break;
+			}
+			AddLoop(Work.Loop, MinWidth, OutPolygons);
+		}
+		return ETraceResult::Done;
+	}
+
+	template <FloatingPoint T>
+	bool FPolygonProcessor2D<T>::BooleanInto(FWorkspace &Work, std::span<const FVector2D<T>> Subject, std::span<const FVector2D<T>> Clip,
+											 const EPolygonBoolean Operation, FPolygonSet2D<T> &OutPolygons)
+	{
+		const int64 SubjectCount = static_cast<int64>(Subject.size());
+		const int64 ClipCount = static_cast<int64>(Clip.size());
+		const T SubjectArea = SubjectCount >= 3 ? GetDoubleArea(Subject) : T(0);
+		const T ClipArea = ClipCount >= 3 ? GetDoubleArea(Clip) : T(0);
+
+		// A polygon without area is empty
+		if (SubjectArea == 0 || ClipArea == 0)
+		{
+			if (Operation != EPolygonBoolean::Intersection && SubjectArea != 0)
+				AddPolygon(Subject, SubjectArea < 0, OutPolygons);
+			if (Operation == EPolygonBoolean::Union && ClipArea != 0)
+				AddPolygon(Clip, ClipArea < 0, OutPolygons);
+			return true;
+		}
+
+		T Extent = 0;
+		for (const std::span<const FVector2D<T>> Polygon : {Subject, Clip})
+		{
+			for (const FVector2D<T> &Point : Polygon)
+				Extent = std::max({Extent, std::abs(Point.GetX()), std::abs(Point.GetY())});
+		}
+
+		for (int32 Attempt = 0; Attempt <= MaxPerturbations; ++Attempt)
+		{
+			std::span<const FVector2D<T>> Moved = Clip;
+			T Length = 0;
+			if (Attempt > 0)
+			{
+				// Successive attempts step out along the golden angle, so no edge direction stays degenerate for long
+				Length = Extent * 64 * std::numeric_limits<T>::epsilon() * static_cast<T>(Attempt);
+				const T Angle = T(2.39996322972865332) * static_cast<T>(Attempt);
+				const T OffsetX = Length * std::cos(Angle), OffsetY = Length * std::sin(Angle);
+
+				Work.Points.Clear();
+				for (int64 j = 0; j < ClipCount; ++j)
+					Work.Points.Add(FVector2D<T>(Clip[j].GetX() + OffsetX, Clip[j].GetY() + OffsetY));
+				Moved = Work.Points;
+			}
+
+			// Edges that overlapped before the nudge leave slivers about as wide as it, which are not part of the result
+			if (Trace(Work, Subject, SubjectArea < 0, Moved, ClipArea < 0, Operation, 2 * Length, OutPolygons) == ETraceResult::Done)
+				return true;
+		}
+		return false;
+	}
+
+	template <FloatingPoint T>
+	void FPolygonProcessor2D<T>::TriangulateInto(FWorkspace &Work, std::span<const FVector2D<T>> Polygon, const uint32 BaseIndex, uint32 *OutIndices)
+	{
+		const int32 Count = static_cast<int32>(Polygon.size());
+		if (Count < 3)
+			return;
+
+		const bool bReversed = GetDoubleArea(Polygon) < 0;
+
+		// Circular list running counterclockwise
+		Work.Links.Resize(2 * Count);
+		int32 *const Prev = Work.Links.GetData();
+		int32 *const Next = Prev + Count;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Next[i] = bReversed ? (i + Count - 1) % Count : (i + 1) % Count;
+			Prev[Next[i]] = i;
+		}
+
+		const auto Turn = [Polygon](const int32 A, const int32 B, const int32 C)
+		{ return Orient(Polygon[A], Polygon[B], Polygon[C]); };
+		const auto IsSamePoint = [Polygon](const int32 A, const int32 B)
+		{ return Polygon[A].GetX() == Polygon[B].GetX() && Polygon[A].GetY() == Polygon[B].GetY(); };
+
+		// Collinear vertices count as reflex: they are never ears and can block one
+		Work.Reflex.Resize(Count);
+		uint8 *const Reflex = Work.Reflex.GetData();
+		int32 ReflexCount = 0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Reflex[i] = !(Turn(Prev[i], i, Next[i]) > 0);
+			ReflexCount += Reflex[i];
+		}
+
+		// Only reflex vertices can lie inside the triangle of a convex vertex
+		const auto IsEar = [&](const int32 Ear)
+		{
+			const int32 A = Prev[Ear], C = Next[Ear];
+			if (ReflexCount == 0)
+				return true;
+			for (int32 Vertex = Next[C]; Vertex != A; Vertex = Next[Vertex])
+			{
+				if (!Reflex[Vertex] || IsSamePoint(Vertex, A) || IsSamePoint(Vertex, Ear) || IsSamePoint(Vertex, C))
+					continue;
+				if (Turn(A, Ear, Vertex) >= 0 && Turn(Ear, C, Vertex) >= 0 && Turn(C, A, Vertex) >= 0)
+					return false;
+			}
+			return true;
+		};
+
+		uint32 *Indices = OutIndices;
+		const auto ClipEar = [&](const int32 Ear)
+		{
+			const int32 A = Prev[Ear], C = Next[Ear];
+			*Indices++ = BaseIndex + static_cast<uint32>(bReversed ? C : A);
+			*Indices++ = BaseIndex + static_cast<uint32>(Ear);
+			*Indices++ = BaseIndex + static_cast<uint32>(bReversed ? A : C);
+
+			Next[A] = C;
+			Prev[C] = A;
+			ReflexCount -= Reflex[Ear];
+			for (const int32 Vertex : {A, C})
+			{
+				const uint8 bReflex = !(Turn(Prev[Vertex], Vertex, Next[Vertex]) > 0);
+				ReflexCount += bReflex - Reflex[Vertex];
+				Reflex[Vertex] = bReflex;
+			}
+		};
+
+		int32 Ear = 0;
+		int32 Misses = 0;
+		for (int32 Remaining = Count; Remaining > 3; --Remaining)
+		{
+			while (Reflex[Ear] || !IsEar(Ear))
+			{
+				Ear = Next[Ear];
+				if (++Misses < Remaining)
+					continue;
+
+				// A full turn without an ear: the input is not simple. Clip a convex vertex regardless, or any vertex.
+				for (int32 i = 0; i < Remaining && Reflex[Ear]; ++i)
+					Ear = Next[Ear];
+				break;
+			}
+
+			const int32 Following = Next[Ear];
+			ClipEar(Ear);
+			Ear = Following;
+			Misses = 0;
+		}
+		ClipEar(Ear);
+	}
+
+	template <FloatingPoint T>
+	void FPolygonProcessor2D<T>::OffsetInto(FWorkspace &Work, std::span<const FVector2D<T>> Polygon, const T Distance, const EPolygonJoin Join,
+											const T MiterLimit, const T ArcTolerance, FPolygonSet2D<T> &OutPolygons)
+	{
+		const int64 Count = static_cast<int64>(Polygon.size());
+		const bool bReversed = Count >= 3 && GetDoubleArea(Polygon) < 0;
+
+		Memory::FAlignedBuffer<T> &Cleaned = Work.Cleaned;
+		Cleaned.Clear();
+		for (int64 i = 0; i < Count; ++i)
+		{
+			const int64 Vertex = bReversed ? Count - 1 - i : i;
+			const T X = Polygon[Vertex].GetX(), Y = Polygon[Vertex].GetY();
+			if (Cleaned.Num() >= 2 && Cleaned[Cleaned.Num() - 2] == X && Cleaned[Cleaned.Num() - 1] == Y)
+				continue;
+			Cleaned.Add(X);
+			Cleaned.Add(Y);
+		}
+		if (Cleaned.Num() >= 4 && Cleaned[Cleaned.Num() - 2] == Cleaned[0] && Cleaned[Cleaned.Num() - 1] == Cleaned[1])
+			Cleaned.Resize(Cleaned.Num() - 2);
+
+		const int64 VertexCount = static_cast<int64>(Cleaned.Num() / 2);
+		if (VertexCount < 3 || !(GetDoubleArea(Cleaned.GetData(), VertexCount) > 0))
+		{
+			OutPolygons.ClosePolygon();
+			return;
+		}
+
+		Work.Tangents.Resize(Cleaned.Num());
+		T *const Tangents = Work.Tangents.GetData();
+		for (int64 i = 0; i < VertexCount; ++i)
+		{
+			const int64 Next = i + 1 < VertexCount ? i + 1 : 0;
+			const T DX = Cleaned[2 * Next] - Cleaned[2 * i], DY = Cleaned[2 * Next + 1] - Cleaned[2 * i + 1];
+			const T Length = std::sqrt(DX * DX + DY * DY);
+			Tangents[2 * i] = DX / Length;
+			Tangents[2 * i + 1] = DY / Length;
+		}
+
+		const T Radius = std::abs(Distance);
+		const T Side = Distance < 0 ? T(-1) : T(1);
+		const T Tolerance = ArcTolerance > 0 ? std::min(ArcTolerance, Radius) : Radius / 100;
+		const T MaxArcStep = Radius > 0 ? 2 * std::acos(1 - Tolerance / Radius) : T(0);
+
+		// Counts offset edges that run against their source edge, checked at the first point of every vertex
+		Memory::FAlignedBuffer<T> &Loop = Work.Loop;
+		Loop.Clear();
+		int64 ReversedCount = 0;
+		int64 PendingEdge = -1;
+		const auto CountReversed = [&Loop, Tangents, &ReversedCount](const size_t From, const T X, const T Y, const int64 Edge)
+		{
+			ReversedCount += (X - Loop[From]) * Tangents[2 * Edge] + (Y - Loop[From + 1]) * Tangents[2 * Edge + 1] < 0;
+		};
+		const auto Emit = [&](const T X, const T Y)
+		{
+			if (PendingEdge >= 0)
+				CountReversed(Loop.Num() - 2, X, Y, PendingEdge);
+			PendingEdge = -1;
+			Loop.Add(X);
+			Loop.Add(Y);
+		};
+
+		for (int64 i = 0; i < VertexCount; ++i)
+		{
+			PendingEdge = i - 1;
+
+			const int64 Previous = i > 0 ? i - 1 : VertexCount - 1;
+			const T VX = Cleaned[2 * i], VY = Cleaned[2 * i + 1];
+			const T T1X = Tangents[2 * Previous], T1Y = Tangents[2 * Previous + 1];
+			const T T2X = Tangents[2 * i], T2Y = Tangents[2 * i + 1];
+
+			// Outward normals of the edges before and after the vertex
+			const T N1X = T1Y, N1Y = -T1X;
+			const T N2X = T2Y, N2Y = -T2X;
+			const T Turn = T1X * T2Y - T1Y * T2X;
+			const T Alignment = T1X * T2X + T1Y * T2Y;
+
+			if (Distance == 0)
+			{
+				Emit(VX, VY);
+				continue;
+			}
+
+			// Where the offset edges overlap, their intersection is the corner; a full reversal has none
+			const bool bOpening = Turn * Distance > 0 || (Turn == 0 && Alignment < 0);
+			if (!bOpening)
+			{
+				if (1 + Alignment > std::sqrt(std::numeric_limits<T>::epsilon()))
+				{
+					const T Scale = Distance / (1 + Alignment);
+					Emit(VX + (N1X + N2X) * Scale, VY + (N1Y + N2Y) * Scale);
+				}
+				else
+				{
+					Emit(VX + N1X * Distance, VY + N1Y * Distance);
+					Emit(VX + N2X * Distance, VY + N2Y * Distance);
+				}
+				continue;
+			}
+
+			// Unit directions from the vertex to the two offset edges
+			const T U1X = N1X * Side, U1Y = N1Y * Side;
+			const T U2X = N2X * Side, U2Y = N2Y * Side;
+
+			if (Join == EPolygonJoin::Miter && (1 + Alignment) * MiterLimit * MiterLimit >= 2)
+			{
+				const T Scale = Distance / (1 + Alignment);
+				Emit(VX + (N1X + N2X) * Scale, VY + (N1Y + N2Y) * Scale);
+			}
+			else if (Join == EPolygonJoin::Round)
+			{
+				const T Angle = std::atan2(U1X * U2Y - U1Y * U2X, U1X * U2X + U1Y * U2Y);
+				const int32 Steps = std::max(1, static_cast<int32>(std::ceil(std::abs(Angle) / MaxArcStep)));
+				const T StepCos = std::cos(Angle / static_cast<T>(Steps)), StepSin = std::sin(Angle / static_cast<T>(Steps));
+				T RX = U1X, RY = U1Y;
+				for (int32 Step = 0; Step <= Steps; ++Step)
+				{
+					Emit(VX + RX * Radius, VY + RY * Radius);
+					const T NextX = RX * StepCos - RY * StepSin;
+					RY = RX * StepSin + RY * StepCos;
+					RX = NextX;
+				}
+			}
+			else
+			{
+				// Square, or a miter beyond the limit: cut the corner at the offset distance along the bisector
+				T BX = U1X + U2X, BY = U1Y + U2Y;
+				const T Length = std::sqrt(BX * BX + BY * BY);
+				if (Length > std::numeric_limits<T>::epsilon())
+				{
+					BX /= Length;
+					BY /= Length;
+				}
+				else
+				{
+					BX = T1X;
+					BY = T1Y;
+				}
+				const T Extension1 = Radius * (1 - (U1X * BX + U1Y * BY)) / (T1X * BX + T1Y * BY);
+				const T Extension2 = Radius * (1 - (U2X * BX + U2Y * BY)) / -(T2X * BX + T2Y * BY);
+				Emit(VX + U1X * Radius + T1X * Extension1, VY + U1Y * Radius + T1Y * Extension1);
+				Emit(VX + U2X * Radius - T2X * Extension2, VY + U2Y * Radius - T2Y * Extension2);
+			}
+		}
+
+		CountReversed(Loop.Num() - 2, Loop[0], Loop[1], VertexCount - 1);
+
+		// A loop that turned inside out, or whose edges all flipped over, has collapsed
+		if (ReversedCount < VertexCount && GetDoubleArea(Loop.GetData(), static_cast<int64>(Loop.Num() / 2)) > 0)
+		{
+			for (size_t i = 0; i < Loop.Num(); i += 2)
+				OutPolygons.AddVertex(FVector2D<T>(Loop[i], Loop[i + 1]));
+		}
+		OutPolygons.ClosePolygon();
+	}
+
+	template <FloatingPoint T>
+	bool FPolygonProcessor2D<T>::Boolean(std::span<const FVector2D<T>> Subject, std::type_identity_t<std::span<const FVector2D<T>>> Clip,
+										 const EPolygonBoolean Operation, FPolygonSet2D<T> &OutPolygons)
+	{
+		RATCHET_INSTRUMENT_SCOPE(Polygon2DBoolean);
+
+		PreparePartitions(1);
+		return BooleanInto(Workspaces[0], Subject, Clip, Operation, OutPolygons);
+	}
+
+	template <FloatingPoint T>
+	bool FPolygonProcessor2D<T>::Triangulate(std::span<const FVector2D<T>> Polygon, std::span<uint32> OutIndices)
+	{
+		if (static_cast<int64>(OutIndices.size()) != 3 * std::max<int64>(static_cast<int64>(Polygon.size()) - 2, 0))
+			return false;
+
+		RATCHET_INSTRUMENT_SCOPE(Polygon2DTriangulate);
+
+		PreparePartitions(1);
+		TriangulateInto(Workspaces[0], Polygon, 0, OutIndices.data());
+		return true;
+	}
+
+	template <FloatingPoint T>
+	void FPolygonProcessor2D<T>::Offset(std::span<const FVector2D<T>> Polygon, const std::type_identity_t<T> Distance, const EPolygonJoin Join,
+										FPolygonSet2D<T> &OutPolygons, const std::type_identity_t<T> MiterLimit, const std::type_identity_t<T> ArcTolerance)
+	{
+		RATCHET_INSTRUMENT_SCOPE(Polygon2DOffset);
+
+		PreparePartitions(1);
+		OffsetInto(Workspaces[0], Polygon, Distance, Join, MiterLimit, ArcTolerance, OutPolygons);
+	}
+
+	template <FloatingPoint T>
+	bool FPolygonProcessor2D<T>::BooleanMany(const FPolygonSet2D<T> &Subjects, const FPolygonSet2D<T> &Clips, const EPolygonBoolean Operation,
+											 FPolygonSet2D<T> &OutPolygons, std::span<uint32> OutFirstPolygons)
+	{
+		const int64 Count = Subjects.Num();
+		if ((Clips.Num() != 1 && Clips.Num() != Count) || static_cast<int64>(OutFirstPolygons.size()) != Count + 1)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(Polygon2DBooleanMany, Count);
+
+		const int64 PartitionCount = PreparePartitions(Count);
+		FWorkspace *const Works = Workspaces.GetData();
+		const bool bSharedClip = Clips.Num() == 1;
+		Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+							  {
+								  for (int64 Partition = Begin; Partition < End; ++Partition)
+								  {
+									  FWorkspace &Work = Works[Partition];
+									  Work.Output.Clear();
+									  Work.bSucceeded = true;
+
+									  // Counts for now, turned into offsets once all partitions are done
+									  const int64 Last = Count * (Partition + 1) / PartitionCount;
+									  for (int64 i = Count * Partition / PartitionCount; i < Last; ++i)
+									  {
+										  const int64 Before = Work.Output.Num();
+										  const bool bSucceeded = BooleanInto(Work, Subjects.GetPolygon(i), Clips.GetPolygon(bSharedClip ? 0 : i), Operation, Work.Output);
+										  Work.bSucceeded = Work.bSucceeded && bSucceeded;
+										  OutFirstPolygons[i + 1] = static_cast<uint32>(Work.Output.Num() - Before);
+									  }
+								  } });
+
+		bool bSucceeded = true;
+		OutPolygons.Clear();
+		for (int64 Partition = 0; Partition < PartitionCount; ++Partition)
+		{
+			OutPolygons.Append(Works[Partition].Output);
+			bSucceeded = bSucceeded && Works[Partition].bSucceeded;
+		}
+
+		OutFirstPolygons[0] = 0;
+		for (int64 i = 0; i < Count; ++i)
+			OutFirstPolygons[i + 1] += OutFirstPolygons[i];
+		return bSucceeded;
+	}
+
+	template <FloatingPoint T>
+	bool FPolygonProcessor2D<T>::TriangulateMany(const FPolygonSet2D<T> &Polygons, std::span<uint32> OutIndices)
+	{
+		if (static_cast<int64>(OutIndices.size()) != Polygons.GetTriangleIndexCount())
+			return false;
+
+		const int64 Count = Polygons.Num();
+		RATCHET_INSTRUMENT_BATCH(Polygon2DTriangulateMany, Count);
+
+		// Every polygon writes its own range of the output
+		const std::span<const uint32> Offsets = Polygons.GetOffsets();
+		TriangleOffsets.Resize(Count);
+		int64 Running = 0;
+		for (int64 i = 0; i < Count; ++i)
+		{
+			TriangleOffsets[i] = Running;
+			Running += 3 * std::max<int64>(static_cast<int64>(Offsets[i + 1]) - Offsets[i] - 2, 0);
+		}
+
+		const int64 PartitionCount = PreparePartitions(Count);
+		FWorkspace *const Works = Workspaces.GetData();
+		const int64 *const Starts = TriangleOffsets.GetData();
+		Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+							  {
+								  for (int64 Partition = Begin; Partition < End; ++Partition)
+								  {
+									  const int64 Last = Count * (Partition + 1) / PartitionCount;
+									  for (int64 i = Count * Partition / PartitionCount; i < Last; ++i)
+										  TriangulateInto(Works[Partition], Polygons.GetPolygon(i), Offsets[i], OutIndices.data() + Starts[i]);
+								  } });
+		return true;
+	}
+
+	template <FloatingPoint T>
+	void FPolygonProcessor2D<T>::OffsetMany(const FPolygonSet2D<T> &Polygons, const std::type_identity_t<T> Distance, const EPolygonJoin Join,
+											FPolygonSet2D<T> &OutPolygons, const std::type_identity_t<T> MiterLimit, const std::type_identity_t<T> ArcTolerance)
+	{
+		const int64 Count = Polygons.Num();
+		RATCHET_INSTRUMENT_BATCH(Polygon2DOffsetMany, Count);
+
+		const int64 PartitionCount = PreparePartitions(Count);
+		FWorkspace *const Works = Workspaces.GetData();
+		Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+							  {
+								  for (int64 Partition = Begin; Partition < End; ++Partition)
+								  {
+									  FWorkspace &Work = Works[Partition];
+									  Work.Output.Clear();
+									  const int64 Last = Count * (Partition + 1) / PartitionCount;
+									  for (int64 i = Count * Partition / PartitionCount; i < Last; ++i)
+										  OffsetInto(Work, Polygons.GetPolygon(i), Distance, Join, MiterLimit, ArcTolerance, Work.Output);
+								  } });
+
+		OutPolygons.Clear();
+		for (int64 Partition = 0; Partition < PartitionCount; ++Partition)
+			OutPolygons.Append(Works[Partition].Output);
+	}
+
+	// Explicit instantiation for float
+	template class FPolygonSet2D<float>;
+	template class FPolygonProcessor2D<float>;
+
+	// Explicit instantiation for double
+	template class FPolygonSet2D<double>;
+	template class FPolygonProcessor2D<double>;
+}
@@ -0,0 +1,391 @@
+#include "Predicates.h"
+#include "Instrument.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ratchet
+{
+	namespace Predicates
+	{
+		namespace
+		{
+			// Half an ulp of 1, the relative error of one rounding
+			constexpr double Epsilon = 0x1p-53;
+
+			// Splits a double into two halves of 26 bits whose products are exact
+			constexpr double Splitter = 0x1p27 + 1;
+
+			// Relative error bounds of the double evaluations, from Shewchuk's analysis
+			constexpr double Orient2DErrorBound = (3 + 16 * Epsilon) * Epsilon;
+			constexpr double Orient3DErrorBound = (7 + 56 * Epsilon) * Epsilon;
+			constexpr double InCircleErrorBound = (10 + 96 * Epsilon) * Epsilon;
+			constexpr double InSphereErrorBound = (16 + 224 * Epsilon) * Epsilon;
+
+			/**
+			 * Sum of doubles without round-off: nonoverlapping components in order of increasing magnitude,
+			 * zeros removed. Never empty; zero is a single zero component. Capacity is the worst-case length
+			 * and grows with every operation at compile time.
+			 */
+			template <int32 Capacity>
+			struct FExpansion
+			{
+				int32 Length = 0;
+				double Terms[Capacity];
+
+				// The most significant component, which has the sign and roughly the value of the whole expansion
+				double GetApproximation() const
+				{
+					return Terms[Length - 1];
+				}
+
+				void Push(const double Term)
+				{
+					if (Term != 0)
+						Terms[Length++] = Term;
+				}
+
+				// Pushes the last, most significant component, which is kept even if zero when nothing else is
+				void Finish(const double Term)
+				{
+					if (Term != 0 || Length == 0)
+						Terms[Length++] = Term;
+				}
+			};
+
+			// X + Y = A + B exactly, with X the rounded sum
+			void TwoSum(const double A, const double B, double &X, double &Y)
+			{
+				X = A + B;
+				const double BVirtual = X - A;
+				const double AVirtual = X - BVirtual;
+				Y = (A - AVirtual) + (B - BVirtual);
+			}
+
+			// TwoSum for |A| >= |B|
+			void FastTwoSum(const double A, const double B, double &X, double &Y)
+			{
+				X = A + B;
+				Y = B - (X - A);
+			}
+
+			void Split(const double A, double &High, double &Low)
+			{
+				const double C = Splitter * A;
+				High = C - (C - A);
+				Low = A - High;
+			}
+
+			// X + Y = A * B exactly, with X the rounded product
+			void TwoProduct(const double A, const double B, double &X, double &Y)
+			{
+				X = A * B;
+				double AHigh, ALow, BHigh, BLow;
+				Split(A, AHigh, ALow);
+				Split(B, BHigh, BLow);
+				Y = ALow * BLow - (((X - AHigh * BHigh) - ALow * BHigh) - AHigh * BLow);
+			}
+
+			FExpansion<2> Product(const double A, const double B)
+			{
+				FExpansion<2> Result;
+				double X, Y;
+				TwoProduct(A, B, X, Y);
+				Result.Push(Y);
+				Result.Finish(X);
+				return Result;
+			}
+
+			template <int32 A, int32 B>
+			FExpansion<A + B> operator+(const FExpansion<A> &E, const FExpansion<B> &F)
+			{
+				// Merge by increasing magnitude, then carry the running sum through all components
+				int32 i = 0, j = 0;
+				const auto Next = [&E, &F, &i, &j]()
+				{
+					if (j == F.Length || (i < E.Length && std::abs(E.Terms[i]) < std::abs(F.Terms[j])))
+						return E.Terms[i++];
+					return F.Terms[j++];
+				};
+
+				FExpansion<A + B> Result;
+				double Q = Next();
+				for (int32 k = 1; k < E.Length + F.Length; ++k)
+				{
+					double Sum, Error;
+					TwoSum(Q, Next(), Sum, Error);
+					Result.Push(Error);
+					Q = Sum;
+				}
+				Result.Finish(Q);
+				return Result;
+			}
+
+			template <int32 A>
+			FExpansion<A> operator-(const FExpansion<A> &E)
+			{
+				FExpansion<A> Result = E;
+				for (int32 k = 0; k < Result.Length; ++k)
+					Result.Terms[k] = -Result.Terms[k];
+				return Result;
+			}
+
+			template <int32 A, int32 B>
+			FExpansion<A + B> operator-(const FExpansion<A> &E, const FExpansion<B> &F)
+			{
+				return E + -F;
+			}
+
+			template <int32 A>
+			FExpansion<2 * A> operator*(const FExpansion<A> &E, const double B)
+			{
+				FExpansion<2 * A> Result;
+				double Q, Error;
+				TwoProduct(E.Terms[0], B, Q, Error);
+				Result.Push(Error);
+				for (int32 k = 1; k < E.Length; ++k)
+				{
+					double High, Low, Sum;
+					TwoProduct(E.Terms[k], B, High, Low);
+					TwoSum(Q, Low, Sum, Error);
+					Result.Push(Error);
+					FastTwoSum(High, Sum, Q, Error);
+					Result.Push(Error);
+				}
+				Result.Finish(Q);
+				return Result;
+			}
+
+			template <int32 A, int32 B>
+			FExpansion<2 * A * B> operator*(const FExpansion<A> &E, const FExpansion<B> &F)
+			{
+				FExpansion<2 * A * B> Result;
+				Result.Finish(0);
+				for (int32 k = 0; k < F.Length; ++k)
+				{
+					const FExpansion<2 * A> Scaled = E * F.Terms[k];
+					const FExpansion<2 * A * B + 2 * A> Sum = Result + Scaled;
+
+					// The true length never exceeds the capacity of the full product
+					Result.Length = Sum.Length;
+					std::copy(Sum.Terms, Sum.Terms + Sum.Length, Result.Terms);
+				}
+				return Result;
+			}
+
+			// A * B - C * D
+			FExpansion<4> CrossDifference(const double A, const double B, const double C, const double D)
+			{
+				return Product(A, B) - Product(C, D);
+			}
+
+			// X * X + Y * Y (+ Z * Z), the lifting of a point onto the paraboloid
+			FExpansion<4> Lift(const double X, const double Y)
+			{
+				return Product(X, X) + Product(Y, Y);
+			}
+
+			FExpansion<6> Lift(const double X, const double Y, const double Z)
+			{
+				return Product(X, X) + Product(Y, Y) + Product(Z, Z);
+			}
+
+			// Determinant of the rows (X, Y) of two points
+			FExpansion<4> Determinant2(const double *P, const double *Q)
+			{
+				return CrossDifference(P[0], Q[1], Q[0], P[1]);
+			}
+
+			// Determinant of the rows (X, Y, Z) of three points, expanded along Z
+			FExpansion<24> Determinant3(const double *P, const double *Q, const double *R)
+			{
+				return (Determinant2(Q, R) * P[2] - Determinant2(P, R) * Q[2]) + Determinant2(P, Q) * R[2];
+			}
+
+			double Orient2DExact(const double (&Points)[3][2])
+			{
+				RATCHET_INSTRUMENT_SCOPE(PredicateOrient2DExact);
+
+				// Determinant of the rows (X, Y, 1)
+				const FExpansion<12> Result = (Determinant2(Points[0], Points[1]) + Determinant2(Points[1], Points[2])) + Determinant2(Points[2], Points[0]);
+				return Result.GetApproximation();
+			}
+
+			double Orient3DExact(const double (&Points)[4][3])
+			{
+				RATCHET_INSTRUMENT_SCOPE(PredicateOrient3DExact);
+
+				// Determinant of the rows (X, Y, Z, 1), expanded along the last column
+				const double *const A = Points[0], *const B = Points[1], *const C = Points[2], *const D = Points[3];
+				const FExpansion<96> Result = (Determinant3(A, B, C) - Determinant3(A, B, D)) + (Determinant3(A, C, D) - Determinant3(B, C, D));
+				return Result.GetApproximation();
+			}
+
+			double InCircleExact(const double (&Points)[4][2])
+			{
+				RATCHET_INSTRUMENT_SCOPE(PredicateInCircleExact);
+
+				// Determinant of the rows (X, Y, X^2 + Y^2, 1), expanded along the last column and then the lifted one
+				FExpansion<4> Lifts[4];
+				for (int32 i = 0; i < 4; ++i)
+					Lifts[i] = Lift(Points[i][0], Points[i][1]);
+
+				const auto Minor = [&Points, &Lifts](const int32 P, const int32 Q, const int32 R)
+				{
+					return (Lifts[P] * Determinant2(Points[Q], Points[R]) - Lifts[Q] * Determinant2(Points[P], Points[R])) +
+						   Lifts[R] * Determinant2(Points[P], Points[Q]);
+				};
+				const FExpansion<384> Result = (Minor(0, 1, 2) - Minor(0, 1, 3)) + (Minor(0, 2, 3) - Minor(1, 2, 3));
+				return Result.GetApproximation();
+			}
+
+			double InSphereExact(const double (&Points)[5][3])
+			{
+				RATCHET_INSTRUMENT_SCOPE(PredicateInSphereExact);
+
+				// Determinant of the rows (X, Y, Z, X^2 + Y^2 + Z^2, 1), expanded along the last column and then
+				// the lifted one
+				FExpansion<6> Lifts[5];
+				for (int32 i = 0; i < 5; ++i)
+					Lifts[i] = Lift(Points[i][0], Points[i][1], Points[i][2]);
+
+				const auto Minor = [&Points, &Lifts](const int32 P, const int32 Q, const int32 R, const int32 S)
+				{
+					return (Lifts[Q] * Determinant3(Points[P], Points[R], Points[S]) - Lifts[P] * Determinant3(Points[Q], Points[R], Points[S])) +
+						   (Lifts[S] * Determinant3(Points[P], Points[Q], Points[R]) - Lifts[R] * Determinant3(Points[P], Points[Q], Points[S]));
+				};
+				const FExpansion<5760> Result = ((Minor(1, 2, 3, 4) - Minor(0, 2, 3, 4)) + (Minor(0, 1, 3, 4) - Minor(0, 1, 2, 4))) + Minor(0, 1, 2, 3);
+				return Result.GetApproximation();
+			}
+		}
+
+		template <FloatingPoint T>
+		double Orient2D(const FVector2D<T> &A, const FVector2D<T> &B, const FVector2D<T> &C)
+		{
+			RATCHET_INSTRUMENT_SCOPE(PredicateOrient2D);
+
+			const double Points[3][2] = {{double(A.GetX()), double(A.GetY())}, {double(B.GetX()), double(B.GetY())}, {double(C.GetX()), double(C.GetY())}};
+			const double Left = (Points[0][0] - Points[2][0]) * (Points[1][1] - Points[2][1]);
+			const double Right = (Points[0][1] - Points[2][1]) * (Points[1][0] - Points[2][0]);
+			const double Determinant = Left - Right;
+			const double ErrorBound = Orient2DErrorBound * (std::abs(Left) + std::abs(Right));
+			if (std::abs(Determinant) > ErrorBound)
+				return Determinant;
+
+			return Orient2DExact(Points);
+		}
+
+		template <FloatingPoint T>
+		double Orient3D(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3D<T> &D)
+		{
+			RATCHET_INSTRUMENT_SCOPE(PredicateOrient3D);
+
+			const double Points[4][3] = {{double(A.GetX()), double(A.GetY()), double(A.GetZ())},
+										 {double(B.GetX()), double(B.GetY()), double(B.GetZ())},
+										 {double(C.GetX()), double(C.GetY()), double(C.GetZ())},
+										 {double(D.GetX()), double(D.GetY()), double(D.GetZ())}};
+			const double ADX = Points[0][0] - Points[3][0], ADY = Points[0][1] - Points[3][1], ADZ = Points[0][2] - Points[3][2];
+			const double BDX = Points[1][0] - Points[3][0], BDY = Points[1][1] - Points[3][1], BDZ = Points[1][2] - Points[3][2];
+			const double CDX = Points[2][0] - Points[3][0], CDY = Points[2][1] - Points[3][1], CDZ = Points[2][2] - Points[3][2];
+
+			const double BDXCDY = BDX * CDY, CDXBDY = CDX * BDY;
+			const double CDXADY = CDX * ADY, ADXCDY = ADX * CDY;
+			const double ADXBDY = ADX * BDY, BDXADY = BDX * ADY;
+			const double Determinant = ADZ * (BDXCDY - CDXBDY) + BDZ * (CDXADY - ADXCDY) + CDZ * (ADXBDY - BDXADY);
+			const double Permanent = (std::abs(BDXCDY) + std::abs(CDXBDY)) * std::abs(ADZ) + (std::abs(CDXADY) + std::abs(ADXCDY)) * std::abs(BDZ) +
+									 (std::abs(ADXBDY) + std::abs(BDXADY)) * std::abs(CDZ);
+			if (std::abs(Determinant) > Orient3DErrorBound * Permanent)
+				return Determinant;
+
+			return Orient3DExact(Points);
+		}
+
+		template <FloatingPoint T>
+		double InCircle(const FVector2D<T> &A, const FVector2D<T> &B, const FVector2D<T> &C, const FVector2D<T> &D)
+		{
+			RATCHET_INSTRUMENT_SCOPE(PredicateInCircle);
+
+			const double Points[4][2] = {{double(A.GetX()), double(A.GetY())},
+										 {double(B.GetX()), double(B.GetY())},
+										 {double(C.GetX()), double(C.GetY())},
+										 {double(D.GetX()), double(D.GetY())}};
+			const double ADX = Points[0][0] - Points[3][0], ADY = Points[0][1] - Points[3][1];
+			const double BDX = Points[1][0] - Points[3][0], BDY = Points[1][1] - Points[3][1];
+			const double CDX = Points[2][0] - Points[3][0], CDY = Points[2][1] - Points[3][1];
+
+			const double BDXCDY = BDX * CDY, CDXBDY = CDX * BDY;
+			const double CDXADY = CDX * ADY, ADXCDY = ADX * CDY;
+			const double ADXBDY = ADX * BDY, BDXADY = BDX * ADY;
+			const double ALift = ADX * ADX + ADY * ADY;
+			const double BLift = BDX * BDX + BDY * BDY;
+			const double CLift = CDX * CDX + CDY * CDY;
+			const double Determinant = ALift * (BDXCDY - CDXBDY) + BLift * (CDXADY - ADXCDY) + CLift * (ADXBDY - BDXADY);
+			const double Permanent = (std::abs(BDXCDY) + std::abs(CDXBDY)) * ALift + (std::abs(CDXADY) + std::abs(ADXCDY)) * BLift +
+									 (std::abs(ADXBDY) + std::abs(BDXADY)) * CLift;
+			if (std::abs(Determinant) > InCircleErrorBound * Permanent)
+				return Determinant;
+
+			return InCircleExact(Points);
+		}
+
+		template <FloatingPoint T>
+		double InSphere(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3D<T> &D, const FVector3D<T> &E)
+		{
+			RATCHET_INSTRUMENT_SCOPE(PredicateInSphere);
+
+			const double Points[5][3] = {{double(A.GetX()), double(A.GetY()), double(A.GetZ())},
+										 {double(B.GetX()), double(B.GetY()), double(B.GetZ())},
+										 {double(C.GetX()), double(C.GetY()), double(C.GetZ())},
+										 {double(D.GetX()), double(D.GetY()), double(D.GetZ())},
+										 {double(E.GetX()), double(E.GetY()), double(E.GetZ())}};
+			const double AEX = Points[0][0] - Points[4][0], AEY = Points[0][1] - Points[4][1], AEZ = Points[0][2] - Points[4][2];
+			const double BEX = Points[1][0] - Points[4][0], BEY = Points[1][1] - Points[4][1], BEZ = Points[1][2] - Points[4][2];
+			const double CEX = Points[2][0] - Points[4][0], CEY = Points[2][1] - Points[4][1], CEZ = Points[2][2] - Points[4][2];
+			const double DEX = Points[3][0] - Points[4][0], DEY = Points[3][1] - Points[4][1], DEZ = Points[3][2] - Points[4][2];
+
+			const double AEXBEY = AEX * BEY, BEXAEY = BEX * AEY;
+			const double BEXCEY = BEX * CEY, CEXBEY = CEX * BEY;
+			const double CEXDEY = CEX * DEY, DEXCEY = DEX * CEY;
+			const double DEXAEY = DEX * AEY, AEXDEY = AEX * DEY;
+			const double AEXCEY = AEX * CEY, CEXAEY = CEX * AEY;
+			const double BEXDEY = BEX * DEY, DEXBEY = DEX * BEY;
+			const double AB = AEXBEY - BEXAEY, BC = BEXCEY - CEXBEY, CD = CEXDEY - DEXCEY;
+			const double DA = DEXAEY - AEXDEY, AC = AEXCEY - CEXAEY, BD = BEXDEY - DEXBEY;
+
+			const double ABC = AEZ * BC - BEZ * AC + CEZ * AB;
+			const double BCD = BEZ * CD - CEZ * BD + DEZ * BC;
+			const double CDA = CEZ * DA + DEZ * AC + AEZ * CD;
+			const double DAB = DEZ * AB + AEZ * BD + BEZ * DA;
+			const double ALift = AEX * AEX + AEY * AEY + AEZ * AEZ;
+			const double BLift = BEX * BEX + BEY * BEY + BEZ * BEZ;
+			const double CLift = CEX * CEX + CEY * CEY + CEZ * CEZ;
+			const double DLift = DEX * DEX + DEY * DEY + DEZ * DEZ;
+			const double Determinant = (DLift * ABC - CLift * DAB) + (BLift * CDA - ALift * BCD);
+
+			const double AZ = std::abs(AEZ), BZ = std::abs(BEZ), CZ = std::abs(CEZ), DZ = std::abs(DEZ);
+			const double ABPlus = std::abs(AEXBEY) + std::abs(BEXAEY), BCPlus = std::abs(BEXCEY) + std::abs(CEXBEY);
+			const double CDPlus = std::abs(CEXDEY) + std::abs(DEXCEY), DAPlus = std::abs(DEXAEY) + std::abs(AEXDEY);
+			const double ACPlus = std::abs(AEXCEY) + std::abs(CEXAEY), BDPlus = std::abs(BEXDEY) + std::abs(DEXBEY);
+			const double Permanent = (CDPlus * BZ + BDPlus * CZ + BCPlus * DZ) * ALift + (DAPlus * CZ + ACPlus * DZ + CDPlus * AZ) * BLift +
+									 (ABPlus * DZ + BDPlus * AZ + DAPlus * BZ) * CLift + (BCPlus * AZ + ACPlus * BZ + ABPlus * CZ) * DLift;
+			if (std::abs(Determinant) > InSphereErrorBound * Permanent)
+				return Determinant;
+
+			return InSphereExact(Points);
+		}
+
+		// Explicit instantiation for float
+		template double Orient2D(const FVector2D<float> &A, const FVector2D<float> &B, const FVector2D<float> &C);
+		template double Orient3D(const FVector3D<float> &A, const FVector3D<float> &B, const FVector3D<float> &C, const FVector3D<float> &D);
+		template double InCircle(const FVector2D<float> &A, const FVector2D<float> &B, const FVector2D<float> &C, const FVector2D<float> &D);
+		template double InSphere(const FVector3D<float> &A, const FVector3D<float> &B, const FVector3D<float> &C, const FVector3D<float> &D,
+								 const FVector3D<float> &E);
+
+		// Explicit instantiation for double
+		template double Orient2D(const FVector2D<double> &A, const FVector2D<double> &B, const FVector2D<double> &C);
+		template double Orient3D(const FVector3D<double> &A, const FVector3D<double> &B, const FVector3D<double> &C, const FVector3D<double> &D);
+		template double InCircle(const FVector2D<double> &A, const FVector2D<double> &B, const FVector2D<double> &C, const FVector2D<double> &D);
+		template double InSphere(const FVector3D<double> &A, const FVector3D<double> &B, const FVector3D<double> &C, const FVector3D<double> &D,
+								 const FVector3D<double> &E);
+	}
+}
@@ -0,0 +1,128 @@
+#include "Quat.h"
+#include "REMath.h"
+
+#include <cmath>
+
+namespace Ratchet
+{
+	template <FloatingPoint T>
+	FQuat<T>::FQuat()
+		: Components{0, 0, 0, 1} {}
+
+	template <FloatingPoint T>
+	FQuat<T>::FQuat(const T InX, const T InY, const T InZ, const T InW)
+		: Components{InX, InY, InZ, InW} {}
+
+	template <FloatingPoint T>
+	FQuat<T>::FQuat(const FVector3D<T> &Axis, const T Angle)
+	{
+		const T HalfAngle = Angle / 2;
+		const T Sine = std::sin(HalfAngle);
+		Components[0] = Axis.GetX() * Sine;
+		Components[1] = Axis.GetY() * Sine;
+		Components[2] = Axis.GetZ() * Sine;
+		Components[3] = std::cos(HalfAngle);
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FQuat<T>::GetVector() const
+	{
+		return {Components[0], Components[1], Components[2]};
+	}
+
+	template <FloatingPoint T>
+	T FQuat<T>::Magnitude() const
+	{
+		return Math::Sqrt<T>(Components[0] * Components[0] + Components[1] * Components[1] + Components[2] * Components[2] + Components[3] * Components[3]);
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> &FQuat<T>::Normalize()
+	{
+		return *this *= static_cast<T>(1) / Magnitude();
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> FQuat<T>::GetConjugate() const
+	{
+		return {-Components[0], -Components[1], -Components[2], Components[3]};
+	}
+
+	template <FloatingPoint T>
+	FVector3D<T> FQuat<T>::RotateVector(const FVector3D<T> &Vector) const
+	{
+		// v' = v + 2 * q.xyz x (q.xyz x v + w * v)
+		const FVector3D<T> Axis = GetVector();
+		const FVector3D<T> Inner = Cross(Axis, Vector) + Vector * Components[3];
+		return Vector + Cross(Axis, Inner) * static_cast<T>(2);
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> &FQuat<T>::operator+=(const FQuat &Other)
+	{
+		Components[0] += Other.Components[0];
+		Components[1] += Other.Components[1];
+		Components[2] += Other.Components[2];
+		Components[3] += Other.Components[3];
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> &FQuat<T>::operator*=(const T Scalar)
+	{
+		Components[0] *= Scalar;
+		Components[1] *= Scalar;
+		Components[2] *= Scalar;
+		Components[3] *= Scalar;
+		return *this;
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> operator*(const FQuat<T> &A, const FQuat<T> &B)
+	{
+		return {
+			A.GetW() * B.GetX() + A.GetX() * B.GetW() + A.GetY() * B.GetZ() - A.GetZ() * B.GetY(),
+			A.GetW() * B.GetY() - A.GetX() * B.GetZ() + A.GetY() * B.GetW() + A.GetZ() * B.GetX(),
+			A.GetW() * B.GetZ() + A.GetX() * B.GetY() - A.GetY() * B.GetX() + A.GetZ() * B.GetW(),
+			A.GetW() * B.GetW() - A.GetX() * B.GetX() - A.GetY() * B.GetY() - A.GetZ() * B.GetZ()};
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> operator*(const FQuat<T> &LHS, const T Scalar)
+	{
+		return {LHS.GetX() * Scalar, LHS.GetY() * Scalar, LHS.GetZ() * Scalar, LHS.GetW() * Scalar};
+	}
+
+	template <FloatingPoint T>
+	FQuat<T> operator+(const FQuat<T> &A, const FQuat<T> &B)
+	{
+		return {A.GetX() + B.GetX(), A.GetY() + B.GetY(), A.GetZ() + B.GetZ(), A.GetW() + B.GetW()};
+	}
+
+	template <FloatingPoint T>
+	T Dot(const FQuat<T> &A, const FQuat<T> &B)
+	{
+		return A.GetX() * B.GetX() + A.GetY() * B.GetY() + A.GetZ() * B.GetZ() + A.GetW() * B.GetW();
+	}
+
+	// Explicit instantiation for float
+	template class FQuat<float>;
+	template FQuat<float> operator*(const FQuat<float> &A, const FQuat<float> &B);
+	template FQuat<float> operator*(const FQuat<float> &LHS, const float Scalar);
+	template FQuat<float> operator+(const FQuat<float> &A, const FQuat<float> &B);
+	template float Dot(const FQuat<float> &A, const FQuat<float> &B);
+
+	// Explicit instantiation for double
+	template class FQuat<double>;
+	template FQuat<double> operator*(const FQuat<double> &A, const FQuat<double> &B);
+	template FQuat<double> operator*(const FQuat<double> &LHS, const double Scalar);
+	template FQuat<double> operator+(const FQuat<double> &A, const FQuat<double> &B);
+	template double Dot(const FQuat<double> &A, const FQuat<double> &B);
+
+	// Explicit instantiation for long double
+	template class FQuat<long double>;
+	template FQuat<long double> operator*(const FQuat<long double> &A, const FQuat<long double> &B);
+	template FQuat<long double> operator*(const FQuat<long double> &LHS, const long double Scalar);
+	template FQuat<long double> operator+(const FQuat<long double> &A, const FQuat<long double> &B);
+	template long double Dot(const FQuat<long double> &A, const FQuat<long double> &B);
+}
@@ -1,13 +1,279 @@
 #include "REMath.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
 #include <type_traits>
 
+#include "Instrument.h"
+#include "Parallel.h"
 #include "Platform.h"
 
 namespace Ratchet
 {
 	namespace Math
 	{
+		namespace
+		{
+			// Elements per worker batch of the array functions
+			constexpr int64 ArrayBatchSize = 16384;
+
+			template <typename T>
+			struct TFloatBits;
+
+			template <>
+			struct TFloatBits<float>
+			{
+				using UIntType = uint32;
+				using IntType = int32;
+				static constexpr int32 MantissaBits = 23;
+				static constexpr int32 ExponentBias = 127;
+			};
+
+			template <>
+			struct TFloatBits<double>
+			{
+				using UIntType = uint64;
+				using IntType = int64;
+				static constexpr int32 MantissaBits = 52;
+				static constexpr int32 ExponentBias = 1023;
+			};
+
+			/**
+			 * Minimax coefficients, lowest power first, fitted in double precision. Each tier uses the
+			 * smallest degree that meets its error target after float rounding.
+			 */
+
+			// sin(r) / r = P(r^2) on [0, pi/4]
+			template <EPrecision Precision>
+			constexpr auto GetSinCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Low)
+					return std::array<double, 2>{0.9990314480265328, -0.16034406681121147};
+				else if constexpr (Precision == EPrecision::Medium)
+					return std::array<double, 3>{0.9999949977900874, -0.1666016211439204, 0.00812155943598498};
+				else
+					return std::array<double, 4>{0.9999999861803085, -0.16666636755335545, 0.008331584636770598, -0.00019462119623787598};
+			}
+
+			// cos(r) = P(r^2) on [0, pi/4]
+			template <EPrecision Precision>
+			constexpr auto GetCosCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Low)
+					return std::array<double, 3>{0.9999900711949112, -0.4997083768649642, 0.04039884359119448};
+				else if constexpr (Precision == EPrecision::Medium)
+					return std::array<double, 4>{0.9999999725295626, -0.49999856834883755, 0.04165503141192058, -0.0013585950562861827};
+				else
+					return std::array<double, 5>{0.9999999999525943, -0.49999999614672613, 0.04166661666432171, -0.0013886617117847193, 2.437975306629846e-05};
+			}
+
+			// atan(z) / z = P(z^2) on [0, tan(pi/8)]
+			template <EPrecision Precision>
+			constexpr auto GetAtanCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Low)
+					return std::array<double, 2>{0.9984600903730154, -0.29551055397212456};
+				else if constexpr (Precision == EPrecision::Medium)
+					return std::array<double, 3>{0.9999393724622697, -0.33039566678440163, 0.16358584761244568};
+				else
+					return std::array<double, 5>{0.9999999055850541, -0.33332204073987465, 0.19961965034451576, -0.13754805531219624, 0.07734539134002838};
+			}
+
+			// acos(x) / sqrt(1 - x) = P(x) on [0, 1]
+			template <EPrecision Precision>
+			constexpr auto GetAcosCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Low)
+					return std::array<double, 3>{1.5704702426473338, -0.2054972989616585, 0.051389199452229944};
+				else if constexpr (Precision == EPrecision::Medium)
+					return std::array<double, 5>{1.5707915336827003, -0.21428059802951124, 0.08563829728383748, -0.037618063069713284, 0.009732879571371976};
+				else
+					return std::array<double, 8>{1.570796314298345, -0.21459989017872172, 0.08899922451807223, -0.050312517355467185,
+												 0.031334635381014754, -0.017807653939094052, 0.007244403539792531, -0.001441159407832799};
+			}
+
+			// exp(r) = P(r) on [-ln(2)/2, ln(2)/2], minimax in relative error
+			template <EPrecision Precision>
+			constexpr auto GetExpCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Low)
+					return std::array<double, 4>{0.9999280739673557, 1.000164197838829, 0.5049632569448204, 0.1656682872881687};
+				else if constexpr (Precision == EPrecision::Medium)
+					return std::array<double, 5>{0.9999992614067442, 0.9999634049633201, 0.5000435893068904, 0.16790907091654664, 0.041458585494843374};
+				else
+					return std::array<double, 7>{1.0000000005541017, 1.00000003632229, 0.4999999208037369, 0.16666420172769444,
+												 0.04166822547719258, 0.00837481561304714, 0.0013836850162365936};
+			}
+
+			// 2 atanh(s) / s = P(s^2) for s = (m - 1) / (m + 1), m in [sqrt(1/2), sqrt(2)); the quadratic already meets Medium
+			template <EPrecision Precision>
+			constexpr auto GetLogCoefficients()
+			{
+				if constexpr (Precision == EPrecision::Full)
+					return std::array<double, 3>{2.000000836997345, 0.66644078518843, 0.41517693987046483};
+				else
+					return std::array<double, 2>{1.9998880515100423, 0.681734037075944};
+			}
+
+			template <typename T, std::size_t N>
+			inline T Polynomial(const T X, const std::array<double, N> &Coefficients)
+			{
+				T Result = static_cast<T>(Coefficients[N - 1]);
+				for (std::size_t i = N - 1; i-- > 0;)
+					Result = Result * X + static_cast<T>(Coefficients[i]);
+				return Result;
+			}
+
+			// Adding this rounds to the nearest integer and leaves it in the low mantissa bits
+			template <typename T>
+			constexpr T RoundingShift = static_cast<T>(1.5) * static_cast<T>(1ull << (std::numeric_limits<T>::digits - 1));
+
+			// Branch-free select; plain ternaries get turned back into branches when only one side is used
+			template <typename T>
+			inline T Select(const bool bCondition, const T IfTrue, const T IfFalse)
+			{
+				using UIntType = typename TFloatBits<T>::UIntType;
+				const UIntType Mask = static_cast<UIntType>(0) - static_cast<UIntType>(bCondition);
+				return std::bit_cast<T>((std::bit_cast<UIntType>(IfTrue) & Mask) | (std::bit_cast<UIntType>(IfFalse) & ~Mask));
+			}
+
+			template <typename T>
+			constexpr T Pi = static_cast<T>(3.14159265358979323846264338327950288L);
+
+			template <EPrecision Precision, typename T>
+			inline void SinCosKernel(const T Value, T &OutSin, T &OutCos)
+			{
+				using UIntType = typename TFloatBits<T>::UIntType;
+
+				// Cody-Waite reduction by pi/2; the leading parts have few bits so their products stay exact
+				constexpr T TwoOverPi = static_cast<T>(0.636619772367581343075535053490057448L);
+				constexpr T PiOver2A = static_cast<T>(1.5703125);
+				constexpr T PiOver2B = static_cast<T>(4.837512969970703125e-4);
+				constexpr T PiOver2C = static_cast<T>(7.54978995489188216e-8);
+
+				const T Shifted = Value * TwoOverPi + RoundingShift<T>;
+				const T Quadrant = Shifted - RoundingShift<T>;
+				const UIntType QuadrantBits = std::bit_cast<UIntType>(Shifted);
+
+				const T R = ((Value - Quadrant * PiOver2A) - Quadrant * PiOver2B) - Quadrant * PiOver2C;
+				const T R2 = R * R;
+				const T S = R * Polynomial(R2, GetSinCoefficients<Precision>());
+				const T C = Polynomial(R2, GetCosCoefficients<Precision>());
+
+				const bool bSwap = (QuadrantBits & 1) != 0;
+				const T SinAbs = Select(bSwap, C, S);
+				const T CosAbs = Select(bSwap, S, C);
+				OutSin = Select((QuadrantBits & 2) != 0, -SinAbs, SinAbs);
+				OutCos = Select(((QuadrantBits + 1) & 2) != 0, -CosAbs, CosAbs);
+			}
+
+			template <EPrecision Precision, typename T>
+			inline T Atan2Kernel(const T Y, const T X)
+			{
+				constexpr T TanPiOver8 = static_cast<T>(0.414213562373095048801688724209698079L);
+
+				const T AbsX = std::abs(X);
+				const T AbsY = std::abs(Y);
+				const T Max = std::max(AbsX, AbsY);
+				const T Min = std::min(AbsX, AbsY);
+				const T Ratio = Min / Select(Max == 0, static_cast<T>(1), Max);
+
+				// Fold [tan(pi/8), 1] onto [-tan(pi/8), 0] with atan(r) = pi/4 + atan((r - 1) / (r + 1))
+				const bool bFold = Ratio > TanPiOver8;
+				const T Z = Select(bFold, (Ratio - 1) / (Ratio + 1), Ratio);
+				T Angle = Z * Polynomial(Z * Z, GetAtanCoefficients<Precision>());
+				Angle = Select(bFold, Angle + Pi<T> / 4, Angle);
+
+				Angle = Select(AbsY > AbsX, Pi<T> / 2 - Angle, Angle);
+				Angle = Select(X < 0, Pi<T> - Angle, Angle);
+				return Select(Y < 0, -Angle, Angle);
+			}
+
+			template <EPrecision Precision, typename T>
+			inline T AcosKernel(const T Value)
+			{
+				const T AbsValue = std::min(std::abs(Value), static_cast<T>(1));
+				const T Angle = std::sqrt(1 - AbsValue) * Polynomial(AbsValue, GetAcosCoefficients<Precision>());
+				return Select(Value < 0, Pi<T> - Angle, Angle);
+			}
+
+			template <EPrecision Precision, typename T>
+			inline T ExpKernel(const T Value)
+			{
+				using UIntType = typename TFloatBits<T>::UIntType;
+				constexpr int32 MantissaBits = TFloatBits<T>::MantissaBits;
+				constexpr int32 ExponentBias = TFloatBits<T>::ExponentBias;
+
+				constexpr T Log2E = static_cast<T>(1.44269504088896340735992468100189214L);
+				constexpr T Ln2Hi = static_cast<T>(0.693359375);
+				constexpr T Ln2Lo = static_cast<T>(-2.12194440054690582767605619416237e-4L);
+
+				// Keep 2^(K - 1) a normal number so the scale can be assembled from exponent bits
+				constexpr T MinValue = static_cast<T>(std::numeric_limits<T>::min_exponent) * static_cast<T>(0.693147180559945309417232121458176568L);
+				constexpr T MaxValue = static_cast<T>(std::numeric_limits<T>::max_exponent) * static_cast<T>(0.693147180559945309417232121458176568L);
+
+				const T Clamped = std::clamp(Value, MinValue, MaxValue);
+				const T Shifted = Clamped * Log2E + RoundingShift<T>;
+				const T K = Shifted - RoundingShift<T>;
+				const T R = (Clamped - K * Ln2Hi) - K * Ln2Lo;
+
+				// K as an integer is the difference of the shifted bit patterns
+				const UIntType KBits = std::bit_cast<UIntType>(Shifted) - std::bit_cast<UIntType>(RoundingShift<T>);
+				const T Scale = std::bit_cast<T>(static_cast<UIntType>((KBits + (ExponentBias - 1)) << MantissaBits));
+				const T Result = Polynomial(R, GetExpCoefficients<Precision>()) * Scale * 2;
+
+				const T Bounded = Select(Value > MaxValue, std::numeric_limits<T>::infinity(), Result);
+				return Select(Value < MinValue, static_cast<T>(0), Bounded);
+			}
+
+			template <EPrecision Precision, typename T>
+			inline T LogKernel(const T Value)
+			{
+				using UIntType = typename TFloatBits<T>::UIntType;
+				using IntType = typename TFloatBits<T>::IntType;
+				constexpr int32 MantissaBits = TFloatBits<T>::MantissaBits;
+				constexpr int32 ExponentBias = TFloatBits<T>::ExponentBias;
+				constexpr UIntType MantissaMask = (static_cast<UIntType>(1) << MantissaBits) - 1;
+				constexpr UIntType ExponentMask = (static_cast<UIntType>(1) << (sizeof(T) * 8 - 1 - MantissaBits)) - 1;
+
+				constexpr T Sqrt2 = static_cast<T>(1.41421356237309504880168872420969808L);
+				constexpr T Ln2Hi = static_cast<T>(0.693359375);
+				constexpr T Ln2Lo = static_cast<T>(-2.12194440054690582767605619416237e-4L);
+
+				// Split into 2^E * M with M in [sqrt(1/2), sqrt(2))
+				const UIntType Bits = std::bit_cast<UIntType>(Value);
+				const UIntType ExponentField = (Bits >> MantissaBits) & ExponentMask;
+				const T Mantissa = std::bit_cast<T>((Bits & MantissaMask) | (static_cast<UIntType>(ExponentBias) << MantissaBits));
+				const bool bHigh = Mantissa > Sqrt2;
+				const T M = Select(bHigh, Mantissa * static_cast<T>(0.5), Mantissa);
+				const T E = static_cast<T>(static_cast<IntType>(ExponentField) - ExponentBias + (bHigh ? 1 : 0));
+
+				const T S = (M - 1) / (M + 1);
+				T Result = S * Polynomial(S * S, GetLogCoefficients<Precision>());
+				Result = (Result + E * Ln2Lo) + E * Ln2Hi;
+
+				// Zero and subnormals, then infinity, then negatives and NaN
+				Result = Select(ExponentField == 0, -std::numeric_limits<T>::infinity(), Result);
+				Result = Select(Value == std::numeric_limits<T>::infinity(), Value, Result);
+				return Select(Value >= 0, Result, std::numeric_limits<T>::quiet_NaN());
+			}
+
+			template <typename T, typename FunctionType>
+			void Transform(std::span<const T> Values, std::span<T> OutValues, FunctionType Function)
+			{
+				const int64 Count = static_cast<int64>(std::min(Values.size(), OutValues.size()));
+				const T *RESTRICT const In = Values.data();
+				T *const Out = OutValues.data();
+
+				Parallel::ParallelFor(Count, ArrayBatchSize, [&](const int64 Begin, const int64 End)
+									  {
+					for (int64 i = Begin; i < End; ++i)
+						Out[i] = Function(In[i]); });
+			}
+		}
+
 		template <typename T>
 		T Abs(T value)
 		{
@@ -17,21 +283,145 @@ namespace Ratchet
 		template <FloatingPoint T>
 		T Sqrt(T value)
 		{
+			RATCHET_INSTRUMENT_SCOPE(MathSqrt);
+
 			if (value == 0 || value == 1)
 				return value;
 
 			T x = value;
 			T y = (x + value / x) / 2;
+			uint32 Iterations = 1;
 
 			while (Abs<T>(x - y) > Epsilon<T>)
 			{
 				x = y;
 				y = (x + value / x) / 2;
+				++Iterations;
 			}
 
+			RATCHET_INSTRUMENT_VALUE(MathSqrtIterations, Iterations);
 			return y;
 		}
 
+		/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Sin(T Value)
+		{
+			T S, C;
+			SinCosKernel<Precision>(Value, S, C);
+			return S;
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Cos(T Value)
+		{
+			T S, C;
+			SinCosKernel<Precision>(Value, S, C);
+			return C;
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void SinCos(T Value, T &OutSin, T &OutCos)
+		{
+			SinCosKernel<Precision>(Value, OutSin, OutCos);
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Atan2(T Y, T X)
+		{
+			return Atan2Kernel<Precision>(Y, X);
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Acos(T Value)
+		{
+			return AcosKernel<Precision>(Value);
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Exp(T Value)
+		{
+			return ExpKernel<Precision>(Value);
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		T Log(T Value)
+		{
+			return LogKernel<Precision>(Value);
+		}
+
+		/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Sin(std::span<const T> Values, std::span<T> OutValues)
+		{
+			Transform(Values, OutValues, [](const T Value)
+					  {
+				T S, C;
+				SinCosKernel<Precision>(Value, S, C);
+				return S; });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Cos(std::span<const T> Values, std::span<T> OutValues)
+		{
+			Transform(Values, OutValues, [](const T Value)
+					  {
+				T S, C;
+				SinCosKernel<Precision>(Value, S, C);
+				return C; });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void SinCos(std::span<const T> Values, std::span<T> OutSin, std::span<T> OutCos)
+		{
+			const int64 Count = static_cast<int64>(std::min({Values.size(), OutSin.size(), OutCos.size()}));
+			const T *RESTRICT const In = Values.data();
+			T *RESTRICT const Sines = OutSin.data();
+			T *RESTRICT const Cosines = OutCos.data();
+
+			Parallel::ParallelFor(Count, ArrayBatchSize, [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 i = Begin; i < End; ++i)
+					SinCosKernel<Precision>(In[i], Sines[i], Cosines[i]); });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Atan2(std::span<const T> Y, std::span<const T> X, std::span<T> OutValues)
+		{
+			const int64 Count = static_cast<int64>(std::min({Y.size(), X.size(), OutValues.size()}));
+			const T *const InY = Y.data();
+			const T *const InX = X.data();
+			T *const Out = OutValues.data();
+
+			Parallel::ParallelFor(Count, ArrayBatchSize, [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 i = Begin; i < End; ++i)
+					Out[i] = Atan2Kernel<Precision>(InY[i], InX[i]); });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Acos(std::span<const T> Values, std::span<T> OutValues)
+		{
+			Transform(Values, OutValues, [](const T Value)
+					  { return AcosKernel<Precision>(Value); });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Exp(std::span<const T> Values, std::span<T> OutValues)
+		{
+			Transform(Values, OutValues, [](const T Value)
+					  { return ExpKernel<Precision>(Value); });
+		}
+
+		template <EPrecision Precision, FloatingPoint T>
+		void Log(std::span<const T> Values, std::span<T> OutValues)
+		{
+			Transform(Values, OutValues, [](const T Value)
+					  { return LogKernel<Precision>(Value); });
+		}
+
 		// Explicit instantiations for the required floating-point types
 		template float Abs<float>(float value);
 		template double Abs<double>(double value);
@@ -40,5 +430,34 @@ namespace Ratchet
 		template float Sqrt<float>(float value);
 		template double Sqrt<double>(double value);
 		template long double Sqrt<long double>(long double value);
+
+		// The approximations rely on the IEEE layout of float and double
+#define RATCHET_INSTANTIATE_APPROXIMATIONS(P, T)                                                           \
+	template T Sin<P, T>(T Value);                                                                         \
+	template T Cos<P, T>(T Value);                                                                         \
+	template void SinCos<P, T>(T Value, T & OutSin, T & OutCos);                                           \
+	template T Atan2<P, T>(T Y, T X);                                                                      \
+	template T Acos<P, T>(T Value);                                                                        \
+	template T Exp<P, T>(T Value);                                                                         \
+	template T Log<P, T>(T Value);                                                                         \
+	template void Sin<P, T>(std::span<const T> Values, std::span<T> OutValues);                            \
+	template void Cos<P, T>(std::span<const T> Values, std::span<T> OutValues);                            \
+	template void SinCos<P, T>(std::span<const T> Values, std::span<T> OutSin, std::span<T> OutCos);       \
+	template void Atan2<P, T>(std::span<const T> Y, std::span<const T> X, std::span<T> OutValues);         \
+	template void Acos<P, T>(std::span<const T> Values, std::span<T> OutValues);                           \
+	template void Exp<P, T>(std::span<const T> Values, std::span<T> OutValues);                            \
+	template void Log<P, T>(std::span<const T> Values, std::span<T> OutValues);
+
+		// Explicit instantiation for float
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Low, float)
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Medium, float)
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Full, float)
+
+		// Explicit instantiation for double
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Low, double)
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Medium, double)
+		RATCHET_INSTANTIATE_APPROXIMATIONS(EPrecision::Full, double)
+
+#undef RATCHET_INSTANTIATE_APPROXIMATIONS
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,628 @@
+#include "Random.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <utility>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Samples generated side by side; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Samples per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 4096;
+
+		// Largest Poisson disk acceleration grid, 1 GiB of cells
+		constexpr int64 MaxGridCells = int64(1) << 28;
+
+		// Philox4x32 multipliers and Weyl key increments (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+		constexpr uint32 PhiloxM0 = 0xD2511F53u;
+		constexpr uint32 PhiloxM1 = 0xCD9E8D57u;
+		constexpr uint32 PhiloxW0 = 0x9E3779B9u;
+		constexpr uint32 PhiloxW1 = 0xBB67AE85u;
+		constexpr int32 PhiloxRounds = 10;
+
+		/**
+		 * Philox4x32-10 of a lane block of counters, in place. The 32 x 32 -> 64-bit products map to one
+		 * SIMD multiply per four or eight lanes.
+		 */
+		void PhiloxLanes(uint32 (&Counters)[4][LaneCount], const uint64 Key)
+		{
+			uint32 Key0 = static_cast<uint32>(Key);
+			uint32 Key1 = static_cast<uint32>(Key >> 32);
+			for (int32 Round = 0; Round < PhiloxRounds; ++Round)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					const uint64 Product0 = uint64(PhiloxM0) * Counters[0][Lane];
+					const uint64 Product1 = uint64(PhiloxM1) * Counters[2][Lane];
+					Counters[0][Lane] = static_cast<uint32>(Product1 >> 32) ^ Counters[1][Lane] ^ Key0;
+					Counters[1][Lane] = static_cast<uint32>(Product1);
+					Counters[2][Lane] = static_cast<uint32>(Product0 >> 32) ^ Counters[3][Lane] ^ Key1;
+					Counters[3][Lane] = static_cast<uint32>(Product0);
+				}
+				Key0 += PhiloxW0;
+				Key1 += PhiloxW1;
+			}
+		}
+
+		/**
+		 * Uniform numbers in [0, 1) for the samples First + Lane. Sample i takes its numbers from the Philox
+		 * blocks with counter (i, Block): four per block for float, two for double.
+		 */
+		template <typename T, int32 Count>
+		void UniformLanes(const uint64 Seed, const uint64 First, T (&OutUniforms)[Count][LaneCount])
+		{
+			constexpr int32 PerBlock = sizeof(T) == sizeof(uint32) ? 4 : 2;
+			for (int32 Block = 0; Block * PerBlock < Count; ++Block)
+			{
+				uint32 Counters[4][LaneCount];
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					Counters[0][Lane] = static_cast<uint32>(First + Lane);
+					Counters[1][Lane] = static_cast<uint32>((First + Lane) >> 32);
+					Counters[2][Lane] = static_cast<uint32>(Block);
+					Counters[3][Lane] = 0;
+				}
+				PhiloxLanes(Counters, Seed);
+
+				// The top mantissa bits over an exponent of 0 give a number in [1, 2)
+				for (int32 k = 0; k < PerBlock && Block * PerBlock + k < Count; ++k)
+				{
+					T *const Out = OutUniforms[Block * PerBlock + k];
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						if constexpr (PerBlock == 4)
+							Out[Lane] = std::bit_cast<float>((Counters[k][Lane] >> 9) | 0x3F800000u) - 1.0f;
+						else
+						{
+							const uint64 Bits = (uint64(Counters[2 * k][Lane]) << 32) | Counters[2 * k + 1][Lane];
+							Out[Lane] = std::bit_cast<double>((Bits >> 12) | 0x3FF0000000000000ull) - 1.0;
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * The polynomial with the first TermCount coefficients at X, unrolled so that lane loops calling it vectorize.
+		 */
+		template <int32 TermCount, typename T, int32 Size>
+		T Horner(const T X, const T (&Terms)[Size])
+		{
+			T Sum = Terms[TermCount - 1];
+			[&]<int32... Steps>(std::integer_sequence<int32, Steps...>)
+			{ ((Sum = Sum * X + Terms[TermCount - 2 - Steps]), ...); }(std::make_integer_sequence<int32, TermCount - 1>{});
+			return Sum;
+		}
+
+		/**
+		 * Sine and cosine of Turns full turns, for turns in [0, 1]. Reduces to a quarter turn around the
+		 * nearest multiple of pi/2 and evaluates the Taylor series there.
+		 */
+		template <typename T>
+		void SinCosTurnLanes(const T (&Turns)[LaneCount], T (&RESTRICT OutSin)[LaneCount], T (&RESTRICT OutCos)[LaneCount])
+		{
+			// Enough terms for |R| <= pi/4 at the precision of T
+			constexpr int32 TermCount = sizeof(T) == sizeof(float) ? 6 : 9;
+			constexpr T SinTerms[9] = {T(1), T(-1.0 / 6), T(1.0 / 120), T(-1.0 / 5040), T(1.0 / 362880), T(-1.0 / 39916800), T(1.0 / 6227020800),
+									   T(-1.0 / 1307674368000), T(1.0 / 355687428096000)};
+			constexpr T CosTerms[9] = {T(1), T(-1.0 / 2), T(1.0 / 24), T(-1.0 / 720), T(1.0 / 40320), T(-1.0 / 3628800), T(1.0 / 479001600),
+									   T(-1.0 / 87178291200), T(1.0 / 20922789888000)};
+
+			// Adding 1.5 * 2^(digits - 1) rounds to an integer, which lands in the low mantissa bits
+			using UIntType = std::conditional_t<sizeof(T) == sizeof(uint32), uint32, uint64>;
+			constexpr T RoundingShift = static_cast<T>(1.5) * static_cast<T>(1ull << (std::numeric_limits<T>::digits - 1));
+
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T Quarters = Turns[Lane] * 4;
+				const T Shifted = Quarters + RoundingShift;
+				const T Quadrant = Shifted - RoundingShift;
+				const UIntType QuadrantBits = std::bit_cast<UIntType>(Shifted);
+				const T R = (Quarters - Quadrant) * (std::numbers::pi_v<T> / 2);
+				const T R2 = R * R;
+
+				const T S = R * Horner<TermCount>(R2, SinTerms);
+				const T C = Horner<TermCount>(R2, CosTerms);
+
+				// Sign flips as sign-bit masks, so the lane loop needs no selects
+				const UIntType SignBit = UIntType(1) << (8 * sizeof(T) - 1);
+				const UIntType SwapMask = UIntType(0) - (QuadrantBits & 1);
+				const UIntType SinBits = (std::bit_cast<UIntType>(C) & SwapMask) | (std::bit_cast<UIntType>(S) & ~SwapMask);
+				const UIntType CosBits = (std::bit_cast<UIntType>(S) & SwapMask) | (std::bit_cast<UIntType>(C) & ~SwapMask);
+				OutSin[Lane] = std::bit_cast<T>(SinBits ^ ((QuadrantBits & 2) != 0 ? SignBit : 0));
+				OutCos[Lane] = std::bit_cast<T>(CosBits ^ (((QuadrantBits + 1) & 2) != 0 ? SignBit : 0));
+			}
+		}
+
+		/**
+		 * Uniform unit vectors from the height Z = 1 - 2 * Height and the turn around Z (Archimedes).
+		 */
+		template <typename T>
+		void SphereLanes(const T (&Heights)[LaneCount], const T (&Turns)[LaneCount], T (&RESTRICT OutVectors)[3][LaneCount])
+		{
+			T Rings[LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				OutVectors[2][Lane] = 1 - 2 * Heights[Lane];
+				Rings[Lane] = std::max(T(0), 1 - OutVectors[2][Lane] * OutVectors[2][Lane]);
+			}
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Rings[Lane] = std::sqrt(Rings[Lane]);
+
+			T Sines[LaneCount], Cosines[LaneCount];
+			SinCosTurnLanes(Turns, Sines, Cosines);
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				OutVectors[0][Lane] = Rings[Lane] * Cosines[Lane];
+				OutVectors[1][Lane] = Rings[Lane] * Sines[Lane];
+			}
+		}
+
+		/**
+		 * Points of the unit disk at radius sqrt(Area) and the given turn, uniform for uniform inputs.
+		 */
+		template <typename T>
+		void DiskLanes(const T (&Areas)[LaneCount], const T (&Turns)[LaneCount], T (&RESTRICT OutPoints)[2][LaneCount])
+		{
+			T Radii[LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Radii[Lane] = std::sqrt(Areas[Lane]);
+
+			T Sines[LaneCount], Cosines[LaneCount];
+			SinCosTurnLanes(Turns, Sines, Cosines);
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				OutPoints[0][Lane] = Radii[Lane] * Cosines[Lane];
+				OutPoints[1][Lane] = Radii[Lane] * Sines[Lane];
+			}
+		}
+
+		/**
+		 * Barycentric weights of uniform points in a triangle, reflecting the half of the unit square beyond
+		 * the diagonal back into the triangle.
+		 */
+		template <typename T>
+		void BarycentricLanes(const T (&Uniforms)[2][LaneCount], T (&RESTRICT OutWeights)[3][LaneCount])
+		{
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const bool bOutside = Uniforms[0][Lane] + Uniforms[1][Lane] > 1;
+				const T U = bOutside ? 1 - Uniforms[0][Lane] : Uniforms[0][Lane];
+				const T V = bOutside ? 1 - Uniforms[1][Lane] : Uniforms[1][Lane];
+				OutWeights[0][Lane] = 1 - U - V;
+				OutWeights[1][Lane] = U;
+				OutWeights[2][Lane] = V;
+			}
+		}
+
+		/**
+		 * Runs Kernel<bPartial>(Begin, Count) over the lane blocks of [Begin, End), the last one partial.
+		 */
+		template <typename KernelType>
+		void ForEachBlock(const int64 Begin, const int64 End, const KernelType &Kernel)
+		{
+			int64 Item = Begin;
+			for (; Item + LaneCount <= End; Item += LaneCount)
+				Kernel.template operator()<false>(Item, LaneCount);
+			if (Item < End)
+				Kernel.template operator()<true>(Item, static_cast<int32>(End - Item));
+		}
+
+		/**
+		 * Generates Count samples over the worker pool: Map turns a lane block of uniform numbers into a lane
+		 * block of output components, which are stored to the streams.
+		 */
+		template <typename T, int32 UniformCount, int32 Dimension, typename MapType>
+		void SampleStreams(const uint64 Seed, const uint64 Position, const int64 Count, T *const (&OutStreams)[Dimension], const MapType &Map)
+		{
+			Parallel::ParallelFor(Count, BatchSize, [&](const int64 Begin, const int64 End)
+								  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Valid)
+												 {
+													 T Uniforms[UniformCount][LaneCount];
+													 UniformLanes(Seed, Position + static_cast<uint64>(First), Uniforms);
+
+													 T Values[Dimension][LaneCount];
+													 Map(Uniforms, Values);
+													 for (int32 c = 0; c < Dimension; ++c)
+													 {
+														 for (int32 Lane = 0; Lane < (bPartial ? Valid : LaneCount); ++Lane)
+															 OutStreams[c][First + Lane] = Values[c][Lane];
+													 } }); });
+		}
+	}
+
+	template <FloatingPoint T>
+	FRandomSampler<T>::FRandomSampler(const uint64 InSeed, Memory::FAllocator &InAllocator)
+		: Seed(InSeed), Position(0), Grid(InAllocator), Active(InAllocator)
+	{
+	}
+
+	template <FloatingPoint T>
+	void FRandomSampler<T>::SetSeed(const uint64 InSeed)
+	{
+		Seed = InSeed;
+		Position = 0;
+	}
+
+	template <FloatingPoint T>
+	uint64 FRandomSampler<T>::GetSeed() const
+	{
+		return Seed;
+	}
+
+	template <FloatingPoint T>
+	void FRandomSampler<T>::SetPosition(const uint64 InPosition)
+	{
+		Position = InPosition;
+	}
+
+	template <FloatingPoint T>
+	uint64 FRandomSampler<T>::GetPosition() const
+	{
+		return Position;
+	}
+
+	template <FloatingPoint T>
+	void FRandomSampler<T>::Uniform(std::span<T> OutValues, const std::type_identity_t<T> Min, const std::type_identity_t<T> Max)
+	{
+		const int64 Count = static_cast<int64>(OutValues.size());
+		RATCHET_INSTRUMENT_BATCH(RandomUniform, Count);
+
+		T *const Streams[1] = {OutValues.data()};
+		const T Range = Max - Min;
+		SampleStreams<T, 1>(Seed, Position, Count, Streams, [Min, Range](const T (&Uniforms)[1][LaneCount], T (&Values)[1][LaneCount])
+							{
+								for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+									Values[0][Lane] = Min + Range * Uniforms[0][Lane]; });
+		Position += static_cast<uint64>(Count);
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::UnitVectors(const FVector3DStreams<T> &OutVectors)
+	{
+		if (!OutVectors.IsValid())
+			return false;
+
+		const int64 Count = OutVectors.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomUnitVectors, Count);
+
+		T *const Streams[3] = {OutVectors.X.data(), OutVectors.Y.data(), OutVectors.Z.data()};
+		SampleStreams<T, 2>(Seed, Position, Count, Streams, [](const T (&Uniforms)[2][LaneCount], T (&Values)[3][LaneCount])
+							{ SphereLanes(Uniforms[0], Uniforms[1], Values); });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::PointsInSphere(const FVector3DStreams<T> &OutPoints)
+	{
+		if (!OutPoints.IsValid())
+			return false;
+
+		const int64 Count = OutPoints.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomPointsInSphere, Count);
+
+		// The largest of three uniform numbers has the distribution of the radius, P(r <= x) = x^3, without a cube root
+		T *const Streams[3] = {OutPoints.X.data(), OutPoints.Y.data(), OutPoints.Z.data()};
+		SampleStreams<T, 5>(Seed, Position, Count, Streams, [](const T (&Uniforms)[5][LaneCount], T (&Values)[3][LaneCount])
+							{
+								SphereLanes(Uniforms[0], Uniforms[1], Values);
+								for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+								{
+									const T Radius = std::max({Uniforms[2][Lane], Uniforms[3][Lane], Uniforms[4][Lane]});
+									for (int32 c = 0; c < 3; ++c)
+										Values[c][Lane] *= Radius;
+								} });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::PointsInDisk(const FVector2DStreams<T> &OutPoints)
+	{
+		if (!OutPoints.IsValid())
+			return false;
+
+		const int64 Count = OutPoints.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomPointsInDisk, Count);
+
+		T *const Streams[2] = {OutPoints.X.data(), OutPoints.Y.data()};
+		SampleStreams<T, 2>(Seed, Position, Count, Streams, [](const T (&Uniforms)[2][LaneCount], T (&Values)[2][LaneCount])
+							{ DiskLanes(Uniforms[0], Uniforms[1], Values); });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::CosineHemisphere(const FVector3DStreams<T> &OutVectors)
+	{
+		if (!OutVectors.IsValid())
+			return false;
+
+		const int64 Count = OutVectors.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomCosineHemisphere, Count);
+
+		// Malley's method: a uniform point of the unit disk lifted onto the hemisphere
+		T *const Streams[3] = {OutVectors.X.data(), OutVectors.Y.data(), OutVectors.Z.data()};
+		SampleStreams<T, 2>(Seed, Position, Count, Streams, [](const T (&Uniforms)[2][LaneCount], T (&Values)[3][LaneCount])
+							{
+								T Disk[2][LaneCount];
+								DiskLanes(Uniforms[0], Uniforms[1], Disk);
+								for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+								{
+									Values[0][Lane] = Disk[0][Lane];
+									Values[1][Lane] = Disk[1][Lane];
+									Values[2][Lane] = 1 - Uniforms[0][Lane];
+								}
+								for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+									Values[2][Lane] = std::sqrt(Values[2][Lane]); });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::Barycentrics(const FVector3DStreams<T> &OutWeights)
+	{
+		if (!OutWeights.IsValid())
+			return false;
+
+		const int64 Count = OutWeights.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomBarycentrics, Count);
+
+		T *const Streams[3] = {OutWeights.X.data(), OutWeights.Y.data(), OutWeights.Z.data()};
+		SampleStreams<T, 2>(Seed, Position, Count, Streams, [](const T (&Uniforms)[2][LaneCount], T (&Values)[3][LaneCount])
+							{ BarycentricLanes(Uniforms, Values); });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	bool FRandomSampler<T>::PointsInTriangle(const FVector3D<T> &A, const FVector3D<T> &B, const FVector3D<T> &C, const FVector3DStreams<T> &OutPoints)
+	{
+		if (!OutPoints.IsValid())
+			return false;
+
+		const int64 Count = OutPoints.Num();
+		RATCHET_INSTRUMENT_BATCH(RandomPointsInTriangle, Count);
+
+		const T Corners[3][3] = {{A.GetX(), A.GetY(), A.GetZ()}, {B.GetX(), B.GetY(), B.GetZ()}, {C.GetX(), C.GetY(), C.GetZ()}};
+		T *const Streams[3] = {OutPoints.X.data(), OutPoints.Y.data(), OutPoints.Z.data()};
+		SampleStreams<T, 2>(Seed, Position, Count, Streams, [&Corners](const T (&Uniforms)[2][LaneCount], T (&Values)[3][LaneCount])
+							{
+								T Weights[3][LaneCount];
+								BarycentricLanes(Uniforms, Weights);
+								for (int32 c = 0; c < 3; ++c)
+								{
+									for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+										Values[c][Lane] = Weights[0][Lane] * Corners[0][c] + Weights[1][Lane] * Corners[1][c] + Weights[2][Lane] * Corners[2][c];
+								} });
+		Position += static_cast<uint64>(Count);
+		return true;
+	}
+
+	template <FloatingPoint T>
+	template <int32 Dimension>
+	int64 FRandomSampler<T>::PoissonDisk(const T (&Min)[Dimension], const T (&Max)[Dimension], const T Radius, T *const (&OutPoints)[Dimension],
+										 const int64 Capacity, const int32 Attempts)
+	{
+		if (!(Radius > 0) || Capacity <= 0 || Attempts <= 0)
+			return 0;
+
+		// A cell's diagonal is the radius, so each cell holds at most one point
+		const T CellSize = Radius / std::sqrt(static_cast<T>(Dimension));
+		int64 CellCounts[Dimension];
+		int64 GridCount = 1;
+		for (int32 d = 0; d < Dimension; ++d)
+		{
+			if (!(Max[d] > Min[d]))
+				return 0;
+			const T Cells = std::ceil((Max[d] - Min[d]) / CellSize);
+			if (!(Cells <= static_cast<T>(MaxGridCells)))
+				return 0;
+			CellCounts[d] = std::max(int64(1), static_cast<int64>(Cells));
+			GridCount *= CellCounts[d];
+			if (GridCount > MaxGridCells)
+				return 0;
+		}
+
+		Grid.Clear();
+		Grid.Resize(static_cast<size_t>(GridCount), -1);
+		Active.Clear();
+
+		const auto GetCell = [&](const T (&Point)[Dimension], int64 (&OutCell)[Dimension])
+		{
+			int64 Index = 0;
+			for (int32 d = Dimension - 1; d >= 0; --d)
+			{
+				OutCell[d] = std::clamp(static_cast<int64>((Point[d] - Min[d]) / CellSize), int64(0), CellCounts[d] - 1);
+				Index = Index * CellCounts[d] + OutCell[d];
+			}
+			return Index;
+		};
+
+		// Points closer than the radius lie at most two cells away along each axis
+		const T RadiusSquared = Radius * Radius;
+		const auto IsTaken = [&](const T (&Point)[Dimension], const int64 Index)
+		{
+			if (Grid[Index] < 0)
+				return false;
+			T DistanceSquared = 0;
+			for (int32 d = 0; d < Dimension; ++d)
+			{
+				const T Delta = OutPoints[d][Grid[Index]] - Point[d];
+				DistanceSquared += Delta * Delta;
+			}
+			return DistanceSquared < RadiusSquared;
+		};
+		const auto IsFree = [&](const T (&Point)[Dimension], const int64 (&Cell)[Dimension])
+		{
+			int64 Lower[Dimension], Upper[Dimension];
+			for (int32 d = 0; d < Dimension; ++d)
+			{
+				Lower[d] = std::max(Cell[d] - 2, int64(0));
+				Upper[d] = std::min(Cell[d] + 2, CellCounts[d] - 1);
+			}
+
+			for (int64 Y = Lower[1]; Y <= Upper[1]; ++Y)
+			{
+				if constexpr (Dimension == 2)
+				{
+					for (int64 X = Lower[0]; X <= Upper[0]; ++X)
+					{
+						if (IsTaken(Point, Y * CellCounts[0] + X))
+							return false;
+					}
+				}
+				else
+				{
+					for (int64 Z = Lower[2]; Z <= Upper[2]; ++Z)
+					{
+						for (int64 X = Lower[0]; X <= Upper[0]; ++X)
+						{
+							if (IsTaken(Point, (Z * CellCounts[1] + Y) * CellCounts[0] + X))
+								return false;
+						}
+					}
+				}
+			}
+			return true;
+		};
+
+		int64 Count = 0;
+		const auto AddPoint = [&](const T (&Point)[Dimension], const int64 CellIndex)
+		{
+			for (int32 d = 0; d < Dimension; ++d)
+				OutPoints[d][Count] = Point[d];
+			Grid[CellIndex] = static_cast<int32>(Count);
+			Active.Add(static_cast<int32>(Count));
+			++Count;
+		};
+
+		// Every lane block of candidates takes LaneCount counters
+		uint64 Counter = Position;
+		{
+			T Uniforms[Dimension][LaneCount];
+			UniformLanes(Seed, Counter, Uniforms);
+			Counter += LaneCount;
+
+			T Point[Dimension];
+			int64 Cell[Dimension];
+			for (int32 d = 0; d < Dimension; ++d)
+				Point[d] = Min[d] + (Max[d] - Min[d]) * Uniforms[d][0];
+			AddPoint(Point, GetCell(Point, Cell));
+		}
+
+		while (!Active.IsEmpty() && Count < Capacity)
+		{
+			int64 Slot = 0;
+			bool bPlaced = false;
+			for (int32 Tried = 0; Tried < Attempts && !bPlaced; Tried += LaneCount)
+			{
+				// The offsets, plus one number to pick the active point with
+				T Uniforms[Dimension + 1][LaneCount];
+				UniformLanes(Seed, Counter, Uniforms);
+				Counter += LaneCount;
+				if (Tried == 0)
+					Slot = std::min(static_cast<int64>(Uniforms[Dimension][0] * static_cast<T>(Active.Num())), static_cast<int64>(Active.Num()) - 1);
+
+				// Uniform in the shell between Radius and 2 * Radius
+				T Offsets[Dimension][LaneCount];
+				if constexpr (Dimension == 2)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Uniforms[1][Lane] = 1 + 3 * Uniforms[1][Lane];
+					DiskLanes(Uniforms[1], Uniforms[0], Offsets);
+				}
+				else
+				{
+					SphereLanes(Uniforms[0], Uniforms[1], Offsets);
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					{
+						const T Scale = std::cbrt(1 + 7 * Uniforms[2][Lane]);
+						for (int32 d = 0; d < 3; ++d)
+							Offsets[d][Lane] *= Scale;
+					}
+				}
+
+				const int32 Center = Active[Slot];
+				for (int32 Lane = 0; Lane < std::min(LaneCount, Attempts - Tried); ++Lane)
+				{
+					T Point[Dimension];
+					bool bInside = true;
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						Point[d] = OutPoints[d][Center] + Offsets[d][Lane] * Radius;
+						bInside = bInside && Point[d] >= Min[d] && Point[d] <= Max[d];
+					}
+					if (!bInside)
+						continue;
+
+					int64 Cell[Dimension];
+					const int64 CellIndex = GetCell(Point, Cell);
+					if (IsFree(Point, Cell))
+					{
+						AddPoint(Point, CellIndex);
+						bPlaced = true;
+						break;
+					}
+				}
+			}
+
+			// Retire a point once the attempts around it all failed
+			if (!bPlaced)
+			{
+				Active[Slot] = Active[Active.Num() - 1];
+				Active.Resize(Active.Num() - 1);
+			}
+		}
+
+		Position = Counter;
+		return Count;
+	}
+
+	template <FloatingPoint T>
+	int64 FRandomSampler<T>::PoissonDisk2D(const FVector2D<T> &Min, const FVector2D<T> &Max, const std::type_identity_t<T> Radius,
+										   const FVector2DStreams<T> &OutPoints, const int32 Attempts)
+	{
+		if (!OutPoints.IsValid())
+			return 0;
+
+		RATCHET_INSTRUMENT_SCOPE(RandomPoissonDisk2D);
+
+		const T Lower[2] = {Min.GetX(), Min.GetY()};
+		const T Upper[2] = {Max.GetX(), Max.GetY()};
+		T *const Streams[2] = {OutPoints.X.data(), OutPoints.Y.data()};
+		return PoissonDisk<2>(Lower, Upper, Radius, Streams, std::min(OutPoints.Num(), int64(std::numeric_limits<int32>::max())), Attempts);
+	}
+
+	template <FloatingPoint T>
+	int64 FRandomSampler<T>::PoissonDisk3D(const FVector3D<T> &Min, const FVector3D<T> &Max, const std::type_identity_t<T> Radius,
+										   const FVector3DStreams<T> &OutPoints, const int32 Attempts)
+	{
+		if (!OutPoints.IsValid())
+			return 0;
+
+		RATCHET_INSTRUMENT_SCOPE(RandomPoissonDisk3D);
+
+		const T Lower[3] = {Min.GetX(), Min.GetY(), Min.GetZ()};
+		const T Upper[3] = {Max.GetX(), Max.GetY(), Max.GetZ()};
+		T *const Streams[3] = {OutPoints.X.data(), OutPoints.Y.data(), OutPoints.Z.data()};
+		return PoissonDisk<3>(Lower, Upper, Radius, Streams, std::min(OutPoints.Num(), int64(std::numeric_limits<int32>::max())), Attempts);
+	}
+
+	// Explicit instantiation for float
+	template class FRandomSampler<float>;
+
+	// Explicit instantiation for double
+	template class FRandomSampler<double>;
+}
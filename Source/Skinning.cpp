@@ -0,0 +1,183 @@
+#include "Skinning.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Vertices skinned side by side; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Vertices per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 2048;
+
+		template <typename T>
+		struct FSkinningJob
+		{
+			const FDualQuat<T> *Palette;
+			const uint16 *BoneIndices;
+			const T *Weights;
+			const T *Positions[3];
+			const T *Normals[3]; // nullptr to skip normals
+			T *OutPositions[3];
+			T *OutNormals[3];
+		};
+
+		// Copies a bone into 8 components: real X, Y, Z, W, then dual X, Y, Z, W
+		template <typename T>
+		void LoadBone(const FDualQuat<T> &Bone, T (&Components)[8])
+		{
+			for (int32 c = 0; c < 4; ++c)
+			{
+				Components[c] = Bone.GetReal()[c];
+				Components[4 + c] = Bone.GetDual()[c];
+			}
+		}
+
+		/**
+		 * Skins the vertices [Begin, Begin + Count) with Count <= LaneCount. Partial blocks repeat their last
+		 * vertex in the unused lanes and only store the valid ones.
+		 */
+		template <typename T, bool bPartial>
+		void SkinLanes(const FSkinningJob<T> &Job, const int64 Begin, const int32 Count)
+		{
+			int64 Vertices[LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				Vertices[Lane] = Begin + (bPartial ? std::min(Lane, Count - 1) : Lane);
+
+			// Blend the bone dual quaternions, flipping those in the other hemisphere than the first influence.
+			// Bones are gathered per vertex, so the blend runs across the 8 components of each bone.
+			T Blend[8][LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const int64 First = Vertices[Lane] * MaxSkinInfluences;
+				T Pivot[8];
+				LoadBone(Job.Palette[Job.BoneIndices[First]], Pivot);
+
+				T Sum[8];
+				for (int32 c = 0; c < 8; ++c)
+					Sum[c] = Job.Weights[First] * Pivot[c];
+
+				for (int32 k = 1; k < MaxSkinInfluences; ++k)
+				{
+					T Bone[8];
+					LoadBone(Job.Palette[Job.BoneIndices[First + k]], Bone);
+					const T Hemisphere = Pivot[0] * Bone[0] + Pivot[1] * Bone[1] + Pivot[2] * Bone[2] + Pivot[3] * Bone[3];
+					const T Weight = std::copysign(Job.Weights[First + k], Hemisphere); // Bitwise, so never a branch
+					for (int32 c = 0; c < 8; ++c)
+						Sum[c] += Weight * Bone[c];
+				}
+
+				for (int32 c = 0; c < 8; ++c)
+					Blend[c][Lane] = Sum[c];
+			}
+
+			// Rotating by q / |q| and translating by 2 * d * conj(q) / |q|^2 are both quadratic in the blend, so
+			// normalization folds into one scale of 2 / |q|^2 and needs no square root. Every term of the rotation
+			// and translation has a factor of the real part, so a zero blend leaves the vertex unchanged.
+			// Keeps the scale finite for a zero blend without a branch; negligible for any real weight sum
+			constexpr T Tiny = std::numeric_limits<T>::min();
+			T Scales[LaneCount];
+			T Translation[3][LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T RX = Blend[0][Lane], RY = Blend[1][Lane], RZ = Blend[2][Lane], RW = Blend[3][Lane];
+				const T DX = Blend[4][Lane], DY = Blend[5][Lane], DZ = Blend[6][Lane], DW = Blend[7][Lane];
+				const T SquaredMagnitude = RX * RX + RY * RY + RZ * RZ + RW * RW;
+				Scales[Lane] = 2 / (SquaredMagnitude + Tiny);
+
+				Translation[0][Lane] = Scales[Lane] * (RW * DX - DW * RX + RY * DZ - RZ * DY);
+				Translation[1][Lane] = Scales[Lane] * (RW * DY - DW * RY + RZ * DX - RX * DZ);
+				Translation[2][Lane] = Scales[Lane] * (RW * DZ - DW * RZ + RX * DY - RY * DX);
+			}
+
+			// v' = v + Scale * r x (r x v + w * v), plus the translation for positions
+			const auto Rotate = [&Blend, &Scales, &Vertices, Begin](const T *const (&Input)[3], T (&Output)[3][LaneCount])
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					const int64 Vertex = bPartial ? Vertices[Lane] : Begin + Lane;
+					const T RX = Blend[0][Lane], RY = Blend[1][Lane], RZ = Blend[2][Lane], RW = Blend[3][Lane];
+					const T VX = Input[0][Vertex], VY = Input[1][Vertex], VZ = Input[2][Vertex];
+					const T IX = RY * VZ - RZ * VY + RW * VX;
+					const T IY = RZ * VX - RX * VZ + RW * VY;
+					const T IZ = RX * VY - RY * VX + RW * VZ;
+					Output[0][Lane] = VX + Scales[Lane] * (RY * IZ - RZ * IY);
+					Output[1][Lane] = VY + Scales[Lane] * (RZ * IX - RX * IZ);
+					Output[2][Lane] = VZ + Scales[Lane] * (RX * IY - RY * IX);
+				}
+			};
+
+			const int32 StoreCount = bPartial ? Count : LaneCount;
+
+			T Positions[3][LaneCount];
+			Rotate(Job.Positions, Positions);
+			for (int32 c = 0; c < 3; ++c)
+			{
+				for (int32 Lane = 0; Lane < StoreCount; ++Lane)
+					Job.OutPositions[c][Begin + Lane] = Positions[c][Lane] + Translation[c][Lane];
+			}
+
+			if (Job.Normals[0] != nullptr)
+			{
+				T Normals[3][LaneCount];
+				Rotate(Job.Normals, Normals);
+				for (int32 c = 0; c < 3; ++c)
+				{
+					for (int32 Lane = 0; Lane < StoreCount; ++Lane)
+						Job.OutNormals[c][Begin + Lane] = Normals[c][Lane];
+				}
+			}
+		}
+	}
+
+	template <FloatingPoint T>
+	bool SkinDualQuat(std::span<const FDualQuat<T>> Palette, const FSkinInfluences<T> &Influences,
+					  const std::type_identity_t<FVector3DStreams<const T>> &Positions, const std::type_identity_t<FVector3DStreams<const T>> &Normals,
+					  const FVector3DStreams<T> &OutPositions, const FVector3DStreams<T> &OutNormals)
+	{
+		const int64 Count = Positions.Num();
+		const bool bNormals = Normals.Num() > 0;
+		if (!Positions.IsValid() || !OutPositions.IsValid() || OutPositions.Num() != Count ||
+			static_cast<int64>(Influences.BoneIndices.size()) != Count * MaxSkinInfluences ||
+			static_cast<int64>(Influences.Weights.size()) != Count * MaxSkinInfluences)
+			return false;
+		if (bNormals && (!Normals.IsValid() || !OutNormals.IsValid() || Normals.Num() != Count || OutNormals.Num() != Count))
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(SkinDualQuat, Count);
+
+		const FSkinningJob<T> Job = {
+			Palette.data(),
+			Influences.BoneIndices.data(),
+			Influences.Weights.data(),
+			{Positions.X.data(), Positions.Y.data(), Positions.Z.data()},
+			{bNormals ? Normals.X.data() : nullptr, Normals.Y.data(), Normals.Z.data()},
+			{OutPositions.X.data(), OutPositions.Y.data(), OutPositions.Z.data()},
+			{OutNormals.X.data(), OutNormals.Y.data(), OutNormals.Z.data()}};
+
+		Parallel::ParallelFor(Count, BatchSize, [&Job](const int64 Begin, const int64 End)
+							  {
+								  int64 Vertex = Begin;
+								  for (; Vertex + LaneCount <= End; Vertex += LaneCount)
+									  SkinLanes<T, false>(Job, Vertex, LaneCount);
+								  if (Vertex < End)
+									  SkinLanes<T, true>(Job, Vertex, static_cast<int32>(End - Vertex)); });
+		return true;
+	}
+
+	// Explicit instantiation for float
+	template bool SkinDualQuat(std::span<const FDualQuat<float>> Palette, const FSkinInfluences<float> &Influences,
+							   const FVector3DStreams<const float> &Positions, const FVector3DStreams<const float> &Normals,
+							   const FVector3DStreams<float> &OutPositions, const FVector3DStreams<float> &OutNormals);
+
+	// Explicit instantiation for double
+	template bool SkinDualQuat(std::span<const FDualQuat<double>> Palette, const FSkinInfluences<double> &Influences,
+							   const FVector3DStreams<const double> &Positions, const FVector3DStreams<const double> &Normals,
+							   const FVector3DStreams<double> &OutPositions, const FVector3DStreams<double> &OutNormals);
+}
@@ -0,0 +1,229 @@
+#include "SparseMatrix.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Block rows per worker batch of Multiply
+		constexpr int64 RowBatchSize = 1024;
+
+		// Rows [BeginRow, EndRow) of a 3x3 block product. Load(Column, c) reads component c of the input block
+		// Column, Store(Row, X, Y, Z) writes an output block.
+		template <typename T, typename LoadType, typename StoreType>
+		void MultiplyBlockRows(const int64 *Offsets, const int32 *Indices, const T *Entries, const int64 BeginRow, const int64 EndRow,
+							   const LoadType &Load, const StoreType &Store)
+		{
+			for (int64 Row = BeginRow; Row < EndRow; ++Row)
+			{
+				T SumX = 0, SumY = 0, SumZ = 0;
+				for (int64 k = Offsets[Row]; k < Offsets[Row + 1]; ++k)
+				{
+					const T *const Block = Entries + k * 9;
+					const int64 Column = Indices[k];
+					const T X = Load(Column, 0), Y = Load(Column, 1), Z = Load(Column, 2);
+					SumX += Block[0] * X + Block[1] * Y + Block[2] * Z;
+					SumY += Block[3] * X + Block[4] * Y + Block[5] * Z;
+					SumZ += Block[6] * X + Block[7] * Y + Block[8] * Z;
+				}
+				Store(Row, SumX, SumY, SumZ);
+			}
+		}
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	FSparseMatrix<T, BlockSize>::FSparseMatrix(Memory::FAllocator &InAllocator)
+		: RowOffsets(InAllocator), ColumnIndices(InAllocator), Values(InAllocator)
+	{
+		RowOffsets.Resize(1, 0);
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	void FSparseMatrix<T, BlockSize>::SetPattern(const int64 InRows, const int64 InColumns, std::span<const FSparseIndex> Entries)
+	{
+		Rows = std::max<int64>(InRows, 0);
+		Columns = std::max<int64>(InColumns, 0);
+
+		const auto IsValid = [this](const FSparseIndex &Entry)
+		{ return Entry.Row >= 0 && Entry.Row < Rows && Entry.Column >= 0 && Entry.Column < Columns; };
+
+		// Count the blocks of every row, turn the counts into row ends, then fill each row back to front so
+		// RowOffsets ends up holding the row starts without a separate cursor array
+		RowOffsets.Resize(Rows + 1);
+		std::fill(RowOffsets.begin(), RowOffsets.end(), 0);
+		for (const FSparseIndex &Entry : Entries)
+		{
+			if (IsValid(Entry))
+				++RowOffsets[Entry.Row];
+		}
+		for (int64 Row = 1; Row <= Rows; ++Row)
+			RowOffsets[Row] += RowOffsets[Row - 1];
+
+		ColumnIndices.Resize(RowOffsets[Rows]);
+		for (const FSparseIndex &Entry : Entries)
+		{
+			if (IsValid(Entry))
+				ColumnIndices[--RowOffsets[Entry.Row]] = static_cast<int32>(Entry.Column);
+		}
+
+		// Sort every row and drop duplicates, compacting the rows towards the front
+		int64 Write = 0;
+		for (int64 Row = 0; Row < Rows; ++Row)
+		{
+			int32 *const Begin = ColumnIndices.GetData() + RowOffsets[Row];
+			int32 *const End = ColumnIndices.GetData() + RowOffsets[Row + 1];
+			std::sort(Begin, End);
+			int32 *const UniqueEnd = std::unique(Begin, End);
+
+			RowOffsets[Row] = Write;
+			for (const int32 *Column = Begin; Column != UniqueEnd; ++Column)
+				ColumnIndices[Write++] = *Column;
+		}
+		RowOffsets[Rows] = Write;
+
+		ColumnIndices.Resize(Write);
+		Values.Resize(Write * BlockEntryCount);
+		SetZero();
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	void FSparseMatrix<T, BlockSize>::SetZero()
+	{
+		std::fill(Values.begin(), Values.end(), T(0));
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	T *FSparseMatrix<T, BlockSize>::Find(const int64 Row, const int64 Column)
+	{
+		return const_cast<T *>(static_cast<const FSparseMatrix *>(this)->Find(Row, Column));
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	const T *FSparseMatrix<T, BlockSize>::Find(const int64 Row, const int64 Column) const
+	{
+		if (Row < 0 || Row >= Rows || Column < 0 || Column >= Columns)
+			return nullptr;
+
+		const int32 *const Begin = ColumnIndices.GetData() + RowOffsets[Row];
+		const int32 *const End = ColumnIndices.GetData() + RowOffsets[Row + 1];
+		const int32 *const Found = std::lower_bound(Begin, End, static_cast<int32>(Column));
+		if (Found == End || *Found != Column)
+			return nullptr;
+
+		return Values.GetData() + (Found - ColumnIndices.GetData()) * BlockEntryCount;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	bool FSparseMatrix<T, BlockSize>::Multiply(std::span<const VectorType> X, std::span<VectorType> Y) const
+	{
+		if (static_cast<int64>(X.size()) != Columns || static_cast<int64>(Y.size()) != Rows)
+			return false;
+
+		RATCHET_INSTRUMENT_BATCH(SparseMultiply, GetBlockCount());
+
+		const VectorType *const Input = X.data();
+		VectorType *const Output = Y.data();
+		Parallel::ParallelFor(Rows, RowBatchSize, [this, Input, Output](const int64 Begin, const int64 End)
+							  { MultiplyRows(Begin, End, Input, Output); });
+		return true;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	void FSparseMatrix<T, BlockSize>::MultiplyRows(const int64 BeginRow, const int64 EndRow, const VectorType *RESTRICT X, VectorType *RESTRICT Y) const
+	{
+		const int64 *const Offsets = RowOffsets.GetData();
+		const int32 *const Indices = ColumnIndices.GetData();
+		const T *const Entries = Values.GetData();
+
+		if constexpr (BlockSize == 1)
+		{
+			for (int64 Row = BeginRow; Row < EndRow; ++Row)
+			{
+				T Sum = 0;
+				for (int64 k = Offsets[Row]; k < Offsets[Row + 1]; ++k)
+					Sum += Entries[k] * X[Indices[k]];
+				Y[Row] = Sum;
+			}
+		}
+		else
+		{
+			MultiplyBlockRows(
+				Offsets, Indices, Entries, BeginRow, EndRow, [X](const int64 Column, const int32 c)
+				{ return X[Column][c]; },
+				[Y](const int64 Row, const T SumX, const T SumY, const T SumZ)
+				{ Y[Row] = VectorType(SumX, SumY, SumZ); });
+		}
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	void FSparseMatrix<T, BlockSize>::MultiplyRows(const int64 BeginRow, const int64 EndRow, const T *RESTRICT X, T *RESTRICT Y) const
+		requires(BlockSize > 1)
+	{
+		MultiplyBlockRows(
+			RowOffsets.GetData(), ColumnIndices.GetData(), Values.GetData(), BeginRow, EndRow, [X](const int64 Column, const int32 c)
+			{ return X[3 * Column + c]; },
+			[Y](const int64 Row, const T SumX, const T SumY, const T SumZ)
+			{
+				Y[3 * Row + 0] = SumX;
+				Y[3 * Row + 1] = SumY;
+				Y[3 * Row + 2] = SumZ;
+			});
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	int64 FSparseMatrix<T, BlockSize>::GetRows() const
+	{
+		return Rows;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	int64 FSparseMatrix<T, BlockSize>::GetColumns() const
+	{
+		return Columns;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	int64 FSparseMatrix<T, BlockSize>::GetBlockCount() const
+	{
+		return static_cast<int64>(ColumnIndices.Num());
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	std::span<const int64> FSparseMatrix<T, BlockSize>::GetRowOffsets() const
+	{
+		return RowOffsets;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	std::span<const int32> FSparseMatrix<T, BlockSize>::GetColumnIndices() const
+	{
+		return ColumnIndices;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	std::span<T> FSparseMatrix<T, BlockSize>::GetValues()
+	{
+		return Values;
+	}
+
+	template <FloatingPoint T, int32 BlockSize>
+	std::span<const T> FSparseMatrix<T, BlockSize>::GetValues() const
+	{
+		return Values;
+	}
+
+	// Explicit instantiation for float
+	template class FSparseMatrix<float, 1>;
+	template class FSparseMatrix<float, 3>;
+
+	// Explicit instantiation for double
+	template class FSparseMatrix<double, 1>;
+	template class FSparseMatrix<double, 3>;
+
+	// Explicit instantiation for long double
+	template class FSparseMatrix<long double, 1>;
+	template class FSparseMatrix<long double, 3>;
+}
@@ -0,0 +1,410 @@
+#include "SpatialOrder.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define RATCHET_SPATIAL_ORDER_PDEP 1
+#else
+#define RATCHET_SPATIAL_ORDER_PDEP 0
+#endif
+
+namespace Ratchet
+{
+	namespace SpatialOrder
+	{
+		namespace
+		{
+			// Points encoded side by side; the lane loops are what the compiler vectorizes
+			constexpr int32 LaneCount = 8;
+
+			// Points per worker batch of the encoders, a multiple of LaneCount
+			constexpr int64 EncodeBatchSize = 4096;
+
+			// The radix sort splits its input into at most MaxPartitionCount partitions of at least MinPartitionSize codes
+			constexpr int64 MinPartitionSize = 16384;
+			constexpr int64 MaxPartitionCount = 64;
+
+			// Bits sorted per radix pass: three passes cover 30-bit codes, six 63-bit ones
+			constexpr int32 DigitBits = 11;
+			constexpr int32 DigitCount = 1 << DigitBits;
+
+			// Bits per axis of a code; one bit of every code type stays unused
+			template <int32 Dimension, typename CodeType>
+			constexpr int32 AxisBits = static_cast<int32>(8 * sizeof(CodeType) - 1) / Dimension;
+
+			/**
+			 * Moves the low AxisBits bits of a cell coordinate Dimension bits apart.
+			 */
+			template <int32 Dimension, typename CodeType>
+			CodeType SpreadBits(const uint32 Cell)
+			{
+#if RATCHET_SPATIAL_ORDER_PDEP
+				if constexpr (sizeof(CodeType) == 4)
+					return _pdep_u32(Cell, Dimension == 2 ? 0x15555555u : 0x09249249u);
+				else
+					return _pdep_u64(Cell, Dimension == 2 ? 0x1555555555555555ull : 0x1249249249249249ull);
+#else
+				CodeType Value = Cell;
+				if constexpr (Dimension == 2 && sizeof(CodeType) == 4)
+				{
+					Value = (Value | (Value << 8)) & 0x00FF00FFu;
+					Value = (Value | (Value << 4)) & 0x0F0F0F0Fu;
+					Value = (Value | (Value << 2)) & 0x33333333u;
+					Value = (Value | (Value << 1)) & 0x55555555u;
+				}
+				else if constexpr (Dimension == 2)
+				{
+					Value = (Value | (Value << 16)) & 0x0000FFFF0000FFFFull;
+					Value = (Value | (Value << 8)) & 0x00FF00FF00FF00FFull;
+					Value = (Value | (Value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+					Value = (Value | (Value << 2)) & 0x3333333333333333ull;
+					Value = (Value | (Value << 1)) & 0x5555555555555555ull;
+				}
+				else if constexpr (sizeof(CodeType) == 4)
+				{
+					Value = (Value | (Value << 16)) & 0x030000FFu;
+					Value = (Value | (Value << 8)) & 0x0300F00Fu;
+					Value = (Value | (Value << 4)) & 0x030C30C3u;
+					Value = (Value | (Value << 2)) & 0x09249249u;
+				}
+				else
+				{
+					Value = (Value | (Value << 32)) & 0x001F00000000FFFFull;
+					Value = (Value | (Value << 16)) & 0x001F0000FF0000FFull;
+					Value = (Value | (Value << 8)) & 0x100F00F00F00F00Full;
+					Value = (Value | (Value << 4)) & 0x10C30C30C30C30C3ull;
+					Value = (Value | (Value << 2)) & 0x1249249249249249ull;
+				}
+				return Value;
+#endif
+			}
+
+			/**
+			 * Interleaves cell coordinates with X in the lowest bit.
+			 */
+			template <int32 Dimension, typename CodeType>
+			void MortonLanes(const uint32 (&Cells)[Dimension][LaneCount], CodeType (&RESTRICT OutCodes)[LaneCount])
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutCodes[Lane] = 0;
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutCodes[Lane] |= SpreadBits<Dimension, CodeType>(Cells[d][Lane]) << d;
+				}
+			}
+
+			/**
+			 * Skilling's transform of cell coordinates to the transposed Hilbert index ("Programming the Hilbert
+			 * curve", 2004), then interleaved with the first axis in the highest bit. The conditional swaps and
+			 * inversions are done with masks.
+			 */
+			template <int32 Dimension, typename CodeType>
+			void HilbertLanes(const uint32 (&Cells)[Dimension][LaneCount], CodeType (&RESTRICT OutCodes)[LaneCount])
+			{
+				constexpr int32 Bits = AxisBits<Dimension, CodeType>;
+
+				uint32 Axes[Dimension][LaneCount];
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Axes[d][Lane] = Cells[d][Lane];
+				}
+
+				// The first axis is kept apart so the compiler sees it doesn't alias the others
+				uint32 Head[LaneCount];
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Head[Lane] = Axes[0][Lane];
+				for (int32 Bit = Bits - 1; Bit > 0; --Bit)
+				{
+					const uint32 Low = (1u << Bit) - 1;
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Head[Lane] ^= Low & (0u - ((Head[Lane] >> Bit) & 1));
+					for (int32 d = 1; d < Dimension; ++d)
+					{
+						for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						{
+							const uint32 Set = 0u - ((Axes[d][Lane] >> Bit) & 1);
+							const uint32 Swap = (Head[Lane] ^ Axes[d][Lane]) & Low & ~Set;
+							Head[Lane] ^= (Low & Set) | Swap;
+							Axes[d][Lane] ^= Swap;
+						}
+					}
+				}
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Axes[0][Lane] = Head[Lane];
+
+				// Gray encode
+				for (int32 d = 1; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Axes[d][Lane] ^= Axes[d - 1][Lane];
+				}
+				uint32 Flip[LaneCount] = {};
+				for (int32 Bit = Bits - 1; Bit > 0; --Bit)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						Flip[Lane] ^= ((1u << Bit) - 1) & (0u - ((Axes[Dimension - 1][Lane] >> Bit) & 1));
+				}
+
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					OutCodes[Lane] = 0;
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+						OutCodes[Lane] |= SpreadBits<Dimension, CodeType>(Axes[d][Lane] ^ Flip[Lane]) << (Dimension - 1 - d);
+				}
+			}
+
+			/**
+			 * Runs Kernel<bPartial>(Begin, Count) over the lane blocks of [Begin, End), the last one partial.
+			 */
+			template <typename KernelType>
+			void ForEachBlock(const int64 Begin, const int64 End, const KernelType &Kernel)
+			{
+				int64 Item = Begin;
+				for (; Item + LaneCount <= End; Item += LaneCount)
+					Kernel.template operator()<false>(Item, LaneCount);
+				if (Item < End)
+					Kernel.template operator()<true>(Item, static_cast<int32>(End - Item));
+			}
+
+			/**
+			 * Quantizes the points to cells of the bounds and encodes them a lane block at a time. Partial blocks
+			 * repeat their last point in the unused lanes.
+			 */
+			template <typename VectorType, typename CodeType, typename EncodeType>
+			void EncodePoints(std::span<const VectorType> Points, const FBounds<VectorType> &Bounds, CodeType *const OutCodes, const EncodeType &EncodeLanes)
+			{
+				using T = typename TVectorTraits<VectorType>::ScalarType;
+				constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+				constexpr int32 Bits = AxisBits<Dimension, CodeType>;
+
+				// 2^31 cells don't fit an int32 cell index
+				using CellType = std::conditional_t<(Bits > 30), int64, int32>;
+				constexpr CellType LastCell = (CellType(1) << Bits) - 1;
+
+				T Min[Dimension], Scale[Dimension];
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					const T Extent = Bounds.Max[d] - Bounds.Min[d];
+					Min[d] = Bounds.Min[d];
+					Scale[d] = Extent > 0 ? static_cast<T>(CellType(1) << Bits) / Extent : T(0);
+				}
+
+				Parallel::ParallelFor(static_cast<int64>(Points.size()), EncodeBatchSize, [&](const int64 Begin, const int64 End)
+									  { ForEachBlock(Begin, End, [&]<bool bPartial>(const int64 First, const int32 Valid)
+													 {
+														 uint32 Cells[Dimension][LaneCount];
+														 for (int32 d = 0; d < Dimension; ++d)
+														 {
+															 for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+															 {
+																 const int64 Point = First + (bPartial ? std::min(Lane, Valid - 1) : Lane);
+																 T Scaled = (Points[Point][d] - Min[d]) * Scale[d];
+																 Scaled = Scaled > 0 ? Scaled : T(0); // Also maps NaN to the first cell
+																 Scaled = Scaled < static_cast<T>(LastCell) ? Scaled : static_cast<T>(LastCell);
+																 Cells[d][Lane] = static_cast<uint32>(std::min(static_cast<CellType>(Scaled), LastCell));
+															 }
+														 }
+
+														 CodeType Codes[LaneCount];
+														 EncodeLanes(Cells, Codes);
+														 for (int32 Lane = 0; Lane < (bPartial ? Valid : LaneCount); ++Lane)
+															 OutCodes[First + Lane] = Codes[Lane];
+													 }); });
+			}
+
+			// Fixed partitions of the radix sort, independent of the number of workers
+			int64 GetPartitionCount(const int64 Count)
+			{
+				return std::clamp<int64>(Count / MinPartitionSize, 1, MaxPartitionCount);
+			}
+
+			int64 GetPartitionBegin(const int64 Count, const int64 PartitionCount, const int64 Partition)
+			{
+				return Count * Partition / PartitionCount;
+			}
+		}
+
+		template <typename VectorType, SpatialCode CodeType>
+		bool MortonCodes(std::span<const VectorType> Points, const FBounds<VectorType> &Bounds, std::span<CodeType> OutCodes)
+		{
+			if (OutCodes.size() != Points.size())
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(SpatialMortonCodes, Points.size());
+
+			constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+			EncodePoints(Points, Bounds, OutCodes.data(), [](const uint32 (&Cells)[Dimension][LaneCount], CodeType (&Codes)[LaneCount])
+						 { MortonLanes<Dimension>(Cells, Codes); });
+			return true;
+		}
+
+		template <typename VectorType, SpatialCode CodeType>
+		bool HilbertCodes(std::span<const VectorType> Points, const FBounds<VectorType> &Bounds, std::span<CodeType> OutCodes)
+		{
+			if (OutCodes.size() != Points.size())
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(SpatialHilbertCodes, Points.size());
+
+			constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+			EncodePoints(Points, Bounds, OutCodes.data(), [](const uint32 (&Cells)[Dimension][LaneCount], CodeType (&Codes)[LaneCount])
+						 { HilbertLanes<Dimension>(Cells, Codes); });
+			return true;
+		}
+
+		template <SpatialCode CodeType>
+		bool SortPermutation(std::span<const CodeType> Codes, std::span<int32> OutPermutation, Memory::FAllocator &Allocator)
+		{
+			constexpr int32 PassCount = (static_cast<int32>(8 * sizeof(CodeType)) + DigitBits - 1) / DigitBits;
+
+			if (OutPermutation.size() != Codes.size() || Codes.size() > static_cast<size_t>(std::numeric_limits<int32>::max()))
+				return false;
+
+			RATCHET_INSTRUMENT_BATCH(SpatialSortPermutation, Codes.size());
+
+			const int64 Count = static_cast<int64>(Codes.size());
+			const int64 PartitionCount = GetPartitionCount(Count);
+
+			// Count every digit of every pass in one read; a pass whose digit is the same for all codes is skipped
+			Memory::FAlignedBuffer<int32, CacheLineSize> Histograms(static_cast<size_t>(PartitionCount * PassCount * DigitCount), Allocator);
+			Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 Partition = Begin; Partition < End; ++Partition)
+				{
+					int32 *const Histogram = Histograms.GetData() + Partition * PassCount * DigitCount;
+					const int64 First = GetPartitionBegin(Count, PartitionCount, Partition);
+					const int64 Last = GetPartitionBegin(Count, PartitionCount, Partition + 1);
+					for (int64 i = First; i < Last; ++i)
+					{
+						for (int32 Pass = 0; Pass < PassCount; ++Pass)
+							++Histogram[Pass * DigitCount + ((Codes[i] >> (Pass * DigitBits)) & (DigitCount - 1))];
+					}
+				} });
+
+			int32 Passes[PassCount];
+			int32 ActivePassCount = 0;
+			for (int32 Pass = 0; Pass < PassCount; ++Pass)
+			{
+				for (int32 Digit = 0; Digit < DigitCount; ++Digit)
+				{
+					int64 Total = 0;
+					for (int64 Partition = 0; Partition < PartitionCount; ++Partition)
+						Total += Histograms[(Partition * PassCount + Pass) * DigitCount + Digit];
+					if (Total == Count)
+						break;
+					if (Total > 0)
+					{
+						Passes[ActivePassCount++] = Pass;
+						break;
+					}
+				}
+			}
+
+			if (ActivePassCount == 0)
+			{
+				for (int64 i = 0; i < Count; ++i)
+					OutPermutation[i] = static_cast<int32>(i);
+				return true;
+			}
+
+			// Keys are only written for the passes that have a successor, and the last pass lands in OutPermutation
+			Memory::FAlignedBuffer<CodeType, CacheLineSize> Keys[2] = {Memory::FAlignedBuffer<CodeType, CacheLineSize>(Allocator),
+																		Memory::FAlignedBuffer<CodeType, CacheLineSize>(Allocator)};
+			Memory::FAlignedBuffer<int32, CacheLineSize> Indices(Allocator);
+			if (ActivePassCount > 1)
+			{
+				Keys[0].Resize(Codes.size());
+				Indices.Resize(Codes.size());
+			}
+			if (ActivePassCount > 2)
+				Keys[1].Resize(Codes.size());
+
+			Memory::FAlignedBuffer<int64, CacheLineSize> Offsets(static_cast<size_t>(PartitionCount * DigitCount), Allocator);
+			for (int32 Step = 0; Step < ActivePassCount; ++Step)
+			{
+				const int32 Shift = Passes[Step] * DigitBits;
+				const bool bLast = Step == ActivePassCount - 1;
+				const CodeType *const SourceKeys = Step == 0 ? Codes.data() : Keys[(Step - 1) % 2].GetData();
+				const int32 *const SourceIndices = Step == 0 ? nullptr : (ActivePassCount - Step) % 2 == 0 ? OutPermutation.data() : Indices.GetData();
+				CodeType *const TargetKeys = bLast ? nullptr : Keys[Step % 2].GetData();
+				int32 *const TargetIndices = (ActivePassCount - 1 - Step) % 2 == 0 ? OutPermutation.data() : Indices.GetData();
+
+				// The first pass reuses the histograms of the initial count; later ones recount in the current order
+				if (Step > 0)
+				{
+					Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+										  {
+						for (int64 Partition = Begin; Partition < End; ++Partition)
+						{
+							int32 *const Histogram = Histograms.GetData() + (Partition * PassCount + Passes[Step]) * DigitCount;
+							std::fill(Histogram, Histogram + DigitCount, 0);
+							const int64 First = GetPartitionBegin(Count, PartitionCount, Partition);
+							const int64 Last = GetPartitionBegin(Count, PartitionCount, Partition + 1);
+							for (int64 i = First; i < Last; ++i)
+								++Histogram[(SourceKeys[i] >> Shift) & (DigitCount - 1)];
+						} });
+				}
+
+				// Digit-major, partition-minor prefix sums keep equal digits in input order
+				int64 Offset = 0;
+				for (int32 Digit = 0; Digit < DigitCount; ++Digit)
+				{
+					for (int64 Partition = 0; Partition < PartitionCount; ++Partition)
+					{
+						Offsets[Partition * DigitCount + Digit] = Offset;
+						Offset += Histograms[(Partition * PassCount + Passes[Step]) * DigitCount + Digit];
+					}
+				}
+
+				Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+									  {
+					for (int64 Partition = Begin; Partition < End; ++Partition)
+					{
+						int64 *const Next = Offsets.GetData() + Partition * DigitCount;
+						const int64 First = GetPartitionBegin(Count, PartitionCount, Partition);
+						const int64 Last = GetPartitionBegin(Count, PartitionCount, Partition + 1);
+						for (int64 i = First; i < Last; ++i)
+						{
+							const CodeType Key = SourceKeys[i];
+							const int64 Target = Next[(Key >> Shift) & (DigitCount - 1)]++;
+							if (TargetKeys != nullptr)
+								TargetKeys[Target] = Key;
+							TargetIndices[Target] = SourceIndices != nullptr ? SourceIndices[i] : static_cast<int32>(i);
+						}
+					} });
+			}
+			return true;
+		}
+
+		// Explicit instantiation for float
+		template bool MortonCodes<FVector2D<float>, uint32>(std::span<const FVector2D<float>> Points, const FBounds<FVector2D<float>> &Bounds, std::span<uint32> OutCodes);
+		template bool MortonCodes<FVector2D<float>, uint64>(std::span<const FVector2D<float>> Points, const FBounds<FVector2D<float>> &Bounds, std::span<uint64> OutCodes);
+		template bool MortonCodes<FVector3D<float>, uint32>(std::span<const FVector3D<float>> Points, const FBounds<FVector3D<float>> &Bounds, std::span<uint32> OutCodes);
+		template bool MortonCodes<FVector3D<float>, uint64>(std::span<const FVector3D<float>> Points, const FBounds<FVector3D<float>> &Bounds, std::span<uint64> OutCodes);
+		template bool HilbertCodes<FVector2D<float>, uint32>(std::span<const FVector2D<float>> Points, const FBounds<FVector2D<float>> &Bounds, std::span<uint32> OutCodes);
+		template bool HilbertCodes<FVector2D<float>, uint64>(std::span<const FVector2D<float>> Points, const FBounds<FVector2D<float>> &Bounds, std::span<uint64> OutCodes);
+		template bool HilbertCodes<FVector3D<float>, uint32>(std::span<const FVector3D<float>> Points, const FBounds<FVector3D<float>> &Bounds, std::span<uint32> OutCodes);
+		template bool HilbertCodes<FVector3D<float>, uint64>(std::span<const FVector3D<float>> Points, const FBounds<FVector3D<float>> &Bounds, std::span<uint64> OutCodes);
+
+		// Explicit instantiation for double
+		template bool MortonCodes<FVector2D<double>, uint32>(std::span<const FVector2D<double>> Points, const FBounds<FVector2D<double>> &Bounds, std::span<uint32> OutCodes);
+		template bool MortonCodes<FVector2D<double>, uint64>(std::span<const FVector2D<double>> Points, const FBounds<FVector2D<double>> &Bounds, std::span<uint64> OutCodes);
+		template bool MortonCodes<FVector3D<double>, uint32>(std::span<const FVector3D<double>> Points, const FBounds<FVector3D<double>> &Bounds, std::span<uint32> OutCodes);
+		template bool MortonCodes<FVector3D<double>, uint64>(std::span<const FVector3D<double>> Points, const FBounds<FVector3D<double>> &Bounds, std::span<uint64> OutCodes);
+		template bool HilbertCodes<FVector2D<double>, uint32>(std::span<const FVector2D<double>> Points, const FBounds<FVector2D<double>> &Bounds, std::span<uint32> OutCodes);
+		template bool HilbertCodes<FVector2D<double>, uint64>(std::span<const FVector2D<double>> Points, const FBounds<FVector2D<double>> &Bounds, std::span<uint64> OutCodes);
+		template bool HilbertCodes<FVector3D<double>, uint32>(std::span<const FVector3D<double>> Points, const FBounds<FVector3D<double>> &Bounds, std::span<uint32> OutCodes);
+		template bool HilbertCodes<FVector3D<double>, uint64>(std::span<const FVector3D<double>> Points, const FBounds<FVector3D<double>> &Bounds, std::span<uint64> OutCodes);
+
+		// Explicit instantiation for the code types
+		template bool SortPermutation<uint32>(std::span<const uint32> Codes, std::span<int32> OutPermutation, Memory::FAllocator &Allocator);
+		template bool SortPermutation<uint64>(std::span<const uint64> Codes, std::span<int32> OutPermutation, Memory::FAllocator &Allocator);
+	}
+}
@@ -0,0 +1,347 @@
+#include "TransformHierarchy.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Nodes composed side by side; the lane loops are what the compiler vectorizes
+		constexpr int32 LaneCount = 8;
+
+		// Nodes of a level per worker batch, a multiple of LaneCount
+		constexpr int64 BatchSize = 1024;
+
+		// Component offsets into the structure-of-arrays
+		constexpr int32 TranslationX = 0;
+		constexpr int32 RotationX = 3;
+		constexpr int32 ScaleX = 7;
+
+		template <typename T>
+		using FComponents = Memory::FAlignedBuffer<T, CacheLineSize>[10];
+
+		/**
+		 * Composes the world transforms of the slots [Begin, Begin + Count) with Count <= LaneCount from their
+		 * parents' world and their local transforms. A block is skipped unless one of its nodes or their parents
+		 * is dirty, and only dirty nodes are stored.
+		 *
+		 * @return The number of nodes recomputed.
+		 */
+		template <typename T>
+		int32 ComposeLanes(const FComponents<T> &Local, FComponents<T> &World, const int32 *Parents, uint8 *Dirty, const int32 Begin, const int32 Count)
+		{
+			int32 Slots[LaneCount];
+			int32 ParentSlots[LaneCount];
+			uint8 Flags[LaneCount];
+			uint8 AnyDirty = 0;
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				Slots[Lane] = Begin + std::min(Lane, Count - 1);
+				ParentSlots[Lane] = Parents[Slots[Lane]];
+				Flags[Lane] = Dirty[Slots[Lane]] | Dirty[ParentSlots[Lane]];
+				AnyDirty |= Flags[Lane];
+			}
+			if (AnyDirty == 0)
+				return 0;
+
+			T Parent[10][LaneCount];
+			T Child[10][LaneCount];
+			for (int32 c = 0; c < 10; ++c)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					Parent[c][Lane] = World[c][ParentSlots[Lane]];
+					Child[c][Lane] = Local[c][Slots[Lane]];
+				}
+			}
+
+			T Result[10][LaneCount];
+			for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+			{
+				const T PX = Parent[RotationX + 0][Lane], PY = Parent[RotationX + 1][Lane], PZ = Parent[RotationX + 2][Lane], PW = Parent[RotationX + 3][Lane];
+				const T CX = Child[RotationX + 0][Lane], CY = Child[RotationX + 1][Lane], CZ = Child[RotationX + 2][Lane], CW = Child[RotationX + 3][Lane];
+
+				// Rotation = ParentRotation * LocalRotation
+				Result[RotationX + 0][Lane] = PW * CX + PX * CW + PY * CZ - PZ * CY;
+				Result[RotationX + 1][Lane] = PW * CY - PX * CZ + PY * CW + PZ * CX;
+				Result[RotationX + 2][Lane] = PW * CZ + PX * CY - PY * CX + PZ * CW;
+				Result[RotationX + 3][Lane] = PW * CW - PX * CX - PY * CY - PZ * CZ;
+
+				// Scale = ParentScale * LocalScale
+				for (int32 i = 0; i < 3; ++i)
+					Result[ScaleX + i][Lane] = Parent[ScaleX + i][Lane] * Child[ScaleX + i][Lane];
+
+				// Translation = ParentTranslation + ParentRotation * (ParentScale * LocalTranslation)
+				const T VX = Parent[ScaleX + 0][Lane] * Child[TranslationX + 0][Lane];
+				const T VY = Parent[ScaleX + 1][Lane] * Child[TranslationX + 1][Lane];
+				const T VZ = Parent[ScaleX + 2][Lane] * Child[TranslationX + 2][Lane];
+				const T IX = PY * VZ - PZ * VY + PW * VX;
+				const T IY = PZ * VX - PX * VZ + PW * VY;
+				const T IZ = PX * VY - PY * VX + PW * VZ;
+				Result[TranslationX + 0][Lane] = Parent[TranslationX + 0][Lane] + VX + 2 * (PY * IZ - PZ * IY);
+				Result[TranslationX + 1][Lane] = Parent[TranslationX + 1][Lane] + VY + 2 * (PZ * IX - PX * IZ);
+				Result[TranslationX + 2][Lane] = Parent[TranslationX + 2][Lane] + VZ + 2 * (PX * IY - PY * IX);
+			}
+
+			int32 Updated = 0;
+			for (int32 Lane = 0; Lane < Count; ++Lane)
+			{
+				Dirty[Begin + Lane] = Flags[Lane];
+				Updated += Flags[Lane];
+			}
+			for (int32 c = 0; c < 10; ++c)
+			{
+				T *const Target = World[c].GetData() + Begin;
+				for (int32 Lane = 0; Lane < Count; ++Lane)
+					Target[Lane] = Flags[Lane] ? Result[c][Lane] : Target[Lane];
+			}
+			return Updated;
+		}
+	}
+
+	template <FloatingPoint T>
+	FTransformHierarchy<T>::FTransformHierarchy(Memory::FAllocator &InAllocator)
+		: Parents(InAllocator), Handles(InAllocator), Dirty(InAllocator), Slots(InAllocator), LevelOffsets(InAllocator),
+		  Order(InAllocator), ChildOffsets(InAllocator), Children(InAllocator), Scratch(InAllocator)
+	{
+		for (int32 c = 0; c < ComponentCount; ++c)
+		{
+			Local[c] = Memory::FAlignedBuffer<T, CacheLineSize>(InAllocator);
+			World[c] = Memory::FAlignedBuffer<T, CacheLineSize>(InAllocator);
+		}
+		LevelOffsets.Add(0);
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::Reserve(const int32 Capacity)
+	{
+		for (int32 c = 0; c < ComponentCount; ++c)
+		{
+			Local[c].Reserve(Capacity);
+			World[c].Reserve(Capacity);
+		}
+		Parents.Reserve(Capacity);
+		Handles.Reserve(Capacity);
+		Dirty.Reserve(Capacity);
+		Slots.Reserve(Capacity);
+	}
+
+	template <FloatingPoint T>
+	int32 FTransformHierarchy<T>::AddNode(const int32 Parent, const FTransform<T> &InLocal)
+	{
+		const int32 Count = GetNodeCount();
+		if (Parent != InvalidNode && (Parent < 0 || Parent >= Count))
+			return InvalidNode;
+
+		// Appending keeps parents before children, but not the level ranges
+		Parents.Add(Parent == InvalidNode ? InvalidNode : Slots[Parent]);
+		Handles.Add(Count);
+		Dirty.Add(1);
+		Slots.Add(Count);
+		for (int32 c = 0; c < ComponentCount; ++c)
+		{
+			Local[c].Add(0);
+			World[c].Add(0);
+		}
+		SetLocalTransform(Count, InLocal);
+		bLayoutValid = false;
+		return Count;
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::SetLocal(const int32 Slot, const int32 First, const int32 Count, const T *Values)
+	{
+		for (int32 i = 0; i < Count; ++i)
+			Local[First + i][Slot] = Values[i];
+		Dirty[Slot] = 1;
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::SetLocalTransform(const int32 Node, const FTransform<T> &InLocal)
+	{
+		SetLocalTranslation(Node, InLocal.Translation);
+		SetLocalRotation(Node, InLocal.Rotation);
+		SetLocalScale(Node, InLocal.Scale);
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::SetLocalTranslation(const int32 Node, const FVector3D<T> &Translation)
+	{
+		const T Values[3] = {Translation.GetX(), Translation.GetY(), Translation.GetZ()};
+		SetLocal(Slots[Node], TranslationX, 3, Values);
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::SetLocalRotation(const int32 Node, const FQuat<T> &Rotation)
+	{
+		const T Values[4] = {Rotation.GetX(), Rotation.GetY(), Rotation.GetZ(), Rotation.GetW()};
+		SetLocal(Slots[Node], RotationX, 4, Values);
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::SetLocalScale(const int32 Node, const FVector3D<T> &Scale)
+	{
+		const T Values[3] = {Scale.GetX(), Scale.GetY(), Scale.GetZ()};
+		SetLocal(Slots[Node], ScaleX, 3, Values);
+	}
+
+	template <FloatingPoint T>
+	FTransform<T> FTransformHierarchy<T>::GetTransform(const Memory::FAlignedBuffer<T, CacheLineSize> (&Components)[ComponentCount], const int32 Slot) const
+	{
+		FTransform<T> Result;
+		Result.Translation = FVector3D<T>(Components[TranslationX][Slot], Components[TranslationX + 1][Slot], Components[TranslationX + 2][Slot]);
+		Result.Rotation = FQuat<T>(Components[RotationX][Slot], Components[RotationX + 1][Slot], Components[RotationX + 2][Slot], Components[RotationX + 3][Slot]);
+		Result.Scale = FVector3D<T>(Components[ScaleX][Slot], Components[ScaleX + 1][Slot], Components[ScaleX + 2][Slot]);
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	FTransform<T> FTransformHierarchy<T>::GetLocalTransform(const int32 Node) const
+	{
+		return GetTransform(Local, Slots[Node]);
+	}
+
+	template <FloatingPoint T>
+	FTransform<T> FTransformHierarchy<T>::GetWorldTransform(const int32 Node) const
+	{
+		return GetTransform(World, Slots[Node]);
+	}
+
+	template <FloatingPoint T>
+	int32 FTransformHierarchy<T>::GetParent(const int32 Node) const
+	{
+		const int32 ParentSlot = Parents[Slots[Node]];
+		return ParentSlot == InvalidNode ? InvalidNode : Handles[ParentSlot];
+	}
+
+	template <FloatingPoint T>
+	int32 FTransformHierarchy<T>::GetNodeCount() const
+	{
+		return static_cast<int32>(Slots.Num());
+	}
+
+	template <FloatingPoint T>
+	void FTransformHierarchy<T>::RebuildLayout()
+	{
+		const int32 Count = GetNodeCount();
+
+		// Bucket the slots by parent, keeping their order: bucket 0 holds the roots, bucket s + 1 the children
+		// of slot s. The buckets are filled back to front so ChildOffsets ends up holding their starts.
+		ChildOffsets.Resize(Count + 2);
+		std::fill(ChildOffsets.begin(), ChildOffsets.end(), 0);
+		for (int32 Slot = 0; Slot < Count; ++Slot)
+			++ChildOffsets[Parents[Slot] + 1];
+		for (int32 Bucket = 1; Bucket <= Count + 1; ++Bucket)
+			ChildOffsets[Bucket] += ChildOffsets[Bucket - 1];
+		Children.Resize(Count);
+		for (int32 Slot = Count - 1; Slot >= 0; --Slot)
+			Children[--ChildOffsets[Parents[Slot] + 1]] = Slot;
+
+		// Breadth-first traversal; Order[NewSlot] = OldSlot
+		Order.Resize(Count);
+		int32 Write = 0;
+		for (int32 k = ChildOffsets[0]; k < ChildOffsets[1]; ++k)
+			Order[Write++] = Children[k];
+
+		LevelOffsets.Clear();
+		LevelOffsets.Add(0);
+		for (int32 LevelBegin = 0, LevelEnd = Write; LevelBegin < LevelEnd; LevelBegin = LevelEnd, LevelEnd = Write)
+		{
+			for (int32 Read = LevelBegin; Read < LevelEnd; ++Read)
+			{
+				const int32 Bucket = Order[Read] + 1;
+				for (int32 k = ChildOffsets[Bucket]; k < ChildOffsets[Bucket + 1]; ++k)
+					Order[Write++] = Children[k];
+			}
+			LevelOffsets.Add(LevelEnd);
+		}
+
+		// Permute the node arrays; Children becomes the map from old to new slots
+		for (int32 NewSlot = 0; NewSlot < Count; ++NewSlot)
+			Children[Order[NewSlot]] = NewSlot;
+
+		ChildOffsets.Resize(Count);
+		for (int32 NewSlot = 0; NewSlot < Count; ++NewSlot)
+		{
+			const int32 OldParent = Parents[Order[NewSlot]];
+			ChildOffsets[NewSlot] = OldParent == InvalidNode ? InvalidNode : Children[OldParent];
+		}
+		std::swap(ChildOffsets, Parents);
+
+		for (int32 NewSlot = 0; NewSlot < Count; ++NewSlot)
+			ChildOffsets[NewSlot] = Handles[Order[NewSlot]];
+		std::swap(ChildOffsets, Handles);
+
+		for (int32 NewSlot = 0; NewSlot < Count; ++NewSlot)
+			Slots[Handles[NewSlot]] = NewSlot;
+
+		Scratch.Resize(Count);
+		for (int32 c = 0; c < ComponentCount; ++c)
+		{
+			for (int32 NewSlot = 0; NewSlot < Count; ++NewSlot)
+				Scratch[NewSlot] = Local[c][Order[NewSlot]];
+			std::swap(Scratch, Local[c]);
+		}
+
+		// World transforms are not carried over; every node is recomputed
+		std::fill(Dirty.begin(), Dirty.end(), uint8(1));
+	}
+
+	template <FloatingPoint T>
+	int32 FTransformHierarchy<T>::UpdateWorldTransforms()
+	{
+		if (!bLayoutValid)
+		{
+			RebuildLayout();
+			bLayoutValid = true;
+		}
+
+		const int32 LevelCount = static_cast<int32>(LevelOffsets.Num()) - 1;
+		RATCHET_INSTRUMENT_BATCH(TransformHierarchyUpdate, GetNodeCount());
+
+		std::atomic<int32> Updated{0};
+
+		// Roots take their local transform as is
+		const int32 RootCount = LevelCount > 0 ? LevelOffsets[1] : 0;
+		for (int32 Slot = 0; Slot < RootCount; ++Slot)
+		{
+			if (Dirty[Slot])
+			{
+				for (int32 c = 0; c < ComponentCount; ++c)
+					World[c][Slot] = Local[c][Slot];
+				Updated.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		// Every later level only reads the finished level before it
+		for (int32 Level = 1; Level < LevelCount; ++Level)
+		{
+			const int32 LevelBegin = LevelOffsets[Level];
+			Parallel::ParallelFor(LevelOffsets[Level + 1] - LevelBegin, BatchSize, [this, LevelBegin, &Updated](const int64 Begin, const int64 End)
+								  {
+									  int32 BatchUpdated = 0;
+									  for (int64 Block = Begin; Block < End; Block += LaneCount)
+									  {
+										  const int32 Count = static_cast<int32>(std::min<int64>(LaneCount, End - Block));
+										  BatchUpdated += ComposeLanes<T>(Local, World, Parents.GetData(), Dirty.GetData(), LevelBegin + static_cast<int32>(Block), Count);
+									  }
+									  Updated.fetch_add(BatchUpdated, std::memory_order_relaxed); });
+		}
+
+		std::fill(Dirty.begin(), Dirty.end(), uint8(0));
+		return Updated.load(std::memory_order_relaxed);
+	}
+
+	// Explicit instantiation for float
+	template class FTransformHierarchy<float>;
+
+	// Explicit instantiation for double
+	template class FTransformHierarchy<double>;
+
+	// Explicit instantiation for long double
+	template class FTransformHierarchy<long double>;
+}
@@ -0,0 +1,387 @@
+#include "VectorFile.h"
+#include "Instrument.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Ratchet
+{
+	static_assert(sizeof(FVectorFileHeader) == 72, "FVectorFileHeader layout is part of the file format");
+
+	namespace
+	{
+		// Vectors converted to SoA per write call
+		constexpr uint64 StagingCount = 16384;
+
+		uint64 AlignUp(const uint64 Value, const uint64 Alignment)
+		{
+			return (Value + Alignment - 1) & ~(Alignment - 1);
+		}
+
+		bool SeekFile(std::FILE *File, const uint64 Offset)
+		{
+#if defined(_WIN32)
+			return _fseeki64(File, static_cast<int64>(Offset), SEEK_SET) == 0;
+#else
+			return fseeko(File, static_cast<off_t>(Offset), SEEK_SET) == 0;
+#endif
+		}
+
+		// Streams are viewed in place, so they must start on the declared alignment, itself a multiple of the scalar size
+		bool HasAlignedStreams(const FVectorFileHeader &Header)
+		{
+			const uint64 Alignment = Header.Alignment;
+			return Alignment >= Header.ScalarSize && (Alignment & (Alignment - 1)) == 0 &&
+				   Header.DataOffset >= sizeof(FVectorFileHeader) && Header.DataOffset % Alignment == 0 && Header.StreamStride % Alignment == 0;
+		}
+
+		// Every term is bounded by the mapping size before it is added or multiplied, so a crafted header cannot wrap around
+		bool StreamsFitInMapping(const FVectorFileHeader &Header, const int32 StreamCount, const uint64 MappingSize)
+		{
+			const uint64 ElementSize = static_cast<uint64>(StreamCount == 1 ? Header.Dimension : 1) * Header.ScalarSize;
+			if (Header.Count > MappingSize / ElementSize || Header.DataOffset > MappingSize)
+				return false;
+
+			const uint64 StreamSize = Header.Count * ElementSize;
+			if (StreamSize > MappingSize - Header.DataOffset)
+				return false;
+
+			return StreamCount == 1 ||
+				   (Header.StreamStride >= StreamSize && Header.StreamStride <= (MappingSize - Header.DataOffset - StreamSize) / static_cast<uint64>(StreamCount - 1));
+		}
+
+		template <typename VectorType>
+		bool HasVectorLayout(const FVectorFileHeader &Header)
+		{
+			using T = typename TVectorTraits<VectorType>::ScalarType;
+			return Header.Dimension == TVectorTraits<VectorType>::Dimension && Header.ScalarSize == sizeof(T);
+		}
+	}
+
+	uint64 VectorFileChecksum(const void *Data, const uint64 Size, const uint64 Seed)
+	{
+		const uint8 *Bytes = static_cast<const uint8 *>(Data);
+		uint64 Hash = Seed;
+		for (uint64 Offset = 0; Offset + 4 <= Size; Offset += 4)
+		{
+			uint32 Word;
+			std::memcpy(&Word, Bytes + Offset, sizeof(Word));
+			Hash = (Hash ^ Word) * 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	FVectorFileReader::FVectorFileReader() {}
+
+	FVectorFileReader::~FVectorFileReader()
+	{
+		Close();
+	}
+
+	EVectorFileStatus FVectorFileReader::Open(const char *Path, const bool bVerifyChecksums)
+	{
+		Close();
+
+#if defined(_WIN32)
+		HANDLE File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (File == INVALID_HANDLE_VALUE)
+			return EVectorFileStatus::CannotOpen;
+
+		LARGE_INTEGER FileSize;
+		HANDLE MappingObject = GetFileSizeEx(File, &FileSize) && FileSize.QuadPart > 0
+								   ? CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr)
+								   : nullptr;
+		const void *View = MappingObject != nullptr ? MapViewOfFile(MappingObject, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (View == nullptr)
+		{
+			if (MappingObject != nullptr)
+				CloseHandle(MappingObject);
+			CloseHandle(File);
+			return EVectorFileStatus::CannotOpen;
+		}
+
+		FileHandle = reinterpret_cast<machine_address>(File);
+		MappingHandle = reinterpret_cast<machine_address>(MappingObject);
+		Mapping = static_cast<const uint8 *>(View);
+		MappingSize = static_cast<uint64>(FileSize.QuadPart);
+#else
+		const int File = open(Path, O_RDONLY);
+		if (File < 0)
+			return EVectorFileStatus::CannotOpen;
+
+		struct stat FileStat;
+		void *View = fstat(File, &FileStat) == 0 && FileStat.st_size > 0
+						 ? mmap(nullptr, static_cast<size_t>(FileStat.st_size), PROT_READ, MAP_PRIVATE, File, 0)
+						 : MAP_FAILED;
+		// The mapping keeps the file alive on its own
+		close(File);
+		if (View == MAP_FAILED)
+			return EVectorFileStatus::CannotOpen;
+
+		Mapping = static_cast<const uint8 *>(View);
+		MappingSize = static_cast<uint64>(FileStat.st_size);
+#endif
+
+		EVectorFileStatus Status = EVectorFileStatus::Ok;
+		if (MappingSize < sizeof(FVectorFileHeader))
+		{
+			Status = EVectorFileStatus::Truncated;
+		}
+		else
+		{
+			std::memcpy(&Header, Mapping, sizeof(Header));
+			if (Header.Magic != FVectorFileHeader::ExpectedMagic)
+				Status = EVectorFileStatus::BadMagic;
+			else if (Header.Version != FVectorFileHeader::CurrentVersion)
+				Status = EVectorFileStatus::UnsupportedVersion;
+			else if (Header.Dimension < 2 || Header.Dimension > FVectorFileHeader::MaxStreams || (Header.ScalarSize != 4 && Header.ScalarSize != 8) || Header.Layout > static_cast<uint8>(EVectorFileLayout::SoA))
+				Status = EVectorFileStatus::InvalidArgument;
+			else if (!HasAlignedStreams(Header))
+				Status = EVectorFileStatus::InvalidArgument;
+			else if (!StreamsFitInMapping(Header, GetStreamCount(), MappingSize))
+				Status = EVectorFileStatus::Truncated;
+			else if (bVerifyChecksums)
+				Status = VerifyChecksums();
+		}
+
+		if (Status != EVectorFileStatus::Ok)
+			Close();
+
+		return Status;
+	}
+
+	void FVectorFileReader::Close()
+	{
+		if (Mapping == nullptr)
+			return;
+
+#if defined(_WIN32)
+		UnmapViewOfFile(Mapping);
+		CloseHandle(reinterpret_cast<HANDLE>(MappingHandle));
+		CloseHandle(reinterpret_cast<HANDLE>(FileHandle));
+#else
+		munmap(const_cast<uint8 *>(Mapping), static_cast<size_t>(MappingSize));
+#endif
+
+		Mapping = nullptr;
+		MappingSize = 0;
+		FileHandle = 0;
+		MappingHandle = 0;
+		Header = FVectorFileHeader();
+	}
+
+	EVectorFileStatus FVectorFileReader::VerifyChecksums() const
+	{
+		for (int32 Stream = 0; Stream < GetStreamCount(); ++Stream)
+		{
+			if (VectorFileChecksum(GetStreamData(Stream), GetStreamSize()) != Header.Checksums[Stream])
+				return EVectorFileStatus::ChecksumMismatch;
+		}
+		return EVectorFileStatus::Ok;
+	}
+
+	void FVectorFileReader::Prefetch() const
+	{
+		if (Mapping == nullptr)
+			return;
+
+#if defined(_WIN32)
+		WIN32_MEMORY_RANGE_ENTRY Range{const_cast<uint8 *>(Mapping), static_cast<SIZE_T>(MappingSize)};
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &Range, 0);
+#else
+		madvise(const_cast<uint8 *>(Mapping), static_cast<size_t>(MappingSize), MADV_WILLNEED);
+#endif
+	}
+
+	bool FVectorFileReader::IsOpen() const
+	{
+		return Mapping != nullptr;
+	}
+
+	const FVectorFileHeader &FVectorFileReader::GetHeader() const
+	{
+		return Header;
+	}
+
+	template <typename VectorType>
+	std::span<const VectorType> FVectorFileReader::GetElements() const
+	{
+		static_assert(sizeof(VectorType) == sizeof(typename TVectorTraits<VectorType>::ScalarType) * TVectorTraits<VectorType>::Dimension,
+					  "Vector types must be tightly packed to be viewed in place");
+
+		if (Mapping == nullptr || Header.Layout != static_cast<uint8>(EVectorFileLayout::AoS) || !HasVectorLayout<VectorType>(Header))
+			return {};
+
+		return {reinterpret_cast<const VectorType *>(GetStreamData(0)), static_cast<size_t>(Header.Count)};
+	}
+
+	template <FloatingPoint T>
+	std::span<const T> FVectorFileReader::GetComponent(const int32 Component) const
+	{
+		if (Mapping == nullptr || Header.Layout != static_cast<uint8>(EVectorFileLayout::SoA) || Header.ScalarSize != sizeof(T) || Component < 0 || Component >= Header.Dimension)
+			return {};
+
+		return {reinterpret_cast<const T *>(GetStreamData(Component)), static_cast<size_t>(Header.Count)};
+	}
+
+	const uint8 *FVectorFileReader::GetStreamData(const int32 Stream) const
+	{
+		return Mapping + Header.DataOffset + Stream * Header.StreamStride;
+	}
+
+	uint64 FVectorFileReader::GetStreamSize() const
+	{
+		const uint64 StreamComponents = Header.Layout == static_cast<uint8>(EVectorFileLayout::AoS) ? Header.Dimension : 1;
+		return Header.Count * StreamComponents * Header.ScalarSize;
+	}
+
+	int32 FVectorFileReader::GetStreamCount() const
+	{
+		return Header.Layout == static_cast<uint8>(EVectorFileLayout::AoS) ? 1 : Header.Dimension;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <typename VectorType>
+	FVectorFileWriter<VectorType>::FVectorFileWriter(Memory::FAllocator &InAllocator)
+		: Staging(InAllocator) {}
+
+	template <typename VectorType>
+	FVectorFileWriter<VectorType>::~FVectorFileWriter()
+	{
+		Close();
+	}
+
+	template <typename VectorType>
+	EVectorFileStatus FVectorFileWriter<VectorType>::Open(const char *Path, const EVectorFileLayout Layout, const uint64 TotalCount, const uint32 Alignment)
+	{
+		Close();
+
+		if (Alignment == 0 || (Alignment & (Alignment - 1)) != 0 || Alignment < sizeof(ScalarType))
+			return EVectorFileStatus::InvalidArgument;
+
+		File = std::fopen(Path, "wb");
+		if (File == nullptr)
+			return EVectorFileStatus::CannotOpen;
+
+		Header = FVectorFileHeader();
+		Header.Dimension = static_cast<uint8>(Dimension);
+		Header.ScalarSize = static_cast<uint8>(sizeof(ScalarType));
+		Header.Layout = static_cast<uint8>(Layout);
+		Header.Alignment = Alignment;
+		Header.DataOffset = AlignUp(sizeof(FVectorFileHeader), Alignment);
+		if (Layout == EVectorFileLayout::SoA)
+		{
+			Header.Count = TotalCount;
+			Header.StreamStride = AlignUp(TotalCount * sizeof(ScalarType), Alignment);
+			Staging.Resize(StagingCount);
+		}
+		for (uint64 &Checksum : Header.Checksums)
+			Checksum = VectorFileChecksum(nullptr, 0);
+
+		Written = 0;
+		bFailed = !WriteAt(0, &Header, sizeof(Header));
+
+		return bFailed ? EVectorFileStatus::WriteFailed : EVectorFileStatus::Ok;
+	}
+
+	template <typename VectorType>
+	EVectorFileStatus FVectorFileWriter<VectorType>::Append(std::span<const VectorType> Elements)
+	{
+		RATCHET_INSTRUMENT_BATCH(VectorFileAppend, Elements.size());
+
+		if (File == nullptr || bFailed)
+			return EVectorFileStatus::WriteFailed;
+
+		if (Header.Layout == static_cast<uint8>(EVectorFileLayout::AoS))
+		{
+			const uint64 Size = Elements.size_bytes();
+			bFailed = !WriteAt(Header.DataOffset + Written * sizeof(VectorType), Elements.data(), Size);
+			Header.Checksums[0] = VectorFileChecksum(Elements.data(), Size, Header.Checksums[0]);
+			Written += Elements.size();
+			return bFailed ? EVectorFileStatus::WriteFailed : EVectorFileStatus::Ok;
+		}
+
+		if (Written + Elements.size() > Header.Count)
+			return EVectorFileStatus::InvalidArgument;
+
+		// Transpose one staging block at a time and write every component run to its own stream
+		for (uint64 ChunkBegin = 0; ChunkBegin < Elements.size() && !bFailed; ChunkBegin += StagingCount)
+		{
+			const uint64 ChunkCount = std::min<uint64>(StagingCount, Elements.size() - ChunkBegin);
+			for (int32 Component = 0; Component < Dimension && !bFailed; ++Component)
+			{
+				for (uint64 i = 0; i < ChunkCount; ++i)
+					Staging[i] = Elements[ChunkBegin + i][static_cast<int8>(Component)];
+
+				const uint64 Size = ChunkCount * sizeof(ScalarType);
+				const uint64 Offset = Header.DataOffset + Component * Header.StreamStride + (Written + ChunkBegin) * sizeof(ScalarType);
+				bFailed = !WriteAt(Offset, Staging.GetData(), Size);
+				Header.Checksums[Component] = VectorFileChecksum(Staging.GetData(), Size, Header.Checksums[Component]);
+			}
+		}
+		Written += Elements.size();
+
+		return bFailed ? EVectorFileStatus::WriteFailed : EVectorFileStatus::Ok;
+	}
+
+	template <typename VectorType>
+	EVectorFileStatus FVectorFileWriter<VectorType>::Close()
+	{
+		if (File == nullptr)
+			return EVectorFileStatus::InvalidArgument;
+
+		EVectorFileStatus Status = EVectorFileStatus::Ok;
+		if (Header.Layout == static_cast<uint8>(EVectorFileLayout::AoS))
+			Header.Count = Written;
+		else if (Written != Header.Count)
+			Status = EVectorFileStatus::Truncated;
+
+		if (!bFailed)
+			bFailed = !WriteAt(0, &Header, sizeof(Header));
+
+		if (std::fclose(File) != 0)
+			bFailed = true;
+		File = nullptr;
+		Staging.Release();
+
+		return bFailed ? EVectorFileStatus::WriteFailed : Status;
+	}
+
+	template <typename VectorType>
+	bool FVectorFileWriter<VectorType>::WriteAt(const uint64 Offset, const void *Data, const uint64 Size)
+	{
+		return SeekFile(File, Offset) && std::fwrite(Data, 1, static_cast<size_t>(Size), File) == Size;
+	}
+
+	// Explicit instantiation for float
+	template class FVectorFileWriter<FVector2D<float>>;
+	template class FVectorFileWriter<FVector3D<float>>;
+	template class FVectorFileWriter<FVector4D<float>>;
+	template std::span<const FVector2D<float>> FVectorFileReader::GetElements<FVector2D<float>>() const;
+	template std::span<const FVector3D<float>> FVectorFileReader::GetElements<FVector3D<float>>() const;
+	template std::span<const FVector4D<float>> FVectorFileReader::GetElements<FVector4D<float>>() const;
+	template std::span<const float> FVectorFileReader::GetComponent<float>(const int32 Component) const;
+
+	// Explicit instantiation for double
+	template class FVectorFileWriter<FVector2D<double>>;
+	template class FVectorFileWriter<FVector3D<double>>;
+	template class FVectorFileWriter<FVector4D<double>>;
+	template std::span<const FVector2D<double>> FVectorFileReader::GetElements<FVector2D<double>>() const;
+	template std::span<const FVector3D<double>> FVectorFileReader::GetElements<FVector3D<double>>() const;
+	template std::span<const FVector4D<double>> FVectorFileReader::GetElements<FVector4D<double>>() const;
+	template std::span<const double> FVectorFileReader::GetComponent<double>(const int32 Component) const;
+}
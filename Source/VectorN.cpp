@@ -0,0 +1,212 @@
+#include "VectorN.h"
+#include "Instrument.h"
+#include "REMath.h"
+
+#include <utility>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Component indices of a vector; functions expand them in fold expressions, unrolled at compile time
+		template <int32 N>
+		constexpr std::make_integer_sequence<int32, N> ComponentIndices{};
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T>::FVector()
+		: Components{} {}
+
+	template <int32 N, FloatingPoint T>
+	bool FVector<N, T>::operator==(const FVector &Other) const
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return ((Components[Index] == Other.Components[Index]) && ...); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	T FVector<N, T>::Magnitude() const
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorMagnitude);
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return Ratchet::Math::Sqrt<T>((... + (Components[Index] * Components[Index]))); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> &FVector<N, T>::Normalize()
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorNormalize);
+		const T magnitude = Magnitude();
+		*this /= magnitude;
+		return *this;
+	}
+
+	template <int32 N, FloatingPoint T>
+	T FVector<N, T>::DistanceTo(const FVector &Other) const
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorDistanceTo);
+		FVector DiffernceVector = *this - Other;
+		return DiffernceVector.Magnitude();
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> &FVector<N, T>::operator+=(const FVector &Other)
+	{
+		[&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ ((Components[Index] += Other.Components[Index]), ...); }(ComponentIndices<N>);
+		return *this;
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> &FVector<N, T>::operator-=(const FVector &Other)
+	{
+		[&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ ((Components[Index] -= Other.Components[Index]), ...); }(ComponentIndices<N>);
+		return *this;
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> &FVector<N, T>::operator*=(const T Scalar)
+	{
+		[&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ ((Components[Index] *= Scalar), ...); }(ComponentIndices<N>);
+		return *this;
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> &FVector<N, T>::operator/=(const T Scalar)
+	{
+		const T Delimeter = static_cast<T>(1) / Scalar;
+		return *this *= Delimeter;
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator*(const FVector<N, T> &LHS, const T Scalar)
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return FVector<N, T>((LHS[Index] * Scalar)...); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator/(const FVector<N, T> &LHS, const T Scalar)
+	{
+		const T Delimeter = static_cast<T>(1) / Scalar;
+		return LHS * Delimeter;
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator+(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return FVector<N, T>((A[Index] + B[Index])...); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator-(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return FVector<N, T>((A[Index] - B[Index])...); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> operator-(const FVector<N, T> &Vector)
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return FVector<N, T>((-Vector[Index])...); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	T Magnitude(const FVector<N, T> &Vector)
+	{
+		return Vector.Magnitude();
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> GetNormalized(const FVector<N, T> &Vector)
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorGetNormalized);
+		const T magnitude = Magnitude(Vector);
+		FVector<N, T> NormalizedVector = Vector / magnitude;
+
+		return NormalizedVector;
+	}
+
+	template <int32 N, FloatingPoint T>
+	T Dot(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		return [&]<int32... Index>(std::integer_sequence<int32, Index...>)
+		{ return (... + (A[Index] * B[Index])); }(ComponentIndices<N>);
+	}
+
+	template <int32 N, FloatingPoint T>
+	T Distance(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorDistance);
+		return Magnitude(A - B);
+	}
+
+	template <int32 N, FloatingPoint T>
+	T DistanceSquared(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		const FVector<N, T> Difference = A - B;
+		return Dot(Difference, Difference);
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Project(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		return B * (Dot(A, B) / Dot(B, B));
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Reject(const FVector<N, T> &A, const FVector<N, T> &B)
+	{
+		return A - B * (Dot(A, B) / Dot(B, B));
+	}
+
+	template <int32 N, FloatingPoint T>
+	FVector<N, T> Lerp(const FVector<N, T> &A, const FVector<N, T> &B, const T Alpha)
+	{
+		return A + (B - A) * Alpha;
+	}
+
+#define RATCHET_INSTANTIATE_VECTOR(N, T)                                                     \
+	static_assert(IsInstantiatedDimension(N), "Add N to IsInstantiatedDimension");           \
+	template class FVector<N, T>;                                                            \
+	template FVector<N, T> operator*(const FVector<N, T> &LHS, const T Scalar);              \
+	template FVector<N, T> operator/(const FVector<N, T> &LHS, const T Scalar);              \
+	template FVector<N, T> operator+(const FVector<N, T> &A, const FVector<N, T> &B);        \
+	template FVector<N, T> operator-(const FVector<N, T> &A, const FVector<N, T> &B);        \
+	template FVector<N, T> operator-(const FVector<N, T> &Vector);                           \
+	template T Magnitude(const FVector<N, T> &Vector);                                       \
+	template FVector<N, T> GetNormalized(const FVector<N, T> &Vector);                       \
+	template T Dot(const FVector<N, T> &A, const FVector<N, T> &B);                          \
+	template T Distance(const FVector<N, T> &A, const FVector<N, T> &B);                     \
+	template T DistanceSquared(const FVector<N, T> &A, const FVector<N, T> &B);              \
+	template FVector<N, T> Project(const FVector<N, T> &A, const FVector<N, T> &B);          \
+	template FVector<N, T> Reject(const FVector<N, T> &A, const FVector<N, T> &B);           \
+	template FVector<N, T> Lerp(const FVector<N, T> &A, const FVector<N, T> &B, const T Alpha);
+
+	// Explicit instantiation for float
+	RATCHET_INSTANTIATE_VECTOR(2, float)
+	RATCHET_INSTANTIATE_VECTOR(3, float)
+	RATCHET_INSTANTIATE_VECTOR(4, float)
+	RATCHET_INSTANTIATE_VECTOR(8, float)
+	RATCHET_INSTANTIATE_VECTOR(16, float)
+
+	// Explicit instantiation for double
+	RATCHET_INSTANTIATE_VECTOR(2, double)
+	RATCHET_INSTANTIATE_VECTOR(3, double)
+	RATCHET_INSTANTIATE_VECTOR(4, double)
+	RATCHET_INSTANTIATE_VECTOR(8, double)
+	RATCHET_INSTANTIATE_VECTOR(16, double)
+
+	// Explicit instantiation for long double
+	RATCHET_INSTANTIATE_VECTOR(2, long double)
+	RATCHET_INSTANTIATE_VECTOR(3, long double)
+	RATCHET_INSTANTIATE_VECTOR(4, long double)
+	RATCHET_INSTANTIATE_VECTOR(8, long double)
+	RATCHET_INSTANTIATE_VECTOR(16, long double)
+
+#undef RATCHET_INSTANTIATE_VECTOR
+}
@@ -0,0 +1,293 @@
+#include "VectorPipeline.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Vectors per worker batch inside a chunk
+		constexpr int64 ProcessBatchSize = 4096;
+
+		enum class ESlotState : uint8
+		{
+			Empty,
+			Filled,
+			Processed
+		};
+	}
+
+	double FVectorPipelineStats::GetThroughputGBs() const
+	{
+		return Seconds > 0 ? static_cast<double>(BytesRead + BytesWritten) / Seconds * 1e-9 : 0;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <typename VectorType>
+	FVectorFileSource<VectorType>::FVectorFileSource(const FVectorFileReader &InReader)
+		: Reader(InReader) {}
+
+	template <typename VectorType>
+	uint64 FVectorFileSource<VectorType>::Read(std::span<VectorType> OutChunk)
+	{
+		using T = typename TVectorTraits<VectorType>::ScalarType;
+		constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+
+		const uint64 Count = std::min<uint64>(OutChunk.size(), Reader.GetHeader().Count - Position);
+		if (Count == 0)
+			return 0;
+
+		const std::span<const VectorType> Elements = Reader.GetElements<VectorType>();
+		if (!Elements.empty())
+		{
+			std::copy_n(Elements.begin() + Position, Count, OutChunk.begin());
+		}
+		else
+		{
+			for (int32 Component = 0; Component < Dimension; ++Component)
+			{
+				const std::span<const T> Stream = Reader.GetComponent<T>(Component);
+				if (Stream.empty() || Reader.GetHeader().Dimension != Dimension)
+					return 0;
+				for (uint64 i = 0; i < Count; ++i)
+					OutChunk[i][static_cast<int8>(Component)] = Stream[Position + i];
+			}
+		}
+
+		Position += Count;
+		return Count;
+	}
+
+	template <typename VectorType>
+	FVectorFileSink<VectorType>::FVectorFileSink(FVectorFileWriter<VectorType> &InWriter)
+		: Writer(InWriter) {}
+
+	template <typename VectorType>
+	bool FVectorFileSink<VectorType>::Write(std::span<const VectorType> Chunk)
+	{
+		return Writer.Append(Chunk) == EVectorFileStatus::Ok;
+	}
+
+	/* //////////////////////////////////////////////////////////////////////////////////////////////////////// */
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType>::FVectorPipeline(const uint64 InChunkSize, Memory::FAllocator &InAllocator)
+		: Stages(InAllocator), Buffers(InAllocator), ChunkSize(std::max<uint64>(1, InChunkSize)) {}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Scale(const ScalarType Scalar)
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Scale, VectorType(), Scalar, nullptr});
+		return *this;
+	}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Translate(const VectorType &Offset)
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Translate, Offset, 0, nullptr});
+		return *this;
+	}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Normalize()
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Normalize, VectorType(), 0, nullptr});
+		return *this;
+	}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Project(const VectorType &Direction)
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Project, Direction, static_cast<ScalarType>(1) / Dot(Direction, Direction), nullptr});
+		return *this;
+	}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Reject(const VectorType &Direction)
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Reject, Direction, static_cast<ScalarType>(1) / Dot(Direction, Direction), nullptr});
+		return *this;
+	}
+
+	template <typename VectorType>
+	FVectorPipeline<VectorType> &FVectorPipeline<VectorType>::Custom(FCustomFunction Function)
+	{
+		Stages.Add(FStage{EVectorPipelineOp::Custom, VectorType(), 0, std::move(Function)});
+		return *this;
+	}
+
+	template <typename VectorType>
+	void FVectorPipeline<VectorType>::ClearStages()
+	{
+		Stages.Clear();
+	}
+
+	template <typename VectorType>
+	void FVectorPipeline<VectorType>::Process(std::span<VectorType> Chunk) const
+	{
+		// Run the whole chain on one batch before moving on, so the batch stays in cache across stages
+		Parallel::ParallelFor(static_cast<int64>(Chunk.size()), ProcessBatchSize, [&](const int64 Begin, const int64 End)
+							  {
+			const std::span<VectorType> Batch = Chunk.subspan(Begin, End - Begin);
+			for (const FStage &Stage : Stages)
+			{
+				switch (Stage.Op)
+				{
+				case EVectorPipelineOp::Scale:
+					for (VectorType &Vector : Batch)
+						Vector *= Stage.Scalar;
+					break;
+				case EVectorPipelineOp::Translate:
+					for (VectorType &Vector : Batch)
+						Vector += Stage.Operand;
+					break;
+				case EVectorPipelineOp::Normalize:
+					for (VectorType &Vector : Batch)
+						Vector.Normalize();
+					break;
+				case EVectorPipelineOp::Project:
+					for (VectorType &Vector : Batch)
+						Vector = Stage.Operand * (Dot(Vector, Stage.Operand) * Stage.Scalar);
+					break;
+				case EVectorPipelineOp::Reject:
+					for (VectorType &Vector : Batch)
+						Vector -= Stage.Operand * (Dot(Vector, Stage.Operand) * Stage.Scalar);
+					break;
+				case EVectorPipelineOp::Custom:
+					Stage.Function(Batch);
+					break;
+				}
+			} });
+	}
+
+	template <typename VectorType>
+	FVectorPipelineStats FVectorPipeline<VectorType>::Run(IVectorSource<VectorType> &Source, IVectorSink<VectorType> &Sink)
+	{
+		RATCHET_INSTRUMENT_SCOPE(VectorPipelineRun);
+
+		const auto StartTime = std::chrono::steady_clock::now();
+
+		Buffers.Resize(ChunkSize * BufferCount);
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		ESlotState SlotStates[BufferCount] = {};
+		uint64 SlotCounts[BufferCount] = {};
+		uint64 ReadChunks = 0;	  // Chunks handed out by the source so far
+		uint64 WrittenChunks = 0; // Chunks accepted by the sink so far
+		bool bSourceDone = false;
+		bool bFailed = false;
+
+		FVectorPipelineStats Stats;
+
+		const auto GetSlot = [&](const uint64 Chunk)
+		{
+			return std::span<VectorType>(Buffers.GetData() + (Chunk % BufferCount) * ChunkSize, ChunkSize);
+		};
+
+		// The I/O thread writes finished chunks as soon as they are ready and reads ahead into free slots
+		std::thread IOThread([&]
+							 {
+			std::unique_lock<std::mutex> Lock(Mutex);
+			while (!bFailed && !(bSourceDone && WrittenChunks == ReadChunks))
+			{
+				const int32 WriteSlot = static_cast<int32>(WrittenChunks % BufferCount);
+				const int32 ReadSlot = static_cast<int32>(ReadChunks % BufferCount);
+
+				if (WrittenChunks < ReadChunks && SlotStates[WriteSlot] == ESlotState::Processed)
+				{
+					const uint64 Count = SlotCounts[WriteSlot];
+					Lock.unlock();
+					const bool bWritten = Sink.Write(GetSlot(WrittenChunks).first(Count));
+					Lock.lock();
+
+					SlotStates[WriteSlot] = ESlotState::Empty;
+					++WrittenChunks;
+					Stats.BytesWritten += Count * sizeof(VectorType);
+					bFailed = !bWritten;
+					Condition.notify_all();
+				}
+				else if (!bSourceDone && SlotStates[ReadSlot] == ESlotState::Empty)
+				{
+					Lock.unlock();
+					const uint64 Count = Source.Read(GetSlot(ReadChunks));
+					Lock.lock();
+
+					if (Count == 0)
+					{
+						bSourceDone = true;
+					}
+					else
+					{
+						SlotCounts[ReadSlot] = Count;
+						SlotStates[ReadSlot] = ESlotState::Filled;
+						++ReadChunks;
+						Stats.BytesRead += Count * sizeof(VectorType);
+					}
+					Condition.notify_all();
+				}
+				else
+				{
+					Condition.wait(Lock);
+				}
+			} });
+
+		// Process chunks in order on this thread and the worker pool
+		for (uint64 Chunk = 0;; ++Chunk)
+		{
+			const int32 Slot = static_cast<int32>(Chunk % BufferCount);
+			uint64 Count;
+			{
+				std::unique_lock<std::mutex> Lock(Mutex);
+				Condition.wait(Lock, [&]
+							   { return SlotStates[Slot] == ESlotState::Filled || (Chunk >= ReadChunks && (bSourceDone || bFailed)); });
+				if (SlotStates[Slot] != ESlotState::Filled || bFailed)
+					break;
+				Count = SlotCounts[Slot];
+			}
+
+			Process(GetSlot(Chunk).first(Count));
+
+			std::lock_guard<std::mutex> Lock(Mutex);
+			SlotStates[Slot] = ESlotState::Processed;
+			Stats.ElementCount += Count;
+			++Stats.ChunkCount;
+			Condition.notify_all();
+		}
+
+		IOThread.join();
+
+		Stats.bSucceeded = !bFailed;
+		Stats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+		return Stats;
+	}
+
+	// Explicit instantiation for float
+	template class FVectorFileSource<FVector2D<float>>;
+	template class FVectorFileSource<FVector3D<float>>;
+	template class FVectorFileSource<FVector4D<float>>;
+	template class FVectorFileSink<FVector2D<float>>;
+	template class FVectorFileSink<FVector3D<float>>;
+	template class FVectorFileSink<FVector4D<float>>;
+	template class FVectorPipeline<FVector2D<float>>;
+	template class FVectorPipeline<FVector3D<float>>;
+	template class FVectorPipeline<FVector4D<float>>;
+
+	// Explicit instantiation for double
+	template class FVectorFileSource<FVector2D<double>>;
+	template class FVectorFileSource<FVector3D<double>>;
+	template class FVectorFileSource<FVector4D<double>>;
+	template class FVectorFileSink<FVector2D<double>>;
+	template class FVectorFileSink<FVector3D<double>>;
+	template class FVectorFileSink<FVector4D<double>>;
+	template class FVectorPipeline<FVector2D<double>>;
+	template class FVectorPipeline<FVector3D<double>>;
+	template class FVectorPipeline<FVector4D<double>>;
+}
@@ -0,0 +1,344 @@
+#include "VectorReduce.h"
+#include "Instrument.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace Ratchet
+{
+	namespace
+	{
+		// Independent accumulators per component, enough to hide the add latency
+		constexpr int32 LaneCount = 8;
+
+		// Vectors summed directly at the leaves of the pairwise recursion
+		constexpr int64 PairwiseBlockSize = 256;
+
+		// Inputs are split into at most MaxPartitionCount partitions of at least MinPartitionSize vectors
+		constexpr int64 MinPartitionSize = 16384;
+		constexpr int64 MaxPartitionCount = 256;
+
+		template <typename T, int32 Width>
+		using TSums = std::array<T, Width>;
+
+		/**
+		 * Sums Width-wide records [Begin, End) produced by Load(Index, Out) with the given algorithm.
+		 * Records are gathered LaneCount at a time into a flat block so the adds run over contiguous lanes.
+		 */
+		template <typename T, int32 Width, typename LoadFunction>
+		TSums<T, Width> SumRange(const int64 Begin, const int64 End, const ESummation Summation, const LoadFunction &Load)
+		{
+			if (Summation == ESummation::Pairwise)
+			{
+				if (End - Begin > PairwiseBlockSize)
+				{
+					const int64 Mid = Begin + (End - Begin) / 2;
+					TSums<T, Width> Result = SumRange<T, Width>(Begin, Mid, Summation, Load);
+					const TSums<T, Width> Right = SumRange<T, Width>(Mid, End, Summation, Load);
+					for (int32 k = 0; k < Width; ++k)
+						Result[k] += Right[k];
+					return Result;
+				}
+			}
+
+			const bool bKahan = Summation == ESummation::Kahan;
+
+			T Block[LaneCount * Width];
+			T Sums[LaneCount * Width] = {};
+			T Compensations[LaneCount * Width] = {};
+
+			int64 Index = Begin;
+			for (; Index + LaneCount <= End; Index += LaneCount)
+			{
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Load(Index + Lane, Block + Lane * Width);
+
+				if (bKahan)
+				{
+					for (int32 k = 0; k < LaneCount * Width; ++k)
+					{
+						const T Value = Block[k] - Compensations[k];
+						const T NewSum = Sums[k] + Value;
+						Compensations[k] = (NewSum - Sums[k]) - Value;
+						Sums[k] = NewSum;
+					}
+				}
+				else
+				{
+					for (int32 k = 0; k < LaneCount * Width; ++k)
+						Sums[k] += Block[k];
+				}
+			}
+
+			// Fold the remaining records into the first lane, then the lanes into the result
+			for (; Index < End; ++Index)
+			{
+				Load(Index, Block);
+				for (int32 k = 0; k < Width; ++k)
+				{
+					const T Value = Block[k] - Compensations[k];
+					const T NewSum = Sums[k] + Value;
+					Compensations[k] = bKahan ? (NewSum - Sums[k]) - Value : 0;
+					Sums[k] = NewSum;
+				}
+			}
+
+			TSums<T, Width> Result;
+			for (int32 k = 0; k < Width; ++k)
+			{
+				T Total = 0;
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+					Total += Sums[Lane * Width + k] - Compensations[Lane * Width + k];
+				Result[k] = Total;
+			}
+			return Result;
+		}
+
+		// Number and length of the partitions of a large input; depends only on the count
+		void GetPartitions(const int64 Count, int64 &OutPartitionCount, int64 &OutPartitionSize)
+		{
+			OutPartitionCount = std::clamp<int64>(Count / MinPartitionSize, 1, MaxPartitionCount);
+			OutPartitionSize = (Count + OutPartitionCount - 1) / OutPartitionCount;
+		}
+
+		template <typename T, int32 Width, typename LoadFunction>
+		TSums<T, Width> Reduce(const int64 Count, const ESummation Summation, const LoadFunction &Load)
+		{
+			int64 PartitionCount, PartitionSize;
+			GetPartitions(Count, PartitionCount, PartitionSize);
+			if (PartitionCount == 1)
+				return SumRange<T, Width>(0, Count, Summation, Load);
+
+			TSums<T, Width> Partials[MaxPartitionCount];
+			Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+								  {
+				for (int64 Partition = Begin; Partition < End; ++Partition)
+					Partials[Partition] = SumRange<T, Width>(Partition * PartitionSize, std::min(Count, (Partition + 1) * PartitionSize), Summation, Load); });
+
+			// Combine neighbors level by level, a fixed tree over the partitions
+			for (int64 Stride = 1; Stride < PartitionCount; Stride *= 2)
+			{
+				for (int64 Partition = 0; Partition + Stride < PartitionCount; Partition += 2 * Stride)
+				{
+					for (int32 k = 0; k < Width; ++k)
+						Partials[Partition][k] += Partials[Partition + Stride][k];
+				}
+			}
+			return Partials[0];
+		}
+
+		template <typename VectorType>
+		FBounds<VectorType> BoundsRange(std::span<const VectorType> Vectors)
+		{
+			using T = typename TVectorTraits<VectorType>::ScalarType;
+			constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+			constexpr int32 BlockWidth = LaneCount * Dimension;
+
+			const int64 Count = static_cast<int64>(Vectors.size());
+
+			T Mins[BlockWidth];
+			T Maxs[BlockWidth];
+			std::fill_n(Mins, BlockWidth, std::numeric_limits<T>::max());
+			std::fill_n(Maxs, BlockWidth, std::numeric_limits<T>::lowest());
+
+			int64 Index = 0;
+			for (; Index + LaneCount <= Count; Index += LaneCount)
+			{
+				T Block[BlockWidth];
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					for (int32 Component = 0; Component < Dimension; ++Component)
+						Block[Lane * Dimension + Component] = Vectors[Index + Lane][static_cast<int8>(Component)];
+				}
+				for (int32 k = 0; k < BlockWidth; ++k)
+				{
+					Mins[k] = Block[k] < Mins[k] ? Block[k] : Mins[k];
+					Maxs[k] = Maxs[k] < Block[k] ? Block[k] : Maxs[k];
+				}
+			}
+			for (int32 Lane = 0; Index < Count; ++Lane, ++Index)
+			{
+				for (int32 Component = 0; Component < Dimension; ++Component)
+				{
+					const int32 k = Lane * Dimension + Component;
+					Mins[k] = std::min(Mins[k], Vectors[Index][static_cast<int8>(Component)]);
+					Maxs[k] = std::max(Maxs[k], Vectors[Index][static_cast<int8>(Component)]);
+				}
+			}
+
+			FBounds<VectorType> Result;
+			for (int32 Component = 0; Component < Dimension; ++Component)
+			{
+				T Min = Mins[Component];
+				T Max = Maxs[Component];
+				for (int32 Lane = 1; Lane < LaneCount; ++Lane)
+				{
+					Min = std::min(Min, Mins[Lane * Dimension + Component]);
+					Max = std::max(Max, Maxs[Lane * Dimension + Component]);
+				}
+				Result.Min[static_cast<int8>(Component)] = Min;
+				Result.Max[static_cast<int8>(Component)] = Max;
+			}
+			return Result;
+		}
+	}
+
+	template <typename VectorType>
+	VectorType Sum(std::span<const VectorType> Vectors, const ESummation Summation)
+	{
+		using T = typename TVectorTraits<VectorType>::ScalarType;
+		constexpr int32 Dimension = TVectorTraits<VectorType>::Dimension;
+
+		RATCHET_INSTRUMENT_BATCH(VectorSum, Vectors.size());
+
+		const TSums<T, Dimension> Sums = Reduce<T, Dimension>(static_cast<int64>(Vectors.size()), Summation, [Vectors](const int64 Index, T *Out)
+															  {
+			for (int32 Component = 0; Component < Dimension; ++Component)
+				Out[Component] = Vectors[Index][static_cast<int8>(Component)]; });
+
+		VectorType Result;
+		for (int32 Component = 0; Component < Dimension; ++Component)
+			Result[static_cast<int8>(Component)] = Sums[Component];
+		return Result;
+	}
+
+	template <typename VectorType>
+	VectorType Mean(std::span<const VectorType> Vectors, const ESummation Summation)
+	{
+		using T = typename TVectorTraits<VectorType>::ScalarType;
+
+		if (Vectors.empty())
+			return VectorType();
+
+		return Sum(Vectors, Summation) * (static_cast<T>(1) / static_cast<T>(Vectors.size()));
+	}
+
+	template <typename VectorType>
+	VectorType ComponentMin(std::span<const VectorType> Vectors)
+	{
+		return Bounds(Vectors).Min;
+	}
+
+	template <typename VectorType>
+	VectorType ComponentMax(std::span<const VectorType> Vectors)
+	{
+		return Bounds(Vectors).Max;
+	}
+
+	template <typename VectorType>
+	FBounds<VectorType> Bounds(std::span<const VectorType> Vectors)
+	{
+		RATCHET_INSTRUMENT_BATCH(VectorBounds, Vectors.size());
+
+		int64 PartitionCount, PartitionSize;
+		GetPartitions(static_cast<int64>(Vectors.size()), PartitionCount, PartitionSize);
+		if (PartitionCount == 1)
+			return BoundsRange(Vectors);
+
+		FBounds<VectorType> Partials[MaxPartitionCount];
+		Parallel::ParallelFor(PartitionCount, 1, [&](const int64 Begin, const int64 End)
+							  {
+			for (int64 Partition = Begin; Partition < End; ++Partition)
+			{
+				const int64 First = Partition * PartitionSize;
+				Partials[Partition] = BoundsRange(Vectors.subspan(First, std::min<int64>(PartitionSize, Vectors.size() - First)));
+			} });
+
+		FBounds<VectorType> Result = Partials[0];
+		for (int64 Partition = 1; Partition < PartitionCount; ++Partition)
+		{
+			for (int8 Component = 0; Component < TVectorTraits<VectorType>::Dimension; ++Component)
+			{
+				Result.Min[Component] = std::min(Result.Min[Component], Partials[Partition].Min[Component]);
+				Result.Max[Component] = std::max(Result.Max[Component], Partials[Partition].Max[Component]);
+			}
+		}
+		return Result;
+	}
+
+	template <FloatingPoint T>
+	FSymmetricMatrix3x3<T> Covariance3x3(std::span<const FVector3D<T>> Points, const ESummation Summation)
+	{
+		RATCHET_INSTRUMENT_BATCH(VectorCovariance, Points.size());
+
+		if (Points.empty())
+			return FSymmetricMatrix3x3<T>();
+
+		const FVector3D<T> Center = Mean(Points, Summation);
+		const T CenterX = Center.GetX();
+		const T CenterY = Center.GetY();
+		const T CenterZ = Center.GetZ();
+
+		const TSums<T, 6> Sums = Reduce<T, 6>(static_cast<int64>(Points.size()), Summation, [=](const int64 Index, T *Out)
+											  {
+			const T X = Points[Index].GetX() - CenterX;
+			const T Y = Points[Index].GetY() - CenterY;
+			const T Z = Points[Index].GetZ() - CenterZ;
+			Out[0] = X * X;
+			Out[1] = X * Y;
+			Out[2] = X * Z;
+			Out[3] = Y * Y;
+			Out[4] = Y * Z;
+			Out[5] = Z * Z; });
+
+		const T InverseCount = static_cast<T>(1) / static_cast<T>(Points.size());
+		return {Sums[0] * InverseCount, Sums[1] * InverseCount, Sums[2] * InverseCount,
+				Sums[3] * InverseCount, Sums[4] * InverseCount, Sums[5] * InverseCount};
+	}
+
+	// Explicit instantiation for float
+	template FVector2D<float> Sum<FVector2D<float>>(std::span<const FVector2D<float>> Vectors, const ESummation Summation);
+	template FVector3D<float> Sum<FVector3D<float>>(std::span<const FVector3D<float>> Vectors, const ESummation Summation);
+	template FVector4D<float> Sum<FVector4D<float>>(std::span<const FVector4D<float>> Vectors, const ESummation Summation);
+	template FVector2D<float> Mean<FVector2D<float>>(std::span<const FVector2D<float>> Vectors, const ESummation Summation);
+	template FVector3D<float> Mean<FVector3D<float>>(std::span<const FVector3D<float>> Vectors, const ESummation Summation);
+	template FVector4D<float> Mean<FVector4D<float>>(std::span<const FVector4D<float>> Vectors, const ESummation Summation);
+	template FVector2D<float> ComponentMin<FVector2D<float>>(std::span<const FVector2D<float>> Vectors);
+	template FVector3D<float> ComponentMin<FVector3D<float>>(std::span<const FVector3D<float>> Vectors);
+	template FVector4D<float> ComponentMin<FVector4D<float>>(std::span<const FVector4D<float>> Vectors);
+	template FVector2D<float> ComponentMax<FVector2D<float>>(std::span<const FVector2D<float>> Vectors);
+	template FVector3D<float> ComponentMax<FVector3D<float>>(std::span<const FVector3D<float>> Vectors);
+	template FVector4D<float> ComponentMax<FVector4D<float>>(std::span<const FVector4D<float>> Vectors);
+	template FBounds<FVector2D<float>> Bounds<FVector2D<float>>(std::span<const FVector2D<float>> Vectors);
+	template FBounds<FVector3D<float>> Bounds<FVector3D<float>>(std::span<const FVector3D<float>> Vectors);
+	template FBounds<FVector4D<float>> Bounds<FVector4D<float>>(std::span<const FVector4D<float>> Vectors);
+	template FSymmetricMatrix3x3<float> Covariance3x3<float>(std::span<const FVector3D<float>> Points, const ESummation Summation);
+
+	// Explicit instantiation for double
+	template FVector2D<double> Sum<FVector2D<double>>(std::span<const FVector2D<double>> Vectors, const ESummation Summation);
+	template FVector3D<double> Sum<FVector3D<double>>(std::span<const FVector3D<double>> Vectors, const ESummation Summation);
+	template FVector4D<double> Sum<FVector4D<double>>(std::span<const FVector4D<double>> Vectors, const ESummation Summation);
+	template FVector2D<double> Mean<FVector2D<double>>(std::span<const FVector2D<double>> Vectors, const ESummation Summation);
+	template FVector3D<double> Mean<FVector3D<double>>(std::span<const FVector3D<double>> Vectors, const ESummation Summation);
+	template FVector4D<double> Mean<FVector4D<double>>(std::span<const FVector4D<double>> Vectors, const ESummation Summation);
+	template FVector2D<double> ComponentMin<FVector2D<double>>(std::span<const FVector2D<double>> Vectors);
+	template FVector3D<double> ComponentMin<FVector3D<double>>(std::span<const FVector3D<double>> Vectors);
+	template FVector4D<double> ComponentMin<FVector4D<double>>(std::span<const FVector4D<double>> Vectors);
+	template FVector2D<double> ComponentMax<FVector2D<double>>(std::span<const FVector2D<double>> Vectors);
+	template FVector3D<double> ComponentMax<FVector3D<double>>(std::span<const FVector3D<double>> Vectors);
+	template FVector4D<double> ComponentMax<FVector4D<double>>(std::span<const FVector4D<double>> Vectors);
+	template FBounds<FVector2D<double>> Bounds<FVector2D<double>>(std::span<const FVector2D<double>> Vectors);
+	template FBounds<FVector3D<double>> Bounds<FVector3D<double>>(std::span<const FVector3D<double>> Vectors);
+	template FBounds<FVector4D<double>> Bounds<FVector4D<double>>(std::span<const FVector4D<double>> Vectors);
+	template FSymmetricMatrix3x3<double> Covariance3x3<double>(std::span<const FVector3D<double>> Points, const ESummation Summation);
+
+	// Explicit instantiation for long double
+	template FVector2D<long double> Sum<FVector2D<long double>>(std::span<const FVector2D<long double>> Vectors, const ESummation Summation);
+	template FVector3D<long double> Sum<FVector3D<long double>>(std::span<const FVector3D<long double>> Vectors, const ESummation Summation);
+	template FVector4D<long double> Sum<FVector4D<long double>>(std::span<const FVector4D<long double>> Vectors, const ESummation Summation);
+	template FVector2D<long double> Mean<FVector2D<long double>>(std::span<const FVector2D<long double>> Vectors, const ESummation Summation);
+	template FVector3D<long double> Mean<FVector3D<long double>>(std::span<const FVector3D<long double>> Vectors, const ESummation Summation);
+	template FVector4D<long double> Mean<FVector4D<long double>>(std::span<const FVector4D<long double>> Vectors, const ESummation Summation);
+	template FVector2D<long double> ComponentMin<FVector2D<long double>>(std::span<const FVector2D<long double>> Vectors);
+	template FVector3D<long double> ComponentMin<FVector3D<long double>>(std::span<const FVector3D<long double>> Vectors);
+	template FVector4D<long double> ComponentMin<FVector4D<long double>>(std::span<const FVector4D<long double>> Vectors);
+	template FVector2D<long double> ComponentMax<FVector2D<long double>>(std::span<const FVector2D<long double>> Vectors);
+	template FVector3D<long double> ComponentMax<FVector3D<long double>>(std::span<const FVector3D<long double>> Vectors);
+	template FVector4D<long double> ComponentMax<FVector4D<long double>>(std::span<const FVector4D<long double>> Vectors);
+	template FBounds<FVector2D<long double>> Bounds<FVector2D<long double>>(std::span<const FVector2D<long double>> Vectors);
+	template FBounds<FVector3D<long double>> Bounds<FVector3D<long double>>(std::span<const FVector3D<long double>> Vectors);
+	template FBounds<FVector4D<long double>> Bounds<FVector4D<long double>>(std::span<const FVector4D<long double>> Vectors);
+	template FSymmetricMatrix3x3<long double> Covariance3x3<long double>(std::span<const FVector3D<long double>> Points, const ESummation Summation);
+}
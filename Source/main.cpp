@@ -12,7 +12,7 @@ int main()
 	Vector2D Location2X{3, 4}, Location2Y{4, 5};
 
 	auto X2 = Distance(Location2X, Location2Y);
-	// auto Y2 = Cross(Location2X, Location2Y);
+	auto Y2 = Cross(Location2X, Location2Y);
 	auto Z2 = Dot(Location2X, Location2Y);
 
 	Vector4D Location4X{3, 4, 5, 6}, Location4Y{5, 6, 7, 8};